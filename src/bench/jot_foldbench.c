@@ -0,0 +1,363 @@
+/*
+    jot - Folding Benchmark
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+
+/*
+    Measures what jot_Fold saves on generated scripts, by counting the
+    operations a straightforward code generator would have to emit for
+    them (one per operator, and one per read of a name) before and after
+    folding, along with how long folding takes:
+
+        cc -O2 -I../jot jot_foldbench.c ../jot/jot_*.c -o jot_foldbench -lpthread -lm
+        ./jot_foldbench [-size megabytes] [-repeat count] [-json]
+
+    Each operation that's folded away is one that no longer runs every
+    time the script does.
+*/
+#if defined(__unix__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 200112L
+#define JOT_BENCH_POSIX
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef JOT_BENCH_POSIX
+#include <sys/time.h>
+#endif
+
+#include "jot_fold.h"
+#include "jot_parse.h"
+
+typedef struct
+{
+    char* data;
+    size_t size;
+    size_t capacity;
+    /* Deterministic, so every run and every release folds the same text. */
+    unsigned long seed;
+} Corpus;
+
+typedef struct
+{
+    const char* name;
+    void (*generate)(Corpus* corpus);
+} CorpusKind;
+
+typedef struct
+{
+    unsigned long operators;
+    unsigned long names;
+} Operations;
+
+static size_t corpus_size = 4 << 20;
+
+static unsigned long Random(Corpus* corpus, unsigned long limit)
+{
+    corpus->seed = (corpus->seed * 1103515245UL + 12345UL) & 0x7FFFFFFFUL;
+    return (corpus->seed >> 8) % limit;
+}
+
+static void AppendString(Corpus* corpus, const char* text)
+{
+    size_t length = strlen(text);
+    if(corpus->size + length > corpus->capacity)
+    {
+        while(corpus->size + length > corpus->capacity)
+        {
+            corpus->capacity = corpus->capacity ? corpus->capacity * 2 : 4096;
+        }
+        corpus->data = realloc(corpus->data, corpus->capacity);
+        if(corpus->data == NULL)
+        {
+            fprintf(stderr, "jot_foldbench: out of memory\n");
+            exit(1);
+        }
+    }
+    memcpy(corpus->data + corpus->size, text, length);
+    corpus->size += length;
+}
+
+/* Settings the way a generator writes them out, as literal arithmetic over named constants. */
+static void GenerateConstants(Corpus* corpus)
+{
+    char line[512];
+    unsigned long n = 0;
+    
+    while(corpus->size < corpus_size)
+    {
+        unsigned long k = Random(corpus, 16);
+        sprintf(line,
+            "func plugin_%lu(config, event)\n"
+            "    var flags = 1 << %lu | 0b100, 0x%lx & ~0xF\n"
+            "    var timeout = 60 * 60 * 24 * %lu\n"
+            "    var prefix = \"plugin\" .. \".\" .. \"name%lu\"\n"
+            "    var scale = 1.5 * %lu / 2\n"
+            "    config.timeout = timeout * 7 + flags - (-%lu)\n"
+            "    if flags & 4 != 0 and not false then\n"
+            "        config.log(prefix .. event.name, event.size * scale)\n"
+            "    end\n"
+            "    -> timeout > 3600 or event.fallback, 2 ** 10 - 1\n"
+            "end\n",
+            n, k, k * 4099, k + 1, n, k, k);
+        AppendString(corpus, line);
+        n++;
+    }
+}
+
+/* Ordinary code, where little is constant, to show folding doesn't get in the way. */
+static void GenerateCode(Corpus* corpus)
+{
+    char line[512];
+    unsigned long n = 0;
+    
+    while(corpus->size < corpus_size)
+    {
+        sprintf(line,
+            "func update_%lu(self, items, dt)\n"
+            "    var total = 0\n"
+            "    for item in items do\n"
+            "        total = total + item.weight * dt\n"
+            "        if item.alive and item.x < self.width then\n"
+            "            item.x = item.x + item.speed * dt - %lu\n"
+            "        end\n"
+            "    end\n"
+            "    -> total / %lu\n"
+            "end\n",
+            n, Random(corpus, 100), n + 1);
+        AppendString(corpus, line);
+        n++;
+    }
+}
+
+static const CorpusKind corpus_kinds[] = {
+    { "constants", GenerateConstants },
+    { "code", GenerateCode }
+};
+
+static void Count(const jot_Ast* ast, jot_NodeRef node, Operations* operations);
+
+static void CountChildren(const jot_Ast* ast, jot_NodeRef node, size_t first, size_t count, Operations* operations)
+{
+    size_t i;
+    for(i = 0; i < count; i++)
+    {
+        Count(ast, jot_AstWord(ast, node, first + i), operations);
+    }
+}
+
+static void Count(const jot_Ast* ast, jot_NodeRef node, Operations* operations)
+{
+    size_t count;
+    size_t i;
+    jot_NodeRef target;
+    
+    if(!node)
+    {
+        return;
+    }
+    switch(jot_AstKind(ast, node))
+    {
+        case JOT_NODE_NAME:
+            operations->names++;
+            break;
+        case JOT_NODE_FUNC:
+            Count(ast, jot_AstWord(ast, node, 2), operations);
+            break;
+        case JOT_NODE_TABLE:
+            CountChildren(ast, node, 1, jot_AstWord(ast, node, 0) * 2, operations);
+            break;
+        case JOT_NODE_ARRAY:
+        case JOT_NODE_BLOCK:
+        case JOT_NODE_RETURN:
+            CountChildren(ast, node, 1, jot_AstWord(ast, node, 0), operations);
+            break;
+        case JOT_NODE_CALL:
+            Count(ast, jot_AstWord(ast, node, 0), operations);
+            CountChildren(ast, node, 2, jot_AstWord(ast, node, 1), operations);
+            break;
+        case JOT_NODE_METHOD_CALL:
+            Count(ast, jot_AstWord(ast, node, 0), operations);
+            CountChildren(ast, node, 3, jot_AstWord(ast, node, 2), operations);
+            break;
+        case JOT_NODE_UNARY:
+            operations->operators++;
+            Count(ast, jot_AstWord(ast, node, 0), operations);
+            break;
+        case JOT_NODE_BINARY:
+        case JOT_NODE_AND:
+        case JOT_NODE_OR:
+            operations->operators++;
+            CountChildren(ast, node, 0, 2, operations);
+            break;
+        case JOT_NODE_INDEX:
+        case JOT_NODE_WHILE:
+        case JOT_NODE_REPEAT:
+            CountChildren(ast, node, 0, 2, operations);
+            break;
+        case JOT_NODE_VAR:
+            CountChildren(ast, node, 2 + jot_AstWord(ast, node, 0), jot_AstWord(ast, node, 1), operations);
+            break;
+        case JOT_NODE_ASSIGN:
+            /* Storing to a name isn't reading it. */
+            count = jot_AstWord(ast, node, 0);
+            for(i = 0; i < count; i++)
+            {
+                target = jot_AstWord(ast, node, 2 + i);
+                if(jot_AstKind(ast, target) == JOT_NODE_INDEX)
+                {
+                    CountChildren(ast, target, 0, 2, operations);
+                }
+            }
+            CountChildren(ast, node, 2 + count, jot_AstWord(ast, node, 1), operations);
+            break;
+        case JOT_NODE_IF:
+            CountChildren(ast, node, 1, jot_AstWord(ast, node, 0) * 2 + 1, operations);
+            break;
+        case JOT_NODE_FOR:
+            CountChildren(ast, node, 0, 2, operations);
+            break;
+        default:
+            break;
+    }
+}
+
+static double Now(void)
+{
+#ifdef JOT_BENCH_POSIX
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec + now.tv_usec * 1e-6;
+#else
+    return (double) clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+int main(int argc, char** argv)
+{
+    int repeat = 5;
+    int json = 0;
+    Corpus corpus;
+    jot_AtomTable* atoms;
+    jot_ParseError error;
+    jot_Ast* ast;
+    Operations before, after;
+    double start, elapsed, best;
+    size_t i;
+    int k;
+    
+    for(k = 1; k < argc; k++)
+    {
+        if(strcmp(argv[k], "-size") == 0 && k + 1 < argc)
+        {
+            corpus_size = (size_t) atol(argv[++k]) << 20;
+        }
+        else if(strcmp(argv[k], "-repeat") == 0 && k + 1 < argc)
+        {
+            repeat = atoi(argv[++k]);
+        }
+        else if(strcmp(argv[k], "-json") == 0)
+        {
+            json = 1;
+        }
+        else
+        {
+            fprintf(stderr, "usage: jot_foldbench [-size megabytes] [-repeat count] [-json]\n");
+            return 1;
+        }
+    }
+    
+    if(!json)
+    {
+        printf("%-10s %10s %12s %12s %12s %12s %9s %9s\n",
+            "corpus", "bytes", "ops before", "ops after", "names before", "names after", "saved", "fold MB/s");
+    }
+    
+    for(i = 0; i < sizeof(corpus_kinds) / sizeof(corpus_kinds[0]); i++)
+    {
+        corpus.data = NULL;
+        corpus.size = 0;
+        corpus.capacity = 0;
+        corpus.seed = 1;
+        corpus_kinds[i].generate(&corpus);
+        
+        best = -1;
+        for(k = 0; k < repeat; k++)
+        {
+            atoms = jot_AtomTableNew(NULL);
+            ast = atoms != NULL ? jot_ParseText(NULL, corpus.data, corpus.size, atoms, 0, &error) : NULL;
+            if(ast == NULL)
+            {
+                fprintf(stderr, "jot_foldbench: %s\n", atoms != NULL ? error.message : "out of memory");
+                return 1;
+            }
+            before.operators = before.names = 0;
+            Count(ast, ast->root, &before);
+            
+            start = Now();
+            if(!jot_Fold(ast, ast->root))
+            {
+                fprintf(stderr, "jot_foldbench: out of memory\n");
+                return 1;
+            }
+            elapsed = Now() - start;
+            if(best < 0 || elapsed < best)
+            {
+                best = elapsed;
+            }
+            
+            after.operators = after.names = 0;
+            Count(ast, ast->root, &after);
+            jot_AstFree(ast);
+            jot_AtomTableFree(atoms);
+        }
+        if(best <= 0)
+        {
+            best = 1e-9;
+        }
+        
+        if(json)
+        {
+            printf("{\"corpus\": \"%s\", \"bytes\": %lu, \"operators_before\": %lu, \"operators_after\": %lu, "
+                "\"names_before\": %lu, \"names_after\": %lu, \"fold_seconds\": %.6f}\n",
+                corpus_kinds[i].name, (unsigned long) corpus.size, before.operators, after.operators,
+                before.names, after.names, best);
+        }
+        else
+        {
+            printf("%-10s %10lu %12lu %12lu %12lu %12lu %8.1f%% %9.1f\n",
+                corpus_kinds[i].name, (unsigned long) corpus.size, before.operators, after.operators,
+                before.names, after.names,
+                100.0 - 100.0 * (after.operators + after.names) / (before.operators + before.names),
+                corpus.size / best / 1e6);
+        }
+        free(corpus.data);
+    }
+    
+    return 0;
+}
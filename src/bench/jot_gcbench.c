@@ -0,0 +1,275 @@
+/*
+    jot - GC Benchmark
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+
+/*
+    Measures how long the collector stops scripts for, once a lot of the
+    heap is alive and a script is making garbage as fast as it can:
+
+        cc -O2 -I../jot jot_gcbench.c ../jot/jot_*.c -o jot_gcbench -lpthread -lm
+        ./jot_gcbench [-mb n] [-churn n] [-budget n] [-repeat count] [-json]
+
+    First a script builds up a global array of small tables, each with a
+    string and an array of its own, until a full collection finds -mb
+    megabytes live, give or take one batch of 1000 of them; that's the
+    live heap reported, whereas the heap afterward includes garbage.
+    Then another makes -churn tables, strings and arrays that are mostly
+    thrown away, now and then storing one in an old table so the write
+    barrier has work to do. -budget sets gc.budget, the most work one step
+    may do, to see what it trades between pauses and throughput.
+
+    The churn is run -repeat times, and the fastest run is reported, along
+    with the pauses of every run: how many steps took each power of 2
+    microseconds, their percentiles (rounded up to the top of a bucket),
+    and the longest. Pauses are timed with the same clock as the rest.
+*/
+#if defined(__unix__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 200112L
+#define JOT_BENCH_POSIX
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef JOT_BENCH_POSIX
+#include <sys/time.h>
+#endif
+
+#include "jot_gc.h"
+#include "jot_lib.h"
+#include "jot_vm.h"
+
+/* Given how many nodes to add to live as '...'. */
+static const char build_text[] =
+    "var count = ...\n"
+    "if live == nil then live = [] end\n"
+    "for i in count do\n"
+    "    var id = len(live)\n"
+    "    push(live, {id: id, name: \"node\" .. id, items: [id, \"item\", nil], next: nil})\n"
+    "end\n";
+
+/* Given how many times to go around as '...'. */
+static const char churn_text[] =
+    "var count = ...\n"
+    "var size = len(live)\n"
+    "for i in count do\n"
+    "    var t = {x: i, name: \"garbage\" .. i}\n"
+    "    var a = [t, i, t.name]\n"
+    "    if i % 64 == 0 then live[i * 7919 % size].next = a end\n"
+    "end\n";
+
+/* Nodes the build script adds per call, so the heap can be checked as it grows. */
+enum { BATCH = 1000 };
+
+static const double percentiles[] = { 0.5, 0.9, 0.99, 0.999 };
+static const char* const percentile_names[] = { "p50", "p90", "p99", "p99.9" };
+
+static double Now(void)
+{
+#ifdef JOT_BENCH_POSIX
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec + now.tv_usec * 1e-6;
+#else
+    return (double) clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+static int Run(jot_Vm* vm, const char* name, jot_Value function, long count)
+{
+    jot_Value arg;
+    
+    JOT_SET_SMALL_INT(&arg, count);
+    if(!jot_VmCall(vm, function, &arg, 1, NULL, 0))
+    {
+        fprintf(stderr, "jot_gcbench: %s: %s\n", name, vm->error);
+        return 0;
+    }
+    return 1;
+}
+
+int main(int argc, char** argv)
+{
+    long mb = 64;
+    long churn = 2000000;
+    long budget = -1;
+    int repeat = 3;
+    int json = 0;
+    jot_Vm* vm;
+    jot_Gc* gc;
+    jot_Value build;
+    jot_Value churner;
+    unsigned long cycles, steps;
+    size_t freed;
+    double start, elapsed, best, build_seconds;
+    size_t live = 0;
+    size_t objects;
+    size_t i;
+    int k;
+    
+    for(k = 1; k < argc; k++)
+    {
+        if(strcmp(argv[k], "-mb") == 0 && k + 1 < argc)
+        {
+            mb = atol(argv[++k]);
+        }
+        else if(strcmp(argv[k], "-churn") == 0 && k + 1 < argc)
+        {
+            churn = atol(argv[++k]);
+        }
+        else if(strcmp(argv[k], "-budget") == 0 && k + 1 < argc)
+        {
+            budget = atol(argv[++k]);
+        }
+        else if(strcmp(argv[k], "-repeat") == 0 && k + 1 < argc)
+        {
+            repeat = atoi(argv[++k]);
+        }
+        else if(strcmp(argv[k], "-json") == 0)
+        {
+            json = 1;
+        }
+        else
+        {
+            fprintf(stderr, "usage: jot_gcbench [-mb n] [-churn n] [-budget n] [-repeat count] [-json]\n");
+            return 1;
+        }
+    }
+    
+    vm = jot_VmNew(NULL);
+    if(vm == NULL || !jot_LibOpen(vm))
+    {
+        fprintf(stderr, "jot_gcbench: out of memory\n");
+        return 1;
+    }
+    gc = &vm->heap.gc;
+    gc->clock = Now;
+    if(budget > 0)
+    {
+        gc->budget = (size_t) budget;
+    }
+    if(!jot_VmLoad(vm, "build", build_text, sizeof(build_text) - 1, &build)
+        || !jot_VmLoad(vm, "churn", churn_text, sizeof(churn_text) - 1, &churner))
+    {
+        fprintf(stderr, "jot_gcbench: %s\n", vm->error);
+        return 1;
+    }
+    /* Otherwise the collector would free one while the other runs. */
+    if(!jot_VmSetGlobal(vm, "build", build) || !jot_VmSetGlobal(vm, "churn", churner))
+    {
+        fprintf(stderr, "jot_gcbench: out of memory\n");
+        return 1;
+    }
+    
+    start = Now();
+    while(live < (size_t) mb << 20)
+    {
+        if(!Run(vm, "build", build, BATCH))
+        {
+            return 1;
+        }
+        /* The heap's bytes count garbage too, until a collection shows how much is live. */
+        if(vm->heap.bytes >= (size_t) mb << 20)
+        {
+            jot_GcCollect(vm);
+            live = vm->heap.bytes;
+        }
+    }
+    build_seconds = Now() - start;
+    objects = vm->heap.count;
+    
+    /* Only the churn's pauses are reported. */
+    cycles = gc->cycles;
+    steps = gc->steps;
+    freed = gc->freed;
+    memset(gc->pauses, 0, sizeof(gc->pauses));
+    gc->longest = 0;
+    
+    best = -1;
+    for(k = 0; k < repeat; k++)
+    {
+        start = Now();
+        if(!Run(vm, "churn", churner, churn))
+        {
+            return 1;
+        }
+        elapsed = Now() - start;
+        if(best < 0 || elapsed < best)
+        {
+            best = elapsed;
+        }
+    }
+    if(best <= 0)
+    {
+        best = 1e-9;
+    }
+    cycles = gc->cycles - cycles;
+    steps = gc->steps - steps;
+    freed = gc->freed - freed;
+    
+    if(json)
+    {
+        printf("{\"live_mb\": %ld, \"live_bytes\": %lu, \"live_objects\": %lu, \"build_seconds\": %.6f, \"heap_bytes\": %lu, ",
+            mb, (unsigned long) live, (unsigned long) objects, build_seconds, (unsigned long) vm->heap.bytes);
+        printf("\"churn\": %ld, \"budget\": %lu, \"seconds\": %.6f, \"cycles\": %lu, \"steps\": %lu, \"freed\": %lu, ",
+            churn, (unsigned long) gc->budget, best, cycles, steps, (unsigned long) freed);
+        for(i = 0; i < sizeof(percentiles) / sizeof(percentiles[0]); i++)
+        {
+            printf("\"%s_seconds\": %.6f, ", percentile_names[i], jot_GcPercentile(gc, percentiles[i]));
+        }
+        printf("\"max_seconds\": %.6f, \"histogram\": [", gc->longest);
+        for(i = 0; i < JOT_GC_HISTOGRAM_SIZE; i++)
+        {
+            printf(i == 0 ? "%lu" : ", %lu", gc->pauses[i]);
+        }
+        printf("]}\n");
+    }
+    else
+    {
+        printf("live heap: %lu bytes in %lu objects, built in %.3f s; heap afterward %lu bytes\n",
+            (unsigned long) live, (unsigned long) objects, build_seconds, (unsigned long) vm->heap.bytes);
+        printf("churn: %ld in %.3f s, budget %lu, %lu cycles, %lu steps, %lu objects freed\n",
+            churn, best, (unsigned long) gc->budget, cycles, steps, (unsigned long) freed);
+        for(i = 0; i < sizeof(percentiles) / sizeof(percentiles[0]); i++)
+        {
+            printf("%s %.3f ms, ", percentile_names[i], jot_GcPercentile(gc, percentiles[i]) * 1e3);
+        }
+        printf("max %.3f ms\n", gc->longest * 1e3);
+        printf("%12s %10s\n", "pause us", "steps");
+        for(i = 0; i < JOT_GC_HISTOGRAM_SIZE; i++)
+        {
+            if(gc->pauses[i] != 0)
+            {
+                printf("%5lu-%-6lu %10lu\n", i == 0 ? 0UL : 1UL << (i - 1), 1UL << i, gc->pauses[i]);
+            }
+        }
+    }
+    
+    jot_VmFree(vm);
+    return 0;
+}
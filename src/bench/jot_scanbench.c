@@ -0,0 +1,552 @@
+/*
+    jot - Scanner Benchmark
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+
+/*
+    Measures how fast jot_ScannerNext gets through a set of generated
+    corpora, over each kind of jot_Source:
+
+        cc -O2 -I../jot jot_scanbench.c ../jot/jot_*.c -o jot_scanbench -lpthread -lm
+        ./jot_scanbench [-size megabytes] [-repeat count] [-dir path] [-json]
+
+    Each corpus is written to a file under -dir (default /tmp), scanned
+    -repeat times per source, and the fastest run is reported along with the
+    peak resident set size so far. The pipe- sources read the file through
+    `cat`, the way a large input usually arrives on standard input. With
+    -json, every result is printed as a single JSON object per line instead
+    of a table, to be kept around and compared between releases.
+
+    Allocations are counted by a jot_Allocator that everything is made with,
+    so they only cover what jot itself asks for.
+*/
+#if defined(__unix__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 200112L
+#define JOT_BENCH_POSIX
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef JOT_BENCH_POSIX
+#include <sys/resource.h>
+#include <sys/time.h>
+#endif
+
+#include "jot_source.h"
+#include "jot_scanner.h"
+
+static jot_Allocator allocator;
+
+typedef struct
+{
+    char* data;
+    size_t size;
+    size_t capacity;
+    /* Deterministic, so every run and every release scans the same text. */
+    unsigned long seed;
+} Corpus;
+
+typedef struct
+{
+    const char* name;
+    void (*generate)(Corpus* corpus);
+} CorpusKind;
+
+typedef struct
+{
+    const char* name;
+    jot_Source* (*open)(const char* filename, const Corpus* corpus);
+    void (*close)(jot_Source* source);
+} SourceKind;
+
+static size_t corpus_size = 8 << 20;
+
+static unsigned long Random(Corpus* corpus, unsigned long limit)
+{
+    corpus->seed = (corpus->seed * 1103515245UL + 12345UL) & 0x7FFFFFFFUL;
+    return (corpus->seed >> 8) % limit;
+}
+
+static void Append(Corpus* corpus, const char* text, size_t length)
+{
+    if(corpus->size + length > corpus->capacity)
+    {
+        while(corpus->size + length > corpus->capacity)
+        {
+            corpus->capacity = corpus->capacity ? corpus->capacity * 2 : 4096;
+        }
+        corpus->data = realloc(corpus->data, corpus->capacity);
+        if(corpus->data == NULL)
+        {
+            fprintf(stderr, "jot_scanbench: out of memory\n");
+            exit(1);
+        }
+    }
+    memcpy(corpus->data + corpus->size, text, length);
+    corpus->size += length;
+}
+
+static void AppendString(Corpus* corpus, const char* text)
+{
+    Append(corpus, text, strlen(text));
+}
+
+static void AppendChar(Corpus* corpus, char c)
+{
+    Append(corpus, &c, 1);
+}
+
+static void AppendIdentifier(Corpus* corpus, size_t length)
+{
+    static const char letters[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_";
+    static const char rest[] = "abcdefghijklmnopqrstuvwxyz_0123456789";
+    size_t i;
+    
+    AppendChar(corpus, letters[Random(corpus, sizeof(letters) - 1)]);
+    for(i = 1; i < length; i++)
+    {
+        AppendChar(corpus, rest[Random(corpus, sizeof(rest) - 1)]);
+    }
+}
+
+static void AppendDigits(Corpus* corpus, size_t length)
+{
+    size_t i;
+    for(i = 0; i < length; i++)
+    {
+        AppendChar(corpus, (char) ('0' + Random(corpus, 10)));
+    }
+}
+
+/* Code that's mostly names: declarations, calls, field accesses and keywords. */
+static void GenerateIdentifiers(Corpus* corpus)
+{
+    static const char* keywords[] = {"var", "if", "then", "end", "and", "not", "func", "while", "do", "for", "in"};
+    static const char* separators[] = {" ", " ", " = ", ".", ", ", "(", ") ", " == "};
+    int i;
+    
+    while(corpus->size < corpus_size)
+    {
+        for(i = 0; i < 10; i++)
+        {
+            if(Random(corpus, 5) == 0)
+            {
+                AppendString(corpus, keywords[Random(corpus, sizeof(keywords) / sizeof(keywords[0]))]);
+            }
+            else
+            {
+                AppendIdentifier(corpus, 1 + Random(corpus, 16));
+            }
+            AppendString(corpus, separators[Random(corpus, sizeof(separators) / sizeof(separators[0]))]);
+        }
+        AppendChar(corpus, '\n');
+    }
+}
+
+/* Data tables: integers, decimals with exponents, hex and binary, some with separators. */
+static void GenerateNumbers(Corpus* corpus)
+{
+    int i;
+    
+    while(corpus->size < corpus_size)
+    {
+        AppendChar(corpus, '[');
+        for(i = 0; i < 8; i++)
+        {
+            switch(Random(corpus, 6))
+            {
+                case 0:
+                    AppendDigits(corpus, 1 + Random(corpus, 6));
+                    break;
+                case 1:
+                    AppendDigits(corpus, 1 + Random(corpus, 3));
+                    AppendChar(corpus, '_');
+                    AppendDigits(corpus, 3);
+                    AppendChar(corpus, '_');
+                    AppendDigits(corpus, 3);
+                    break;
+                case 2:
+                    AppendString(corpus, "0x");
+                    AppendString(corpus, Random(corpus, 2) ? "FF_" : "1f");
+                    AppendString(corpus, Random(corpus, 2) ? "7A" : "c0de");
+                    break;
+                case 3:
+                    AppendString(corpus, Random(corpus, 2) ? "0b1011_0110" : "0b1");
+                    break;
+                case 4:
+                    AppendDigits(corpus, 1 + Random(corpus, 4));
+                    AppendChar(corpus, '.');
+                    AppendDigits(corpus, 1 + Random(corpus, 17));
+                    break;
+                default:
+                    AppendDigits(corpus, 1);
+                    AppendChar(corpus, '.');
+                    AppendDigits(corpus, 1 + Random(corpus, 8));
+                    AppendString(corpus, Random(corpus, 2) ? "e-" : "e+");
+                    AppendDigits(corpus, 1 + Random(corpus, 2));
+                    break;
+            }
+            AppendString(corpus, i < 7 ? ", " : "],\n");
+        }
+    }
+}
+
+/* String literals, a good share of them with escapes of every kind. */
+static void GenerateStrings(Corpus* corpus)
+{
+    static const char* pieces[] = {"hello", " world", "\\n", "\\t", "\\x41", "\\\\", " and some more text", "\\'", "\\\""};
+    unsigned long count, j;
+    int i;
+    
+    while(corpus->size < corpus_size)
+    {
+        AppendIdentifier(corpus, 1 + Random(corpus, 8));
+        AppendString(corpus, " = ");
+        for(i = 0; i < 3; i++)
+        {
+            AppendChar(corpus, i == 1 ? '\'' : '"');
+            count = Random(corpus, 10);
+            for(j = 0; j < count; j++)
+            {
+                AppendString(corpus, pieces[Random(corpus, sizeof(pieces) / sizeof(pieces[0]))]);
+            }
+            AppendString(corpus, i == 1 ? "'" : "\"");
+            AppendString(corpus, i < 2 ? " .. " : "\n");
+        }
+    }
+}
+
+/* Mostly commentary, with a little code between. */
+static void GenerateComments(Corpus* corpus)
+{
+    int i;
+    
+    while(corpus->size < corpus_size)
+    {
+        if(Random(corpus, 3) == 0)
+        {
+            AppendString(corpus, "##\n");
+            for(i = 0; i < 5; i++)
+            {
+                AppendString(corpus, "    The quick brown fox jumps over the lazy dog, ");
+                AppendIdentifier(corpus, 1 + Random(corpus, 30));
+                AppendString(corpus, " # not a line comment here\n");
+            }
+            AppendString(corpus, "##\n");
+        }
+        else
+        {
+            AppendString(corpus, "# The quick brown fox jumps over the lazy dog ");
+            AppendDigits(corpus, 1 + Random(corpus, 40));
+            AppendChar(corpus, '\n');
+        }
+        AppendIdentifier(corpus, 1 + Random(corpus, 12));
+        AppendString(corpus, " = 1 # trailing remark\n");
+    }
+}
+
+/* Ordinary code, but with Windows line ends. */
+static void GenerateCrlf(Corpus* corpus)
+{
+    while(corpus->size < corpus_size)
+    {
+        AppendString(corpus, "var ");
+        AppendIdentifier(corpus, 1 + Random(corpus, 12));
+        AppendString(corpus, " = ");
+        AppendDigits(corpus, 1 + Random(corpus, 5));
+        AppendString(corpus, " + \"");
+        AppendIdentifier(corpus, 1 + Random(corpus, 20));
+        AppendString(corpus, "\"\r\n\r\n");
+    }
+}
+
+/* A few enormous tokens, which can't stay spans across source chunks. */
+static void GenerateLongTokens(Corpus* corpus)
+{
+    while(corpus->size < corpus_size)
+    {
+        AppendIdentifier(corpus, 65536);
+        AppendString(corpus, "\n\"");
+        AppendIdentifier(corpus, 65536);
+        AppendString(corpus, "\"\n");
+        AppendDigits(corpus, 4096);
+        AppendString(corpus, "\n##");
+        AppendIdentifier(corpus, 65536);
+        AppendString(corpus, "##\n");
+    }
+}
+
+static const CorpusKind corpus_kinds[] = {
+    {"identifiers", GenerateIdentifiers},
+    {"numbers", GenerateNumbers},
+    {"strings", GenerateStrings},
+    {"comments", GenerateComments},
+    {"crlf", GenerateCrlf},
+    {"long-tokens", GenerateLongTokens}
+};
+
+static jot_Source* OpenFileSource(const char* filename, const Corpus* corpus)
+{
+    (void) corpus;
+    return jot_FileSourceNew(&allocator, filename);
+}
+
+static jot_Source* OpenMmapSource(const char* filename, const Corpus* corpus)
+{
+    (void) corpus;
+    return jot_MmapSourceNew(&allocator, filename);
+}
+
+static jot_Source* OpenStringSource(const char* filename, const Corpus* corpus)
+{
+    return jot_StringSourceNew(&allocator, filename, corpus->data, corpus->size);
+}
+
+static jot_Source* OpenPrefetchSource(const char* filename, const Corpus* corpus)
+{
+    (void) corpus;
+    return jot_PrefetchSourceNew(&allocator, filename);
+}
+
+#ifdef JOT_BENCH_POSIX
+/* Only one source is open at a time, so one pipe will do. */
+static FILE* pipe_file;
+
+/* Gives back the pipe's name for the source to open, or NULL. */
+static const char* OpenPipe(const char* filename)
+{
+    static char pipe_name[64];
+    char command[1024];
+    
+    sprintf(command, "cat '%.900s'", filename);
+    pipe_file = popen(command, "r");
+    if(pipe_file == NULL)
+    {
+        return NULL;
+    }
+    sprintf(pipe_name, "/dev/fd/%d", fileno(pipe_file));
+    return pipe_name;
+}
+
+static jot_Source* OpenPipeSource(const char* filename, const Corpus* corpus)
+{
+    const char* pipe_name = OpenPipe(filename);
+    (void) corpus;
+    return pipe_name ? jot_FileSourceNew(&allocator, pipe_name) : NULL;
+}
+
+static void ClosePipeSource(jot_Source* source)
+{
+    jot_FileSourceFree(source);
+    pclose(pipe_file);
+}
+
+static jot_Source* OpenPipePrefetchSource(const char* filename, const Corpus* corpus)
+{
+    const char* pipe_name = OpenPipe(filename);
+    (void) corpus;
+    return pipe_name ? jot_PrefetchSourceNew(&allocator, pipe_name) : NULL;
+}
+
+static void ClosePipePrefetchSource(jot_Source* source)
+{
+    jot_PrefetchSourceFree(source);
+    pclose(pipe_file);
+}
+#endif
+
+static const SourceKind source_kinds[] = {
+    {"file", OpenFileSource, jot_FileSourceFree},
+    {"mmap", OpenMmapSource, jot_MmapSourceFree},
+    {"string", OpenStringSource, jot_StringSourceFree},
+    {"prefetch", OpenPrefetchSource, jot_PrefetchSourceFree}
+#ifdef JOT_BENCH_POSIX
+    ,
+    {"pipe-file", OpenPipeSource, ClosePipeSource},
+    {"pipe-prefetch", OpenPipePrefetchSource, ClosePipePrefetchSource}
+#endif
+};
+
+static double Now(void)
+{
+#ifdef JOT_BENCH_POSIX
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec + now.tv_usec * 1e-6;
+#else
+    return (double) clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+/* In kilobytes, or 0 if there's no way to know. */
+static long PeakResidentSize(void)
+{
+#ifdef JOT_BENCH_POSIX
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return 0;
+#endif
+}
+
+int main(int argc, char** argv)
+{
+    const char* directory = "/tmp";
+    int repeat = 5;
+    int json = 0;
+    char filename[1024];
+    Corpus corpus;
+    FILE* file;
+    jot_Source* source;
+    jot_Scanner* scanner;
+    unsigned long tokens;
+    unsigned long allocations = 0;
+    double start, elapsed, best;
+    size_t i, j;
+    int k;
+    
+    jot_AllocatorInit(&allocator);
+    for(k = 1; k < argc; k++)
+    {
+        if(strcmp(argv[k], "-size") == 0 && k + 1 < argc)
+        {
+            corpus_size = (size_t) atol(argv[++k]) << 20;
+        }
+        else if(strcmp(argv[k], "-repeat") == 0 && k + 1 < argc)
+        {
+            repeat = atoi(argv[++k]);
+        }
+        else if(strcmp(argv[k], "-dir") == 0 && k + 1 < argc)
+        {
+            directory = argv[++k];
+        }
+        else if(strcmp(argv[k], "-json") == 0)
+        {
+            json = 1;
+        }
+        else
+        {
+            fprintf(stderr, "usage: jot_scanbench [-size megabytes] [-repeat count] [-dir path] [-json]\n");
+            return 1;
+        }
+    }
+    
+    if(!json)
+    {
+        printf("skip routines: %s\n", jot_ScanSkipGet()->name);
+        printf("%-12s %-13s %10s %10s %9s %9s %12s %10s\n",
+            "corpus", "source", "bytes", "tokens", "MB/s", "Mtok/s", "allocs/tok", "peak KB");
+    }
+    
+    for(i = 0; i < sizeof(corpus_kinds) / sizeof(corpus_kinds[0]); i++)
+    {
+        corpus.data = NULL;
+        corpus.size = 0;
+        corpus.capacity = 0;
+        corpus.seed = 1;
+        corpus_kinds[i].generate(&corpus);
+        
+        sprintf(filename, "%.900s/jot_scanbench_%s.txt", directory, corpus_kinds[i].name);
+        file = fopen(filename, "wb");
+        if(file == NULL || fwrite(corpus.data, 1, corpus.size, file) != corpus.size)
+        {
+            fprintf(stderr, "jot_scanbench: can't write %s\n", filename);
+            return 1;
+        }
+        fclose(file);
+        
+        for(j = 0; j < sizeof(source_kinds) / sizeof(source_kinds[0]); j++)
+        {
+            best = -1;
+            tokens = 0;
+            for(k = 0; k < repeat; k++)
+            {
+                jot_AllocatorResetStats(&allocator);
+                start = Now();
+                source = source_kinds[j].open(filename, &corpus);
+                if(source == NULL)
+                {
+                    fprintf(stderr, "jot_scanbench: can't open %s\n", filename);
+                    return 1;
+                }
+                scanner = jot_ScannerNew(&allocator, source);
+                if(scanner == NULL)
+                {
+                    fprintf(stderr, "jot_scanbench: out of memory\n");
+                    return 1;
+                }
+                tokens = 0;
+                while(jot_ScannerNext(scanner) != JOT_TOKEN_EOF)
+                {
+                    tokens++;
+                }
+                jot_ScannerFree(scanner);
+                source_kinds[j].close(source);
+                elapsed = Now() - start;
+                allocations = allocator.total.calls;
+                if(best < 0 || elapsed < best)
+                {
+                    best = elapsed;
+                }
+            }
+            if(best <= 0)
+            {
+                best = 1e-9;
+            }
+            
+            if(json)
+            {
+                printf("{\"corpus\": \"%s\", \"source\": \"%s\", \"skip\": \"%s\", \"bytes\": %lu, \"tokens\": %lu, "
+                    "\"seconds\": %.6f, \"mb_per_second\": %.2f, \"tokens_per_second\": %.0f, ",
+                    corpus_kinds[i].name, source_kinds[j].name, jot_ScanSkipGet()->name,
+                    (unsigned long) corpus.size, tokens, best, corpus.size / best / 1e6, tokens / best);
+                printf("\"allocations_per_token\": %.6f, ", tokens ? (double) allocations / tokens : 0.0);
+                printf("\"peak_allocated_bytes\": %lu, ", (unsigned long) allocator.total.peak);
+                printf("\"peak_rss_kb\": %ld}\n", PeakResidentSize());
+            }
+            else
+            {
+                printf("%-12s %-13s %10lu %10lu %9.1f %9.2f ",
+                    corpus_kinds[i].name, source_kinds[j].name,
+                    (unsigned long) corpus.size, tokens, corpus.size / best / 1e6, tokens / best / 1e6);
+                printf("%12.6f ", tokens ? (double) allocations / tokens : 0.0);
+                printf("%10ld\n", PeakResidentSize());
+            }
+            fflush(stdout);
+        }
+        
+        remove(filename);
+        free(corpus.data);
+    }
+    return 0;
+}
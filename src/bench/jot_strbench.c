@@ -0,0 +1,282 @@
+/*
+    jot - String Benchmark
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+
+/*
+    Measures the string operations scripts lean on most:
+
+        cc -O2 -I../jot jot_strbench.c ../jot/jot_*.c -o jot_strbench -lpthread -lm
+        ./jot_strbench [-count n] [-repeat count] [-json]
+
+    concat builds a string up from -count 8-byte pieces, a hundredth and a
+    tenth as many as well, the way s = s .. piece does in a loop, both
+    through jot_StringAppend and by copying the whole string each time,
+    which is what concatenation did before strings could share a buffer.
+    hash and equal go over -count short keys, of 4 to 22 bytes, working
+    out their hashes, and comparing each against a copy of itself made
+    separately and against the next key.
+
+    The fastest of -repeat runs is reported, in millions of operations a
+    second.
+*/
+#if defined(__unix__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 200112L
+#define JOT_BENCH_POSIX
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef JOT_BENCH_POSIX
+#include <sys/time.h>
+#endif
+
+#include "jot_str.h"
+
+static size_t count = 30000;
+
+/* Keeps the results from being optimized away. */
+static volatile unsigned long sink;
+
+static double Now(void)
+{
+#ifdef JOT_BENCH_POSIX
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec + now.tv_usec * 1e-6;
+#else
+    return (double) clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+static void OutOfMemory(void)
+{
+    fprintf(stderr, "jot_strbench: out of memory\n");
+    exit(1);
+}
+
+static double ConcatAppend(size_t pieces)
+{
+    jot_Heap heap;
+    jot_String* string;
+    double start;
+    size_t i;
+    
+    jot_HeapInit(&heap, NULL);
+    start = Now();
+    string = jot_StringNew(&heap, "", 0);
+    for(i = 0; i < pieces; i++)
+    {
+        string = string != NULL ? jot_StringAppend(&heap, string, "abcdefgh", 8) : NULL;
+    }
+    if(string == NULL)
+    {
+        OutOfMemory();
+    }
+    sink += JOT_STRING_HASH(string);
+    start = Now() - start;
+    jot_HeapFree(&heap);
+    return start;
+}
+
+/* Every step copies everything so far, and frees the last string, as if it had been collected. */
+static double ConcatCopy(size_t pieces)
+{
+    char* text = NULL;
+    char* next;
+    size_t length = 0;
+    double start;
+    size_t i;
+    
+    start = Now();
+    for(i = 0; i < pieces; i++)
+    {
+        next = (char*) malloc(length + 8 + 1);
+        if(next == NULL)
+        {
+            OutOfMemory();
+        }
+        if(text != NULL)
+        {
+            memcpy(next, text, length);
+        }
+        memcpy(next + length, "abcdefgh", 8);
+        length += 8;
+        next[length] = '\0';
+        free(text);
+        text = next;
+    }
+    sink += jot_StrHash(text, length);
+    start = Now() - start;
+    free(text);
+    return start;
+}
+
+static void MakeKeys(jot_Heap* heap, jot_String** keys)
+{
+    char buffer[48];
+    size_t i, length;
+    
+    for(i = 0; i < count; i++)
+    {
+        /* Names like the ones scripts use, from 4 to 22 bytes. */
+        sprintf(buffer, "key_%lu_abcdefghijklmn", (unsigned long) i);
+        length = 4 + i % 19;
+        keys[i] = jot_StringNew(heap, buffer, length);
+        if(keys[i] == NULL)
+        {
+            OutOfMemory();
+        }
+    }
+}
+
+static double Hash(jot_String** keys)
+{
+    unsigned long total = 0;
+    double start = Now();
+    size_t i;
+    
+    for(i = 0; i < count; i++)
+    {
+        total += jot_StrHash(keys[i]->text, keys[i]->length);
+    }
+    sink += total;
+    return Now() - start;
+}
+
+static double Equal(jot_String** keys, jot_String** copies)
+{
+    unsigned long total = 0;
+    double start = Now();
+    size_t i;
+    
+    for(i = 0; i < count; i++)
+    {
+        total += jot_StringEqual(keys[i], copies[i]);
+        total += jot_StringEqual(keys[i], copies[(i + 1) % count]);
+    }
+    sink += total;
+    return Now() - start;
+}
+
+static void Report(const char* name, size_t operations, double seconds, int json)
+{
+    if(json)
+    {
+        printf("{\"benchmark\": \"%s\", \"operations\": %lu, \"seconds\": %.6f}\n", name, (unsigned long) operations, seconds);
+    }
+    else
+    {
+        printf("%-24s %12lu %10.4f %12.2f\n", name, (unsigned long) operations, seconds, operations / (seconds > 0 ? seconds : 1e-9) / 1e6);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int repeat = 5;
+    int json = 0;
+    char name[64];
+    jot_Heap heap;
+    jot_String** keys;
+    jot_String** copies;
+    double best, seconds;
+    size_t pieces;
+    int i, k;
+    
+    for(k = 1; k < argc; k++)
+    {
+        if(strcmp(argv[k], "-count") == 0 && k + 1 < argc)
+        {
+            count = (size_t) atol(argv[++k]);
+        }
+        else if(strcmp(argv[k], "-repeat") == 0 && k + 1 < argc)
+        {
+            repeat = atoi(argv[++k]);
+        }
+        else if(strcmp(argv[k], "-json") == 0)
+        {
+            json = 1;
+        }
+        else
+        {
+            fprintf(stderr, "usage: jot_strbench [-count n] [-repeat count] [-json]\n");
+            return 1;
+        }
+    }
+    if(count < 100)
+    {
+        count = 100;
+    }
+    if(repeat < 1)
+    {
+        repeat = 1;
+    }
+    
+    if(!json)
+    {
+        printf("%-24s %12s %10s %12s\n", "benchmark", "operations", "seconds", "M ops/s");
+    }
+    for(pieces = count / 100; pieces <= count; pieces *= 10)
+    {
+        for(k = 0; k < 2; k++)
+        {
+            best = 0;
+            for(i = 0; i < repeat; i++)
+            {
+                seconds = k == 0 ? ConcatAppend(pieces) : ConcatCopy(pieces);
+                best = i == 0 || seconds < best ? seconds : best;
+            }
+            sprintf(name, "concat %s %lu", k == 0 ? "append" : "copy", (unsigned long) pieces);
+            Report(name, pieces, best, json);
+        }
+    }
+    
+    keys = (jot_String**) malloc(count * sizeof(jot_String*));
+    copies = (jot_String**) malloc(count * sizeof(jot_String*));
+    if(keys == NULL || copies == NULL)
+    {
+        OutOfMemory();
+    }
+    jot_HeapInit(&heap, NULL);
+    MakeKeys(&heap, keys);
+    MakeKeys(&heap, copies);
+    for(k = 0; k < 2; k++)
+    {
+        best = 0;
+        for(i = 0; i < repeat; i++)
+        {
+            seconds = k == 0 ? Hash(keys) : Equal(keys, copies);
+            best = i == 0 || seconds < best ? seconds : best;
+        }
+        Report(k == 0 ? "hash" : "equal", k == 0 ? count : count * 2, best, json);
+    }
+    jot_HeapFree(&heap);
+    free(keys);
+    free(copies);
+    return 0;
+}
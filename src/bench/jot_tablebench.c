@@ -0,0 +1,472 @@
+/*
+    jot - Table Benchmark
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+
+/*
+    Measures jot_Table against a plain chained hash table, which is what
+    tables would be without an array part or open addressing, on a few
+    kinds of keys:
+
+        cc -O2 -I../jot jot_tablebench.c ../jot/jot_*.c -o jot_tablebench -lpthread -lm
+        ./jot_tablebench [-count n] [-repeat count] [-json]
+
+    Each kind of key is inserted -count times into an empty table, then
+    looked up once each in a shuffled order, so the chained table's nodes
+    aren't visited in the order they were allocated, then looked up again
+    with keys that aren't there.
+
+    The fastest of -repeat runs is reported, in millions of operations a
+    second, along with how many bytes each entry ends up costing. The
+    chained table's bytes don't count what malloc adds to every node, so
+    they're on the kind side.
+*/
+#if defined(__unix__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 200112L
+#define JOT_BENCH_POSIX
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef JOT_BENCH_POSIX
+#include <sys/time.h>
+#endif
+
+#include "jot_str.h"
+#include "jot_table.h"
+
+typedef struct Node
+{
+    jot_Value key;
+    jot_Value value;
+    struct Node* next;
+} Node;
+
+/* One node per entry, and a bucket per entry, doubling when it runs out. */
+typedef struct
+{
+    Node** buckets;
+    size_t bucket_count;
+    size_t count;
+    size_t bytes;
+} Chained;
+
+typedef struct
+{
+    const char* name;
+    /* Keys to insert, and keys that won't be found, from n on. */
+    void (*make)(jot_Heap* heap, jot_Value* keys, size_t count);
+} KeyKind;
+
+typedef struct
+{
+    double insert;
+    double hit;
+    double miss;
+    double bytes;
+} Result;
+
+static size_t key_count = 200000;
+
+static double Now(void)
+{
+#ifdef JOT_BENCH_POSIX
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec + now.tv_usec * 1e-6;
+#else
+    return (double) clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+/* Deterministic, so every run and every release sees the same keys. */
+static unsigned long Random(unsigned long* seed)
+{
+    *seed = *seed * 1103515245UL + 12345UL;
+    return (*seed >> 16) & 0x7FFFUL;
+}
+
+/* Shuffles the keys to look up, which are the count keys to insert and then count that won't be found. */
+static void Shuffle(jot_Value* keys, size_t count)
+{
+    unsigned long seed = 7;
+    jot_Value swap;
+    size_t i, j;
+    
+    for(i = count - 1; i > 0; i--)
+    {
+        j = (Random(&seed) << 15 | Random(&seed)) % (i + 1);
+        swap = keys[i];
+        keys[i] = keys[j];
+        keys[j] = swap;
+    }
+}
+
+/* 0, 1, 2, ..., the way arrays and lists are filled. */
+static void MakeSequence(jot_Heap* heap, jot_Value* keys, size_t count)
+{
+    size_t i;
+    
+    (void) heap;
+    for(i = 0; i < count * 2; i++)
+    {
+        JOT_SET_SMALL_INT(&keys[i], i);
+    }
+}
+
+/* Ints spread out over a range far bigger than the count, like ids. */
+static void MakeSparse(jot_Heap* heap, jot_Value* keys, size_t count)
+{
+    size_t i;
+    
+    (void) heap;
+    for(i = 0; i < count * 2; i++)
+    {
+        JOT_SET_SMALL_INT(&keys[i], (int64_t) (i + 1) * 40503);
+    }
+}
+
+/* Names, the way records and maps are keyed. */
+static void MakeStrings(jot_Heap* heap, jot_Value* keys, size_t count)
+{
+    char buffer[32];
+    jot_String* string;
+    size_t i;
+    
+    for(i = 0; i < count * 2; i++)
+    {
+        sprintf(buffer, "key_%lu", (unsigned long) i);
+        string = jot_StringNew(heap, buffer, strlen(buffer));
+        if(string == NULL)
+        {
+            fprintf(stderr, "jot_tablebench: out of memory\n");
+            exit(1);
+        }
+        JOT_SET_OBJECT(&keys[i], string);
+    }
+}
+
+static const KeyKind key_kinds[] = {
+    { "sequence", MakeSequence },
+    { "sparse", MakeSparse },
+    { "strings", MakeStrings }
+};
+
+static uint32_t ChainedHash(jot_Value key)
+{
+    uint64_t bits;
+    
+    if(JOT_IS_STR(key))
+    {
+        return JOT_STRING_HASH((const jot_String*) JOT_AS_OBJECT(key));
+    }
+    bits = key.bits * ((uint64_t) 0x9E3779B9UL << 32 | 0x7F4A7C15UL);
+    return (uint32_t) (bits >> 32);
+}
+
+static void ChainedFree(Chained* self)
+{
+    Node* node;
+    Node* next;
+    size_t i;
+    
+    for(i = 0; i < self->bucket_count; i++)
+    {
+        for(node = self->buckets[i]; node != NULL; node = next)
+        {
+            next = node->next;
+            free(node);
+        }
+    }
+    free(self->buckets);
+}
+
+static int ChainedGrow(Chained* self)
+{
+    size_t bucket_count = self->bucket_count ? self->bucket_count * 2 : 8;
+    Node** buckets = (Node**) calloc(bucket_count, sizeof(Node*));
+    Node* node;
+    Node* next;
+    size_t i, j;
+    
+    if(buckets == NULL)
+    {
+        return 0;
+    }
+    for(i = 0; i < self->bucket_count; i++)
+    {
+        for(node = self->buckets[i]; node != NULL; node = next)
+        {
+            next = node->next;
+            j = ChainedHash(node->key) & (bucket_count - 1);
+            node->next = buckets[j];
+            buckets[j] = node;
+        }
+    }
+    free(self->buckets);
+    self->bytes += (bucket_count - self->bucket_count) * sizeof(Node*);
+    self->buckets = buckets;
+    self->bucket_count = bucket_count;
+    return 1;
+}
+
+static jot_Value* ChainedFind(const Chained* self, jot_Value key)
+{
+    Node* node;
+    
+    if(self->bucket_count == 0)
+    {
+        return NULL;
+    }
+    for(node = self->buckets[ChainedHash(key) & (self->bucket_count - 1)]; node != NULL; node = node->next)
+    {
+        if(jot_ValueEqual(node->key, key))
+        {
+            return &node->value;
+        }
+    }
+    return NULL;
+}
+
+static int ChainedSet(Chained* self, jot_Value key, jot_Value value)
+{
+    jot_Value* found = ChainedFind(self, key);
+    Node* node;
+    size_t i;
+    
+    if(found != NULL)
+    {
+        *found = value;
+        return 1;
+    }
+    if(self->count + 1 > self->bucket_count && !ChainedGrow(self))
+    {
+        return 0;
+    }
+    node = (Node*) malloc(sizeof(Node));
+    if(node == NULL)
+    {
+        return 0;
+    }
+    i = ChainedHash(key) & (self->bucket_count - 1);
+    node->key = key;
+    node->value = value;
+    node->next = self->buckets[i];
+    self->buckets[i] = node;
+    self->count++;
+    self->bytes += sizeof(Node);
+    return 1;
+}
+
+/* Keeps the lookups from being optimized away. */
+static volatile unsigned long found_count;
+
+static void BenchTable(jot_Heap* heap, const jot_Value* keys, const jot_Value* lookups, Result* result)
+{
+    jot_Table* table;
+    jot_Value value;
+    size_t before = heap->bytes;
+    unsigned long found = 0;
+    double start;
+    size_t i;
+    
+    start = Now();
+    table = jot_TableNew(heap, 0);
+    for(i = 0; i < key_count; i++)
+    {
+        JOT_SET_SMALL_INT(&value, i);
+        if(table == NULL || !jot_TableSet(heap, table, keys[i], value))
+        {
+            fprintf(stderr, "jot_tablebench: out of memory\n");
+            exit(1);
+        }
+    }
+    result->insert = Now() - start;
+    result->bytes = (double) (heap->bytes - before) / key_count;
+    
+    start = Now();
+    for(i = 0; i < key_count; i++)
+    {
+        found += jot_TableFind(table, lookups[i]) != NULL;
+    }
+    result->hit = Now() - start;
+    
+    start = Now();
+    for(i = key_count; i < key_count * 2; i++)
+    {
+        found += jot_TableFind(table, lookups[i]) != NULL;
+    }
+    result->miss = Now() - start;
+    found_count += found;
+    /* It's the newest object, and the heap would otherwise keep it until the end. */
+    heap->objects = table->object.next;
+    jot_TableFree(heap, table);
+}
+
+static void BenchChained(const jot_Value* keys, const jot_Value* lookups, Result* result)
+{
+    Chained chained;
+    jot_Value value;
+    unsigned long found = 0;
+    double start;
+    size_t i;
+    
+    memset(&chained, 0, sizeof(chained));
+    start = Now();
+    for(i = 0; i < key_count; i++)
+    {
+        JOT_SET_SMALL_INT(&value, i);
+        if(!ChainedSet(&chained, keys[i], value))
+        {
+            fprintf(stderr, "jot_tablebench: out of memory\n");
+            exit(1);
+        }
+    }
+    result->insert = Now() - start;
+    result->bytes = (double) chained.bytes / key_count;
+    
+    start = Now();
+    for(i = 0; i < key_count; i++)
+    {
+        found += ChainedFind(&chained, lookups[i]) != NULL;
+    }
+    result->hit = Now() - start;
+    
+    start = Now();
+    for(i = key_count; i < key_count * 2; i++)
+    {
+        found += ChainedFind(&chained, lookups[i]) != NULL;
+    }
+    result->miss = Now() - start;
+    found_count += found;
+    ChainedFree(&chained);
+}
+
+static void Keep(Result* best, const Result* run, int first)
+{
+    if(first || run->insert < best->insert)
+    {
+        best->insert = run->insert;
+    }
+    if(first || run->hit < best->hit)
+    {
+        best->hit = run->hit;
+    }
+    if(first || run->miss < best->miss)
+    {
+        best->miss = run->miss;
+    }
+    best->bytes = run->bytes;
+}
+
+static double Rate(double seconds)
+{
+    return key_count / (seconds > 0 ? seconds : 1e-9) / 1e6;
+}
+
+static void Report(const char* kind, const char* table, const Result* result, int json)
+{
+    if(json)
+    {
+        printf("{\"keys\": \"%s\", \"table\": \"%s\", \"count\": %lu, \"insert_seconds\": %.6f, \"hit_seconds\": %.6f, \"miss_seconds\": %.6f, \"bytes_per_entry\": %.1f}\n",
+            kind, table, (unsigned long) key_count, result->insert, result->hit, result->miss, result->bytes);
+    }
+    else
+    {
+        printf("%-10s %-8s %12.1f %12.1f %12.1f %12.1f\n", kind, table, Rate(result->insert), Rate(result->hit), Rate(result->miss), result->bytes);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int repeat = 5;
+    int json = 0;
+    jot_Heap heap;
+    jot_Value* keys;
+    jot_Value* lookups;
+    Result run, table_best, chained_best;
+    size_t i;
+    int k;
+    
+    for(k = 1; k < argc; k++)
+    {
+        if(strcmp(argv[k], "-count") == 0 && k + 1 < argc)
+        {
+            key_count = (size_t) atol(argv[++k]);
+        }
+        else if(strcmp(argv[k], "-repeat") == 0 && k + 1 < argc)
+        {
+            repeat = atoi(argv[++k]);
+        }
+        else if(strcmp(argv[k], "-json") == 0)
+        {
+            json = 1;
+        }
+        else
+        {
+            fprintf(stderr, "usage: jot_tablebench [-count n] [-repeat count] [-json]\n");
+            return 1;
+        }
+    }
+    if(key_count == 0)
+    {
+        key_count = 1;
+    }
+    
+    keys = (jot_Value*) malloc(key_count * 2 * sizeof(jot_Value));
+    lookups = (jot_Value*) malloc(key_count * 2 * sizeof(jot_Value));
+    if(keys == NULL || lookups == NULL)
+    {
+        fprintf(stderr, "jot_tablebench: out of memory\n");
+        return 1;
+    }
+    if(!json)
+    {
+        printf("%-10s %-8s %12s %12s %12s %12s\n", "keys", "table", "insert M/s", "hit M/s", "miss M/s", "bytes/entry");
+    }
+    for(i = 0; i < sizeof(key_kinds) / sizeof(key_kinds[0]); i++)
+    {
+        jot_HeapInit(&heap, NULL);
+        key_kinds[i].make(&heap, keys, key_count);
+        memcpy(lookups, keys, key_count * 2 * sizeof(jot_Value));
+        Shuffle(lookups, key_count);
+        for(k = 0; k < repeat; k++)
+        {
+            BenchTable(&heap, keys, lookups, &run);
+            Keep(&table_best, &run, k == 0);
+            BenchChained(keys, lookups, &run);
+            Keep(&chained_best, &run, k == 0);
+        }
+        Report(key_kinds[i].name, "jot", &table_best, json);
+        Report(key_kinds[i].name, "chained", &chained_best, json);
+        jot_HeapFree(&heap);
+    }
+    free(keys);
+    free(lookups);
+    return 0;
+}
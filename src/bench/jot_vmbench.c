@@ -0,0 +1,280 @@
+/*
+    jot - VM Benchmark
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+
+/*
+    Measures how fast the VM runs a few typical workloads, in instructions
+    per second as well as time, how much memory one run of each needs at
+    once, and how long the collector stopped it for:
+
+        cc -O2 -fno-gcse -fno-crossjumping -I../jot jot_vmbench.c ../jot/jot_*.c -o jot_vmbench -lpthread -lm
+        ./jot_vmbench [-scale n] [-repeat count] [-json]
+
+    Each script is compiled once and run -repeat times, and the fastest run
+    is reported. -scale multiplies how much work every script does. To
+    compare threaded dispatch against the plain switch, build a second copy
+    with -DJOT_VM_NO_COMPUTED_GOTO; the dispatch each was built with is
+    printed alongside its results. Without -fno-gcse -fno-crossjumping, GCC
+    merges most of the dispatch jumps back into a few, which loses much of
+    what threading is for.
+
+    Memory is counted by a jot_Allocator the VM makes everything with, and
+    peak bytes is the most that was allocated at once during a run, above
+    what the VM already had. gc steps is how many times the collector ran
+    in a run, and p99 and max are over the pauses of every run, from the
+    VM's own histogram, so p99 is rounded up to a power of 2 microseconds.
+*/
+#if defined(__unix__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 200112L
+#define JOT_BENCH_POSIX
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef JOT_BENCH_POSIX
+#include <sys/time.h>
+#endif
+
+#include "jot_gc.h"
+#include "jot_lib.h"
+#include "jot_vm.h"
+
+typedef struct
+{
+    const char* name;
+    /* Given the scale as '...'. */
+    const char* text;
+} Workload;
+
+static const Workload workloads[] = {
+    { "fib",
+        "func fib(n)\n"
+        "    if n < 2 then -> n end\n"
+        "    -> fib(n - 1) + fib(n - 2)\n"
+        "end\n"
+        "var scale = ...\n"
+        "for i in scale do fib(25) end\n" },
+    { "loops",
+        "var scale = ...\n"
+        "var total, x = 0, 0.5\n"
+        "for i in scale * 1000 do\n"
+        "    var j = 0\n"
+        "    while j < 100 do\n"
+        "        total = total + (i * j) % 7\n"
+        "        x = x * 0.999 + 1.0\n"
+        "        j = j + 1\n"
+        "    end\n"
+        "end\n"
+        "-> total, x\n" },
+    { "tables",
+        "var scale = ...\n"
+        "for round in scale do\n"
+        "    var points = []\n"
+        "    for i in 2000 do\n"
+        "        push(points, {x: i, y: i * 2, name: \"p\"})\n"
+        "    end\n"
+        "    var sum = 0\n"
+        "    for p in points do\n"
+        "        p.x = p.x + p.y\n"
+        "        sum = sum + p.x\n"
+        "    end\n"
+        "    var counts = {}\n"
+        "    for i in 20000 do\n"
+        "        var k = i % 1000\n"
+        "        counts[k] = (counts[k] or 0) + 1\n"
+        "    end\n"
+        "end\n" },
+    { "strings",
+        "var scale = ...\n"
+        "for round in scale do\n"
+        "    var words = []\n"
+        "    for i in 2000 do\n"
+        "        push(words, \"word\" .. i)\n"
+        "    end\n"
+        "    var line, longest = \"\", \"\"\n"
+        "    for w in words do\n"
+        "        if len(line) > 60 then line = \"\" end\n"
+        "        line = line .. w .. \" \"\n"
+        "        if w > longest then longest = w end\n"
+        "    end\n"
+        "    var seen = {}\n"
+        "    for w in words do seen[w] = tostring(len(w)) end\n"
+        "end\n" },
+    { "numeric",
+        "var scale = ...\n"
+        "for round in scale do\n"
+        "    var xs = []\n"
+        "    for i in 20000 do push(xs, i * 0.25 + 0.5) end\n"
+        "    var sum, squares = 0.0, 0.0\n"
+        "    for x in xs do\n"
+        "        sum = sum + x\n"
+        "        squares = squares + x * x\n"
+        "    end\n"
+        "    var mean = sum / len(xs)\n"
+        "    var spread = squares / len(xs) - mean * mean\n"
+        "    for i in len(xs) do xs[i] = (xs[i] - mean) / spread end\n"
+        "end\n" },
+    { "arrays",
+        "var scale = ...\n"
+        "for round in scale do\n"
+        "    var ints, flags = [], []\n"
+        "    fill(ints, 0, 0, 100000)\n"
+        "    fill(flags, false, 0, 100000)\n"
+        "    for i in 1000 do ints[i * 97 % 100000] = i; flags[i * 89 % 100000] = true end\n"
+        "    var total = 0\n"
+        "    for i in 10 do\n"
+        "        var part = slice(ints, i * 1000, i * 1000 + 20000)\n"
+        "        total = total + sum(part) + max(part) - min(part)\n"
+        "        copy(ints, 0, part)\n"
+        "    end\n"
+        "end\n" }
+};
+
+static jot_Allocator allocator;
+
+static double Now(void)
+{
+#ifdef JOT_BENCH_POSIX
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec + now.tv_usec * 1e-6;
+#else
+    return (double) clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+int main(int argc, char** argv)
+{
+    int scale = 30;
+    int repeat = 5;
+    int json = 0;
+    jot_Vm* vm;
+    jot_Value function;
+    jot_Value arg;
+    unsigned long instructions;
+    unsigned long bytes;
+    unsigned long steps;
+    uint64_t before;
+    unsigned long steps_before;
+    size_t live_before;
+    double start, elapsed, best;
+    size_t i;
+    int k;
+    
+    for(k = 1; k < argc; k++)
+    {
+        if(strcmp(argv[k], "-scale") == 0 && k + 1 < argc)
+        {
+            scale = atoi(argv[++k]);
+        }
+        else if(strcmp(argv[k], "-repeat") == 0 && k + 1 < argc)
+        {
+            repeat = atoi(argv[++k]);
+        }
+        else if(strcmp(argv[k], "-json") == 0)
+        {
+            json = 1;
+        }
+        else
+        {
+            fprintf(stderr, "usage: jot_vmbench [-scale n] [-repeat count] [-json]\n");
+            return 1;
+        }
+    }
+    
+    if(!json)
+    {
+        printf("dispatch: %s\n", jot_VmDispatch());
+        printf("%-10s %14s %10s %12s %12s %9s %9s %9s\n", "workload", "instructions", "seconds", "M instr/s", "peak bytes", "gc steps", "p99 ms", "max ms");
+    }
+    
+    jot_AllocatorInit(&allocator);
+    
+    for(i = 0; i < sizeof(workloads) / sizeof(workloads[0]); i++)
+    {
+        vm = jot_VmNew(&allocator);
+        if(vm == NULL || !jot_LibOpen(vm))
+        {
+            fprintf(stderr, "jot_vmbench: out of memory\n");
+            return 1;
+        }
+        if(!jot_VmLoad(vm, workloads[i].name, workloads[i].text, strlen(workloads[i].text), &function))
+        {
+            fprintf(stderr, "jot_vmbench: %s: %s\n", workloads[i].name, vm->error);
+            return 1;
+        }
+        JOT_SET_SMALL_INT(&arg, scale);
+        
+        best = -1;
+        instructions = 0;
+        bytes = 0;
+        steps = 0;
+        for(k = 0; k < repeat; k++)
+        {
+            before = vm->instructions;
+            steps_before = vm->heap.gc.steps;
+            jot_AllocatorResetStats(&allocator);
+            live_before = allocator.total.live;
+            start = Now();
+            if(!jot_VmCall(vm, function, &arg, 1, NULL, 0))
+            {
+                fprintf(stderr, "jot_vmbench: %s: %s\n", workloads[i].name, vm->error);
+                return 1;
+            }
+            elapsed = Now() - start;
+            if(best < 0 || elapsed < best)
+            {
+                best = elapsed;
+            }
+            instructions = (unsigned long) (vm->instructions - before);
+            steps = vm->heap.gc.steps - steps_before;
+            bytes = (unsigned long) (allocator.total.peak - live_before);
+        }
+        if(best <= 0)
+        {
+            best = 1e-9;
+        }
+        
+        if(json)
+        {
+            printf("{\"workload\": \"%s\", \"dispatch\": \"%s\", \"scale\": %d, \"instructions\": %lu, \"seconds\": %.6f, \"peak_bytes\": %lu, ",
+                workloads[i].name, jot_VmDispatch(), scale, instructions, best, bytes);
+            printf("\"gc_steps\": %lu, \"gc_p99_seconds\": %.6f, \"gc_max_seconds\": %.6f}\n",
+                steps, jot_GcPercentile(&vm->heap.gc, 0.99), vm->heap.gc.longest);
+        }
+        else
+        {
+            printf("%-10s %14lu %10.3f %12.1f %12lu %9lu %9.3f %9.3f\n", workloads[i].name, instructions, best, instructions / best / 1e6, bytes,
+                steps, jot_GcPercentile(&vm->heap.gc, 0.99) * 1e3, vm->heap.gc.longest * 1e3);
+        }
+        jot_VmFree(vm);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,213 @@
+/*
+    jot - Allocators
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#include <stdlib.h>
+
+#include "jot_alloc.h"
+
+static const char* const jot_alloc_subsystem_names[JOT_ALLOC_SUBSYSTEM_COUNT] =
+{
+    "source",
+    "scanner",
+    "tokens",
+    "atoms",
+    "lines",
+    "document",
+    "parse",
+    "code",
+    "objects",
+    "vm",
+    "gc"
+};
+
+static void* jot_MallocAllocate(void* user, size_t size)
+{
+    (void) user;
+    return malloc(size);
+}
+
+static void* jot_MallocReallocate(void* user, void* pointer, size_t old_size, size_t size)
+{
+    (void) user;
+    (void) old_size;
+    return realloc(pointer, size);
+}
+
+static void jot_MallocDeallocate(void* user, void* pointer, size_t size)
+{
+    (void) user;
+    (void) size;
+    free(pointer);
+}
+
+static void jot_AllocatorClearStats(jot_Allocator* self)
+{
+    size_t i;
+    
+    self->total.live = 0;
+    for(i = 0; i < JOT_ALLOC_SUBSYSTEM_COUNT; i++)
+    {
+        self->subsystems[i].live = 0;
+    }
+    jot_AllocatorResetStats(self);
+}
+
+static void jot_AllocStatsReset(jot_AllocStats* self)
+{
+    self->peak = self->live;
+    self->calls = 0;
+    self->failures = 0;
+    self->frees = 0;
+}
+
+void jot_AllocatorInit(jot_Allocator* self)
+{
+    self->allocate = jot_MallocAllocate;
+    self->reallocate = jot_MallocReallocate;
+    self->deallocate = jot_MallocDeallocate;
+    self->user = NULL;
+    jot_AllocatorClearStats(self);
+}
+
+void jot_AllocatorResetStats(jot_Allocator* self)
+{
+    size_t i;
+    
+    jot_AllocStatsReset(&self->total);
+    for(i = 0; i < JOT_ALLOC_SUBSYSTEM_COUNT; i++)
+    {
+        jot_AllocStatsReset(&self->subsystems[i]);
+    }
+}
+
+void jot_AllocatorFork(const jot_Allocator* self, jot_Allocator* child)
+{
+    child->allocate = self->allocate;
+    child->reallocate = self->reallocate;
+    child->deallocate = self->deallocate;
+    child->user = self->user;
+    jot_AllocatorClearStats(child);
+}
+
+static void jot_AllocStatsJoin(jot_AllocStats* self, const jot_AllocStats* child)
+{
+    if(self->peak < self->live + child->peak)
+    {
+        self->peak = self->live + child->peak;
+    }
+    self->live += child->live;
+    self->calls += child->calls;
+    self->failures += child->failures;
+    self->frees += child->frees;
+}
+
+void jot_AllocatorJoin(jot_Allocator* self, const jot_Allocator* child)
+{
+    size_t i;
+    
+    jot_AllocStatsJoin(&self->total, &child->total);
+    for(i = 0; i < JOT_ALLOC_SUBSYSTEM_COUNT; i++)
+    {
+        jot_AllocStatsJoin(&self->subsystems[i], &child->subsystems[i]);
+    }
+}
+
+const char* jot_AllocSubsystemName(jot_AllocSubsystem subsystem)
+{
+    return subsystem < JOT_ALLOC_SUBSYSTEM_COUNT ? jot_alloc_subsystem_names[subsystem] : "(unknown)";
+}
+
+/* Counts a call that turned old_size bytes into size bytes (0 for a free), or failed to. */
+static void jot_AllocCount(jot_AllocStats* self, size_t old_size, size_t size, int failed)
+{
+    if(size == 0)
+    {
+        self->frees++;
+    }
+    else
+    {
+        self->calls++;
+    }
+    if(failed)
+    {
+        self->failures++;
+        return;
+    }
+    self->live = self->live - old_size + size;
+    if(self->peak < self->live)
+    {
+        self->peak = self->live;
+    }
+}
+
+static void jot_AllocatorCount(jot_Allocator* self, jot_AllocSubsystem subsystem, size_t old_size, size_t size, int failed)
+{
+    jot_AllocCount(&self->total, old_size, size, failed);
+    jot_AllocCount(&self->subsystems[subsystem], old_size, size, failed);
+}
+
+void* jot_Alloc(jot_Allocator* allocator, jot_AllocSubsystem subsystem, size_t size)
+{
+    void* pointer;
+    
+    if(allocator == NULL)
+    {
+        return malloc(size);
+    }
+    pointer = allocator->allocate(allocator->user, size);
+    jot_AllocatorCount(allocator, subsystem, 0, size, pointer == NULL);
+    return pointer;
+}
+
+void* jot_Realloc(jot_Allocator* allocator, jot_AllocSubsystem subsystem, void* pointer, size_t old_size, size_t size)
+{
+    if(pointer == NULL)
+    {
+        return jot_Alloc(allocator, subsystem, size);
+    }
+    if(allocator == NULL)
+    {
+        return realloc(pointer, size);
+    }
+    pointer = allocator->reallocate(allocator->user, pointer, old_size, size);
+    jot_AllocatorCount(allocator, subsystem, old_size, size, pointer == NULL);
+    return pointer;
+}
+
+void jot_Free(jot_Allocator* allocator, jot_AllocSubsystem subsystem, void* pointer, size_t size)
+{
+    if(pointer == NULL)
+    {
+        return;
+    }
+    if(allocator == NULL)
+    {
+        free(pointer);
+        return;
+    }
+    allocator->deallocate(allocator->user, pointer, size);
+    jot_AllocatorCount(allocator, subsystem, size, 0, 0);
+}
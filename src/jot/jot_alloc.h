@@ -0,0 +1,110 @@
+/*
+    jot - Allocators
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#ifndef JOT_ALLOC_H
+#define JOT_ALLOC_H
+
+#include <stddef.h>
+
+/* What an allocation is for, so statistics can say where memory goes. */
+typedef enum
+{
+    JOT_ALLOC_SOURCE,
+    JOT_ALLOC_SCANNER,
+    JOT_ALLOC_TOKENS,
+    JOT_ALLOC_ATOMS,
+    JOT_ALLOC_LINES,
+    JOT_ALLOC_DOCUMENT,
+    JOT_ALLOC_PARSE,
+    JOT_ALLOC_CODE,
+    JOT_ALLOC_OBJECTS,
+    JOT_ALLOC_VM,
+    JOT_ALLOC_GC,
+    JOT_ALLOC_SUBSYSTEM_COUNT
+} jot_AllocSubsystem;
+
+typedef struct
+{
+    /* Bytes allocated and not yet freed, and the most there have ever been. */
+    size_t live;
+    size_t peak;
+    /* Calls to allocate or resize a block, and how many of those failed. */
+    size_t calls;
+    size_t failures;
+    size_t frees;
+} jot_AllocStats;
+
+/*
+    Where everything jot allocates comes from. Every object that allocates
+    takes one when it's made, and keeps using it until it's freed; passing
+    NULL instead means plain malloc, realloc and free, with no statistics.
+    
+    The functions are told the size of every block they resize or free, so
+    arenas and size-classed allocators don't have to keep headers. Sizes are
+    never 0, and allocate and reallocate return NULL when they fail.
+    
+    Statistics aren't locked. An allocator is only ever used from one thread
+    at a time, except by jot_ScannerTokenizeParallel, which gives each of its
+    threads a copy (see jot_AllocatorFork) and so needs the functions to be
+    safe to call from several threads at once.
+*/
+typedef struct
+{
+    void* (*allocate)(void* user, size_t size);
+    void* (*reallocate)(void* user, void* pointer, size_t old_size, size_t size);
+    void (*deallocate)(void* user, void* pointer, size_t size);
+    void* user;
+    
+    jot_AllocStats total;
+    jot_AllocStats subsystems[JOT_ALLOC_SUBSYSTEM_COUNT];
+} jot_Allocator;
+
+/* Sets self up to use malloc, realloc and free, with all statistics at 0. */
+void jot_AllocatorInit(jot_Allocator* self);
+/* Starts the statistics over, except for live, which has to stay right. */
+void jot_AllocatorResetStats(jot_Allocator* self);
+
+/*
+    Makes child a copy of self with statistics of its own, for work done on
+    another thread. jot_AllocatorJoin adds child's statistics back into self
+    once that work is done, by which time everything allocated through child
+    should have been freed through it. Peaks are combined as if every child
+    peaked at once, so self's peak never comes out low.
+*/
+void jot_AllocatorFork(const jot_Allocator* self, jot_Allocator* child);
+void jot_AllocatorJoin(jot_Allocator* self, const jot_Allocator* child);
+
+const char* jot_AllocSubsystemName(jot_AllocSubsystem subsystem);
+
+/*
+    Allocation through an allocator (or malloc, when it's NULL). Resizing
+    NULL allocates, and freeing NULL does nothing, as with realloc and free.
+*/
+void* jot_Alloc(jot_Allocator* allocator, jot_AllocSubsystem subsystem, size_t size);
+void* jot_Realloc(jot_Allocator* allocator, jot_AllocSubsystem subsystem, void* pointer, size_t old_size, size_t size);
+void jot_Free(jot_Allocator* allocator, jot_AllocSubsystem subsystem, void* pointer, size_t size);
+
+#endif
@@ -0,0 +1,593 @@
+/*
+    jot - Arrays
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#include <string.h>
+
+#include "jot_array.h"
+#include "jot_num.h"
+
+enum
+{
+    JOT_ARRAY_MIN_CAPACITY = 4
+};
+
+/* The kind of array that can keep value packed. */
+static jot_ArrayKind jot_ArrayKindOf(jot_Value value)
+{
+    if(JOT_IS_SMALL_INT(value))
+    {
+        return JOT_ARRAY_INTS;
+    }
+    if(JOT_IS_NUM(value))
+    {
+        return JOT_ARRAY_NUMS;
+    }
+    if(JOT_IS_BOOL(value))
+    {
+        return JOT_ARRAY_BOOLS;
+    }
+    return JOT_ARRAY_VALUES;
+}
+
+static size_t jot_ArrayBytes(jot_ArrayKind kind, size_t capacity)
+{
+    switch(kind)
+    {
+        case JOT_ARRAY_EMPTY:
+            return 0;
+        case JOT_ARRAY_INTS:
+            return capacity * sizeof(int64_t);
+        case JOT_ARRAY_NUMS:
+            return capacity * sizeof(double);
+        case JOT_ARRAY_BOOLS:
+            return (capacity + 7) / 8;
+        default:
+            return capacity * sizeof(jot_Value);
+    }
+}
+
+/* Stores value at index, which must already have room, and be packable as the array's kind. */
+static void jot_ArrayPut(jot_Array* self, size_t index, jot_Value value)
+{
+    switch(self->kind)
+    {
+        case JOT_ARRAY_INTS:
+            self->items.ints[index] = JOT_AS_SMALL_INT(value);
+            break;
+        case JOT_ARRAY_NUMS:
+            self->items.nums[index] = JOT_AS_NUM(value);
+            break;
+        case JOT_ARRAY_BOOLS:
+            if(JOT_AS_BOOL(value))
+            {
+                self->items.bools[index >> 3] |= (unsigned char) (1 << (index & 7));
+            }
+            else
+            {
+                self->items.bools[index >> 3] &= (unsigned char) ~(1 << (index & 7));
+            }
+            break;
+        default:
+            self->items.values[index] = value;
+            break;
+    }
+}
+
+/* Moves the items to storage for kind with room for capacity of them, which is just a resize if it's the same kind. */
+static int jot_ArrayConvert(jot_Heap* heap, jot_Array* self, jot_ArrayKind kind, size_t capacity)
+{
+    jot_Array converted;
+    jot_Value value;
+    size_t i;
+    
+    if(capacity > (size_t) -1 / sizeof(jot_Value))
+    {
+        return 0;
+    }
+    converted.kind = kind;
+    if(kind == self->kind)
+    {
+        converted.items.bools = (unsigned char*) jot_HeapResize(heap, JOT_ALLOC_OBJECTS, self->items.bools,
+            jot_ArrayBytes(kind, self->capacity), jot_ArrayBytes(kind, capacity));
+        if(converted.items.bools == NULL && jot_ArrayBytes(kind, capacity) > 0)
+        {
+            return 0;
+        }
+    }
+    else
+    {
+        converted.items.bools = NULL;
+        if(jot_ArrayBytes(kind, capacity) > 0)
+        {
+            converted.items.bools = (unsigned char*) jot_HeapResize(heap, JOT_ALLOC_OBJECTS, NULL, 0, jot_ArrayBytes(kind, capacity));
+            if(converted.items.bools == NULL)
+            {
+                return 0;
+            }
+        }
+        for(i = 0; i < self->count; i++)
+        {
+            JOT_ARRAY_GET(self, i, &value);
+            jot_ArrayPut(&converted, i, value);
+        }
+        jot_HeapRelease(heap, JOT_ALLOC_OBJECTS, self->items.bools, jot_ArrayBytes(self->kind, self->capacity));
+    }
+    self->kind = kind;
+    self->items = converted.items;
+    self->capacity = capacity;
+    return 1;
+}
+
+/* Makes sure the array can keep items of kind, turning it into values if it has to. */
+static int jot_ArrayFit(jot_Heap* heap, jot_Array* self, jot_ArrayKind kind)
+{
+    if(kind == self->kind || self->kind == JOT_ARRAY_VALUES)
+    {
+        return 1;
+    }
+    return jot_ArrayConvert(heap, self, self->count == 0 ? kind : JOT_ARRAY_VALUES, self->capacity);
+}
+
+/* Makes room for count items, at least doubling the capacity if there isn't. */
+static int jot_ArrayGrow(jot_Heap* heap, jot_Array* self, size_t count)
+{
+    size_t capacity;
+    
+    if(count <= self->capacity)
+    {
+        return 1;
+    }
+    capacity = self->capacity < JOT_ARRAY_MIN_CAPACITY ? JOT_ARRAY_MIN_CAPACITY : self->capacity * 2;
+    if(capacity < count)
+    {
+        capacity = count;
+    }
+    if(capacity <= self->capacity)
+    {
+        return 0;
+    }
+    return jot_ArrayReserve(heap, self, capacity);
+}
+
+jot_Array* jot_ArrayNew(jot_Heap* heap, size_t capacity)
+{
+    jot_Array* self = (jot_Array*) jot_HeapAllocate(heap, JOT_TYPE_ARRAY, sizeof(jot_Array));
+    
+    if(self == NULL)
+    {
+        return NULL;
+    }
+    self->kind = JOT_ARRAY_EMPTY;
+    self->count = 0;
+    /* Just a hint, which is taken up once the first item comes along. */
+    self->capacity = capacity;
+    self->items.values = NULL;
+    return self;
+}
+
+void jot_ArrayFree(jot_Heap* heap, jot_Array* self)
+{
+    jot_HeapRelease(heap, JOT_ALLOC_OBJECTS, self->items.bools, jot_ArrayBytes(self->kind, self->capacity));
+    jot_HeapFreeObject(heap, &self->object, sizeof(jot_Array));
+}
+
+int jot_ArrayReserve(jot_Heap* heap, jot_Array* self, size_t capacity)
+{
+    if(capacity <= self->capacity)
+    {
+        return 1;
+    }
+    if(self->kind == JOT_ARRAY_EMPTY)
+    {
+        self->capacity = capacity;
+        return 1;
+    }
+    return jot_ArrayConvert(heap, self, self->kind, capacity);
+}
+
+int jot_ArrayPush(jot_Heap* heap, jot_Array* self, jot_Value value)
+{
+    JOT_GC_BARRIER(heap, &self->object, value);
+    if(!jot_ArrayFit(heap, self, jot_ArrayKindOf(value)) || !jot_ArrayGrow(heap, self, self->count + 1))
+    {
+        return 0;
+    }
+    jot_ArrayPut(self, self->count++, value);
+    return 1;
+}
+
+int jot_ArrayAppend(jot_Heap* heap, jot_Array* self, const jot_Value* values, size_t count)
+{
+    jot_ArrayKind kind;
+    size_t i;
+    
+    if(count == 0)
+    {
+        return 1;
+    }
+    /* The values are looked over first, so a mixed list goes straight to values, without packing any of them. */
+    kind = jot_ArrayKindOf(values[0]);
+    for(i = 1; i < count && kind != JOT_ARRAY_VALUES; i++)
+    {
+        if(jot_ArrayKindOf(values[i]) != kind)
+        {
+            kind = JOT_ARRAY_VALUES;
+        }
+    }
+    if(count > (size_t) -1 - self->count || !jot_ArrayFit(heap, self, kind) || !jot_ArrayGrow(heap, self, self->count + count))
+    {
+        return 0;
+    }
+    for(i = 0; i < count; i++)
+    {
+        JOT_GC_BARRIER(heap, &self->object, values[i]);
+        jot_ArrayPut(self, self->count++, values[i]);
+    }
+    return 1;
+}
+
+int jot_ArraySet(jot_Heap* heap, jot_Array* self, size_t index, jot_Value value)
+{
+    JOT_GC_BARRIER(heap, &self->object, value);
+    if(!jot_ArrayFit(heap, self, jot_ArrayKindOf(value)))
+    {
+        return 0;
+    }
+    jot_ArrayPut(self, index, value);
+    return 1;
+}
+
+/* Sets or clears the bits from start up to end, a byte at a time where it can. */
+static void jot_ArrayFillBits(unsigned char* bits, size_t start, size_t end, int set)
+{
+    for(; start < end && (start & 7) != 0; start++)
+    {
+        if(set)
+        {
+            bits[start >> 3] |= (unsigned char) (1 << (start & 7));
+        }
+        else
+        {
+            bits[start >> 3] &= (unsigned char) ~(1 << (start & 7));
+        }
+    }
+    if(start + 8 <= end)
+    {
+        memset(bits + (start >> 3), set ? 0xFF : 0, (end - start) >> 3);
+        start += (end - start) & ~(size_t) 7;
+    }
+    for(; start < end; start++)
+    {
+        if(set)
+        {
+            bits[start >> 3] |= (unsigned char) (1 << (start & 7));
+        }
+        else
+        {
+            bits[start >> 3] &= (unsigned char) ~(1 << (start & 7));
+        }
+    }
+}
+
+int jot_ArrayFill(jot_Heap* heap, jot_Array* self, size_t start, size_t count, jot_Value value)
+{
+    size_t end = start + count;
+    size_t i;
+    int64_t integer;
+    double number;
+    
+    if(count == 0)
+    {
+        return 1;
+    }
+    JOT_GC_BARRIER(heap, &self->object, value);
+    if(end < start || !jot_ArrayFit(heap, self, jot_ArrayKindOf(value)) || !jot_ArrayGrow(heap, self, end))
+    {
+        return 0;
+    }
+    switch(self->kind)
+    {
+        case JOT_ARRAY_INTS:
+            integer = JOT_AS_SMALL_INT(value);
+            for(i = start; i < end; i++)
+            {
+                self->items.ints[i] = integer;
+            }
+            break;
+        case JOT_ARRAY_NUMS:
+            number = JOT_AS_NUM(value);
+            for(i = start; i < end; i++)
+            {
+                self->items.nums[i] = number;
+            }
+            break;
+        case JOT_ARRAY_BOOLS:
+            jot_ArrayFillBits(self->items.bools, start, end, JOT_AS_BOOL(value));
+            break;
+        default:
+            for(i = start; i < end; i++)
+            {
+                self->items.values[i] = value;
+            }
+            break;
+    }
+    if(end > self->count)
+    {
+        self->count = end;
+    }
+    return 1;
+}
+
+static void jot_ArrayCopyBit(unsigned char* bits, size_t to, const unsigned char* source, size_t from)
+{
+    if(source[from >> 3] >> (from & 7) & 1)
+    {
+        bits[to >> 3] |= (unsigned char) (1 << (to & 7));
+    }
+    else
+    {
+        bits[to >> 3] &= (unsigned char) ~(1 << (to & 7));
+    }
+}
+
+/*
+    Copies count bits, which may overlap, going backward when the copy is
+    further on in the same bits. When both ends start on a byte, all but
+    the last few go over a byte at a time.
+*/
+static void jot_ArrayCopyBits(unsigned char* bits, size_t start, const unsigned char* source, size_t source_start, size_t count)
+{
+    size_t whole = (start & 7) == 0 && (source_start & 7) == 0 ? count & ~(size_t) 7 : 0;
+    size_t i;
+    
+    if(bits == source && start > source_start)
+    {
+        for(i = count; i > whole; i--)
+        {
+            jot_ArrayCopyBit(bits, start + i - 1, source, source_start + i - 1);
+        }
+        memmove(bits + (start >> 3), source + (source_start >> 3), whole >> 3);
+    }
+    else
+    {
+        memmove(bits + (start >> 3), source + (source_start >> 3), whole >> 3);
+        for(i = whole; i < count; i++)
+        {
+            jot_ArrayCopyBit(bits, start + i, source, source_start + i);
+        }
+    }
+}
+
+int jot_ArrayCopy(jot_Heap* heap, jot_Array* self, size_t start, const jot_Array* source, size_t source_start, size_t count)
+{
+    size_t end = start + count;
+    size_t i;
+    
+    if(count == 0)
+    {
+        return 1;
+    }
+    /* The same array is always the same kind, so a copy within one never comes apart into values below. */
+    if(end < start || !jot_ArrayFit(heap, self, source->kind) || !jot_ArrayGrow(heap, self, end))
+    {
+        return 0;
+    }
+    if(self->kind != source->kind)
+    {
+        for(i = 0; i < count; i++)
+        {
+            JOT_ARRAY_GET(source, source_start + i, &self->items.values[start + i]);
+        }
+    }
+    else if(self->kind == JOT_ARRAY_BOOLS)
+    {
+        jot_ArrayCopyBits(self->items.bools, start, source->items.bools, source_start, count);
+    }
+    else
+    {
+        /* Ints, floats and values are all 8 bytes. */
+        memmove(self->items.values + start, source->items.values + source_start, count * sizeof(jot_Value));
+    }
+    /* Only values can be objects, and the rest would be a loop for nothing. */
+    if(self->kind == JOT_ARRAY_VALUES && self->object.color == JOT_GC_BLACK)
+    {
+        for(i = start; i < end; i++)
+        {
+            JOT_GC_BARRIER(heap, &self->object, self->items.values[i]);
+        }
+    }
+    if(end > self->count)
+    {
+        self->count = end;
+    }
+    return 1;
+}
+
+jot_Array* jot_ArraySlice(jot_Heap* heap, const jot_Array* self, size_t start, size_t count)
+{
+    jot_Array* slice = jot_ArrayNew(heap, count);
+    
+    if(slice == NULL || !jot_ArrayCopy(heap, slice, 0, self, start, count))
+    {
+        return NULL;
+    }
+    return slice;
+}
+
+int jot_ArraySum(jot_Heap* heap, const jot_Array* self, jot_Value* result)
+{
+    jot_Value value;
+    uint64_t integer = 0;
+    double number = 0;
+    int is_num = 0;
+    size_t i;
+    
+    switch(self->count > 0 ? self->kind : JOT_ARRAY_EMPTY)
+    {
+        case JOT_ARRAY_EMPTY:
+            JOT_SET_SMALL_INT(result, 0);
+            return 1;
+        case JOT_ARRAY_INTS:
+            /* Ints wrap around like they do when added in a script, which lets these be added in any order. */
+            for(i = 0; i < self->count; i++)
+            {
+                integer += (uint64_t) self->items.ints[i];
+            }
+            return jot_ValueSetInt(heap, result, (int64_t) integer) ? 1 : -1;
+        case JOT_ARRAY_NUMS:
+            for(i = 0; i < self->count; i++)
+            {
+                number += self->items.nums[i];
+            }
+            jot_ValueSetNum(result, number);
+            return 1;
+        case JOT_ARRAY_BOOLS:
+            return 0;
+        default:
+            for(i = 0; i < self->count; i++)
+            {
+                value = self->items.values[i];
+                if(JOT_IS_INT(value))
+                {
+                    if(is_num)
+                    {
+                        number += (double) JOT_AS_INT(value);
+                    }
+                    else
+                    {
+                        integer += (uint64_t) JOT_AS_INT(value);
+                    }
+                }
+                else if(JOT_IS_NUM(value))
+                {
+                    /* From the first float on, the total is one too. */
+                    if(!is_num)
+                    {
+                        number = (double) (int64_t) integer;
+                        is_num = 1;
+                    }
+                    number += JOT_AS_NUM(value);
+                }
+                else
+                {
+                    return 0;
+                }
+            }
+            if(is_num)
+            {
+                jot_ValueSetNum(result, number);
+                return 1;
+            }
+            return jot_ValueSetInt(heap, result, (int64_t) integer) ? 1 : -1;
+    }
+}
+
+/* a < b, for ints and floats. */
+static int jot_ArrayLess(jot_Value a, jot_Value b)
+{
+    if(JOT_IS_INT(a))
+    {
+        return JOT_IS_INT(b) ? JOT_AS_INT(a) < JOT_AS_INT(b) : jot_NumIntLessNum(JOT_AS_INT(a), JOT_AS_NUM(b));
+    }
+    return JOT_IS_INT(b) ? jot_NumNumLessInt(JOT_AS_NUM(a), JOT_AS_INT(b)) : JOT_AS_NUM(a) < JOT_AS_NUM(b);
+}
+
+/* Keeps the first item that nothing later is less than, or with max, that's less than nothing later. */
+static int jot_ArrayExtreme(const jot_Array* self, int max, jot_Value* result)
+{
+    int64_t integer;
+    double number;
+    size_t i;
+    
+    switch(self->count > 0 ? self->kind : JOT_ARRAY_EMPTY)
+    {
+        case JOT_ARRAY_EMPTY:
+            JOT_SET_NIL(result);
+            return 1;
+        case JOT_ARRAY_INTS:
+            integer = self->items.ints[0];
+            if(max)
+            {
+                for(i = 1; i < self->count; i++)
+                {
+                    integer = integer < self->items.ints[i] ? self->items.ints[i] : integer;
+                }
+            }
+            else
+            {
+                for(i = 1; i < self->count; i++)
+                {
+                    integer = self->items.ints[i] < integer ? self->items.ints[i] : integer;
+                }
+            }
+            JOT_SET_SMALL_INT(result, integer);
+            return 1;
+        case JOT_ARRAY_NUMS:
+            number = self->items.nums[0];
+            if(max)
+            {
+                for(i = 1; i < self->count; i++)
+                {
+                    number = number < self->items.nums[i] ? self->items.nums[i] : number;
+                }
+            }
+            else
+            {
+                for(i = 1; i < self->count; i++)
+                {
+                    number = self->items.nums[i] < number ? self->items.nums[i] : number;
+                }
+            }
+            jot_ValueSetNum(result, number);
+            return 1;
+        case JOT_ARRAY_BOOLS:
+            return 0;
+        default:
+            *result = self->items.values[0];
+            for(i = 0; i < self->count; i++)
+            {
+                if(!JOT_IS_INT(self->items.values[i]) && !JOT_IS_NUM(self->items.values[i]))
+                {
+                    return 0;
+                }
+                if(max ? jot_ArrayLess(*result, self->items.values[i]) : jot_ArrayLess(self->items.values[i], *result))
+                {
+                    *result = self->items.values[i];
+                }
+            }
+            return 1;
+    }
+}
+
+int jot_ArrayMin(const jot_Array* self, jot_Value* result)
+{
+    return jot_ArrayExtreme(self, 0, result);
+}
+
+int jot_ArrayMax(const jot_Array* self, jot_Value* result)
+{
+    return jot_ArrayExtreme(self, 1, result);
+}
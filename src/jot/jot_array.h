@@ -0,0 +1,111 @@
+/*
+    jot - Arrays
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#ifndef JOT_ARRAY_H
+#define JOT_ARRAY_H
+
+#include <stddef.h>
+
+#include "jot_value.h"
+
+/* How an array keeps its items. */
+typedef enum
+{
+    /* Nothing's been stored yet, so it doesn't know, and has no storage. */
+    JOT_ARRAY_EMPTY,
+    /* Ints that fit in a value unboxed, as int64_ts. */
+    JOT_ARRAY_INTS,
+    /* Floats, as doubles. */
+    JOT_ARRAY_NUMS,
+    /* Bools, a bit each, from the low bit of each byte up. */
+    JOT_ARRAY_BOOLS,
+    /* Anything, as values. */
+    JOT_ARRAY_VALUES
+} jot_ArrayKind;
+
+/*
+    A growable list of values, indexed from 0.
+
+    While every item is the same kind of int, float or bool, the items are
+    packed as that kind, without the value around them. Storing anything
+    else turns the array into plain values for good, unless it's empty at
+    the time, in which case it just takes up the new kind.
+
+    An empty array's capacity is only a hint of how many items to make
+    room for, once it knows what kind they'll be.
+*/
+typedef struct
+{
+    jot_Object object;
+    jot_ArrayKind kind;
+    size_t count;
+    size_t capacity;
+    union
+    {
+        int64_t* ints;
+        double* nums;
+        unsigned char* bools;
+        jot_Value* values;
+    } items;
+} jot_Array;
+
+/* Stores item index of array a, which must be less than its count, into the jot_Value that p points at. */
+#define JOT_ARRAY_GET(a, index, p) \
+    ((a)->kind == JOT_ARRAY_VALUES ? (void) (*(p) = (a)->items.values[index]) \
+    : (a)->kind == JOT_ARRAY_INTS ? (void) JOT_SET_SMALL_INT(p, (a)->items.ints[index]) \
+    : (a)->kind == JOT_ARRAY_NUMS ? (void) JOT_SET_NUM(p, (a)->items.nums[index]) \
+    : (void) JOT_SET_BOOL(p, (a)->items.bools[(index) >> 3] >> ((index) & 7) & 1))
+
+jot_Array* jot_ArrayNew(jot_Heap* heap, size_t capacity);
+void jot_ArrayFree(jot_Heap* heap, jot_Array* self);
+
+/* These return 0 if memory runs out. */
+int jot_ArrayReserve(jot_Heap* heap, jot_Array* self, size_t capacity);
+int jot_ArrayPush(jot_Heap* heap, jot_Array* self, jot_Value value);
+int jot_ArrayAppend(jot_Heap* heap, jot_Array* self, const jot_Value* values, size_t count);
+/* index must be less than the count. */
+int jot_ArraySet(jot_Heap* heap, jot_Array* self, size_t index, jot_Value value);
+
+/*
+    The bulk operations, which go over packed items a kind at a time.
+    Ranges are a start and a count, and have to be inside the array, except
+    that filling or copying into one may run past its end to lengthen it.
+*/
+int jot_ArrayFill(jot_Heap* heap, jot_Array* self, size_t start, size_t count, jot_Value value);
+int jot_ArrayCopy(jot_Heap* heap, jot_Array* self, size_t start, const jot_Array* source, size_t source_start, size_t count);
+jot_Array* jot_ArraySlice(jot_Heap* heap, const jot_Array* self, size_t start, size_t count);
+
+/*
+    Adds up every item, the way + would one after another, starting from 0.
+    Returns 1 if that worked, 0 if an item isn't an int or a float, and -1
+    if memory runs out.
+*/
+int jot_ArraySum(jot_Heap* heap, const jot_Array* self, jot_Value* result);
+/* Finds the smallest or biggest item, by <, or nil if there aren't any. Returns 0 if an item isn't an int or a float. */
+int jot_ArrayMin(const jot_Array* self, jot_Value* result);
+int jot_ArrayMax(const jot_Array* self, jot_Value* result);
+
+#endif
@@ -0,0 +1,132 @@
+/*
+    jot - Bytecode
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#ifndef JOT_CODE_H
+#define JOT_CODE_H
+
+#include <stdint.h>
+
+/*
+    Instructions are 32 bits: an 8-bit opcode in the low bits, then
+    operands A, B and C of 8 bits each, or A and a 16-bit Bx in place of B
+    and C, or a 24-bit sJ in place of all three. R[x] is register x of the
+    running function, K[x] its constant x and U[x] its upvalue x. Signed
+    operands are stored biased: sB and sC are B and C minus 127, sBx is Bx
+    minus 32767, and sJ is those 24 bits minus 0x7FFFFF.
+    
+    Comparisons and TEST skip the instruction after them, which is always
+    a JMP, unless their result is C. "Up to the top" is as far as the last
+    instruction that made a variable number of values went.
+*/
+#define JOT_OPCODES(X) \
+    X(MOVE)         /* A B      R[A] = R[B] */ \
+    X(LOADK)        /* A Bx     R[A] = K[Bx] */ \
+    X(LOADI)        /* A sBx    R[A] = sBx */ \
+    X(LOADNIL)      /* A B      R[A], ..., R[A+B] = nil */ \
+    X(LOADFALSE)    /* A        R[A] = false */ \
+    X(LOADTRUE)     /* A        R[A] = true */ \
+    X(GETUPVAL)     /* A B      R[A] = U[B] */ \
+    X(SETUPVAL)     /* A B      U[B] = R[A] */ \
+    X(GETGLOBAL)    /* A Bx     R[A] = globals[K[Bx]] */ \
+    X(SETGLOBAL)    /* A Bx     globals[K[Bx]] = R[A] */ \
+    X(GETINDEX)     /* A B C    R[A] = R[B][R[C]] */ \
+    X(GETFIELD)     /* A B C    R[A] = R[B][K[C]] */ \
+    X(SETINDEX)     /* A B C    R[A][R[B]] = R[C] */ \
+    X(SETFIELD)     /* A B C    R[A][K[B]] = R[C] */ \
+    X(NEWTABLE)     /* A B      R[A] = a table with room for B entries */ \
+    X(NEWARRAY)     /* A B      R[A] = an array with room for B elements */ \
+    X(APPEND)       /* A B      appends R[A+1], ..., R[A+B-1] (B = 0: up to the top) to the array R[A] */ \
+    X(SELF)         /* A B C    R[A+1] = R[B]; R[A] = R[B][K[C]] */ \
+    X(ADD)          /* A B C    R[A] = R[B] + R[C] */ \
+    X(SUB)          /* A B C    R[A] = R[B] - R[C] */ \
+    X(MUL)          /* A B C    R[A] = R[B] * R[C] */ \
+    X(DIV)          /* A B C    R[A] = R[B] / R[C] */ \
+    X(MOD)          /* A B C    R[A] = R[B] % R[C] */ \
+    X(POW)          /* A B C    R[A] = R[B] ** R[C] */ \
+    X(BAND)         /* A B C    R[A] = R[B] & R[C] */ \
+    X(BOR)          /* A B C    R[A] = R[B] | R[C] */ \
+    X(BXOR)         /* A B C    R[A] = R[B] ^ R[C] */ \
+    X(SHL)          /* A B C    R[A] = R[B] << R[C] */ \
+    X(SHR)          /* A B C    R[A] = R[B] >> R[C] */ \
+    X(CONCAT)       /* A B C    R[A] = R[B] .. R[C] */ \
+    X(ADDI)         /* A B sC   R[A] = R[B] + sC */ \
+    X(UNM)          /* A B      R[A] = -R[B] */ \
+    X(BNOT)         /* A B      R[A] = ~R[B] */ \
+    X(NOT)          /* A B      R[A] = not R[B] */ \
+    X(JMP)          /* sJ       pc += sJ */ \
+    X(EQ)           /* A B C    if (R[A] == R[B]) != C then pc++ */ \
+    X(LT)           /* A B C    if (R[A] < R[B]) != C then pc++ */ \
+    X(LE)           /* A B C    if (R[A] <= R[B]) != C then pc++ */ \
+    X(EQI)          /* A sB C   if (R[A] == sB) != C then pc++ */ \
+    X(LTI)          /* A sB C   if (R[A] < sB) != C then pc++ */ \
+    X(LEI)          /* A sB C   if (R[A] <= sB) != C then pc++ */ \
+    X(GTI)          /* A sB C   if (R[A] > sB) != C then pc++ */ \
+    X(GEI)          /* A sB C   if (R[A] >= sB) != C then pc++ */ \
+    X(TEST)         /* A C      if R[A] isn't nil or false != C then pc++ */ \
+    X(CALL)         /* A B C    R[A], ..., R[A+C-2] = R[A](R[A+1], ..., R[A+B-1]) (B = 0: up to the top; C = 0: all results, to a new top) */ \
+    X(RETURN)       /* A B      returns R[A], ..., R[A+B-2] (B = 0: up to the top) */ \
+    X(VARARG)       /* A B      R[A], ..., R[A+B-2] = ... (B = 0: all of them, to a new top) */ \
+    X(CLOSURE)      /* A Bx     R[A] = a closure of nested function Bx */ \
+    X(CLOSE)        /* A        closes the upvalues of R[A] and above */ \
+    X(FORNEXT)      /* A C      steps the loop over R[A] with state R[A+1], setting R[A+2], ..., R[A+C+1]; pc++ unless it's done */
+
+#define JOT_OPCODE_ENUM(name) JOT_OP_##name,
+
+typedef enum
+{
+    JOT_OPCODES(JOT_OPCODE_ENUM)
+    JOT_OP_COUNT
+} jot_Op;
+
+typedef uint32_t jot_Instruction;
+
+enum
+{
+    /* Registers are 8-bit operands. */
+    JOT_CODE_MAX_REGISTERS = 255,
+    JOT_CODE_MAX_BX = 0xFFFF,
+    JOT_CODE_SB_BIAS = 127,
+    JOT_CODE_SBX_BIAS = 0x7FFF,
+    JOT_CODE_SJ_BIAS = 0x7FFFFF
+};
+
+#define JOT_CODE_OP(i) ((jot_Op) ((i) & 0xFF))
+#define JOT_CODE_A(i) ((unsigned int) ((i) >> 8) & 0xFF)
+#define JOT_CODE_B(i) ((unsigned int) ((i) >> 16) & 0xFF)
+#define JOT_CODE_C(i) ((unsigned int) ((i) >> 24))
+#define JOT_CODE_BX(i) ((unsigned int) ((i) >> 16))
+#define JOT_CODE_SB(i) ((int) JOT_CODE_B(i) - JOT_CODE_SB_BIAS)
+#define JOT_CODE_SC(i) ((int) JOT_CODE_C(i) - JOT_CODE_SB_BIAS)
+#define JOT_CODE_SBX(i) ((long) JOT_CODE_BX(i) - JOT_CODE_SBX_BIAS)
+#define JOT_CODE_SJ(i) ((long) ((i) >> 8) - JOT_CODE_SJ_BIAS)
+
+#define JOT_CODE_ABC(op, a, b, c) ((jot_Instruction) (op) | (jot_Instruction) (a) << 8 | (jot_Instruction) (b) << 16 | (jot_Instruction) (c) << 24)
+#define JOT_CODE_ABX(op, a, bx) ((jot_Instruction) (op) | (jot_Instruction) (a) << 8 | (jot_Instruction) (bx) << 16)
+#define JOT_CODE_JUMP(sj) ((jot_Instruction) JOT_OP_JMP | (jot_Instruction) ((sj) + JOT_CODE_SJ_BIAS) << 8)
+
+const char* jot_OpName(jot_Op op);
+
+#endif
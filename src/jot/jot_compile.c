@@ -0,0 +1,1755 @@
+/*
+    jot - Compiler
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#include <string.h>
+
+#include "jot_compile.h"
+
+/* Jump lists are chains of JMP instructions waiting to be given a target. */
+#define JOT_COMPILE_NO_JUMP (-1L)
+
+enum
+{
+    JOT_COMPILE_MIN_CAPACITY = 16,
+    /* Array elements put in registers before each APPEND. */
+    JOT_COMPILE_APPEND_BATCH = 32,
+    /* sJ is 24 bits, so every jump has to stay inside this many instructions. */
+    JOT_COMPILE_MAX_CODE = 1L << 23
+};
+
+typedef struct
+{
+    /* JOT_AST_NO_ATOM for registers a for loop keeps to itself. */
+    uint32_t atom;
+    /* Whether a closure has captured it, so it has to be closed when it goes out of scope. */
+    int captured;
+} jot_CompileLocal;
+
+typedef struct jot_CompileLoop
+{
+    struct jot_CompileLoop* previous;
+    /* Locals before the loop; the ones after are made anew each time around. */
+    unsigned int local_count;
+    /* Whether any of those were captured, so going around again has to close them. */
+    int captured;
+    long breaks;
+    long continues;
+} jot_CompileLoop;
+
+typedef struct jot_Compiler jot_Compiler;
+
+/* A function being compiled, with everything that goes into its proto so far. */
+typedef struct jot_FuncState
+{
+    struct jot_FuncState* parent;
+    jot_Compiler* compiler;
+    int vararg;
+    
+    jot_Instruction* code;
+    uint32_t* offsets;
+    size_t code_count;
+    size_t code_capacity;
+    size_t offset_capacity;
+    
+    jot_Value* constants;
+    size_t constant_count;
+    size_t constant_capacity;
+    /* Open addressing over the constants, holding index + 1, so each is only added once. */
+    size_t* constant_slots;
+    size_t constant_slot_capacity;
+    
+    jot_Proto** protos;
+    size_t proto_count;
+    size_t proto_capacity;
+    
+    uint32_t upvalue_atoms[JOT_CODE_MAX_REGISTERS];
+    unsigned char upvalues[JOT_CODE_MAX_REGISTERS * 2];
+    size_t upvalue_count;
+    
+    /* Local i is always in register i. */
+    jot_CompileLocal locals[JOT_CODE_MAX_REGISTERS];
+    unsigned int local_count;
+    unsigned int free_register;
+    unsigned int register_count;
+    
+    jot_CompileLoop* loop;
+} jot_FuncState;
+
+struct jot_Compiler
+{
+    jot_Heap* heap;
+    jot_Ast* ast;
+    jot_String* source;
+    jot_ParseError* error;
+    int failed;
+    
+    /* The string made for each atom so far, by id, so each is only made once. */
+    jot_String** strings;
+    size_t string_capacity;
+};
+
+static void jot_CompileExpression(jot_FuncState* self, jot_NodeRef node, unsigned int target);
+static void jot_CompileStatements(jot_FuncState* self, jot_NodeRef block);
+
+static void jot_CompilerFail(jot_Compiler* self, const char* message, size_t offset)
+{
+    if(!self->failed)
+    {
+        self->failed = 1;
+        self->error->message = message;
+        self->error->offset = offset;
+        self->error->length = 0;
+    }
+}
+
+/* Grows an array of count items of size bytes to make room for one more. */
+static void* jot_CompilerGrow(jot_Compiler* self, void* items, size_t* capacity, size_t count, size_t size)
+{
+    size_t new_capacity;
+    void* result;
+    
+    if(count < *capacity)
+    {
+        return items;
+    }
+    new_capacity = *capacity < JOT_COMPILE_MIN_CAPACITY ? JOT_COMPILE_MIN_CAPACITY : *capacity * 2;
+    if(new_capacity > (size_t) -1 / size)
+    {
+        return NULL;
+    }
+    result = jot_HeapResize(self->heap, JOT_ALLOC_CODE, items, *capacity * size, new_capacity * size);
+    if(result != NULL)
+    {
+        *capacity = new_capacity;
+    }
+    return result;
+}
+
+static size_t jot_CompilerEmit(jot_FuncState* self, jot_Instruction instruction, size_t offset)
+{
+    jot_Compiler* compiler = self->compiler;
+    jot_Instruction* code;
+    uint32_t* offsets;
+    
+    if(compiler->failed)
+    {
+        return self->code_count;
+    }
+    if(self->code_count >= (size_t) JOT_COMPILE_MAX_CODE)
+    {
+        jot_CompilerFail(compiler, "function too large", offset);
+        return self->code_count;
+    }
+    code = (jot_Instruction*) jot_CompilerGrow(compiler, self->code, &self->code_capacity, self->code_count, sizeof(jot_Instruction));
+    if(code != NULL)
+    {
+        self->code = code;
+    }
+    offsets = (uint32_t*) jot_CompilerGrow(compiler, self->offsets, &self->offset_capacity, self->code_count, sizeof(uint32_t));
+    if(offsets != NULL)
+    {
+        self->offsets = offsets;
+    }
+    if(code == NULL || offsets == NULL)
+    {
+        jot_CompilerFail(compiler, "out of memory", offset);
+        return self->code_count;
+    }
+    self->code[self->code_count] = instruction;
+    self->offsets[self->code_count] = (uint32_t) offset;
+    return self->code_count++;
+}
+
+static void jot_CompilerEmitABC(jot_FuncState* self, jot_Op op, unsigned int a, unsigned int b, unsigned int c, size_t offset)
+{
+    jot_CompilerEmit(self, JOT_CODE_ABC(op, a, b, c), offset);
+}
+
+static void jot_CompilerEmitABX(jot_FuncState* self, jot_Op op, unsigned int a, unsigned int bx, size_t offset)
+{
+    jot_CompilerEmit(self, JOT_CODE_ABX(op, a, bx), offset);
+}
+
+static void jot_CompilerMove(jot_FuncState* self, unsigned int target, unsigned int source, size_t offset)
+{
+    if(target != source)
+    {
+        jot_CompilerEmitABC(self, JOT_OP_MOVE, target, source, 0, offset);
+    }
+}
+
+/* Emits a JMP on a jump list of its own. */
+static long jot_CompilerJump(jot_FuncState* self, size_t offset)
+{
+    if(self->compiler->failed)
+    {
+        return JOT_COMPILE_NO_JUMP;
+    }
+    /* Until it's patched, a jump holds the next one on its list, plus one. */
+    return (long) jot_CompilerEmit(self, JOT_OP_JMP, offset);
+}
+
+static long jot_CompilerNextJump(const jot_FuncState* self, long jump)
+{
+    return (long) (self->code[jump] >> 8) - 1;
+}
+
+static void jot_CompilerConcatJumps(jot_FuncState* self, long* list, long jumps)
+{
+    long jump = *list;
+    long next;
+    
+    if(self->compiler->failed || jumps == JOT_COMPILE_NO_JUMP)
+    {
+        return;
+    }
+    if(jump == JOT_COMPILE_NO_JUMP)
+    {
+        *list = jumps;
+        return;
+    }
+    while((next = jot_CompilerNextJump(self, jump)) != JOT_COMPILE_NO_JUMP)
+    {
+        jump = next;
+    }
+    self->code[jump] = JOT_OP_JMP | (jot_Instruction) (jumps + 1) << 8;
+}
+
+static void jot_CompilerPatchJumps(jot_FuncState* self, long list, size_t target)
+{
+    long next;
+    
+    if(self->compiler->failed)
+    {
+        return;
+    }
+    while(list != JOT_COMPILE_NO_JUMP)
+    {
+        next = jot_CompilerNextJump(self, list);
+        self->code[list] = JOT_CODE_JUMP((long) target - (list + 1));
+        list = next;
+    }
+}
+
+static void jot_CompilerPatchHere(jot_FuncState* self, long list)
+{
+    jot_CompilerPatchJumps(self, list, self->code_count);
+}
+
+/* Returns the first of count registers above everything in use. */
+static unsigned int jot_CompilerReserve(jot_FuncState* self, unsigned int count, size_t offset)
+{
+    unsigned int first = self->free_register;
+    
+    if(count > JOT_CODE_MAX_REGISTERS - first)
+    {
+        jot_CompilerFail(self->compiler, "function needs too many registers", offset);
+        return first;
+    }
+    self->free_register += count;
+    if(self->register_count < self->free_register)
+    {
+        self->register_count = self->free_register;
+    }
+    return first;
+}
+
+static void jot_CompilerDeclare(jot_FuncState* self, uint32_t atom)
+{
+    if(self->local_count < self->free_register)
+    {
+        self->locals[self->local_count].atom = atom;
+        self->locals[self->local_count].captured = 0;
+        self->local_count++;
+    }
+}
+
+static long jot_CompilerFindLocal(const jot_FuncState* self, uint32_t atom)
+{
+    unsigned int i = self->local_count;
+    
+    while(i > 0)
+    {
+        i--;
+        if(self->locals[i].atom == atom)
+        {
+            return (long) i;
+        }
+    }
+    return -1;
+}
+
+static void jot_CompilerCapture(jot_FuncState* self, unsigned int local)
+{
+    jot_CompileLoop* loop;
+    
+    self->locals[local].captured = 1;
+    for(loop = self->loop; loop != NULL && local >= loop->local_count; loop = loop->previous)
+    {
+        loop->captured = 1;
+    }
+}
+
+/* Returns the upvalue for a local of an enclosing function, adding it if needed, or -1 for a global. */
+static long jot_CompilerFindUpvalue(jot_FuncState* self, uint32_t atom, size_t offset)
+{
+    long found;
+    int in_stack;
+    size_t i;
+    
+    for(i = 0; i < self->upvalue_count; i++)
+    {
+        if(self->upvalue_atoms[i] == atom)
+        {
+            return (long) i;
+        }
+    }
+    if(self->parent == NULL)
+    {
+        return -1;
+    }
+    found = jot_CompilerFindLocal(self->parent, atom);
+    in_stack = found >= 0;
+    if(in_stack)
+    {
+        jot_CompilerCapture(self->parent, (unsigned int) found);
+    }
+    else
+    {
+        found = jot_CompilerFindUpvalue(self->parent, atom, offset);
+        if(found < 0)
+        {
+            return -1;
+        }
+    }
+    if(self->upvalue_count == JOT_CODE_MAX_REGISTERS)
+    {
+        jot_CompilerFail(self->compiler, "function uses too many upvalues", offset);
+        return 0;
+    }
+    self->upvalue_atoms[self->upvalue_count] = atom;
+    self->upvalues[self->upvalue_count * 2] = (unsigned char) in_stack;
+    self->upvalues[self->upvalue_count * 2 + 1] = (unsigned char) found;
+    return (long) self->upvalue_count++;
+}
+
+static size_t jot_CompilerConstantHash(jot_Value value)
+{
+    uint64_t bits = JOT_IS_INT(value) ? (uint64_t) JOT_AS_INT(value) : value.bits;
+    
+    bits ^= bits >> 29;
+    bits *= (uint64_t) 0xBF58476DUL << 32 | 0x1CE4E5B9UL;
+    return (size_t) (bits ^ (bits >> 32));
+}
+
+/*
+    Constants are the same if they have the same bits, so 0 and -0.0 stay
+    apart, or if they're boxes around the same int. Strings are made once
+    per atom.
+*/
+static int jot_CompilerSameConstant(jot_Value a, jot_Value b)
+{
+    return a.bits == b.bits || (JOT_IS_INT(a) && JOT_IS_INT(b) && JOT_AS_INT(a) == JOT_AS_INT(b));
+}
+
+static int jot_CompilerRehashConstants(jot_FuncState* self)
+{
+    jot_Compiler* compiler = self->compiler;
+    size_t capacity = self->constant_slot_capacity < JOT_COMPILE_MIN_CAPACITY ? JOT_COMPILE_MIN_CAPACITY * 2 : self->constant_slot_capacity * 2;
+    size_t* slots;
+    size_t mask = capacity - 1;
+    size_t i;
+    size_t j;
+    
+    if(capacity > (size_t) -1 / sizeof(size_t))
+    {
+        return 0;
+    }
+    slots = (size_t*) jot_HeapResize(compiler->heap, JOT_ALLOC_CODE, NULL, 0, capacity * sizeof(size_t));
+    if(slots == NULL)
+    {
+        return 0;
+    }
+    memset(slots, 0, capacity * sizeof(size_t));
+    for(i = 0; i < self->constant_count; i++)
+    {
+        for(j = jot_CompilerConstantHash(self->constants[i]) & mask; slots[j] != 0; j = (j + 1) & mask)
+        {
+        }
+        slots[j] = i + 1;
+    }
+    jot_HeapRelease(compiler->heap, JOT_ALLOC_CODE, self->constant_slots, self->constant_slot_capacity * sizeof(size_t));
+    self->constant_slots = slots;
+    self->constant_slot_capacity = capacity;
+    return 1;
+}
+
+static unsigned int jot_CompilerConstant(jot_FuncState* self, jot_Value value, size_t offset)
+{
+    jot_Compiler* compiler = self->compiler;
+    jot_Value* constants;
+    size_t mask;
+    size_t i;
+    
+    if(compiler->failed)
+    {
+        return 0;
+    }
+    if(self->constant_count >= self->constant_slot_capacity / 2 && !jot_CompilerRehashConstants(self))
+    {
+        jot_CompilerFail(compiler, "out of memory", offset);
+        return 0;
+    }
+    mask = self->constant_slot_capacity - 1;
+    for(i = jot_CompilerConstantHash(value) & mask; self->constant_slots[i] != 0; i = (i + 1) & mask)
+    {
+        if(jot_CompilerSameConstant(self->constants[self->constant_slots[i] - 1], value))
+        {
+            return (unsigned int) (self->constant_slots[i] - 1);
+        }
+    }
+    if(self->constant_count > JOT_CODE_MAX_BX)
+    {
+        jot_CompilerFail(compiler, "function has too many constants", offset);
+        return 0;
+    }
+    constants = (jot_Value*) jot_CompilerGrow(compiler, self->constants, &self->constant_capacity, self->constant_count, sizeof(jot_Value));
+    if(constants == NULL)
+    {
+        jot_CompilerFail(compiler, "out of memory", offset);
+        return 0;
+    }
+    self->constants = constants;
+    self->constants[self->constant_count] = value;
+    self->constant_slots[i] = ++self->constant_count;
+    return (unsigned int) (self->constant_count - 1);
+}
+
+static jot_String* jot_CompilerString(jot_Compiler* self, uint32_t atom, size_t offset)
+{
+    const jot_Atom* text = jot_AtomTableGet(self->ast->atoms, atom);
+    jot_String** strings;
+    size_t capacity;
+    
+    if(atom >= self->string_capacity)
+    {
+        /* The table can grow as skipped bodies are parsed and strings are folded. */
+        capacity = self->ast->atoms->count;
+        if(capacity <= atom)
+        {
+            capacity = (size_t) atom + 1;
+        }
+        strings = (jot_String**) jot_Realloc(self->heap->allocator, JOT_ALLOC_CODE, self->strings,
+            self->string_capacity * sizeof(jot_String*), capacity * sizeof(jot_String*));
+        if(strings == NULL)
+        {
+            jot_CompilerFail(self, "out of memory", offset);
+            return NULL;
+        }
+        memset(strings + self->string_capacity, 0, (capacity - self->string_capacity) * sizeof(jot_String*));
+        self->strings = strings;
+        self->string_capacity = capacity;
+    }
+    if(self->strings[atom] == NULL)
+    {
+        self->strings[atom] = jot_StringNew(self->heap, text->text, text->length);
+        if(self->strings[atom] == NULL)
+        {
+            jot_CompilerFail(self, "out of memory", offset);
+        }
+    }
+    return self->strings[atom];
+}
+
+static unsigned int jot_CompilerStringConstant(jot_FuncState* self, uint32_t atom, size_t offset)
+{
+    jot_String* string = jot_CompilerString(self->compiler, atom, offset);
+    jot_Value value;
+    
+    if(string == NULL)
+    {
+        return 0;
+    }
+    JOT_SET_OBJECT(&value, string);
+    return jot_CompilerConstant(self, value, offset);
+}
+
+static void jot_CompilerLoadConstant(jot_FuncState* self, unsigned int target, jot_Value value, size_t offset)
+{
+    jot_CompilerEmitABX(self, JOT_OP_LOADK, target, jot_CompilerConstant(self, value, offset), offset);
+}
+
+static int jot_CompileIsMulti(const jot_Ast* ast, jot_NodeRef node)
+{
+    jot_NodeKind kind = jot_AstKind(ast, node);
+    
+    return kind == JOT_NODE_CALL || kind == JOT_NODE_METHOD_CALL || kind == JOT_NODE_VARARG;
+}
+
+static int jot_CompileIsComparison(jot_Token op)
+{
+    return op == JOT_TOKEN_CMP_EQ || op == JOT_TOKEN_CMP_NE || op == JOT_TOKEN_CMP_LT
+        || op == JOT_TOKEN_CMP_LE || op == JOT_TOKEN_CMP_GT || op == JOT_TOKEN_CMP_GE;
+}
+
+/* Whether node is an integer literal from low to high, small enough for an instruction to hold. */
+static int jot_CompileImmediate(const jot_Ast* ast, jot_NodeRef node, long low, long high, long* value)
+{
+    int64_t integer;
+    
+    if(jot_AstKind(ast, node) != JOT_NODE_INT)
+    {
+        return 0;
+    }
+    integer = jot_AstInt(ast, node);
+    if(integer < low || integer > high)
+    {
+        return 0;
+    }
+    *value = (long) integer;
+    return 1;
+}
+
+/* Returns the register of node if it's a local, or else puts it in a new one. */
+static unsigned int jot_CompileAnyRegister(jot_FuncState* self, jot_NodeRef node)
+{
+    jot_Ast* ast = self->compiler->ast;
+    unsigned int target;
+    long local;
+    
+    if(jot_AstKind(ast, node) == JOT_NODE_NAME)
+    {
+        local = jot_CompilerFindLocal(self, jot_AstWord(ast, node, 0));
+        if(local >= 0)
+        {
+            return (unsigned int) local;
+        }
+    }
+    target = jot_CompilerReserve(self, 1, jot_AstOffset(ast, node));
+    jot_CompileExpression(self, node, target);
+    return target;
+}
+
+/*
+    Puts a key where GETFIELD or SETFIELD can get at it, returning 1, if
+    it's a string whose constant fits in an operand; otherwise puts it in
+    a register for GETINDEX or SETINDEX.
+*/
+static int jot_CompileKey(jot_FuncState* self, jot_NodeRef node, unsigned int* key)
+{
+    jot_Ast* ast = self->compiler->ast;
+    unsigned int constant;
+    
+    if(jot_AstKind(ast, node) == JOT_NODE_STR)
+    {
+        constant = jot_CompilerStringConstant(self, jot_AstWord(ast, node, 0), jot_AstOffset(ast, node));
+        if(constant <= 0xFF)
+        {
+            *key = constant;
+            return 1;
+        }
+    }
+    *key = jot_CompileAnyRegister(self, node);
+    return 0;
+}
+
+static void jot_CompileName(jot_FuncState* self, jot_NodeRef node, unsigned int target)
+{
+    jot_Ast* ast = self->compiler->ast;
+    uint32_t atom = jot_AstWord(ast, node, 0);
+    size_t offset = jot_AstOffset(ast, node);
+    long local = jot_CompilerFindLocal(self, atom);
+    long upvalue;
+    
+    if(local >= 0)
+    {
+        jot_CompilerMove(self, target, (unsigned int) local, offset);
+        return;
+    }
+    upvalue = jot_CompilerFindUpvalue(self, atom, offset);
+    if(upvalue >= 0)
+    {
+        jot_CompilerEmitABC(self, JOT_OP_GETUPVAL, target, (unsigned int) upvalue, 0, offset);
+    }
+    else
+    {
+        jot_CompilerEmitABX(self, JOT_OP_GETGLOBAL, target, jot_CompilerStringConstant(self, atom, offset), offset);
+    }
+}
+
+/*
+    Compiles a call with its callee in the first free register, where
+    results of its results are left (all of them, up to the top, if
+    results is -1). The registers aren't reserved.
+*/
+static void jot_CompileCall(jot_FuncState* self, jot_NodeRef node, int results)
+{
+    jot_Ast* ast = self->compiler->ast;
+    size_t offset = jot_AstOffset(ast, node);
+    unsigned int base = self->free_register;
+    unsigned int object;
+    unsigned int method;
+    unsigned int key;
+    unsigned int arguments;
+    size_t first;
+    size_t count;
+    size_t i;
+    jot_NodeRef argument;
+    
+    if(jot_AstKind(ast, node) == JOT_NODE_METHOD_CALL)
+    {
+        object = jot_CompileAnyRegister(self, jot_AstWord(ast, node, 0));
+        self->free_register = base;
+        jot_CompilerReserve(self, 2, offset);
+        method = jot_CompilerStringConstant(self, jot_AstWord(ast, node, 1), offset);
+        if(method <= 0xFF)
+        {
+            jot_CompilerEmitABC(self, JOT_OP_SELF, base, object, method, offset);
+        }
+        else
+        {
+            jot_CompilerMove(self, base + 1, object, offset);
+            key = jot_CompilerReserve(self, 1, offset);
+            jot_CompilerEmitABX(self, JOT_OP_LOADK, key, method, offset);
+            jot_CompilerEmitABC(self, JOT_OP_GETINDEX, base, base + 1, key, offset);
+            self->free_register = base + 2;
+        }
+        count = jot_AstWord(ast, node, 2);
+        first = 3;
+    }
+    else
+    {
+        jot_CompilerReserve(self, 1, offset);
+        jot_CompileExpression(self, jot_AstWord(ast, node, 0), base);
+        count = jot_AstWord(ast, node, 1);
+        first = 2;
+    }
+    
+    for(i = 0; i < count; i++)
+    {
+        argument = jot_AstWord(ast, node, first + i);
+        if(i == count - 1 && jot_CompileIsMulti(ast, argument))
+        {
+            if(jot_AstKind(ast, argument) == JOT_NODE_VARARG)
+            {
+                jot_CompilerEmitABC(self, JOT_OP_VARARG, self->free_register, 0, 0, jot_AstOffset(ast, argument));
+            }
+            else
+            {
+                jot_CompileCall(self, argument, -1);
+            }
+            self->free_register = base;
+            jot_CompilerEmitABC(self, JOT_OP_CALL, base, 0, (unsigned int) (results + 1), offset);
+            return;
+        }
+        jot_CompileExpression(self, argument, jot_CompilerReserve(self, 1, jot_AstOffset(ast, argument)));
+    }
+    arguments = self->free_register - base;
+    self->free_register = base;
+    jot_CompilerEmitABC(self, JOT_OP_CALL, base, arguments, (unsigned int) (results + 1), offset);
+}
+
+/* Like jot_CompileCall, for anything that gives a variable number of values. */
+static void jot_CompileMultiple(jot_FuncState* self, jot_NodeRef node, int results)
+{
+    jot_Ast* ast = self->compiler->ast;
+    
+    if(jot_AstKind(ast, node) == JOT_NODE_VARARG)
+    {
+        jot_CompilerEmitABC(self, JOT_OP_VARARG, self->free_register, (unsigned int) (results + 1), 0, jot_AstOffset(ast, node));
+    }
+    else
+    {
+        jot_CompileCall(self, node, results);
+    }
+}
+
+/*
+    Puts count values, from word first of node on, into wanted new
+    registers: the last value gives as many as are missing if it can give
+    several, nils make up for any still missing, and values past wanted
+    are worked out and thrown away.
+*/
+static void jot_CompileValues(jot_FuncState* self, jot_NodeRef node, size_t first, size_t count, size_t wanted)
+{
+    jot_Ast* ast = self->compiler->ast;
+    unsigned int free_register;
+    unsigned int target;
+    jot_NodeRef value;
+    size_t offset;
+    size_t i;
+    
+    for(i = 0; i < count; i++)
+    {
+        value = jot_AstWord(ast, node, first + i);
+        offset = jot_AstOffset(ast, value);
+        if(i >= wanted)
+        {
+            free_register = self->free_register;
+            if(jot_CompileIsMulti(ast, value))
+            {
+                jot_CompileMultiple(self, value, 0);
+            }
+            else
+            {
+                jot_CompileExpression(self, value, jot_CompilerReserve(self, 1, offset));
+            }
+            self->free_register = free_register;
+        }
+        else if(i == count - 1 && jot_CompileIsMulti(ast, value) && wanted - i <= JOT_CODE_MAX_REGISTERS)
+        {
+            jot_CompileMultiple(self, value, (int) (wanted - i));
+            jot_CompilerReserve(self, (unsigned int) (wanted - i), offset);
+            return;
+        }
+        else
+        {
+            jot_CompileExpression(self, value, jot_CompilerReserve(self, 1, offset));
+        }
+    }
+    if(count < wanted)
+    {
+        offset = jot_AstOffset(ast, node);
+        if(wanted - count > JOT_CODE_MAX_REGISTERS)
+        {
+            jot_CompilerFail(self->compiler, "function needs too many registers", offset);
+            return;
+        }
+        target = jot_CompilerReserve(self, (unsigned int) (wanted - count), offset);
+        jot_CompilerEmitABC(self, JOT_OP_LOADNIL, target, (unsigned int) (wanted - count - 1), 0, offset);
+    }
+}
+
+static void jot_CompileTable(jot_FuncState* self, jot_NodeRef node, unsigned int target)
+{
+    jot_Ast* ast = self->compiler->ast;
+    size_t count = jot_AstWord(ast, node, 0);
+    unsigned int free_register;
+    unsigned int key;
+    unsigned int value;
+    jot_NodeRef key_node;
+    size_t i;
+    int field;
+    
+    jot_CompilerEmitABC(self, JOT_OP_NEWTABLE, target, count < 0xFF ? (unsigned int) count : 0xFF, 0, jot_AstOffset(ast, node));
+    for(i = 0; i < count; i++)
+    {
+        free_register = self->free_register;
+        key_node = jot_AstWord(ast, node, 1 + i * 2);
+        field = jot_CompileKey(self, key_node, &key);
+        value = jot_CompileAnyRegister(self, jot_AstWord(ast, node, 2 + i * 2));
+        jot_CompilerEmitABC(self, field ? JOT_OP_SETFIELD : JOT_OP_SETINDEX, target, key, value, jot_AstOffset(ast, key_node));
+        self->free_register = free_register;
+    }
+}
+
+/* target has to be the last register reserved, so the elements can go after it. */
+static void jot_CompileArray(jot_FuncState* self, jot_NodeRef node, unsigned int target)
+{
+    jot_Ast* ast = self->compiler->ast;
+    size_t offset = jot_AstOffset(ast, node);
+    size_t count = jot_AstWord(ast, node, 0);
+    unsigned int pending = 0;
+    jot_NodeRef element;
+    size_t i;
+    
+    jot_CompilerEmitABC(self, JOT_OP_NEWARRAY, target, count < 0xFF ? (unsigned int) count : 0xFF, 0, offset);
+    for(i = 0; i < count; i++)
+    {
+        element = jot_AstWord(ast, node, 1 + i);
+        if(i == count - 1 && jot_CompileIsMulti(ast, element))
+        {
+            jot_CompileMultiple(self, element, -1);
+            jot_CompilerEmitABC(self, JOT_OP_APPEND, target, 0, 0, offset);
+            self->free_register = target + 1;
+            return;
+        }
+        jot_CompileExpression(self, element, jot_CompilerReserve(self, 1, jot_AstOffset(ast, element)));
+        if(++pending == JOT_COMPILE_APPEND_BATCH)
+        {
+            jot_CompilerEmitABC(self, JOT_OP_APPEND, target, pending + 1, 0, offset);
+            self->free_register = target + 1;
+            pending = 0;
+        }
+    }
+    if(pending > 0)
+    {
+        jot_CompilerEmitABC(self, JOT_OP_APPEND, target, pending + 1, 0, offset);
+        self->free_register = target + 1;
+    }
+}
+
+/* 'and' and 'or' leave their left side in target if it decides the result. */
+static void jot_CompileLogical(jot_FuncState* self, jot_NodeRef node, unsigned int target)
+{
+    jot_Ast* ast = self->compiler->ast;
+    size_t offset = jot_AstOffset(ast, node);
+    long jump;
+    
+    jot_CompileExpression(self, jot_AstWord(ast, node, 0), target);
+    jot_CompilerEmitABC(self, JOT_OP_TEST, target, 0, jot_AstKind(ast, node) == JOT_NODE_OR, offset);
+    jump = jot_CompilerJump(self, offset);
+    jot_CompileExpression(self, jot_AstWord(ast, node, 1), target);
+    jot_CompilerPatchHere(self, jump);
+}
+
+/*
+    Tables, arrays, 'and' and 'or' write to target before they're done
+    with what's in it, and arrays need the registers after it, so they're
+    built in a new register unless target is the last temporary reserved.
+*/
+static void jot_CompileComposite(jot_FuncState* self, jot_NodeRef node, unsigned int target)
+{
+    jot_Ast* ast = self->compiler->ast;
+    unsigned int temporary;
+    
+    if(self->compiler->failed)
+    {
+        return;
+    }
+    if(target < self->local_count || target + 1 != self->free_register)
+    {
+        temporary = jot_CompilerReserve(self, 1, jot_AstOffset(ast, node));
+        jot_CompileComposite(self, node, temporary);
+        jot_CompilerMove(self, target, temporary, jot_AstOffset(ast, node));
+        self->free_register = temporary;
+        return;
+    }
+    switch(jot_AstKind(ast, node))
+    {
+        case JOT_NODE_TABLE:
+            jot_CompileTable(self, node, target);
+            break;
+        case JOT_NODE_ARRAY:
+            jot_CompileArray(self, node, target);
+            break;
+        default:
+            jot_CompileLogical(self, node, target);
+            break;
+    }
+}
+
+static long jot_CompileJump(jot_FuncState* self, jot_NodeRef node, int when);
+
+/* Emits a comparison and a jump that's taken when its result is when. */
+static long jot_CompileCompare(jot_FuncState* self, jot_NodeRef node, int when)
+{
+    jot_Ast* ast = self->compiler->ast;
+    size_t offset = jot_AstOffset(ast, node);
+    jot_Token op = jot_AstOp(ast, node);
+    jot_NodeRef left = jot_AstWord(ast, node, 0);
+    jot_NodeRef right = jot_AstWord(ast, node, 1);
+    unsigned int free_register = self->free_register;
+    unsigned int a;
+    unsigned int b;
+    long immediate;
+    jot_Op instruction;
+    
+    if(op == JOT_TOKEN_CMP_NE)
+    {
+        op = JOT_TOKEN_CMP_EQ;
+        when = !when;
+    }
+    if(jot_CompileImmediate(ast, right, -JOT_CODE_SB_BIAS, 0xFF - JOT_CODE_SB_BIAS, &immediate))
+    {
+        a = jot_CompileAnyRegister(self, left);
+        instruction = op == JOT_TOKEN_CMP_EQ ? JOT_OP_EQI : op == JOT_TOKEN_CMP_LT ? JOT_OP_LTI
+            : op == JOT_TOKEN_CMP_LE ? JOT_OP_LEI : op == JOT_TOKEN_CMP_GT ? JOT_OP_GTI : JOT_OP_GEI;
+        jot_CompilerEmitABC(self, instruction, a, (unsigned int) (immediate + JOT_CODE_SB_BIAS), (unsigned int) when, offset);
+    }
+    else if(jot_CompileImmediate(ast, left, -JOT_CODE_SB_BIAS, 0xFF - JOT_CODE_SB_BIAS, &immediate))
+    {
+        /* The literal goes on the right, so the comparison turns around. */
+        a = jot_CompileAnyRegister(self, right);
+        instruction = op == JOT_TOKEN_CMP_EQ ? JOT_OP_EQI : op == JOT_TOKEN_CMP_LT ? JOT_OP_GTI
+            : op == JOT_TOKEN_CMP_LE ? JOT_OP_GEI : op == JOT_TOKEN_CMP_GT ? JOT_OP_LTI : JOT_OP_LEI;
+        jot_CompilerEmitABC(self, instruction, a, (unsigned int) (immediate + JOT_CODE_SB_BIAS), (unsigned int) when, offset);
+    }
+    else
+    {
+        a = jot_CompileAnyRegister(self, left);
+        b = jot_CompileAnyRegister(self, right);
+        switch(op)
+        {
+            case JOT_TOKEN_CMP_EQ:
+                jot_CompilerEmitABC(self, JOT_OP_EQ, a, b, (unsigned int) when, offset);
+                break;
+            case JOT_TOKEN_CMP_LT:
+                jot_CompilerEmitABC(self, JOT_OP_LT, a, b, (unsigned int) when, offset);
+                break;
+            case JOT_TOKEN_CMP_LE:
+                jot_CompilerEmitABC(self, JOT_OP_LE, a, b, (unsigned int) when, offset);
+                break;
+            case JOT_TOKEN_CMP_GT:
+                jot_CompilerEmitABC(self, JOT_OP_LT, b, a, (unsigned int) when, offset);
+                break;
+            default:
+                jot_CompilerEmitABC(self, JOT_OP_LE, b, a, (unsigned int) when, offset);
+                break;
+        }
+    }
+    self->free_register = free_register;
+    return jot_CompilerJump(self, offset);
+}
+
+/* Returns a list of jumps that are taken when node's truth is when, and otherwise falls through. */
+static long jot_CompileJump(jot_FuncState* self, jot_NodeRef node, int when)
+{
+    jot_Ast* ast = self->compiler->ast;
+    size_t offset = jot_AstOffset(ast, node);
+    jot_NodeKind kind = jot_AstKind(ast, node);
+    unsigned int free_register = self->free_register;
+    unsigned int value;
+    long jumps;
+    long skip;
+    
+    switch(kind)
+    {
+        case JOT_NODE_NIL:
+        case JOT_NODE_FALSE:
+            return when ? JOT_COMPILE_NO_JUMP : jot_CompilerJump(self, offset);
+        case JOT_NODE_TRUE:
+        case JOT_NODE_INT:
+        case JOT_NODE_NUM:
+        case JOT_NODE_STR:
+            return when ? jot_CompilerJump(self, offset) : JOT_COMPILE_NO_JUMP;
+        case JOT_NODE_UNARY:
+            if(jot_AstOp(ast, node) == JOT_TOKEN_EXCLAIM)
+            {
+                return jot_CompileJump(self, jot_AstWord(ast, node, 0), !when);
+            }
+            break;
+        case JOT_NODE_AND:
+        case JOT_NODE_OR:
+            /* 'and' jumps when false if either side is, 'or' when true if either side is. */
+            if(when == (kind == JOT_NODE_OR))
+            {
+                jumps = jot_CompileJump(self, jot_AstWord(ast, node, 0), when);
+                jot_CompilerConcatJumps(self, &jumps, jot_CompileJump(self, jot_AstWord(ast, node, 1), when));
+                return jumps;
+            }
+            skip = jot_CompileJump(self, jot_AstWord(ast, node, 0), !when);
+            jumps = jot_CompileJump(self, jot_AstWord(ast, node, 1), when);
+            jot_CompilerPatchHere(self, skip);
+            return jumps;
+        case JOT_NODE_BINARY:
+            if(jot_CompileIsComparison(jot_AstOp(ast, node)))
+            {
+                return jot_CompileCompare(self, node, when);
+            }
+            break;
+        default:
+            break;
+    }
+    value = jot_CompileAnyRegister(self, node);
+    self->free_register = free_register;
+    jot_CompilerEmitABC(self, JOT_OP_TEST, value, 0, (unsigned int) when, offset);
+    return jot_CompilerJump(self, offset);
+}
+
+static jot_Op jot_CompileBinaryOp(jot_Token op)
+{
+    switch(op)
+    {
+        case JOT_TOKEN_ADD:
+            return JOT_OP_ADD;
+        case JOT_TOKEN_SUB:
+            return JOT_OP_SUB;
+        case JOT_TOKEN_MUL:
+            return JOT_OP_MUL;
+        case JOT_TOKEN_DIV:
+            return JOT_OP_DIV;
+        case JOT_TOKEN_MOD:
+            return JOT_OP_MOD;
+        case JOT_TOKEN_EXP:
+            return JOT_OP_POW;
+        case JOT_TOKEN_AND:
+            return JOT_OP_BAND;
+        case JOT_TOKEN_OR:
+            return JOT_OP_BOR;
+        case JOT_TOKEN_XOR:
+            return JOT_OP_BXOR;
+        case JOT_TOKEN_SHL:
+            return JOT_OP_SHL;
+        case JOT_TOKEN_SHR:
+            return JOT_OP_SHR;
+        default:
+            return JOT_OP_CONCAT;
+    }
+}
+
+static void jot_CompileBinary(jot_FuncState* self, jot_NodeRef node, unsigned int target)
+{
+    jot_Ast* ast = self->compiler->ast;
+    size_t offset = jot_AstOffset(ast, node);
+    jot_Token op = jot_AstOp(ast, node);
+    jot_NodeRef left = jot_AstWord(ast, node, 0);
+    jot_NodeRef right = jot_AstWord(ast, node, 1);
+    unsigned int free_register = self->free_register;
+    unsigned int a;
+    unsigned int b;
+    long immediate;
+    long jumps;
+    long jump;
+    
+    if(jot_CompileIsComparison(op))
+    {
+        jumps = jot_CompileCompare(self, node, 0);
+        jot_CompilerEmitABC(self, JOT_OP_LOADTRUE, target, 0, 0, offset);
+        jump = jot_CompilerJump(self, offset);
+        jot_CompilerPatchHere(self, jumps);
+        jot_CompilerEmitABC(self, JOT_OP_LOADFALSE, target, 0, 0, offset);
+        jot_CompilerPatchHere(self, jump);
+        return;
+    }
+    
+    /* Adding or taking away a small integer doesn't need it in a register. */
+    if((op == JOT_TOKEN_ADD && jot_CompileImmediate(ast, right, -JOT_CODE_SB_BIAS, 0xFF - JOT_CODE_SB_BIAS, &immediate))
+        || (op == JOT_TOKEN_SUB && jot_CompileImmediate(ast, right, JOT_CODE_SB_BIAS - 0xFF, JOT_CODE_SB_BIAS, &immediate)))
+    {
+        a = jot_CompileAnyRegister(self, left);
+        self->free_register = free_register;
+        jot_CompilerEmitABC(self, JOT_OP_ADDI, target, a, (unsigned int) ((op == JOT_TOKEN_SUB ? -immediate : immediate) + JOT_CODE_SB_BIAS), offset);
+        return;
+    }
+    if(op == JOT_TOKEN_ADD && jot_CompileImmediate(ast, left, -JOT_CODE_SB_BIAS, 0xFF - JOT_CODE_SB_BIAS, &immediate))
+    {
+        a = jot_CompileAnyRegister(self, right);
+        self->free_register = free_register;
+        jot_CompilerEmitABC(self, JOT_OP_ADDI, target, a, (unsigned int) (immediate + JOT_CODE_SB_BIAS), offset);
+        return;
+    }
+    
+    a = jot_CompileAnyRegister(self, left);
+    b = jot_CompileAnyRegister(self, right);
+    self->free_register = free_register;
+    jot_CompilerEmitABC(self, jot_CompileBinaryOp(op), target, a, b, offset);
+}
+
+static unsigned int jot_CompileFunction(jot_FuncState* parent, jot_NodeRef node);
+
+/* Puts the value of node in target, which may be a local's register. */
+static void jot_CompileExpression(jot_FuncState* self, jot_NodeRef node, unsigned int target)
+{
+    jot_Ast* ast = self->compiler->ast;
+    size_t offset = jot_AstOffset(ast, node);
+    unsigned int free_register = self->free_register;
+    unsigned int object;
+    unsigned int key;
+    jot_Value value;
+    int64_t integer;
+    int field;
+    jot_Token op;
+    
+    if(self->compiler->failed)
+    {
+        return;
+    }
+    switch(jot_AstKind(ast, node))
+    {
+        case JOT_NODE_NIL:
+            jot_CompilerEmitABC(self, JOT_OP_LOADNIL, target, 0, 0, offset);
+            break;
+        case JOT_NODE_TRUE:
+            jot_CompilerEmitABC(self, JOT_OP_LOADTRUE, target, 0, 0, offset);
+            break;
+        case JOT_NODE_FALSE:
+            jot_CompilerEmitABC(self, JOT_OP_LOADFALSE, target, 0, 0, offset);
+            break;
+        case JOT_NODE_VARARG:
+            jot_CompilerEmitABC(self, JOT_OP_VARARG, target, 2, 0, offset);
+            break;
+        case JOT_NODE_INT:
+            integer = jot_AstInt(ast, node);
+            if(integer >= -JOT_CODE_SBX_BIAS && integer <= JOT_CODE_MAX_BX - JOT_CODE_SBX_BIAS)
+            {
+                jot_CompilerEmitABX(self, JOT_OP_LOADI, target, (unsigned int) (integer + JOT_CODE_SBX_BIAS), offset);
+            }
+            else
+            {
+                if(!jot_ValueSetInt(self->compiler->heap, &value, integer))
+                {
+                    jot_CompilerFail(self->compiler, "out of memory", offset);
+                    return;
+                }
+                jot_CompilerLoadConstant(self, target, value, offset);
+            }
+            break;
+        case JOT_NODE_NUM:
+            JOT_SET_NUM(&value, jot_AstNum(ast, node));
+            jot_CompilerLoadConstant(self, target, value, offset);
+            break;
+        case JOT_NODE_STR:
+            jot_CompilerEmitABX(self, JOT_OP_LOADK, target, jot_CompilerStringConstant(self, jot_AstWord(ast, node, 0), offset), offset);
+            break;
+        case JOT_NODE_NAME:
+            jot_CompileName(self, node, target);
+            break;
+        case JOT_NODE_FUNC:
+            jot_CompilerEmitABX(self, JOT_OP_CLOSURE, target, jot_CompileFunction(self, node), offset);
+            break;
+        case JOT_NODE_TABLE:
+        case JOT_NODE_ARRAY:
+        case JOT_NODE_AND:
+        case JOT_NODE_OR:
+            jot_CompileComposite(self, node, target);
+            break;
+        case JOT_NODE_INDEX:
+            object = jot_CompileAnyRegister(self, jot_AstWord(ast, node, 0));
+            field = jot_CompileKey(self, jot_AstWord(ast, node, 1), &key);
+            self->free_register = free_register;
+            jot_CompilerEmitABC(self, field ? JOT_OP_GETFIELD : JOT_OP_GETINDEX, target, object, key, offset);
+            break;
+        case JOT_NODE_CALL:
+        case JOT_NODE_METHOD_CALL:
+            if(target + 1 == self->free_register && target >= self->local_count)
+            {
+                /* The call can go right in target. */
+                self->free_register = target;
+                jot_CompileCall(self, node, 1);
+                self->free_register = target + 1;
+            }
+            else
+            {
+                jot_CompileCall(self, node, 1);
+                jot_CompilerMove(self, target, self->free_register, offset);
+            }
+            break;
+        case JOT_NODE_UNARY:
+            op = jot_AstOp(ast, node);
+            object = jot_CompileAnyRegister(self, jot_AstWord(ast, node, 0));
+            self->free_register = free_register;
+            jot_CompilerEmitABC(self, op == JOT_TOKEN_SUB ? JOT_OP_UNM : op == JOT_TOKEN_TILDE ? JOT_OP_BNOT : JOT_OP_NOT,
+                target, object, 0, offset);
+            break;
+        case JOT_NODE_BINARY:
+            jot_CompileBinary(self, node, target);
+            break;
+        default:
+            jot_CompilerFail(self->compiler, "expected an expression", offset);
+            break;
+    }
+}
+
+/* Stores register value into a name, or into the object and key already worked out for an index. */
+static void jot_CompileStore(jot_FuncState* self, jot_NodeRef target, unsigned int value, unsigned int object, unsigned int key, int field)
+{
+    jot_Ast* ast = self->compiler->ast;
+    size_t offset = jot_AstOffset(ast, target);
+    uint32_t atom;
+    long local;
+    long upvalue;
+    
+    if(jot_AstKind(ast, target) == JOT_NODE_INDEX)
+    {
+        jot_CompilerEmitABC(self, field ? JOT_OP_SETFIELD : JOT_OP_SETINDEX, object, key, value, offset);
+        return;
+    }
+    atom = jot_AstWord(ast, target, 0);
+    local = jot_CompilerFindLocal(self, atom);
+    if(local >= 0)
+    {
+        jot_CompilerMove(self, (unsigned int) local, value, offset);
+        return;
+    }
+    upvalue = jot_CompilerFindUpvalue(self, atom, offset);
+    if(upvalue >= 0)
+    {
+        jot_CompilerEmitABC(self, JOT_OP_SETUPVAL, value, (unsigned int) upvalue, 0, offset);
+    }
+    else
+    {
+        jot_CompilerEmitABX(self, JOT_OP_SETGLOBAL, value, jot_CompilerStringConstant(self, atom, offset), offset);
+    }
+}
+
+static void jot_CompileAssign(jot_FuncState* self, jot_NodeRef node)
+{
+    jot_Ast* ast = self->compiler->ast;
+    size_t target_count = jot_AstWord(ast, node, 0);
+    size_t value_count = jot_AstWord(ast, node, 1);
+    unsigned int objects[JOT_CODE_MAX_REGISTERS];
+    unsigned int keys[JOT_CODE_MAX_REGISTERS];
+    int fields[JOT_CODE_MAX_REGISTERS];
+    unsigned int base;
+    jot_NodeRef target;
+    long local;
+    size_t i;
+    
+    objects[0] = 0;
+    keys[0] = 0;
+    fields[0] = 0;
+    if(target_count == 1 && value_count == 1)
+    {
+        target = jot_AstWord(ast, node, 2);
+        if(jot_AstKind(ast, target) == JOT_NODE_NAME)
+        {
+            local = jot_CompilerFindLocal(self, jot_AstWord(ast, target, 0));
+            if(local >= 0)
+            {
+                jot_CompileExpression(self, jot_AstWord(ast, node, 3), (unsigned int) local);
+                return;
+            }
+        }
+        else
+        {
+            objects[0] = jot_CompileAnyRegister(self, jot_AstWord(ast, target, 0));
+            fields[0] = jot_CompileKey(self, jot_AstWord(ast, target, 1), &keys[0]);
+        }
+        jot_CompileStore(self, target, jot_CompileAnyRegister(self, jot_AstWord(ast, node, 3)), objects[0], keys[0], fields[0]);
+        return;
+    }
+    
+    if(target_count > JOT_CODE_MAX_REGISTERS)
+    {
+        jot_CompilerFail(self->compiler, "function needs too many registers", jot_AstOffset(ast, node));
+        return;
+    }
+    /* Objects and keys are worked out first, then all the values, then they're stored last to first. */
+    for(i = 0; i < target_count; i++)
+    {
+        target = jot_AstWord(ast, node, 2 + i);
+        objects[i] = 0;
+        keys[i] = 0;
+        fields[i] = 0;
+        if(jot_AstKind(ast, target) == JOT_NODE_INDEX)
+        {
+            objects[i] = jot_CompileAnyRegister(self, jot_AstWord(ast, target, 0));
+            fields[i] = jot_CompileKey(self, jot_AstWord(ast, target, 1), &keys[i]);
+        }
+    }
+    base = self->free_register;
+    jot_CompileValues(self, node, 2 + target_count, value_count, target_count);
+    i = target_count;
+    while(i > 0 && !self->compiler->failed)
+    {
+        i--;
+        jot_CompileStore(self, jot_AstWord(ast, node, 2 + i), base + (unsigned int) i, objects[i], keys[i], fields[i]);
+    }
+}
+
+static void jot_CompileReturn(jot_FuncState* self, jot_NodeRef node)
+{
+    jot_Ast* ast = self->compiler->ast;
+    size_t offset = jot_AstOffset(ast, node);
+    size_t count = jot_AstWord(ast, node, 0);
+    unsigned int base = self->free_register;
+    jot_NodeRef last;
+    
+    if(count == 0)
+    {
+        jot_CompilerEmitABC(self, JOT_OP_RETURN, 0, 1, 0, offset);
+        return;
+    }
+    last = jot_AstWord(ast, node, count);
+    if(count == 1 && !jot_CompileIsMulti(ast, last))
+    {
+        jot_CompilerEmitABC(self, JOT_OP_RETURN, jot_CompileAnyRegister(self, last), 2, 0, offset);
+        return;
+    }
+    if(jot_CompileIsMulti(ast, last))
+    {
+        jot_CompileValues(self, node, 1, count - 1, count - 1);
+        jot_CompileMultiple(self, last, -1);
+        jot_CompilerEmitABC(self, JOT_OP_RETURN, base, 0, 0, offset);
+    }
+    else
+    {
+        jot_CompileValues(self, node, 1, count, count);
+        jot_CompilerEmitABC(self, JOT_OP_RETURN, base, (unsigned int) count + 1, 0, offset);
+    }
+}
+
+/* Puts locals made after level out of scope, closing them if they were captured and close is set. */
+static void jot_CompilerLeaveScope(jot_FuncState* self, unsigned int level, int close, size_t offset)
+{
+    unsigned int i;
+    
+    for(i = level; close && i < self->local_count; i++)
+    {
+        if(self->locals[i].captured)
+        {
+            jot_CompilerEmitABC(self, JOT_OP_CLOSE, level, 0, 0, offset);
+            break;
+        }
+    }
+    self->local_count = level;
+    self->free_register = level;
+}
+
+static void jot_CompileBlock(jot_FuncState* self, jot_NodeRef block)
+{
+    unsigned int level = self->local_count;
+    
+    jot_CompileStatements(self, block);
+    jot_CompilerLeaveScope(self, level, 1, jot_AstOffset(self->compiler->ast, block));
+}
+
+static void jot_CompileIf(jot_FuncState* self, jot_NodeRef node)
+{
+    jot_Ast* ast = self->compiler->ast;
+    size_t offset = jot_AstOffset(ast, node);
+    size_t count = jot_AstWord(ast, node, 0);
+    jot_NodeRef otherwise = jot_AstWord(ast, node, 1 + count * 2);
+    long ends = JOT_COMPILE_NO_JUMP;
+    long skip;
+    size_t i;
+    
+    for(i = 0; i < count; i++)
+    {
+        skip = jot_CompileJump(self, jot_AstWord(ast, node, 1 + i * 2), 0);
+        jot_CompileBlock(self, jot_AstWord(ast, node, 2 + i * 2));
+        if(i < count - 1 || otherwise)
+        {
+            jot_CompilerConcatJumps(self, &ends, jot_CompilerJump(self, offset));
+        }
+        jot_CompilerPatchHere(self, skip);
+    }
+    if(otherwise)
+    {
+        jot_CompileBlock(self, otherwise);
+    }
+    jot_CompilerPatchHere(self, ends);
+}
+
+static void jot_CompilerEnterLoop(jot_FuncState* self, jot_CompileLoop* loop)
+{
+    loop->previous = self->loop;
+    loop->local_count = self->local_count;
+    loop->captured = 0;
+    loop->breaks = JOT_COMPILE_NO_JUMP;
+    loop->continues = JOT_COMPILE_NO_JUMP;
+    self->loop = loop;
+}
+
+/*
+    Ends the body of a loop that goes back to start: continue comes here,
+    and the locals made in the body are closed before going around again,
+    if any were captured, so each time around gets new ones.
+*/
+static void jot_CompilerLoopBack(jot_FuncState* self, jot_CompileLoop* loop, size_t start, size_t offset)
+{
+    jot_CompilerPatchHere(self, loop->continues);
+    if(loop->captured)
+    {
+        jot_CompilerEmitABC(self, JOT_OP_CLOSE, loop->local_count, 0, 0, offset);
+    }
+    jot_CompilerPatchJumps(self, jot_CompilerJump(self, offset), start);
+}
+
+/* Lands the loop's breaks here, along with exits, which also close what the body captured. */
+static void jot_CompilerLeaveLoop(jot_FuncState* self, jot_CompileLoop* loop, long exits, size_t offset)
+{
+    jot_CompilerConcatJumps(self, &exits, loop->breaks);
+    jot_CompilerPatchHere(self, exits);
+    if(loop->captured)
+    {
+        jot_CompilerEmitABC(self, JOT_OP_CLOSE, loop->local_count, 0, 0, offset);
+    }
+    self->loop = loop->previous;
+}
+
+static void jot_CompileWhile(jot_FuncState* self, jot_NodeRef node)
+{
+    jot_Ast* ast = self->compiler->ast;
+    size_t offset = jot_AstOffset(ast, node);
+    size_t start = self->code_count;
+    jot_CompileLoop loop;
+    long exits;
+    
+    exits = jot_CompileJump(self, jot_AstWord(ast, node, 0), 0);
+    jot_CompilerEnterLoop(self, &loop);
+    jot_CompileStatements(self, jot_AstWord(ast, node, 1));
+    jot_CompilerLeaveScope(self, loop.local_count, 0, offset);
+    jot_CompilerLoopBack(self, &loop, start, offset);
+    jot_CompilerLeaveLoop(self, &loop, exits, offset);
+}
+
+/* The condition can see the body's locals, and continue goes to it. */
+static void jot_CompileRepeat(jot_FuncState* self, jot_NodeRef node)
+{
+    jot_Ast* ast = self->compiler->ast;
+    size_t offset = jot_AstOffset(ast, node);
+    size_t start = self->code_count;
+    jot_CompileLoop loop;
+    long again;
+    long exits;
+    
+    jot_CompilerEnterLoop(self, &loop);
+    jot_CompileStatements(self, jot_AstWord(ast, node, 0));
+    jot_CompilerPatchHere(self, loop.continues);
+    loop.continues = JOT_COMPILE_NO_JUMP;
+    again = jot_CompileJump(self, jot_AstWord(ast, node, 1), 0);
+    jot_CompilerLeaveScope(self, loop.local_count, 0, offset);
+    if(loop.captured)
+    {
+        exits = jot_CompilerJump(self, offset);
+        jot_CompilerPatchHere(self, again);
+        jot_CompilerLoopBack(self, &loop, start, offset);
+    }
+    else
+    {
+        exits = JOT_COMPILE_NO_JUMP;
+        jot_CompilerPatchJumps(self, again, start);
+    }
+    jot_CompilerLeaveLoop(self, &loop, exits, offset);
+}
+
+/* The iterable and the loop's state are kept in two registers of its own, just below the names. */
+static void jot_CompileFor(jot_FuncState* self, jot_NodeRef node)
+{
+    jot_Ast* ast = self->compiler->ast;
+    size_t offset = jot_AstOffset(ast, node);
+    size_t count = jot_AstWord(ast, node, 2);
+    unsigned int base = self->free_register;
+    jot_CompileLoop loop;
+    size_t start;
+    long exits;
+    size_t i;
+    
+    jot_CompileExpression(self, jot_AstWord(ast, node, 0), jot_CompilerReserve(self, 1, offset));
+    jot_CompilerDeclare(self, JOT_AST_NO_ATOM);
+    jot_CompilerEmitABC(self, JOT_OP_LOADNIL, jot_CompilerReserve(self, 1, offset), 0, 0, offset);
+    jot_CompilerDeclare(self, JOT_AST_NO_ATOM);
+    if(count > JOT_CODE_MAX_REGISTERS)
+    {
+        jot_CompilerFail(self->compiler, "function needs too many registers", offset);
+        return;
+    }
+    
+    jot_CompilerEnterLoop(self, &loop);
+    start = jot_CompilerEmit(self, JOT_CODE_ABC(JOT_OP_FORNEXT, base, 0, count), offset);
+    exits = jot_CompilerJump(self, offset);
+    jot_CompilerReserve(self, (unsigned int) count, offset);
+    for(i = 0; i < count; i++)
+    {
+        jot_CompilerDeclare(self, jot_AstWord(ast, node, 3 + i));
+    }
+    jot_CompileStatements(self, jot_AstWord(ast, node, 1));
+    jot_CompilerLeaveScope(self, loop.local_count, 0, offset);
+    jot_CompilerLoopBack(self, &loop, start, offset);
+    jot_CompilerLeaveLoop(self, &loop, exits, offset);
+    jot_CompilerLeaveScope(self, base, 0, offset);
+}
+
+static void jot_CompileStatement(jot_FuncState* self, jot_NodeRef node)
+{
+    jot_Ast* ast = self->compiler->ast;
+    size_t offset = jot_AstOffset(ast, node);
+    size_t count;
+    size_t i;
+    
+    switch(jot_AstKind(ast, node))
+    {
+        case JOT_NODE_VAR:
+            count = jot_AstWord(ast, node, 0);
+            jot_CompileValues(self, node, 2 + count, jot_AstWord(ast, node, 1), count);
+            for(i = 0; i < count; i++)
+            {
+                jot_CompilerDeclare(self, jot_AstWord(ast, node, 2 + i));
+            }
+            break;
+        case JOT_NODE_ASSIGN:
+            jot_CompileAssign(self, node);
+            break;
+        case JOT_NODE_IF:
+            jot_CompileIf(self, node);
+            break;
+        case JOT_NODE_WHILE:
+            jot_CompileWhile(self, node);
+            break;
+        case JOT_NODE_REPEAT:
+            jot_CompileRepeat(self, node);
+            break;
+        case JOT_NODE_FOR:
+            jot_CompileFor(self, node);
+            break;
+        case JOT_NODE_BREAK:
+            jot_CompilerConcatJumps(self, &self->loop->breaks, jot_CompilerJump(self, offset));
+            break;
+        case JOT_NODE_CONTINUE:
+            jot_CompilerConcatJumps(self, &self->loop->continues, jot_CompilerJump(self, offset));
+            break;
+        case JOT_NODE_RETURN:
+            jot_CompileReturn(self, node);
+            break;
+        case JOT_NODE_BLOCK:
+            jot_CompileBlock(self, node);
+            break;
+        case JOT_NODE_CALL:
+        case JOT_NODE_METHOD_CALL:
+            jot_CompileCall(self, node, 0);
+            break;
+        default:
+            jot_CompilerFail(self->compiler, "expected a statement", offset);
+            break;
+    }
+    self->free_register = self->local_count;
+}
+
+static void jot_CompileStatements(jot_FuncState* self, jot_NodeRef block)
+{
+    jot_Ast* ast = self->compiler->ast;
+    size_t count = jot_AstWord(ast, block, 0);
+    size_t i;
+    
+    for(i = 0; i < count && !self->compiler->failed; i++)
+    {
+        jot_CompileStatement(self, jot_AstWord(ast, block, 1 + i));
+    }
+}
+
+static jot_FuncState* jot_CompilerBegin(jot_Compiler* compiler, jot_FuncState* parent, size_t offset)
+{
+    jot_FuncState* self = (jot_FuncState*) jot_Alloc(compiler->heap->allocator, JOT_ALLOC_CODE, sizeof(jot_FuncState));
+    
+    if(self == NULL)
+    {
+        jot_CompilerFail(compiler, "out of memory", offset);
+        return NULL;
+    }
+    self->parent = parent;
+    self->compiler = compiler;
+    self->vararg = 0;
+    self->code = NULL;
+    self->offsets = NULL;
+    self->code_count = 0;
+    self->code_capacity = 0;
+    self->offset_capacity = 0;
+    self->constants = NULL;
+    self->constant_count = 0;
+    self->constant_capacity = 0;
+    self->constant_slots = NULL;
+    self->constant_slot_capacity = 0;
+    self->protos = NULL;
+    self->proto_count = 0;
+    self->proto_capacity = 0;
+    self->upvalue_count = 0;
+    self->local_count = 0;
+    self->free_register = 0;
+    self->register_count = 0;
+    self->loop = NULL;
+    return self;
+}
+
+/* Frees whatever jot_CompilerFinish didn't hand over to a proto. */
+static void jot_CompilerEnd(jot_FuncState* self)
+{
+    jot_Heap* heap = self->compiler->heap;
+    
+    jot_HeapRelease(heap, JOT_ALLOC_CODE, self->code, self->code_capacity * sizeof(jot_Instruction));
+    jot_HeapRelease(heap, JOT_ALLOC_CODE, self->offsets, self->offset_capacity * sizeof(uint32_t));
+    jot_HeapRelease(heap, JOT_ALLOC_CODE, self->constants, self->constant_capacity * sizeof(jot_Value));
+    jot_HeapRelease(heap, JOT_ALLOC_CODE, self->constant_slots, self->constant_slot_capacity * sizeof(size_t));
+    jot_HeapRelease(heap, JOT_ALLOC_CODE, self->protos, self->proto_capacity * sizeof(jot_Proto*));
+    jot_Free(heap->allocator, JOT_ALLOC_CODE, self, sizeof(jot_FuncState));
+}
+
+/* Cuts an array down to exactly count items, as protos keep them. Returns NULL if it's empty or memory runs out. */
+static void* jot_CompilerShrink(jot_Compiler* self, void* items, size_t* capacity, size_t count, size_t size)
+{
+    void* result;
+    
+    if(count == 0)
+    {
+        jot_HeapRelease(self->heap, JOT_ALLOC_CODE, items, *capacity * size);
+        *capacity = 0;
+        return NULL;
+    }
+    if(count == *capacity)
+    {
+        return items;
+    }
+    result = jot_HeapResize(self->heap, JOT_ALLOC_CODE, items, *capacity * size, count * size);
+    if(result != NULL)
+    {
+        *capacity = count;
+    }
+    return result;
+}
+
+static jot_Proto* jot_CompilerFinish(jot_FuncState* self, uint32_t name, unsigned int param_count, size_t offset)
+{
+    jot_Compiler* compiler = self->compiler;
+    jot_Proto* proto;
+    void* items;
+    
+    if(compiler->failed || (proto = jot_ProtoNew(compiler->heap)) == NULL)
+    {
+        jot_CompilerFail(compiler, "out of memory", offset);
+        return NULL;
+    }
+    if((items = jot_CompilerShrink(compiler, self->code, &self->code_capacity, self->code_count, sizeof(jot_Instruction))) != NULL)
+    {
+        self->code = (jot_Instruction*) items;
+    }
+    if((items = jot_CompilerShrink(compiler, self->offsets, &self->offset_capacity, self->code_count, sizeof(uint32_t))) != NULL)
+    {
+        self->offsets = (uint32_t*) items;
+    }
+    if(self->code_capacity != self->code_count || self->offset_capacity != self->code_count)
+    {
+        jot_CompilerFail(compiler, "out of memory", offset);
+        return NULL;
+    }
+    self->constants = (jot_Value*) jot_CompilerShrink(compiler, self->constants, &self->constant_capacity, self->constant_count, sizeof(jot_Value));
+    self->protos = (jot_Proto**) jot_CompilerShrink(compiler, self->protos, &self->proto_capacity, self->proto_count, sizeof(jot_Proto*));
+    if(self->upvalue_count > 0)
+    {
+        proto->upvalues = (unsigned char*) jot_HeapResize(compiler->heap, JOT_ALLOC_CODE, NULL, 0, self->upvalue_count * 2);
+        if(proto->upvalues != NULL)
+        {
+            memcpy(proto->upvalues, self->upvalues, self->upvalue_count * 2);
+            proto->upvalue_count = self->upvalue_count;
+        }
+    }
+    if((self->constant_count > 0 && self->constants == NULL) || (self->proto_count > 0 && self->protos == NULL)
+        || proto->upvalue_count != self->upvalue_count)
+    {
+        jot_CompilerFail(compiler, "out of memory", offset);
+        return NULL;
+    }
+    
+    proto->code = self->code;
+    proto->offsets = self->offsets;
+    proto->code_count = self->code_count;
+    proto->constants = self->constants;
+    proto->constant_count = self->constant_count;
+    proto->protos = self->protos;
+    proto->proto_count = self->proto_count;
+    proto->param_count = param_count;
+    proto->register_count = self->register_count;
+    proto->vararg = self->vararg;
+    proto->name = name == JOT_AST_NO_ATOM ? NULL : jot_CompilerString(compiler, name, offset);
+    proto->source = compiler->source;
+    self->code = NULL;
+    self->offsets = NULL;
+    self->code_capacity = 0;
+    self->offset_capacity = 0;
+    self->constants = NULL;
+    self->constant_capacity = 0;
+    self->protos = NULL;
+    self->proto_capacity = 0;
+    return proto;
+}
+
+static unsigned int jot_CompileFunction(jot_FuncState* parent, jot_NodeRef node)
+{
+    jot_Compiler* compiler = parent->compiler;
+    jot_Ast* ast = compiler->ast;
+    size_t offset = jot_AstOffset(ast, node);
+    unsigned int flags = jot_AstFlags(ast, node);
+    jot_NodeRef body = jot_AstWord(ast, node, 2);
+    size_t count = jot_AstWord(ast, node, 4);
+    const jot_Atom* self_atom;
+    jot_FuncState* state;
+    jot_Proto* proto;
+    jot_Proto** protos;
+    unsigned int param_count;
+    size_t i;
+    
+    if(compiler->failed)
+    {
+        return 0;
+    }
+    if(!body && (body = jot_AstFunctionBody(ast, node, compiler->error)) == 0)
+    {
+        compiler->failed = 1;
+        return 0;
+    }
+    state = jot_CompilerBegin(compiler, parent, offset);
+    if(state == NULL)
+    {
+        return 0;
+    }
+    
+    state->vararg = (flags & JOT_FUNC_VARARG) != 0;
+    if(flags & JOT_FUNC_METHOD)
+    {
+        self_atom = jot_AtomTableFind(ast->atoms, "self", 4, jot_StrHash("self", 4));
+        jot_CompilerReserve(state, 1, offset);
+        jot_CompilerDeclare(state, self_atom != NULL ? self_atom->id : JOT_AST_NO_ATOM);
+    }
+    for(i = 0; i < count; i++)
+    {
+        jot_CompilerReserve(state, 1, offset);
+        jot_CompilerDeclare(state, jot_AstWord(ast, node, 5 + i));
+    }
+    param_count = state->local_count;
+    jot_CompileStatements(state, body);
+    jot_CompilerEmitABC(state, JOT_OP_RETURN, 0, 1, 0, jot_AstWord(ast, node, 1));
+    proto = jot_CompilerFinish(state, jot_AstWord(ast, node, 3), param_count, offset);
+    jot_CompilerEnd(state);
+    
+    if(proto == NULL)
+    {
+        return 0;
+    }
+    if(parent->proto_count > JOT_CODE_MAX_BX)
+    {
+        jot_CompilerFail(compiler, "function has too many functions in it", offset);
+        return 0;
+    }
+    protos = (jot_Proto**) jot_CompilerGrow(compiler, parent->protos, &parent->proto_capacity, parent->proto_count, sizeof(jot_Proto*));
+    if(protos == NULL)
+    {
+        jot_CompilerFail(compiler, "out of memory", offset);
+        return 0;
+    }
+    parent->protos = protos;
+    parent->protos[parent->proto_count] = proto;
+    return (unsigned int) parent->proto_count++;
+}
+
+jot_Proto* jot_Compile(jot_Heap* heap, jot_Ast* ast, jot_String* source, jot_ParseError* error)
+{
+    jot_Compiler compiler;
+    jot_FuncState* state;
+    jot_Proto* proto = NULL;
+    
+    compiler.heap = heap;
+    compiler.ast = ast;
+    compiler.source = source;
+    compiler.error = error;
+    compiler.failed = 0;
+    compiler.strings = NULL;
+    compiler.string_capacity = 0;
+    error->message = NULL;
+    error->offset = 0;
+    error->length = 0;
+    
+    state = jot_CompilerBegin(&compiler, NULL, 0);
+    if(state != NULL)
+    {
+        state->vararg = 1;
+        jot_CompileStatements(state, ast->root);
+        jot_CompilerEmitABC(state, JOT_OP_RETURN, 0, 1, 0, ast->size);
+        proto = jot_CompilerFinish(state, JOT_AST_NO_ATOM, 0, ast->size);
+        jot_CompilerEnd(state);
+    }
+    jot_Free(heap->allocator, JOT_ALLOC_CODE, compiler.strings, compiler.string_capacity * sizeof(jot_String*));
+    return compiler.failed ? NULL : proto;
+}
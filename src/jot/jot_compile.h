@@ -0,0 +1,60 @@
+/*
+    jot - Compiler
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#ifndef JOT_COMPILE_H
+#define JOT_COMPILE_H
+
+#include "jot_func.h"
+#include "jot_parse.h"
+#include "jot_value.h"
+
+/*
+    Compiles a parsed source into register bytecode (see jot_code.h), as a
+    function that takes '...' and nothing else. Locals live in registers,
+    numbered in the order they come into scope, with temporaries above
+    them; names that aren't locals of any enclosing function are globals.
+    
+    Bodies that lazy parsing skipped are parsed as they're reached, so the
+    whole source is compiled up front, not as each function is first
+    called. That's on purpose: a function's CLOSURE instruction has to say
+    which of its parent's locals it captures, which can't be known without
+    parsing its body, and once that's been done, compiling it too costs
+    little next to keeping the text and the AST around until it's called.
+    Nothing is folded here; fold the AST first (and any lazy bodies with
+    it) if it should be.
+    
+    Returns NULL, with error filled in, if a function needs more registers,
+    constants or upvalues than its instructions can address, a skipped
+    body has a syntax error, or memory runs out. Every proto made comes
+    out of heap, and stays alive while it can be reached from a closure or
+    from the function being compiled. The collector only runs while a VM
+    runs a script, so the proto returned has to be made into a closure
+    before then. The rest, including all of them on failure, are freed by
+    its next cycle or with the heap.
+*/
+jot_Proto* jot_Compile(jot_Heap* heap, jot_Ast* ast, jot_String* source, jot_ParseError* error);
+
+#endif
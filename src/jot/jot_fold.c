@@ -0,0 +1,737 @@
+/*
+    jot - Constant Folding
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+
+#include <string.h>
+
+#include "jot_fold.h"
+#include "jot_num.h"
+
+enum
+{
+    JOT_FOLD_MIN_CAPACITY = 64
+};
+
+/* A name in scope, and which binding it refers to. */
+typedef struct
+{
+    uint32_t atom;
+    size_t binding;
+} jot_FoldName;
+
+typedef struct
+{
+    /* Whether it's ever assigned to after it's made. */
+    int assigned;
+    /* The literal it always holds, or 0. */
+    jot_NodeRef value;
+} jot_FoldBinding;
+
+/*
+    The tree is walked twice, in the same order. The first walk only
+    numbers the bindings and notes which are ever assigned to; the second
+    folds, knowing which bindings will always hold their first value.
+*/
+typedef struct
+{
+    jot_Ast* ast;
+    int folding;
+    int failed;
+    
+    size_t scope_count;
+    size_t scope_capacity;
+    jot_FoldName* scope;
+    
+    /* Bindings made so far on this walk. */
+    size_t binding_count;
+    size_t binding_capacity;
+    jot_FoldBinding* bindings;
+} jot_Folder;
+
+static jot_NodeRef jot_FoldExpression(jot_Folder* self, jot_NodeRef node);
+static void jot_FoldBlock(jot_Folder* self, jot_NodeRef block);
+
+static void jot_FolderSetWord(jot_Folder* self, jot_NodeRef node, size_t index, uint32_t word)
+{
+    self->ast->words[node + 2 + index] = word;
+}
+
+/* Folds the child at word index of node, and points node at what it folds into. */
+static void jot_FoldChild(jot_Folder* self, jot_NodeRef node, size_t index)
+{
+    jot_FolderSetWord(self, node, index, jot_FoldExpression(self, jot_AstWord(self->ast, node, index)));
+}
+
+static void jot_FoldChildren(jot_Folder* self, jot_NodeRef node, size_t first, size_t count)
+{
+    size_t i;
+    for(i = 0; i < count; i++)
+    {
+        jot_FoldChild(self, node, first + i);
+    }
+}
+
+/* Makes a binding for atom, visible until the scope it's in is left. */
+static size_t jot_FolderBind(jot_Folder* self, uint32_t atom)
+{
+    size_t binding = self->binding_count;
+    
+    if(self->binding_count == self->binding_capacity)
+    {
+        size_t capacity = self->binding_capacity * 2;
+        jot_FoldBinding* bindings = jot_Realloc(self->ast->allocator, JOT_ALLOC_PARSE, self->bindings,
+            self->binding_capacity * sizeof(jot_FoldBinding), capacity * sizeof(jot_FoldBinding));
+        if(bindings == NULL)
+        {
+            self->failed = 1;
+            return (size_t) -1;
+        }
+        self->bindings = bindings;
+        self->binding_capacity = capacity;
+    }
+    if(self->scope_count == self->scope_capacity)
+    {
+        size_t capacity = self->scope_capacity * 2;
+        jot_FoldName* scope = jot_Realloc(self->ast->allocator, JOT_ALLOC_PARSE, self->scope,
+            self->scope_capacity * sizeof(jot_FoldName), capacity * sizeof(jot_FoldName));
+        if(scope == NULL)
+        {
+            self->failed = 1;
+            return (size_t) -1;
+        }
+        self->scope = scope;
+        self->scope_capacity = capacity;
+    }
+    
+    if(!self->folding)
+    {
+        self->bindings[binding].assigned = 0;
+        self->bindings[binding].value = 0;
+    }
+    self->binding_count++;
+    self->scope[self->scope_count].atom = atom;
+    self->scope[self->scope_count].binding = binding;
+    self->scope_count++;
+    return binding;
+}
+
+/* Makes a binding that's given a new value each time it's entered, so is never constant. */
+static void jot_FolderBindVariable(jot_Folder* self, uint32_t atom)
+{
+    size_t binding = jot_FolderBind(self, atom);
+    
+    if(binding != (size_t) -1)
+    {
+        self->bindings[binding].assigned = 1;
+    }
+}
+
+/* Returns the binding atom refers to here, or -1 if it's a global. */
+static size_t jot_FolderLookup(const jot_Folder* self, uint32_t atom)
+{
+    size_t i;
+    for(i = self->scope_count; i > 0; i--)
+    {
+        if(self->scope[i - 1].atom == atom)
+        {
+            return self->scope[i - 1].binding;
+        }
+    }
+    return (size_t) -1;
+}
+
+static int jot_FoldIsLiteral(const jot_Ast* ast, jot_NodeRef node)
+{
+    switch(jot_AstKind(ast, node))
+    {
+        case JOT_NODE_NIL:
+        case JOT_NODE_TRUE:
+        case JOT_NODE_FALSE:
+        case JOT_NODE_INT:
+        case JOT_NODE_NUM:
+        case JOT_NODE_STR:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static int jot_FoldIsTruthy(const jot_Ast* ast, jot_NodeRef node)
+{
+    return jot_AstKind(ast, node) != JOT_NODE_NIL && jot_AstKind(ast, node) != JOT_NODE_FALSE;
+}
+
+/* Words a node has after the first two, for the kinds folding replaces. */
+static size_t jot_FoldRoom(const jot_Ast* ast, jot_NodeRef node)
+{
+    switch(jot_AstKind(ast, node))
+    {
+        case JOT_NODE_BINARY:
+        case JOT_NODE_AND:
+        case JOT_NODE_OR:
+        case JOT_NODE_INT:
+        case JOT_NODE_NUM:
+            return 2;
+        case JOT_NODE_UNARY:
+        case JOT_NODE_NAME:
+        case JOT_NODE_STR:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/*
+    Replaces node with a literal, reported at the same offset. It's
+    overwritten if it has room, and otherwise a new node is made.
+*/
+static jot_NodeRef jot_FolderLiteral(jot_Folder* self, jot_NodeRef node, jot_NodeKind kind, jot_Token op, uint32_t low, uint32_t high)
+{
+    jot_Ast* ast = self->ast;
+    size_t size = kind == JOT_NODE_INT || kind == JOT_NODE_NUM ? 2 : kind == JOT_NODE_STR ? 1 : 0;
+    jot_NodeRef literal = node;
+    
+    if(jot_FoldRoom(ast, node) >= size)
+    {
+        ast->words[node] = (uint32_t) kind | (uint32_t) op << 8;
+    }
+    else if((literal = jot_AstAppend(ast, kind, op, 0, jot_AstOffset(ast, node), size)) == 0)
+    {
+        self->failed = 1;
+        return node;
+    }
+    if(size > 0)
+    {
+        jot_FolderSetWord(self, literal, 0, low);
+    }
+    if(size > 1)
+    {
+        jot_FolderSetWord(self, literal, 1, high);
+    }
+    return literal;
+}
+
+static jot_NodeRef jot_FolderInt(jot_Folder* self, jot_NodeRef node, int64_t value)
+{
+    uint64_t bits = (uint64_t) value;
+    return jot_FolderLiteral(self, node, JOT_NODE_INT, JOT_TOKEN_INT, (uint32_t) bits, (uint32_t) (bits >> 32));
+}
+
+static jot_NodeRef jot_FolderNum(jot_Folder* self, jot_NodeRef node, double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return jot_FolderLiteral(self, node, JOT_NODE_NUM, JOT_TOKEN_NONE, (uint32_t) bits, (uint32_t) (bits >> 32));
+}
+
+static jot_NodeRef jot_FolderBool(jot_Folder* self, jot_NodeRef node, int value)
+{
+    return jot_FolderLiteral(self, node, value ? JOT_NODE_TRUE : JOT_NODE_FALSE, JOT_TOKEN_NONE, 0, 0);
+}
+
+/* Copies literal over node, leaving literal itself alone, since other names may share it. */
+static jot_NodeRef jot_FolderCopy(jot_Folder* self, jot_NodeRef node, jot_NodeRef literal)
+{
+    jot_NodeKind kind = jot_AstKind(self->ast, literal);
+    uint32_t low = kind == JOT_NODE_NIL || kind == JOT_NODE_TRUE || kind == JOT_NODE_FALSE ? 0 : jot_AstWord(self->ast, literal, 0);
+    uint32_t high = kind == JOT_NODE_INT || kind == JOT_NODE_NUM ? jot_AstWord(self->ast, literal, 1) : 0;
+    return jot_FolderLiteral(self, node, kind, jot_AstOp(self->ast, literal), low, high);
+}
+
+/* Whether node is a number, and its value as a double (and as an integer, if it is one). */
+static int jot_FoldNumber(const jot_Ast* ast, jot_NodeRef node, int* integer, int64_t* int_value, double* num_value)
+{
+    switch(jot_AstKind(ast, node))
+    {
+        case JOT_NODE_INT:
+            *integer = 1;
+            *int_value = jot_AstInt(ast, node);
+            *num_value = (double) *int_value;
+            return 1;
+        case JOT_NODE_NUM:
+            *integer = 0;
+            *num_value = jot_AstNum(ast, node);
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/*
+    Works out base ** exponent if it's an integer small enough that every
+    step of working it out is exact, which any pow gives exactly too.
+*/
+static int jot_FoldPower(double base, double exponent, double* result)
+{
+    const double limit = 9007199254740992.0;
+    double value = 1.0;
+    int i;
+    
+    if(!(base >= -limit && base <= limit) || base != (double) (int64_t) base
+        || !(exponent >= 0.0 && exponent <= 64.0) || exponent != (double) (int) exponent)
+    {
+        return 0;
+    }
+    for(i = 0; i < (int) exponent; i++)
+    {
+        value *= base;
+        if(value < -limit || value > limit)
+        {
+            return 0;
+        }
+    }
+    *result = value;
+    return 1;
+}
+
+static jot_NodeRef jot_FoldUnary(jot_Folder* self, jot_NodeRef node)
+{
+    jot_Ast* ast = self->ast;
+    jot_NodeRef operand = jot_AstWord(ast, node, 0);
+    
+    if(!jot_FoldIsLiteral(ast, operand))
+    {
+        return node;
+    }
+    switch(jot_AstOp(ast, node))
+    {
+        case JOT_TOKEN_EXCLAIM:
+            return jot_FolderBool(self, node, !jot_FoldIsTruthy(ast, operand));
+        /* No literal is shared, so a number can be negated where it is, rather than in a new node. */
+        case JOT_TOKEN_SUB:
+            if(jot_AstKind(ast, operand) == JOT_NODE_INT)
+            {
+                return jot_FolderInt(self, operand, (int64_t) (0 - (uint64_t) jot_AstInt(ast, operand)));
+            }
+            if(jot_AstKind(ast, operand) == JOT_NODE_NUM)
+            {
+                return jot_FolderNum(self, operand, -jot_AstNum(ast, operand));
+            }
+            return node;
+        case JOT_TOKEN_TILDE:
+            if(jot_AstKind(ast, operand) == JOT_NODE_INT)
+            {
+                return jot_FolderInt(self, operand, ~jot_AstInt(ast, operand));
+            }
+            return node;
+        default:
+            return node;
+    }
+}
+
+/* == and != on two literals, or -1 if it can't be told without running it. */
+static int jot_FoldEqual(const jot_Ast* ast, jot_NodeRef left, jot_NodeRef right)
+{
+    jot_NodeKind kind = jot_AstKind(ast, left);
+    
+    if(kind != jot_AstKind(ast, right))
+    {
+        /* An integer and a float are compared by value. */
+        if((kind == JOT_NODE_INT || kind == JOT_NODE_NUM)
+            && (jot_AstKind(ast, right) == JOT_NODE_INT || jot_AstKind(ast, right) == JOT_NODE_NUM))
+        {
+            return -1;
+        }
+        return 0;
+    }
+    switch(kind)
+    {
+        case JOT_NODE_INT:
+            return jot_AstInt(ast, left) == jot_AstInt(ast, right);
+        case JOT_NODE_NUM:
+            return jot_AstNum(ast, left) == jot_AstNum(ast, right);
+        case JOT_NODE_STR:
+            return jot_AstWord(ast, left, 0) == jot_AstWord(ast, right, 0);
+        default:
+            return 1;
+    }
+}
+
+/* left .. right, for two strings. */
+static jot_NodeRef jot_FoldConcat(jot_Folder* self, jot_NodeRef node, jot_NodeRef left, jot_NodeRef right)
+{
+    const jot_Atom* a = jot_AstAtom(self->ast, left);
+    const jot_Atom* b = jot_AstAtom(self->ast, right);
+    size_t length = a->length + b->length;
+    const jot_Atom* atom;
+    char* text;
+    
+    if(length < a->length || (text = jot_Alloc(self->ast->allocator, JOT_ALLOC_PARSE, length + 1)) == NULL)
+    {
+        self->failed = 1;
+        return node;
+    }
+    memcpy(text, a->text, a->length);
+    memcpy(text + a->length, b->text, b->length);
+    atom = jot_AtomTableIntern(self->ast->atoms, text, length, jot_StrHash(text, length));
+    jot_Free(self->ast->allocator, JOT_ALLOC_PARSE, text, length + 1);
+    if(atom == NULL)
+    {
+        self->failed = 1;
+        return node;
+    }
+    return jot_FolderLiteral(self, node, JOT_NODE_STR, JOT_TOKEN_NONE, atom->id, 0);
+}
+
+static jot_NodeRef jot_FoldBinary(jot_Folder* self, jot_NodeRef node)
+{
+    jot_Ast* ast = self->ast;
+    jot_Token op = jot_AstOp(ast, node);
+    jot_NodeRef left = jot_AstWord(ast, node, 0);
+    jot_NodeRef right = jot_AstWord(ast, node, 1);
+    int left_integer, right_integer;
+    int64_t a = 0, b = 0;
+    double x, y, z;
+    int equal;
+    
+    if(!jot_FoldIsLiteral(ast, left) || !jot_FoldIsLiteral(ast, right))
+    {
+        return node;
+    }
+    if(op == JOT_TOKEN_CMP_EQ || op == JOT_TOKEN_CMP_NE)
+    {
+        equal = jot_FoldEqual(ast, left, right);
+        return equal < 0 ? node : jot_FolderBool(self, node, equal == (op == JOT_TOKEN_CMP_EQ));
+    }
+    if(op == JOT_TOKEN_DOT_DOT)
+    {
+        if(jot_AstKind(ast, left) == JOT_NODE_STR && jot_AstKind(ast, right) == JOT_NODE_STR)
+        {
+            return jot_FoldConcat(self, node, left, right);
+        }
+        return node;
+    }
+    if(!jot_FoldNumber(ast, left, &left_integer, &a, &x) || !jot_FoldNumber(ast, right, &right_integer, &b, &y))
+    {
+        return node;
+    }
+    
+    if(left_integer && right_integer)
+    {
+        switch(op)
+        {
+            case JOT_TOKEN_ADD:
+                return jot_FolderInt(self, node, (int64_t) ((uint64_t) a + (uint64_t) b));
+            case JOT_TOKEN_SUB:
+                return jot_FolderInt(self, node, (int64_t) ((uint64_t) a - (uint64_t) b));
+            case JOT_TOKEN_MUL:
+                return jot_FolderInt(self, node, (int64_t) ((uint64_t) a * (uint64_t) b));
+            case JOT_TOKEN_MOD:
+                /* Dividing by zero is an error, left for when it's run. */
+                return b == 0 ? node : jot_FolderInt(self, node, jot_NumMod(a, b));
+            case JOT_TOKEN_AND:
+                return jot_FolderInt(self, node, a & b);
+            case JOT_TOKEN_OR:
+                return jot_FolderInt(self, node, a | b);
+            case JOT_TOKEN_XOR:
+                return jot_FolderInt(self, node, a ^ b);
+            case JOT_TOKEN_SHL:
+                return jot_FolderInt(self, node, jot_NumShiftLeft(a, b));
+            case JOT_TOKEN_SHR:
+                return jot_FolderInt(self, node, b <= -64 ? 0 : jot_NumShiftLeft(a, -b));
+            case JOT_TOKEN_CMP_LT:
+                return jot_FolderBool(self, node, a < b);
+            case JOT_TOKEN_CMP_LE:
+                return jot_FolderBool(self, node, a <= b);
+            case JOT_TOKEN_CMP_GT:
+                return jot_FolderBool(self, node, a > b);
+            case JOT_TOKEN_CMP_GE:
+                return jot_FolderBool(self, node, a >= b);
+            default:
+                break;
+        }
+    }
+    
+    switch(op)
+    {
+        case JOT_TOKEN_ADD:
+            return jot_FolderNum(self, node, x + y);
+        case JOT_TOKEN_SUB:
+            return jot_FolderNum(self, node, x - y);
+        case JOT_TOKEN_MUL:
+            return jot_FolderNum(self, node, x * y);
+        case JOT_TOKEN_DIV:
+            /* Infinities and NaNs are left to be made at run time. */
+            return y == 0.0 ? node : jot_FolderNum(self, node, x / y);
+        case JOT_TOKEN_EXP:
+            return jot_FoldPower(x, y, &z) ? jot_FolderNum(self, node, z) : node;
+        case JOT_TOKEN_CMP_LT:
+        case JOT_TOKEN_CMP_LE:
+        case JOT_TOKEN_CMP_GT:
+        case JOT_TOKEN_CMP_GE:
+            /* A mix of integers and floats is compared exactly, which a double can't always do. */
+            if(left_integer || right_integer)
+            {
+                return node;
+            }
+            return jot_FolderBool(self, node, op == JOT_TOKEN_CMP_LT ? x < y : op == JOT_TOKEN_CMP_LE ? x <= y
+                : op == JOT_TOKEN_CMP_GT ? x > y : x >= y);
+        default:
+            /* Bitwise operators on floats, and % on them, are left for run time. */
+            return node;
+    }
+}
+
+static jot_NodeRef jot_FoldFunction(jot_Folder* self, jot_NodeRef node)
+{
+    jot_Ast* ast = self->ast;
+    jot_NodeRef body = jot_AstWord(ast, node, 2);
+    size_t scope_count = self->scope_count;
+    size_t count = jot_AstWord(ast, node, 4);
+    const jot_Atom* self_atom;
+    size_t i;
+    size_t j;
+    
+    if(!body)
+    {
+        /* There's no telling what it assigns to until it's parsed. */
+        if(!self->folding)
+        {
+            for(i = 0; i < self->scope_count; i++)
+            {
+                self->bindings[self->scope[i].binding].assigned = 1;
+            }
+        }
+        return node;
+    }
+    if(jot_AstFlags(ast, node) & JOT_FUNC_METHOD)
+    {
+        /* If nothing is called self, nothing can refer to it. */
+        self_atom = jot_AtomTableFind(ast->atoms, "self", 4, jot_StrHash("self", 4));
+        if(self_atom != NULL)
+        {
+            jot_FolderBindVariable(self, self_atom->id);
+        }
+    }
+    for(i = 0, j = 5; i < count; i++, j++)
+    {
+        jot_FolderBindVariable(self, jot_AstWord(ast, node, j));
+    }
+    jot_FoldBlock(self, body);
+    self->scope_count = scope_count;
+    return node;
+}
+
+static jot_NodeRef jot_FoldExpression(jot_Folder* self, jot_NodeRef node)
+{
+    jot_Ast* ast = self->ast;
+    size_t binding;
+    
+    switch(jot_AstKind(ast, node))
+    {
+        case JOT_NODE_NAME:
+            binding = jot_FolderLookup(self, jot_AstWord(ast, node, 0));
+            if(self->folding && binding != (size_t) -1 && !self->bindings[binding].assigned && self->bindings[binding].value)
+            {
+                return jot_FolderCopy(self, node, self->bindings[binding].value);
+            }
+            return node;
+        case JOT_NODE_FUNC:
+            return jot_FoldFunction(self, node);
+        case JOT_NODE_TABLE:
+            jot_FoldChildren(self, node, 1, jot_AstWord(ast, node, 0) * 2);
+            return node;
+        case JOT_NODE_ARRAY:
+            jot_FoldChildren(self, node, 1, jot_AstWord(ast, node, 0));
+            return node;
+        case JOT_NODE_INDEX:
+            jot_FoldChildren(self, node, 0, 2);
+            return node;
+        case JOT_NODE_CALL:
+            jot_FoldChild(self, node, 0);
+            jot_FoldChildren(self, node, 2, jot_AstWord(ast, node, 1));
+            return node;
+        case JOT_NODE_METHOD_CALL:
+            jot_FoldChild(self, node, 0);
+            jot_FoldChildren(self, node, 3, jot_AstWord(ast, node, 2));
+            return node;
+        case JOT_NODE_UNARY:
+            jot_FoldChild(self, node, 0);
+            return self->folding ? jot_FoldUnary(self, node) : node;
+        case JOT_NODE_BINARY:
+            jot_FoldChildren(self, node, 0, 2);
+            return self->folding ? jot_FoldBinary(self, node) : node;
+        case JOT_NODE_AND:
+        case JOT_NODE_OR:
+            jot_FoldChildren(self, node, 0, 2);
+            if(self->folding && jot_FoldIsLiteral(ast, jot_AstWord(ast, node, 0)))
+            {
+                /* 'and' gives its left side if that's false, 'or' if it's true, and otherwise the right. */
+                if(jot_FoldIsTruthy(ast, jot_AstWord(ast, node, 0)) == (jot_AstKind(ast, node) == JOT_NODE_OR))
+                {
+                    return jot_AstWord(ast, node, 0);
+                }
+                return jot_AstWord(ast, node, 1);
+            }
+            return node;
+        default:
+            return node;
+    }
+}
+
+/* Walks the statements of block without a scope of their own. */
+static void jot_FoldStatements(jot_Folder* self, jot_NodeRef block)
+{
+    jot_Ast* ast = self->ast;
+    size_t count = jot_AstWord(ast, block, 0);
+    size_t i;
+    size_t j;
+    size_t names;
+    size_t values;
+    size_t binding;
+    size_t scope_count;
+    jot_NodeRef statement;
+    jot_NodeRef value;
+    
+    for(i = 0; i < count; i++)
+    {
+        statement = jot_AstWord(ast, block, 1 + i);
+        switch(jot_AstKind(ast, statement))
+        {
+            case JOT_NODE_BLOCK:
+                jot_FoldBlock(self, statement);
+                break;
+            case JOT_NODE_VAR:
+                /* The values are worked out before the names come into scope. */
+                names = jot_AstWord(ast, statement, 0);
+                values = jot_AstWord(ast, statement, 1);
+                jot_FoldChildren(self, statement, 2 + names, values);
+                for(j = 0; j < names; j++)
+                {
+                    binding = jot_FolderBind(self, jot_AstWord(ast, statement, 2 + j));
+                    value = j < values ? jot_AstWord(ast, statement, 2 + names + j) : 0;
+                    if(self->folding && binding != (size_t) -1 && value && jot_FoldIsLiteral(ast, value))
+                    {
+                        self->bindings[binding].value = value;
+                    }
+                }
+                break;
+            case JOT_NODE_ASSIGN:
+                names = jot_AstWord(ast, statement, 0);
+                values = jot_AstWord(ast, statement, 1);
+                for(j = 0; j < names; j++)
+                {
+                    value = jot_AstWord(ast, statement, 2 + j);
+                    if(jot_AstKind(ast, value) == JOT_NODE_NAME)
+                    {
+                        binding = jot_FolderLookup(self, jot_AstWord(ast, value, 0));
+                        if(!self->folding && binding != (size_t) -1)
+                        {
+                            self->bindings[binding].assigned = 1;
+                        }
+                    }
+                    else
+                    {
+                        jot_FoldChildren(self, value, 0, 2);
+                    }
+                }
+                jot_FoldChildren(self, statement, 2 + names, values);
+                break;
+            case JOT_NODE_IF:
+                names = jot_AstWord(ast, statement, 0);
+                for(j = 0; j < names; j++)
+                {
+                    jot_FoldChild(self, statement, 1 + j * 2);
+                    jot_FoldBlock(self, jot_AstWord(ast, statement, 2 + j * 2));
+                }
+                if(jot_AstWord(ast, statement, 1 + names * 2))
+                {
+                    jot_FoldBlock(self, jot_AstWord(ast, statement, 1 + names * 2));
+                }
+                break;
+            case JOT_NODE_WHILE:
+                jot_FoldChild(self, statement, 0);
+                jot_FoldBlock(self, jot_AstWord(ast, statement, 1));
+                break;
+            case JOT_NODE_REPEAT:
+                /* The condition can see what the body declares. */
+                scope_count = self->scope_count;
+                jot_FoldStatements(self, jot_AstWord(ast, statement, 0));
+                jot_FoldChild(self, statement, 1);
+                self->scope_count = scope_count;
+                break;
+            case JOT_NODE_FOR:
+                jot_FoldChild(self, statement, 0);
+                scope_count = self->scope_count;
+                names = jot_AstWord(ast, statement, 2);
+                for(j = 0; j < names; j++)
+                {
+                    jot_FolderBindVariable(self, jot_AstWord(ast, statement, 3 + j));
+                }
+                jot_FoldBlock(self, jot_AstWord(ast, statement, 1));
+                self->scope_count = scope_count;
+                break;
+            case JOT_NODE_RETURN:
+                jot_FoldChildren(self, statement, 1, jot_AstWord(ast, statement, 0));
+                break;
+            default:
+                jot_FolderSetWord(self, block, 1 + i, jot_FoldExpression(self, statement));
+                break;
+        }
+    }
+}
+
+static void jot_FoldBlock(jot_Folder* self, jot_NodeRef block)
+{
+    size_t scope_count = self->scope_count;
+    jot_FoldStatements(self, block);
+    self->scope_count = scope_count;
+}
+
+int jot_Fold(jot_Ast* ast, jot_NodeRef block)
+{
+    jot_Folder folder;
+    
+    folder.ast = ast;
+    folder.folding = 0;
+    folder.failed = 0;
+    folder.scope_count = 0;
+    folder.scope_capacity = JOT_FOLD_MIN_CAPACITY;
+    folder.scope = jot_Alloc(ast->allocator, JOT_ALLOC_PARSE, folder.scope_capacity * sizeof(jot_FoldName));
+    folder.binding_count = 0;
+    folder.binding_capacity = JOT_FOLD_MIN_CAPACITY;
+    folder.bindings = jot_Alloc(ast->allocator, JOT_ALLOC_PARSE, folder.binding_capacity * sizeof(jot_FoldBinding));
+    
+    if(folder.scope != NULL && folder.bindings != NULL)
+    {
+        jot_FoldBlock(&folder, block);
+        /* Without knowing every assignment, nothing can be folded safely. */
+        if(!folder.failed)
+        {
+            folder.folding = 1;
+            folder.binding_count = 0;
+            jot_FoldBlock(&folder, block);
+        }
+    }
+    else
+    {
+        folder.failed = 1;
+    }
+    
+    jot_Free(ast->allocator, JOT_ALLOC_PARSE, folder.scope, folder.scope_capacity * sizeof(jot_FoldName));
+    jot_Free(ast->allocator, JOT_ALLOC_PARSE, folder.bindings, folder.binding_capacity * sizeof(jot_FoldBinding));
+    return !folder.failed;
+}
@@ -0,0 +1,54 @@
+/*
+    jot - Constant Folding
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#ifndef JOT_FOLD_H
+#define JOT_FOLD_H
+
+#include "jot_parse.h"
+
+/*
+    Rewrites the expressions in block (the root of an AST, or the body of a
+    function) that only involve literals into the literal they always come
+    out as, so they aren't worked out again every time they're run:
+    
+    - arithmetic, bitwise operators and comparisons on numbers, where the
+      result is exactly what running them would give (so integers wrap, /
+      and ** give floats, and nothing that would raise an error is folded),
+    - == and != on any literals, and .. on strings,
+    - not, and 'and' and 'or' whose left side is a literal,
+    - names of var bindings that are never assigned to again, and whose
+      value is (or folds into) a literal.
+    
+    A binding that a function which hasn't been parsed yet could see is
+    assumed to be assigned to in there; such bodies are folded when they're
+    parsed, but without the bindings around them.
+    
+    Returns 0 if memory runs out, which leaves the tree partly folded but
+    still meaning the same thing.
+*/
+int jot_Fold(jot_Ast* ast, jot_NodeRef block);
+
+#endif
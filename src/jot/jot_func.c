@@ -0,0 +1,142 @@
+/*
+    jot - Functions
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#include <stddef.h>
+
+#include "jot_func.h"
+
+#define JOT_OPCODE_NAME(name) #name,
+
+static const char* const jot_op_names[JOT_OP_COUNT] =
+{
+    JOT_OPCODES(JOT_OPCODE_NAME)
+};
+
+const char* jot_OpName(jot_Op op)
+{
+    return op < JOT_OP_COUNT ? jot_op_names[op] : "?";
+}
+
+jot_Proto* jot_ProtoNew(jot_Heap* heap)
+{
+    jot_Proto* self = (jot_Proto*) jot_HeapAllocate(heap, JOT_TYPE_PROTO, sizeof(jot_Proto));
+    
+    if(self == NULL)
+    {
+        return NULL;
+    }
+    self->code = NULL;
+    self->offsets = NULL;
+    self->code_count = 0;
+    self->constants = NULL;
+    self->constant_count = 0;
+    self->protos = NULL;
+    self->proto_count = 0;
+    self->upvalues = NULL;
+    self->upvalue_count = 0;
+    self->param_count = 0;
+    self->register_count = 0;
+    self->vararg = 0;
+    self->name = NULL;
+    self->source = NULL;
+    return self;
+}
+
+jot_Upvalue* jot_UpvalueNew(jot_Heap* heap, jot_Value* value, size_t index)
+{
+    jot_Upvalue* self = (jot_Upvalue*) jot_HeapAllocate(heap, JOT_TYPE_UPVALUE, sizeof(jot_Upvalue));
+    
+    if(self == NULL)
+    {
+        return NULL;
+    }
+    self->value = value;
+    self->index = index;
+    self->next_open = NULL;
+    JOT_SET_NIL(&self->closed);
+    return self;
+}
+
+static size_t jot_ClosureSize(size_t upvalue_count)
+{
+    return offsetof(jot_Closure, upvalues) + (upvalue_count > 0 ? upvalue_count : 1) * sizeof(jot_Upvalue*);
+}
+
+jot_Closure* jot_ClosureNew(jot_Heap* heap, jot_Proto* proto)
+{
+    jot_Closure* self = (jot_Closure*) jot_HeapAllocate(heap, JOT_TYPE_FUNC, jot_ClosureSize(proto->upvalue_count));
+    size_t i;
+    
+    if(self == NULL)
+    {
+        return NULL;
+    }
+    self->proto = proto;
+    self->upvalue_count = proto->upvalue_count;
+    for(i = 0; i < proto->upvalue_count; i++)
+    {
+        self->upvalues[i] = NULL;
+    }
+    return self;
+}
+
+jot_Native* jot_NativeNew(jot_Heap* heap, const char* name, jot_NativeFunction* function)
+{
+    jot_Native* self = (jot_Native*) jot_HeapAllocate(heap, JOT_TYPE_NATIVE, sizeof(jot_Native));
+    
+    if(self == NULL)
+    {
+        return NULL;
+    }
+    self->function = function;
+    self->name = name;
+    return self;
+}
+
+void jot_ProtoFree(jot_Heap* heap, jot_Proto* self)
+{
+    jot_HeapRelease(heap, JOT_ALLOC_CODE, self->code, self->code_count * sizeof(jot_Instruction));
+    jot_HeapRelease(heap, JOT_ALLOC_CODE, self->offsets, self->code_count * sizeof(uint32_t));
+    jot_HeapRelease(heap, JOT_ALLOC_CODE, self->constants, self->constant_count * sizeof(jot_Value));
+    jot_HeapRelease(heap, JOT_ALLOC_CODE, self->protos, self->proto_count * sizeof(jot_Proto*));
+    jot_HeapRelease(heap, JOT_ALLOC_CODE, self->upvalues, self->upvalue_count * 2);
+    jot_HeapFreeObject(heap, &self->object, sizeof(jot_Proto));
+}
+
+void jot_UpvalueFree(jot_Heap* heap, jot_Upvalue* self)
+{
+    jot_HeapFreeObject(heap, &self->object, sizeof(jot_Upvalue));
+}
+
+void jot_ClosureFree(jot_Heap* heap, jot_Closure* self)
+{
+    jot_HeapFreeObject(heap, &self->object, jot_ClosureSize(self->upvalue_count));
+}
+
+void jot_NativeFree(jot_Heap* heap, jot_Native* self)
+{
+    jot_HeapFreeObject(heap, &self->object, sizeof(jot_Native));
+}
@@ -0,0 +1,129 @@
+/*
+    jot - Functions
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#ifndef JOT_FUNC_H
+#define JOT_FUNC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "jot_code.h"
+#include "jot_str.h"
+#include "jot_value.h"
+
+/* A compiled function, which closures are made from. */
+typedef struct jot_Proto
+{
+    jot_Object object;
+    
+    jot_Instruction* code;
+    /* The source offset each instruction was compiled from, for errors. */
+    uint32_t* offsets;
+    size_t code_count;
+    
+    jot_Value* constants;
+    size_t constant_count;
+    
+    /* The functions defined in this one, for CLOSURE. */
+    struct jot_Proto** protos;
+    size_t proto_count;
+    
+    /*
+        Two bytes per upvalue: 1 if it's a register of the enclosing
+        function or 0 if it's one of its upvalues, then which.
+    */
+    unsigned char* upvalues;
+    size_t upvalue_count;
+    
+    /* Counting self, for methods. */
+    unsigned int param_count;
+    unsigned int register_count;
+    int vararg;
+    
+    /* The name it was defined with, or NULL, and the source it was in. */
+    jot_String* name;
+    jot_String* source;
+} jot_Proto;
+
+/*
+    A variable that a closure captured. While the variable is in scope,
+    value points at its register on the VM's stack; once it goes out of
+    scope, the upvalue is closed and value points at closed instead.
+*/
+typedef struct jot_Upvalue
+{
+    jot_Object object;
+    jot_Value* value;
+    /* While open, where the register is on the stack, and the next open upvalue further down it. */
+    size_t index;
+    struct jot_Upvalue* next_open;
+    jot_Value closed;
+} jot_Upvalue;
+
+typedef struct
+{
+    jot_Object object;
+    jot_Proto* proto;
+    size_t upvalue_count;
+    jot_Upvalue* upvalues[1];
+} jot_Closure;
+
+typedef struct jot_Vm jot_Vm;
+
+/*
+    A function written in C. It's given count arguments at args, and
+    writes its results over them, from args[0]; there's always room for
+    JOT_NATIVE_MIN_RESULTS. Returns how many results there are, or -1
+    after jot_VmFail.
+*/
+typedef int jot_NativeFunction(jot_Vm* vm, jot_Value* args, int count);
+
+enum
+{
+    JOT_NATIVE_MIN_RESULTS = 8
+};
+
+typedef struct
+{
+    jot_Object object;
+    jot_NativeFunction* function;
+    /* A static string. */
+    const char* name;
+} jot_Native;
+
+/* These return NULL if memory runs out. A new proto has nothing in it yet. */
+jot_Proto* jot_ProtoNew(jot_Heap* heap);
+jot_Upvalue* jot_UpvalueNew(jot_Heap* heap, jot_Value* value, size_t index);
+/* The upvalues start out NULL, to be filled in. */
+jot_Closure* jot_ClosureNew(jot_Heap* heap, jot_Proto* proto);
+jot_Native* jot_NativeNew(jot_Heap* heap, const char* name, jot_NativeFunction* function);
+
+void jot_ProtoFree(jot_Heap* heap, jot_Proto* self);
+void jot_UpvalueFree(jot_Heap* heap, jot_Upvalue* self);
+void jot_ClosureFree(jot_Heap* heap, jot_Closure* self);
+void jot_NativeFree(jot_Heap* heap, jot_Native* self);
+
+#endif
@@ -0,0 +1,549 @@
+/*
+    jot - Garbage Collector
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#include <time.h>
+
+#include "jot_array.h"
+#include "jot_func.h"
+#include "jot_gc.h"
+#include "jot_str.h"
+#include "jot_table.h"
+
+enum
+{
+    JOT_GC_MIN_GRAY = 256
+};
+
+static double jot_GcNow(const jot_Gc* gc)
+{
+    if(gc->clock != NULL)
+    {
+        return gc->clock();
+    }
+    return (double) clock() / CLOCKS_PER_SEC;
+}
+
+/* Pushes an object to scan from position on. If there isn't room, it's left gray for a walk over the heap to find instead. */
+static void jot_GcPush(jot_Heap* heap, jot_Object* object, size_t position)
+{
+    jot_GcGrayStack* stack = &heap->gc.gray;
+    jot_GcGray* items;
+    size_t capacity;
+    
+    if(stack->count == stack->capacity)
+    {
+        capacity = stack->capacity ? stack->capacity * 2 : JOT_GC_MIN_GRAY;
+        items = (jot_GcGray*) jot_Realloc(heap->allocator, JOT_ALLOC_GC, stack->items,
+            stack->capacity * sizeof(jot_GcGray), capacity * sizeof(jot_GcGray));
+        if(items == NULL)
+        {
+            object->color = JOT_GC_GRAY;
+            heap->gc.overflowed = 1;
+            return;
+        }
+        stack->items = items;
+        stack->capacity = capacity;
+    }
+    stack->items[stack->count].object = object;
+    stack->items[stack->count].position = position;
+    stack->count++;
+}
+
+static void jot_GcMark(jot_Heap* heap, jot_Object* object)
+{
+    if(object->color != JOT_GC_WHITE)
+    {
+        return;
+    }
+    switch(object->type)
+    {
+        /* Nothing in these refers to anything else, so there's nothing to scan. */
+        case JOT_TYPE_STR:
+        case JOT_TYPE_NATIVE:
+        case JOT_TYPE_INT_BOX:
+            object->color = JOT_GC_BLACK;
+            break;
+        default:
+            object->color = JOT_GC_GRAY;
+            jot_GcPush(heap, object, 0);
+            break;
+    }
+}
+
+static void jot_GcMarkValue(jot_Heap* heap, jot_Value value)
+{
+    if(JOT_IS_OBJECT(value))
+    {
+        jot_GcMark(heap, JOT_AS_OBJECT(value));
+    }
+}
+
+/*
+    Marks what an object refers to, from position on, doing no more than
+    about work of it, and returns how much it did. A table, array or proto
+    too big to get through is pushed again, to carry on from where it got
+    to.
+*/
+static size_t jot_GcScan(jot_Heap* heap, jot_Object* object, size_t position, size_t work)
+{
+    const jot_Table* table;
+    const jot_Array* array;
+    const jot_Closure* closure;
+    const jot_Proto* proto;
+    size_t total, end;
+    size_t i;
+    
+    switch(object->type)
+    {
+        case JOT_TYPE_TABLE:
+            table = (const jot_Table*) object;
+            /* The array part and then the hash part, as one run of positions. */
+            total = table->array_size + table->capacity;
+            if(position >= total)
+            {
+                return 1;
+            }
+            end = total - position > work ? position + work : total;
+            for(i = position; i < end && i < table->array_size; i++)
+            {
+                jot_GcMarkValue(heap, table->items[i]);
+            }
+            for(; i < end; i++)
+            {
+                /* Removed keys are still compared against until the table is rehashed. */
+                if(table->distances[i - table->array_size] != 0)
+                {
+                    jot_GcMarkValue(heap, table->entries[i - table->array_size].key);
+                    jot_GcMarkValue(heap, table->entries[i - table->array_size].value);
+                }
+            }
+            if(end < total)
+            {
+                jot_GcPush(heap, object, end);
+            }
+            return end - position + 1;
+        case JOT_TYPE_ARRAY:
+            array = (const jot_Array*) object;
+            /* Packed ints, floats and bools are never objects. */
+            if(array->kind != JOT_ARRAY_VALUES || position >= array->count)
+            {
+                return 1;
+            }
+            end = array->count - position > work ? position + work : array->count;
+            for(i = position; i < end; i++)
+            {
+                jot_GcMarkValue(heap, array->items.values[i]);
+            }
+            if(end < array->count)
+            {
+                jot_GcPush(heap, object, end);
+            }
+            return end - position + 1;
+        case JOT_TYPE_FUNC:
+            closure = (const jot_Closure*) object;
+            jot_GcMark(heap, &closure->proto->object);
+            for(i = 0; i < closure->upvalue_count; i++)
+            {
+                if(closure->upvalues[i] != NULL)
+                {
+                    jot_GcMark(heap, &closure->upvalues[i]->object);
+                }
+            }
+            return 1 + closure->upvalue_count;
+        case JOT_TYPE_PROTO:
+            proto = (const jot_Proto*) object;
+            /* The constants and then the protos, as one run of positions, with the names after the last. */
+            total = proto->constant_count + proto->proto_count;
+            end = total - position > work ? position + work : total;
+            for(i = position; i < end && i < proto->constant_count; i++)
+            {
+                jot_GcMarkValue(heap, proto->constants[i]);
+            }
+            for(; i < end; i++)
+            {
+                if(proto->protos[i - proto->constant_count] != NULL)
+                {
+                    jot_GcMark(heap, &proto->protos[i - proto->constant_count]->object);
+                }
+            }
+            if(end < total)
+            {
+                jot_GcPush(heap, object, end);
+                return end - position + 1;
+            }
+            if(proto->name != NULL)
+            {
+                jot_GcMark(heap, &proto->name->object);
+            }
+            if(proto->source != NULL)
+            {
+                jot_GcMark(heap, &proto->source->object);
+            }
+            return end - position + 1;
+        case JOT_TYPE_UPVALUE:
+            jot_GcMarkValue(heap, *((const jot_Upvalue*) object)->value);
+            return 1;
+        default:
+            return 1;
+    }
+}
+
+/* Scans gray objects until there are none left or work runs out, and returns how much was done. */
+static size_t jot_GcPropagate(jot_Heap* heap, size_t work)
+{
+    jot_GcGrayStack* stack = &heap->gc.gray;
+    jot_GcGray gray;
+    size_t done = 0;
+    
+    while(done < work && stack->count > 0)
+    {
+        gray = stack->items[--stack->count];
+        /* One that's being carried on with is left as it is, in case it's been moved around and has to be started over. */
+        if(gray.position == 0)
+        {
+            gray.object->color = JOT_GC_BLACK;
+        }
+        done += jot_GcScan(heap, gray.object, gray.position, work - done);
+    }
+    return done;
+}
+
+static int jot_GcDrained(const jot_Gc* gc)
+{
+    return gc->gray.count == 0 && !gc->overflowed && gc->rescan == NULL;
+}
+
+/*
+    Scans gray objects until there are none left or work runs out, and
+    returns how much was done. The ones there wasn't memory to push are
+    found by walking the heap, a step's worth at a time; nothing is freed
+    while marking, so the walk can stop anywhere and carry on from there.
+    Anything made since it started is at the front, and black.
+*/
+static size_t jot_GcDrain(jot_Heap* heap, size_t work)
+{
+    jot_Gc* gc = &heap->gc;
+    jot_Object* object;
+    size_t done = 0;
+    
+    while(done < work)
+    {
+        if(gc->gray.count > 0)
+        {
+            done += jot_GcPropagate(heap, work - done);
+        }
+        else if(gc->rescan != NULL)
+        {
+            object = *gc->rescan;
+            if(object == NULL)
+            {
+                gc->rescan = NULL;
+                continue;
+            }
+            gc->rescan = &object->next;
+            /* With nothing on the stack, anything gray is one that didn't fit on it. */
+            if(object->color == JOT_GC_GRAY)
+            {
+                object->color = JOT_GC_BLACK;
+                done += jot_GcScan(heap, object, 0, work - done);
+            }
+            done++;
+        }
+        else if(gc->overflowed)
+        {
+            /* Anything that doesn't fit from now on, even behind where the walk has got to, takes another. */
+            gc->overflowed = 0;
+            gc->rescan = &heap->objects;
+        }
+        else
+        {
+            break;
+        }
+    }
+    return done;
+}
+
+/* Marks what the VM refers to outside of any object. */
+static void jot_GcMarkRoots(jot_Vm* vm)
+{
+    jot_Heap* heap = &vm->heap;
+    const jot_Frame* frame;
+    jot_Upvalue* upvalue;
+    size_t end = vm->native_top;
+    size_t i;
+    
+    /* A call further in can end before the registers of the one that called it do. */
+    for(i = 0; i < vm->frame_count; i++)
+    {
+        frame = &vm->frames[i];
+        if(frame->base + frame->closure->proto->register_count > end)
+        {
+            end = frame->base + frame->closure->proto->register_count;
+        }
+        jot_GcMark(heap, &frame->closure->object);
+    }
+    for(i = 0; i < end; i++)
+    {
+        jot_GcMarkValue(heap, vm->stack[i]);
+    }
+    for(upvalue = vm->open_upvalues; upvalue != NULL; upvalue = upvalue->next_open)
+    {
+        jot_GcMark(heap, &upvalue->object);
+    }
+    jot_GcMark(heap, &vm->globals->object);
+    if(vm->error_source != NULL)
+    {
+        jot_GcMark(heap, &vm->error_source->object);
+    }
+}
+
+/*
+    Ends marking, if nothing's left gray, and marking the roots again,
+    which have no barrier, turns up nothing that hasn't been marked. If
+    either doesn't fit in work, it's tried again next time, carrying on
+    from where this got to. Each object can only be marked once a cycle,
+    however much the script changes in between, so a step gets there in
+    the end. Returns how much work it did.
+*/
+static size_t jot_GcAtomic(jot_Vm* vm, size_t work)
+{
+    jot_Heap* heap = &vm->heap;
+    jot_Gc* gc = &heap->gc;
+    size_t done;
+    
+    done = jot_GcDrain(heap, work);
+    if(!jot_GcDrained(gc))
+    {
+        return done;
+    }
+    jot_GcMarkRoots(vm);
+    done += jot_GcDrain(heap, work - done);
+    if(jot_GcDrained(gc))
+    {
+        gc->phase = JOT_GC_SWEEP;
+        gc->sweep = &heap->objects;
+    }
+    return done;
+}
+
+/* Frees white objects and whitens the rest, until work runs out or the whole heap's been swept, which leaves sweep NULL. */
+static size_t jot_GcSweep(jot_Heap* heap, size_t work)
+{
+    jot_Gc* gc = &heap->gc;
+    jot_Object* object;
+    size_t done = 0;
+    
+    while(done < work)
+    {
+        object = *gc->sweep;
+        if(object == NULL)
+        {
+            gc->sweep = NULL;
+            break;
+        }
+        if(object->color == JOT_GC_WHITE)
+        {
+            *gc->sweep = object->next;
+            jot_ObjectFree(heap, object);
+            gc->freed++;
+        }
+        else
+        {
+            object->color = JOT_GC_WHITE;
+            gc->sweep = &object->next;
+        }
+        done++;
+    }
+    return done;
+}
+
+/* Waits for the heap to grow to pause percent of what's left in it before the next cycle. */
+static void jot_GcPace(jot_Heap* heap)
+{
+    jot_Gc* gc = &heap->gc;
+    
+    gc->threshold = heap->bytes / 100 * gc->pause;
+    if(gc->threshold < heap->bytes + gc->step_size)
+    {
+        gc->threshold = heap->bytes + gc->step_size;
+    }
+}
+
+/* Goes from phase to phase until about work has been done, or a cycle finishes. Returns how much was done. */
+static size_t jot_GcRun(jot_Vm* vm, size_t work)
+{
+    jot_Heap* heap = &vm->heap;
+    jot_Gc* gc = &heap->gc;
+    size_t done = 0;
+    
+    while(done < work)
+    {
+        switch(gc->phase)
+        {
+            case JOT_GC_PAUSE:
+                jot_GcMarkRoots(vm);
+                gc->phase = JOT_GC_PROPAGATE;
+                break;
+            case JOT_GC_PROPAGATE:
+                done += jot_GcDrain(heap, work - done);
+                if(jot_GcDrained(gc))
+                {
+                    gc->phase = JOT_GC_ATOMIC;
+                }
+                break;
+            case JOT_GC_ATOMIC:
+                done += jot_GcAtomic(vm, work - done);
+                break;
+            default:
+                done += jot_GcSweep(heap, work - done);
+                if(gc->sweep == NULL)
+                {
+                    gc->phase = JOT_GC_PAUSE;
+                    gc->cycles++;
+                    return done;
+                }
+                break;
+        }
+    }
+    return done;
+}
+
+int jot_GcStep(jot_Vm* vm)
+{
+    jot_Heap* heap = &vm->heap;
+    jot_Gc* gc = &heap->gc;
+    unsigned long cycles = gc->cycles;
+    size_t owed, work, unpaid = 0;
+    double start, elapsed;
+    double top = 1e-6;
+    size_t i;
+    
+    if(gc->stopped)
+    {
+        gc->threshold = heap->bytes + gc->step_size;
+        return 0;
+    }
+    start = jot_GcNow(gc);
+    /* Steps are due step_size bytes apart, so anything past that is what a late one has to catch up on. */
+    owed = heap->bytes + gc->step_size > gc->threshold ? heap->bytes + gc->step_size - gc->threshold : gc->step_size;
+    work = owed / sizeof(jot_Value) * gc->multiplier / 100;
+    if(work > gc->budget)
+    {
+        unpaid = work - gc->budget;
+        work = gc->budget;
+    }
+    jot_GcRun(vm, work > 0 ? work : 1);
+    if(gc->phase == JOT_GC_PAUSE)
+    {
+        jot_GcPace(heap);
+    }
+    else
+    {
+        /* What the budget didn't allow is owed as soon as the step after this is. */
+        if(unpaid > 0)
+        {
+            unpaid = unpaid / gc->multiplier * 100 * sizeof(jot_Value);
+        }
+        gc->threshold = unpaid < heap->bytes + gc->step_size ? heap->bytes + gc->step_size - unpaid : 0;
+    }
+    
+    elapsed = jot_GcNow(gc) - start;
+    gc->steps++;
+    i = 0;
+    while(i + 1 < JOT_GC_HISTOGRAM_SIZE && elapsed >= top)
+    {
+        i++;
+        top *= 2;
+    }
+    gc->pauses[i]++;
+    if(elapsed > gc->longest)
+    {
+        gc->longest = elapsed;
+    }
+    return gc->cycles != cycles;
+}
+
+void jot_GcCollect(jot_Vm* vm)
+{
+    jot_Gc* gc = &vm->heap.gc;
+    unsigned long cycles;
+    int round;
+    
+    /* A cycle that's already marking may have kept what's been dropped since, so it's finished first, then a fresh one is run. */
+    for(round = gc->phase == JOT_GC_PAUSE ? 1 : 0; round < 2; round++)
+    {
+        cycles = gc->cycles;
+        while(gc->cycles == cycles)
+        {
+            jot_GcRun(vm, (size_t) -1);
+        }
+    }
+    jot_GcPace(&vm->heap);
+}
+
+void jot_GcBarrier(jot_Heap* heap, jot_Object* stored)
+{
+    /* While sweeping, black only means it hasn't been swept yet, and white that it has. */
+    if(heap->gc.phase == JOT_GC_PROPAGATE || heap->gc.phase == JOT_GC_ATOMIC)
+    {
+        jot_GcMark(heap, stored);
+    }
+}
+
+void jot_GcMoved(jot_Heap* heap, jot_Object* object)
+{
+    if(object->color == JOT_GC_BLACK && (heap->gc.phase == JOT_GC_PROPAGATE || heap->gc.phase == JOT_GC_ATOMIC))
+    {
+        object->color = JOT_GC_GRAY;
+        jot_GcPush(heap, object, 0);
+    }
+}
+
+double jot_GcPercentile(const jot_Gc* gc, double fraction)
+{
+    unsigned long total = 0;
+    unsigned long seen = 0;
+    double top = 1e-6;
+    size_t i;
+    
+    for(i = 0; i < JOT_GC_HISTOGRAM_SIZE; i++)
+    {
+        total += gc->pauses[i];
+    }
+    if(total == 0)
+    {
+        return 0;
+    }
+    for(i = 0; i + 1 < JOT_GC_HISTOGRAM_SIZE; i++, top *= 2)
+    {
+        seen += gc->pauses[i];
+        if(seen >= fraction * total)
+        {
+            return top < gc->longest ? top : gc->longest;
+        }
+    }
+    return gc->longest;
+}
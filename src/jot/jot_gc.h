@@ -0,0 +1,92 @@
+/*
+    jot - Garbage Collector
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#ifndef JOT_GC_H
+#define JOT_GC_H
+
+#include <stddef.h>
+
+#include "jot_value.h"
+#include "jot_vm.h"
+
+/*
+    An incremental mark and sweep collector, which frees the objects a VM
+    can't reach any more a little at a time, in steps the script runs
+    between, rather than stopping it for the whole heap at once.
+    
+    Each cycle starts with every object white. The VM's roots are marked
+    gray: the globals, every register of every call in progress, and the
+    upvalues still open on the stack. A gray object is scanned, marking
+    what it refers to, and goes black; once nothing is gray, whatever is
+    still white is garbage, and sweeping frees it and whitens everything
+    else for the next cycle.
+    
+    Meanwhile the script keeps changing things. Objects made while marking
+    start out black, and JOT_GC_BARRIER marks whatever is stored in an
+    object that's already black, so nothing black is left pointing at
+    something white. Entries can also move behind a scan that's part way
+    through a table: a table that's rehashed is started over, and an entry
+    that an insert pushes around from the last slot to the first goes
+    through the barrier. The roots have no barrier, so marking ends with
+    them marked again, and only once that turns up nothing new; if it
+    does, what it turned up is scanned, and they're marked again in a
+    later step. Since every object is marked at most once a cycle, that
+    comes to an end however the script carries on. Strings refer to
+    nothing, so they need no barrier, and the buffers long ones share are
+    counted, not collected.
+    
+    Steps only happen at points in the interpreter loop where the stack is
+    all there is, once the heap has grown by gc.step_size since the last
+    one (or, between cycles, to gc.pause percent of what was left after
+    the last). The work a step does is gc.multiplier percent of what was
+    allocated since the last one, counting a value looked at or an object
+    swept for every 8 bytes, and never more than gc.budget; what's left over
+    is carried on to the next step. Every phase keeps to the budget,
+    including the walk over the heap that finds gray objects there wasn't
+    memory to push, which picks up where it left off. Big tables, arrays
+    and protos are scanned a part at a time. What isn't counted is marking
+    the roots, at the start and end of marking, which is as much work as
+    the VM has registers and open upvalues in use, and what the allocator
+    takes to free a big block while sweeping. Natives and hosts can hold on
+    to objects in C for as long as they don't run a script, but a value a
+    host wants to keep between calls has to be somewhere the VM can reach,
+    like a global.
+    
+    Each step is timed, into gc.pauses.
+*/
+
+/* Does a step's worth of work, as the VM does on its own when the heap's bytes reach gc.threshold. Returns 1 if it finished a cycle. */
+int jot_GcStep(jot_Vm* vm);
+/* Finishes any cycle under way, then runs a whole one, which frees everything that can't be reached now. */
+void jot_GcCollect(jot_Vm* vm);
+/*
+    The pause that fraction of the steps so far took no longer than, in
+    seconds, rounded up to the top of its bucket in gc.pauses, or 0 if
+    there haven't been any.
+*/
+double jot_GcPercentile(const jot_Gc* gc, double fraction);
+
+#endif
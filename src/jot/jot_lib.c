@@ -0,0 +1,329 @@
+/*
+    jot - Standard Library
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#include <stdio.h>
+#include <string.h>
+
+#include "jot_array.h"
+#include "jot_lib.h"
+#include "jot_num.h"
+
+static int jot_LibPrint(jot_Vm* vm, jot_Value* args, int count)
+{
+    char buffer[JOT_NUM_FORMAT_SIZE];
+    const jot_String* string;
+    size_t length;
+    int i;
+    
+    (void) vm;
+    for(i = 0; i < count; i++)
+    {
+        if(i > 0)
+        {
+            putchar('\t');
+        }
+        switch(JOT_VALUE_TYPE(args[i]))
+        {
+            case JOT_TYPE_NIL:
+                fputs("nil", stdout);
+                break;
+            case JOT_TYPE_BOOL:
+                fputs(JOT_AS_BOOL(args[i]) ? "true" : "false", stdout);
+                break;
+            case JOT_TYPE_INT:
+                length = jot_NumFormatInt(JOT_AS_INT(args[i]), buffer);
+                fwrite(buffer, 1, length, stdout);
+                break;
+            case JOT_TYPE_NUM:
+                length = jot_NumFormat(JOT_AS_NUM(args[i]), buffer);
+                fwrite(buffer, 1, length, stdout);
+                break;
+            case JOT_TYPE_STR:
+                string = (const jot_String*) JOT_AS_OBJECT(args[i]);
+                fwrite(string->text, 1, string->length, stdout);
+                break;
+            default:
+                printf("%s: %p", jot_TypeName(JOT_VALUE_TYPE(args[i])), (void*) JOT_AS_OBJECT(args[i]));
+                break;
+        }
+    }
+    putchar('\n');
+    return 0;
+}
+
+static int jot_LibLen(jot_Vm* vm, jot_Value* args, int count)
+{
+    jot_Value key, value;
+    size_t index = 0;
+    int64_t length = 0;
+    
+    switch(count > 0 ? JOT_VALUE_TYPE(args[0]) : JOT_TYPE_NIL)
+    {
+        case JOT_TYPE_STR:
+            length = (int64_t) ((const jot_String*) JOT_AS_OBJECT(args[0]))->length;
+            break;
+        case JOT_TYPE_ARRAY:
+            length = (int64_t) ((const jot_Array*) JOT_AS_OBJECT(args[0]))->count;
+            break;
+        case JOT_TYPE_TABLE:
+            /* Removed keys still take up entries, so only the ones left are counted. */
+            while(jot_TableNext((const jot_Table*) JOT_AS_OBJECT(args[0]), &index, &key, &value))
+            {
+                length++;
+            }
+            break;
+        default:
+            return jot_VmFail(vm, "len expects a str, array or table");
+    }
+    /* Nothing that fits in memory is too long for an unboxed int. */
+    JOT_SET_SMALL_INT(&args[0], length);
+    return 1;
+}
+
+static int jot_LibPush(jot_Vm* vm, jot_Value* args, int count)
+{
+    jot_Array* array;
+    int i;
+    
+    if(count < 1 || !JOT_IS_ARRAY(args[0]))
+    {
+        return jot_VmFail(vm, "push expects an array");
+    }
+    array = (jot_Array*) JOT_AS_OBJECT(args[0]);
+    for(i = 1; i < count; i++)
+    {
+        if(!jot_ArrayPush(&vm->heap, array, args[i]))
+        {
+            return jot_VmFail(vm, "out of memory");
+        }
+    }
+    return 1;
+}
+
+static int jot_LibPop(jot_Vm* vm, jot_Value* args, int count)
+{
+    jot_Array* array;
+    
+    if(count < 1 || !JOT_IS_ARRAY(args[0]))
+    {
+        return jot_VmFail(vm, "pop expects an array");
+    }
+    array = (jot_Array*) JOT_AS_OBJECT(args[0]);
+    if(array->count == 0)
+    {
+        JOT_SET_NIL(&args[0]);
+    }
+    else
+    {
+        array->count--;
+        JOT_ARRAY_GET(array, array->count, &args[0]);
+    }
+    return 1;
+}
+
+/* Reads args[index] as a position in an array, which is fallback if it's missing or nil. */
+static int jot_LibPosition(const jot_Value* args, int count, int index, size_t fallback, size_t* position)
+{
+    int64_t integer;
+    
+    if(index >= count || JOT_IS_NIL(args[index]))
+    {
+        *position = fallback;
+        return 1;
+    }
+    if(JOT_IS_INT(args[index]))
+    {
+        integer = JOT_AS_INT(args[index]);
+    }
+    else if(!JOT_IS_NUM(args[index]) || !jot_NumToInt(JOT_AS_NUM(args[index]), &integer))
+    {
+        return 0;
+    }
+    if(integer < 0 || (uint64_t) integer > (size_t) -1)
+    {
+        return 0;
+    }
+    *position = (size_t) integer;
+    return 1;
+}
+
+static int jot_LibFill(jot_Vm* vm, jot_Value* args, int count)
+{
+    jot_Array* array;
+    size_t start, length;
+    
+    if(count < 2 || !JOT_IS_ARRAY(args[0]))
+    {
+        return jot_VmFail(vm, "fill expects an array and a value");
+    }
+    array = (jot_Array*) JOT_AS_OBJECT(args[0]);
+    if(!jot_LibPosition(args, count, 2, 0, &start) || start > array->count
+        || !jot_LibPosition(args, count, 3, array->count - start, &length))
+    {
+        return jot_VmFail(vm, "array index out of range");
+    }
+    if(!jot_ArrayFill(&vm->heap, array, start, length, args[1]))
+    {
+        return jot_VmFail(vm, "out of memory");
+    }
+    return 1;
+}
+
+static int jot_LibCopy(jot_Vm* vm, jot_Value* args, int count)
+{
+    jot_Array* array;
+    const jot_Array* source;
+    size_t at, start, end;
+    
+    if(count < 3 || !JOT_IS_ARRAY(args[0]) || !JOT_IS_ARRAY(args[2]))
+    {
+        return jot_VmFail(vm, "copy expects an array, an index and an array");
+    }
+    array = (jot_Array*) JOT_AS_OBJECT(args[0]);
+    source = (const jot_Array*) JOT_AS_OBJECT(args[2]);
+    if(!jot_LibPosition(args, count, 1, 0, &at) || at > array->count
+        || !jot_LibPosition(args, count, 3, 0, &start)
+        || !jot_LibPosition(args, count, 4, source->count, &end) || start > end || end > source->count)
+    {
+        return jot_VmFail(vm, "array index out of range");
+    }
+    if(!jot_ArrayCopy(&vm->heap, array, at, source, start, end - start))
+    {
+        return jot_VmFail(vm, "out of memory");
+    }
+    return 1;
+}
+
+static int jot_LibSlice(jot_Vm* vm, jot_Value* args, int count)
+{
+    const jot_Array* array;
+    jot_Array* slice;
+    size_t start, end;
+    
+    if(count < 1 || !JOT_IS_ARRAY(args[0]))
+    {
+        return jot_VmFail(vm, "slice expects an array");
+    }
+    array = (const jot_Array*) JOT_AS_OBJECT(args[0]);
+    if(!jot_LibPosition(args, count, 1, 0, &start)
+        || !jot_LibPosition(args, count, 2, array->count, &end) || start > end || end > array->count)
+    {
+        return jot_VmFail(vm, "array index out of range");
+    }
+    slice = jot_ArraySlice(&vm->heap, array, start, end - start);
+    if(slice == NULL)
+    {
+        return jot_VmFail(vm, "out of memory");
+    }
+    JOT_SET_OBJECT(&args[0], slice);
+    return 1;
+}
+
+static int jot_LibSum(jot_Vm* vm, jot_Value* args, int count)
+{
+    if(count < 1 || !JOT_IS_ARRAY(args[0]))
+    {
+        return jot_VmFail(vm, "sum expects an array");
+    }
+    switch(jot_ArraySum(&vm->heap, (const jot_Array*) JOT_AS_OBJECT(args[0]), &args[0]))
+    {
+        case 1:
+            return 1;
+        case 0:
+            return jot_VmFail(vm, "sum expects an array of numbers");
+        default:
+            return jot_VmFail(vm, "out of memory");
+    }
+}
+
+static int jot_LibMin(jot_Vm* vm, jot_Value* args, int count)
+{
+    if(count < 1 || !JOT_IS_ARRAY(args[0]) || !jot_ArrayMin((const jot_Array*) JOT_AS_OBJECT(args[0]), &args[0]))
+    {
+        return jot_VmFail(vm, "min expects an array of numbers");
+    }
+    return 1;
+}
+
+static int jot_LibMax(jot_Vm* vm, jot_Value* args, int count)
+{
+    if(count < 1 || !JOT_IS_ARRAY(args[0]) || !jot_ArrayMax((const jot_Array*) JOT_AS_OBJECT(args[0]), &args[0]))
+    {
+        return jot_VmFail(vm, "max expects an array of numbers");
+    }
+    return 1;
+}
+
+static int jot_LibToString(jot_Vm* vm, jot_Value* args, int count)
+{
+    jot_Value value;
+    jot_String* string;
+    
+    if(count > 0)
+    {
+        value = args[0];
+    }
+    else
+    {
+        JOT_SET_NIL(&value);
+    }
+    string = jot_StringFromValue(&vm->heap, value);
+    if(string == NULL)
+    {
+        return jot_VmFail(vm, "out of memory");
+    }
+    JOT_SET_OBJECT(&args[0], string);
+    return 1;
+}
+
+static int jot_LibType(jot_Vm* vm, jot_Value* args, int count)
+{
+    const char* name = jot_TypeName(count > 0 ? JOT_VALUE_TYPE(args[0]) : JOT_TYPE_NIL);
+    jot_String* string = jot_StringNew(&vm->heap, name, strlen(name));
+    
+    if(string == NULL)
+    {
+        return jot_VmFail(vm, "out of memory");
+    }
+    JOT_SET_OBJECT(&args[0], string);
+    return 1;
+}
+
+int jot_LibOpen(jot_Vm* vm)
+{
+    return jot_VmRegister(vm, "print", jot_LibPrint)
+        && jot_VmRegister(vm, "len", jot_LibLen)
+        && jot_VmRegister(vm, "push", jot_LibPush)
+        && jot_VmRegister(vm, "pop", jot_LibPop)
+        && jot_VmRegister(vm, "fill", jot_LibFill)
+        && jot_VmRegister(vm, "copy", jot_LibCopy)
+        && jot_VmRegister(vm, "slice", jot_LibSlice)
+        && jot_VmRegister(vm, "sum", jot_LibSum)
+        && jot_VmRegister(vm, "min", jot_LibMin)
+        && jot_VmRegister(vm, "max", jot_LibMax)
+        && jot_VmRegister(vm, "tostring", jot_LibToString)
+        && jot_VmRegister(vm, "type", jot_LibType);
+}
@@ -0,0 +1,59 @@
+/*
+    jot - Standard Library
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#ifndef JOT_LIB_H
+#define JOT_LIB_H
+
+#include "jot_vm.h"
+
+/*
+    Registers the built-in globals:
+    
+        print(...)          writes its arguments to stdout, separated by tabs
+        len(x)              the length of a str or array, or the entries in a table
+        push(array, ...)    appends its other arguments to array, and returns it
+        pop(array)          removes the last element of array, and returns it
+        fill(array, x, start, count)
+                            sets count elements from start to x, lengthening array
+                            if need be; start and count default to all of array
+        copy(array, at, source, start, end)
+                            copies source's elements from start up to end into
+                            array from at, lengthening it if need be; start and
+                            end default to all of source
+        slice(array, start, end)
+                            a new array of the elements from start up to end,
+                            which default to all of array
+        sum(array)          the elements of array added up, starting from 0
+        min(array)          the smallest element of array, or nil if it's empty
+        max(array)          the biggest element of array, or nil if it's empty
+        tostring(x)         x as it would be printed
+        type(x)             the name of x's type
+    
+    Returns 0 if memory runs out.
+*/
+int jot_LibOpen(jot_Vm* vm);
+
+#endif
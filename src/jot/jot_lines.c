@@ -0,0 +1,171 @@
+/*
+    jot - Line Index
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+
+#include <stdlib.h>
+
+#include "jot_lines.h"
+#include "jot_scanskip.h"
+
+enum
+{
+    JOT_LINE_INDEX_MIN_CAPACITY = 256
+};
+
+jot_LineIndex* jot_LineIndexNew(jot_Allocator* allocator)
+{
+    jot_LineIndex* self = jot_Alloc(allocator, JOT_ALLOC_LINES, sizeof(jot_LineIndex));
+    
+    if(self == NULL)
+    {
+        return NULL;
+    }
+    self->allocator = allocator;
+    self->count = 0;
+    self->capacity = 0;
+    self->starts = NULL;
+    self->size = 0;
+    self->after_cr = 0;
+    self->failed = 0;
+    return self;
+}
+
+void jot_LineIndexFree(jot_LineIndex* self)
+{
+    jot_Free(self->allocator, JOT_ALLOC_LINES, self->starts, self->capacity * sizeof(size_t));
+    jot_Free(self->allocator, JOT_ALLOC_LINES, self, sizeof(jot_LineIndex));
+}
+
+static int jot_LineIndexAdd(jot_LineIndex* self, size_t start)
+{
+    size_t capacity;
+    size_t* starts;
+    
+    if(self->count == self->capacity)
+    {
+        capacity = self->capacity ? self->capacity * 2 : JOT_LINE_INDEX_MIN_CAPACITY;
+        if((starts = jot_Realloc(self->allocator, JOT_ALLOC_LINES, self->starts,
+            self->capacity * sizeof(size_t), capacity * sizeof(size_t))) == NULL)
+        {
+            self->failed = 1;
+            return 0;
+        }
+        self->starts = starts;
+        self->capacity = capacity;
+    }
+    self->starts[self->count++] = start;
+    return 1;
+}
+
+int jot_LineIndexAppend(jot_LineIndex* self, const char* data, size_t size)
+{
+    size_t (*line_end)(const char* data, size_t length) = jot_ScanSkipGet()->line_comment;
+    size_t position = 0;
+    
+    if(self->failed)
+    {
+        return 0;
+    }
+    
+    /* A '\n' right after a '\r' is part of the same line end, so the line really starts after it. */
+    if(size > 0 && self->after_cr && data[0] == '\n')
+    {
+        self->starts[self->count - 1]++;
+        position++;
+    }
+    
+    while(position < size)
+    {
+        position += line_end(data + position, size - position);
+        if(position == size)
+        {
+            break;
+        }
+        if(data[position] == '\r' && position + 1 < size && data[position + 1] == '\n')
+        {
+            position++;
+        }
+        position++;
+        if(!jot_LineIndexAdd(self, self->size + position))
+        {
+            return 0;
+        }
+    }
+    
+    if(size > 0)
+    {
+        self->after_cr = data[size - 1] == '\r';
+    }
+    self->size += size;
+    return 1;
+}
+
+/* Returns how many lines start at or before offset. */
+static size_t jot_LineIndexCountStarts(const jot_LineIndex* self, size_t offset)
+{
+    size_t low = 0;
+    size_t high = self->count;
+    size_t middle;
+    
+    while(low < high)
+    {
+        middle = low + (high - low) / 2;
+        if(self->starts[middle] <= offset)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+void jot_LineIndexTruncate(jot_LineIndex* self, size_t offset)
+{
+    if(offset >= self->size)
+    {
+        return;
+    }
+    /*
+        A line starting right at offset goes too, since a '\n' put there
+        after a '\r' would join it to the line before. The text is then
+        indexed up to the start of a line whose first byte isn't changing,
+        so nothing can be left waiting on a '\n'.
+    */
+    self->count = offset > 0 ? jot_LineIndexCountStarts(self, offset - 1) : 0;
+    self->size = self->count > 0 ? self->starts[self->count - 1] : 0;
+    self->after_cr = 0;
+}
+
+void jot_LineIndexLocate(const jot_LineIndex* self, size_t offset, size_t* line, size_t* column)
+{
+    size_t index = jot_LineIndexCountStarts(self, offset);
+    
+    *line = index + 1;
+    *column = offset - (index > 0 ? self->starts[index - 1] : 0) + 1;
+}
@@ -0,0 +1,80 @@
+/*
+    jot - Line Index
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#ifndef JOT_LINES_H
+#define JOT_LINES_H
+
+#include <stddef.h>
+
+#include "jot_alloc.h"
+
+/*
+    Where each line of a source starts, for turning byte offsets into lines
+    and columns when something (usually a diagnostic) needs them. The
+    scanner itself only deals in offsets.
+    
+    Text is fed in with jot_LineIndexAppend, in as many pieces as convenient.
+    '\n', '\r' and "\r\n" each end a line, even when a "\r\n" is split
+    between two pieces. Line ends are found with the same bulk skip the
+    scanner uses for line comments, so building an index costs about as much
+    as a memchr over the text.
+*/
+typedef struct
+{
+    jot_Allocator* allocator;
+    
+    /* Line i + 2 starts at starts[i]; the first line starts at 0. */
+    size_t count;
+    size_t capacity;
+    size_t* starts;
+    
+    /* How much text has been appended so far. */
+    size_t size;
+    /* Whether that text ended in a '\r', which a '\n' still to come would belong to. */
+    char after_cr;
+    /* Set when memory ran out, after which nothing more is indexed. */
+    char failed;
+} jot_LineIndex;
+
+jot_LineIndex* jot_LineIndexNew(jot_Allocator* allocator);
+void jot_LineIndexFree(jot_LineIndex* self);
+
+/* Indexes size more bytes of text at data. Returns 0 if memory ran out. */
+int jot_LineIndexAppend(jot_LineIndex* self, const char* data, size_t size);
+
+/*
+    Forgets everything from the start of the line containing offset onward,
+    so the text can be appended again from there after a change at offset.
+*/
+void jot_LineIndexTruncate(jot_LineIndex* self, size_t offset);
+
+/*
+    Finds the line and column (both counted from 1, columns in bytes) of the
+    byte at offset, which has to have been appended already.
+*/
+void jot_LineIndexLocate(const jot_LineIndex* self, size_t offset, size_t* line, size_t* column);
+
+#endif
@@ -0,0 +1,536 @@
+/*
+    jot - Numbers
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#include <float.h>
+#include <locale.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "jot_num.h"
+#include "jot_numtab.h"
+
+/*
+    The Clinger fast path below is only exact when doubles are computed in
+    double precision, not in wider x87 registers.
+*/
+#if defined(FLT_EVAL_METHOD)
+#define JOT_NUM_EXACT_DOUBLE (FLT_EVAL_METHOD == 0)
+#elif defined(__FLT_EVAL_METHOD__)
+#define JOT_NUM_EXACT_DOUBLE (__FLT_EVAL_METHOD__ == 0)
+#else
+#define JOT_NUM_EXACT_DOUBLE 0
+#endif
+
+#if defined(__GNUC__) && defined(__SIZEOF_INT128__)
+#define JOT_NUM_HAVE_INT128
+__extension__ typedef unsigned __int128 jot_NumUInt128;
+#endif
+
+enum
+{
+    /* Decimal digits that always fit in a uint64_t. */
+    JOT_NUM_MAX_DIGITS = 19,
+    JOT_NUM_MANTISSA_BITS = 52,
+    JOT_NUM_EXPONENT_BIAS = 1023,
+    JOT_NUM_INFINITE_POWER = 0x7FF
+};
+
+/* Powers of ten that are exactly representable as doubles. */
+static const double jot_num_exact_pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+int jot_NumParseInt(const char* text, size_t length, unsigned int base, int64_t* value)
+{
+    const uint64_t cutoff = (uint64_t) INT64_MAX / 10;
+    const unsigned int cutoff_digit = (unsigned int) ((uint64_t) INT64_MAX % 10);
+    uint64_t result = 0;
+    unsigned int shift;
+    unsigned int digit;
+    size_t i;
+    
+    if(base == 10)
+    {
+        for(i = 0; i < length; i++)
+        {
+            digit = (unsigned char) text[i] - '0';
+            if(result >= cutoff && (result > cutoff || digit > cutoff_digit))
+            {
+                return 0;
+            }
+            result = result * 10 + digit;
+        }
+        *value = (int64_t) result;
+        return 1;
+    }
+    
+    shift = base == 16 ? 4 : 1;
+    for(i = 0; i < length; i++)
+    {
+        digit = (unsigned char) text[i];
+        digit = digit <= '9' ? digit - '0' : (digit | 0x20) - 'a' + 10;
+        if(result >> (64 - shift))
+        {
+            return 0;
+        }
+        result = result << shift | digit;
+    }
+    /* Reinterpret the top bit as the sign without relying on implementation-defined conversion. */
+    *value = result > (uint64_t) INT64_MAX ? -(int64_t) ~result - 1 : (int64_t) result;
+    return 1;
+}
+
+static void jot_NumMultiply(uint64_t a, uint64_t b, uint64_t* high, uint64_t* low)
+{
+#ifdef JOT_NUM_HAVE_INT128
+    jot_NumUInt128 product = (jot_NumUInt128) a * b;
+    *high = (uint64_t) (product >> 64);
+    *low = (uint64_t) product;
+#else
+    uint64_t a_low = a & 0xFFFFFFFFUL;
+    uint64_t a_high = a >> 32;
+    uint64_t b_low = b & 0xFFFFFFFFUL;
+    uint64_t b_high = b >> 32;
+    uint64_t low_low = a_low * b_low;
+    uint64_t low_high = a_low * b_high;
+    uint64_t high_low = a_high * b_low;
+    uint64_t middle = (low_low >> 32) + (low_high & 0xFFFFFFFFUL) + (high_low & 0xFFFFFFFFUL);
+    
+    *low = middle << 32 | (low_low & 0xFFFFFFFFUL);
+    *high = a_high * b_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32);
+#endif
+}
+
+static int jot_NumLeadingZeros(uint64_t value)
+{
+#ifdef __GNUC__
+    return __builtin_clzll(value);
+#else
+    int count = 0;
+    while(!(value >> 63))
+    {
+        value <<= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/* floor(log2(10^q)) + 63, for |q| <= 350. */
+static long jot_NumBinaryExponent(long q)
+{
+    const long scaled = (152170 + 65536) * (q < 0 ? -q : q);
+    return (q < 0 ? -((scaled + 65535) >> 16) : scaled >> 16) + 63;
+}
+
+/*
+    Eisel-Lemire: rounds w * 10^q to the nearest double using a single
+    64 x 128-bit multiplication against the power of five table. Stores the
+    double's bits and returns 1. In the (very rare) case where the truncated
+    product isn't precise enough to decide the rounding, the bits might be
+    one ulp off and this returns 0.
+*/
+static int jot_NumEiselLemire(uint64_t w, long q, uint64_t* bits)
+{
+    const uint64_t* power;
+    uint64_t high, low;
+    uint64_t second_high, second_low;
+    uint64_t mantissa;
+    long power2;
+    int zeros;
+    int upper;
+    int shift;
+    int exact = 1;
+    
+    if(w == 0 || q < JOT_NUM_POW5_MIN)
+    {
+        *bits = 0;
+        return 1;
+    }
+    if(q > JOT_NUM_POW5_MAX)
+    {
+        *bits = (uint64_t) JOT_NUM_INFINITE_POWER << JOT_NUM_MANTISSA_BITS;
+        return 1;
+    }
+    
+    zeros = jot_NumLeadingZeros(w);
+    w <<= zeros;
+    power = jot_num_pow5[q - JOT_NUM_POW5_MIN];
+    jot_NumMultiply(w, power[0], &high, &low);
+    
+    /*
+        Only the top 55 bits of the product are kept. If all the bits under
+        them are set, the part of 5^q that the first half of the table entry
+        leaves out might carry into them, so bring in the second half too.
+    */
+    if((high & 0x1FF) == 0x1FF)
+    {
+        jot_NumMultiply(w, power[1], &second_high, &second_low);
+        low += second_high;
+        if(second_high > low)
+        {
+            high++;
+        }
+        /* Outside this range 5^q itself was truncated, so the product still might not be exact. */
+        if(low == ~(uint64_t) 0 && (q < -27 || q > 55))
+        {
+            exact = 0;
+        }
+    }
+    
+    upper = (int) (high >> 63);
+    shift = upper + 64 - JOT_NUM_MANTISSA_BITS - 3;
+    mantissa = high >> shift;
+    power2 = jot_NumBinaryExponent(q) + upper - zeros + JOT_NUM_EXPONENT_BIAS;
+    
+    if(power2 <= 0)
+    {
+        /* Subnormal, or rounds down to zero. */
+        if(-power2 + 1 >= 64)
+        {
+            *bits = 0;
+            return 1;
+        }
+        mantissa >>= -power2 + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        /* Rounding up can carry into the smallest normal exponent. */
+        power2 = mantissa < (uint64_t) 1 << JOT_NUM_MANTISSA_BITS ? 0 : 1;
+        *bits = mantissa | (uint64_t) power2 << JOT_NUM_MANTISSA_BITS;
+        return exact;
+    }
+    
+    /*
+        Exactly halfway between two doubles: only possible when w * 10^q is
+        exact in the product, i.e. for small q. Round to even.
+    */
+    if(low <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && mantissa << shift == high)
+    {
+        mantissa &= ~(uint64_t) 1;
+    }
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if(mantissa >= (uint64_t) 2 << JOT_NUM_MANTISSA_BITS)
+    {
+        mantissa = (uint64_t) 1 << JOT_NUM_MANTISSA_BITS;
+        power2++;
+    }
+    mantissa &= ~((uint64_t) 1 << JOT_NUM_MANTISSA_BITS);
+    if(power2 >= JOT_NUM_INFINITE_POWER)
+    {
+        power2 = JOT_NUM_INFINITE_POWER;
+        mantissa = 0;
+    }
+    *bits = mantissa | (uint64_t) power2 << JOT_NUM_MANTISSA_BITS;
+    return exact;
+}
+
+/*
+    Hands the literal to strtod. The text isn't NUL-terminated and strtod
+    expects the locale's decimal point, so it works on a copy.
+*/
+static double jot_NumParseSlow(const char* text, size_t length, double fallback)
+{
+    const char* point = localeconv()->decimal_point;
+    size_t point_length = strlen(point);
+    char local[128];
+    char* copy = local;
+    char* out;
+    double result;
+    size_t i;
+    
+    if(length + point_length + 1 > sizeof(local))
+    {
+        copy = malloc(length + point_length + 1);
+        if(copy == NULL)
+        {
+            return fallback;
+        }
+    }
+    out = copy;
+    for(i = 0; i < length; i++)
+    {
+        if(text[i] == '.')
+        {
+            memcpy(out, point, point_length);
+            out += point_length;
+        }
+        else
+        {
+            *out++ = text[i];
+        }
+    }
+    *out = '\0';
+    
+    result = strtod(copy, NULL);
+    if(copy != local)
+    {
+        free(copy);
+    }
+    return result;
+}
+
+double jot_NumParseDecimal(const char* text, size_t length)
+{
+    const char* end = text + length;
+    const char* p = text;
+    uint64_t w = 0;
+    uint64_t bits, upper_bits;
+    long exponent = 0;
+    long explicit_exponent = 0;
+    int negative = 0;
+    int digits = 0;
+    int truncated = 0;
+    unsigned int digit;
+    double result;
+    
+    /*
+        Keep the first 19 significant digits in w, and count the rest into
+        the exponent. Leading zeros leave w at 0, so they aren't significant.
+    */
+    for(; p != end && (digit = (unsigned char) *p - '0') <= 9; p++)
+    {
+        if(digits < JOT_NUM_MAX_DIGITS)
+        {
+            w = w * 10 + digit;
+            digits += w != 0;
+        }
+        else
+        {
+            exponent++;
+            truncated |= digit != 0;
+        }
+    }
+    if(p != end && *p == '.')
+    {
+        for(p++; p != end && (digit = (unsigned char) *p - '0') <= 9; p++)
+        {
+            if(digits < JOT_NUM_MAX_DIGITS)
+            {
+                w = w * 10 + digit;
+                digits += w != 0;
+                exponent--;
+            }
+            else
+            {
+                truncated |= digit != 0;
+            }
+        }
+    }
+    /* The scanner allows the exponent digits to be missing, same as strtod ignores them. */
+    if(p != end && (*p | 0x20) == 'e')
+    {
+        p++;
+        if(p != end && (*p == '+' || *p == '-'))
+        {
+            negative = *p == '-';
+            p++;
+        }
+        for(; p != end && (digit = (unsigned char) *p - '0') <= 9; p++)
+        {
+            if(explicit_exponent < 100000)
+            {
+                explicit_exponent = explicit_exponent * 10 + digit;
+            }
+        }
+        exponent += negative ? -explicit_exponent : explicit_exponent;
+    }
+    
+    /* Both w and 10^|q| are exact doubles, so one correctly rounded operation is enough. */
+    if(JOT_NUM_EXACT_DOUBLE && !truncated && w <= (uint64_t) 1 << 53 && exponent >= -22 && exponent <= 22)
+    {
+        result = (double) w;
+        return exponent < 0 ? result / jot_num_exact_pow10[-exponent] : result * jot_num_exact_pow10[exponent];
+    }
+    
+    /*
+        With digits dropped, the literal is somewhere between w and w + 1
+        (times 10^q). If both ends round to the same double, so does it.
+    */
+    if(jot_NumEiselLemire(w, exponent, &bits)
+        && (!truncated || (jot_NumEiselLemire(w + 1, exponent, &upper_bits) && upper_bits == bits)))
+    {
+        memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+    /* Close enough to stand in if strtod can't be given a copy. */
+    memcpy(&result, &bits, sizeof(result));
+    return jot_NumParseSlow(text, length, result);
+}
+
+int64_t jot_NumShiftLeft(int64_t value, int64_t shift)
+{
+    if(shift <= -64 || shift >= 64)
+    {
+        return 0;
+    }
+    if(shift >= 0)
+    {
+        return (int64_t) ((uint64_t) value << shift);
+    }
+    return (int64_t) ((uint64_t) value >> -shift);
+}
+
+int64_t jot_NumMod(int64_t value, int64_t divisor)
+{
+    int64_t remainder;
+    
+    /* INT64_MIN % -1 overflows in C, though the answer is plainly 0. */
+    if(divisor == -1)
+    {
+        return 0;
+    }
+    remainder = value % divisor;
+    if(remainder != 0 && (remainder ^ divisor) < 0)
+    {
+        remainder += divisor;
+    }
+    return remainder;
+}
+
+int jot_NumToInt(double value, int64_t* result)
+{
+    /* -2^63 is the only power of two on the edge that fits. */
+    if(value >= -9223372036854775808.0 && value < 9223372036854775808.0 && value == (double) (int64_t) value)
+    {
+        *result = (int64_t) value;
+        return 1;
+    }
+    return 0;
+}
+
+int jot_NumIntEqualNum(int64_t a, double b)
+{
+    int64_t integer;
+    
+    return jot_NumToInt(b, &integer) && integer == a;
+}
+
+/*
+    b is between two integers (or on one), and a is less than b when it's
+    at most the one below. Truncating gives that one for positive b and
+    the one above for negative b.
+*/
+int jot_NumIntLessNum(int64_t a, double b)
+{
+    int64_t truncated;
+    
+    if(b >= 9223372036854775808.0)
+    {
+        return 1;
+    }
+    if(!(b > -9223372036854775808.0))
+    {
+        /* Below every integer, or NaN. */
+        return 0;
+    }
+    truncated = (int64_t) b;
+    return b > (double) truncated ? a <= truncated : a < truncated;
+}
+
+int jot_NumIntLessEqualNum(int64_t a, double b)
+{
+    int64_t truncated;
+    
+    if(b >= 9223372036854775808.0)
+    {
+        return 1;
+    }
+    if(!(b >= -9223372036854775808.0))
+    {
+        return 0;
+    }
+    truncated = (int64_t) b;
+    return b >= (double) truncated ? a <= truncated : a < truncated;
+}
+
+int jot_NumNumLessInt(double a, int64_t b)
+{
+    return a == a && !jot_NumIntLessEqualNum(b, a);
+}
+
+int jot_NumNumLessEqualInt(double a, int64_t b)
+{
+    return a == a && !jot_NumIntLessNum(b, a);
+}
+
+size_t jot_NumFormatInt(int64_t value, char* buffer)
+{
+    char digits[JOT_NUM_FORMAT_SIZE];
+    uint64_t magnitude = value < 0 ? 0 - (uint64_t) value : (uint64_t) value;
+    size_t count = 0;
+    size_t length = 0;
+    
+    do
+    {
+        digits[count++] = (char) ('0' + magnitude % 10);
+        magnitude /= 10;
+    } while(magnitude != 0);
+    if(value < 0)
+    {
+        buffer[length++] = '-';
+    }
+    while(count > 0)
+    {
+        buffer[length++] = digits[--count];
+    }
+    buffer[length] = '\0';
+    return length;
+}
+
+size_t jot_NumFormat(double value, char* buffer)
+{
+    const char* point = localeconv()->decimal_point;
+    char* found;
+    size_t length;
+    
+    if(value != value)
+    {
+        strcpy(buffer, "nan");
+        return 3;
+    }
+    if(value == HUGE_VAL || value == -HUGE_VAL)
+    {
+        strcpy(buffer, value < 0 ? "-inf" : "inf");
+        return strlen(buffer);
+    }
+    /* Enough digits to tell most floats apart, without printing 0.1 as 0.10000000000000001. */
+    sprintf(buffer, "%.14g", value);
+    if(point[0] != '.' && point[0] != '\0' && (found = strchr(buffer, point[0])) != NULL)
+    {
+        *found = '.';
+    }
+    length = strlen(buffer);
+    if(strspn(buffer, "-0123456789") == length)
+    {
+        strcpy(buffer + length, ".0");
+        length += 2;
+    }
+    return length;
+}
@@ -0,0 +1,86 @@
+/*
+    jot - Numbers
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#ifndef JOT_NUM_H
+#define JOT_NUM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+    Converts the digits of an integer literal in base 2, 10 or 16, as the
+    scanner hands them out (no prefix, no '_' separators). Returns 0 if the
+    literal doesn't fit: decimal literals must be at most INT64_MAX, while
+    binary and hex literals spell out a bit pattern and may use all 64 bits.
+*/
+int jot_NumParseInt(const char* text, size_t length, unsigned int base, int64_t* value);
+
+/*
+    Converts a decimal literal (digits, optional fraction, optional exponent)
+    to the nearest double. The result is the same as strtod's, bit for bit,
+    but most literals never go anywhere near strtod.
+*/
+double jot_NumParseDecimal(const char* text, size_t length);
+
+/*
+    Integer operators whose results C leaves undefined for some operands.
+    Integer arithmetic wraps around in 64 bits, the same at run time as
+    when constants are folded.
+*/
+
+/* Shifts left by shift bits, or right (without sign extension) if shift is negative. Shifts of 64 or more give 0. */
+int64_t jot_NumShiftLeft(int64_t value, int64_t shift);
+/* The remainder of flooring division, with the sign of divisor, which must not be 0. */
+int64_t jot_NumMod(int64_t value, int64_t divisor);
+
+/*
+    Comparisons between an integer and a float, done exactly: converting
+    the integer to a double would round anything past 2^53.
+*/
+int jot_NumIntEqualNum(int64_t a, double b);
+int jot_NumIntLessNum(int64_t a, double b);
+int jot_NumIntLessEqualNum(int64_t a, double b);
+int jot_NumNumLessInt(double a, int64_t b);
+int jot_NumNumLessEqualInt(double a, int64_t b);
+
+/* Converts a float to the integer with exactly its value, if there is one. */
+int jot_NumToInt(double value, int64_t* result);
+
+enum
+{
+    /* Enough for any number jot_NumFormat writes, and its NUL. */
+    JOT_NUM_FORMAT_SIZE = 32
+};
+
+/*
+    Writes a number the way scripts see it turned into a string, and
+    returns its length. Floats always come out with a '.', an exponent or
+    as inf or nan, so they can't be mistaken for integers.
+*/
+size_t jot_NumFormatInt(int64_t value, char* buffer);
+size_t jot_NumFormat(double value, char* buffer);
+
+#endif
@@ -0,0 +1,670 @@
+/* Generated by src/tools/jot_numgen.c -- do not edit. */
+#ifndef JOT_NUMTAB_H
+#define JOT_NUMTAB_H
+
+enum
+{
+    JOT_NUM_POW5_MIN = -342,
+    JOT_NUM_POW5_MAX = 308
+};
+
+#define JOT_NUM_U64(high, low) ((uint64_t) (high) << 32 | (low))
+
+/* High then low 64 bits of 5^q, for q = JOT_NUM_POW5_MIN .. JOT_NUM_POW5_MAX. */
+static const uint64_t jot_num_pow5[651][2] = {
+    {JOT_NUM_U64(0xEEF453D6UL, 0x923BD65AUL), JOT_NUM_U64(0x113FAA29UL, 0x06A13B3FUL)}, /* -342 */
+    {JOT_NUM_U64(0x9558B466UL, 0x1B6565F8UL), JOT_NUM_U64(0x4AC7CA59UL, 0xA424C507UL)}, /* -341 */
+    {JOT_NUM_U64(0xBAAEE17FUL, 0xA23EBF76UL), JOT_NUM_U64(0x5D79BCF0UL, 0x0D2DF649UL)}, /* -340 */
+    {JOT_NUM_U64(0xE95A99DFUL, 0x8ACE6F53UL), JOT_NUM_U64(0xF4D82C2CUL, 0x107973DCUL)}, /* -339 */
+    {JOT_NUM_U64(0x91D8A02BUL, 0xB6C10594UL), JOT_NUM_U64(0x79071B9BUL, 0x8A4BE869UL)}, /* -338 */
+    {JOT_NUM_U64(0xB64EC836UL, 0xA47146F9UL), JOT_NUM_U64(0x9748E282UL, 0x6CDEE284UL)}, /* -337 */
+    {JOT_NUM_U64(0xE3E27A44UL, 0x4D8D98B7UL), JOT_NUM_U64(0xFD1B1B23UL, 0x08169B25UL)}, /* -336 */
+    {JOT_NUM_U64(0x8E6D8C6AUL, 0xB0787F72UL), JOT_NUM_U64(0xFE30F0F5UL, 0xE50E20F7UL)}, /* -335 */
+    {JOT_NUM_U64(0xB208EF85UL, 0x5C969F4FUL), JOT_NUM_U64(0xBDBD2D33UL, 0x5E51A935UL)}, /* -334 */
+    {JOT_NUM_U64(0xDE8B2B66UL, 0xB3BC4723UL), JOT_NUM_U64(0xAD2C7880UL, 0x35E61382UL)}, /* -333 */
+    {JOT_NUM_U64(0x8B16FB20UL, 0x3055AC76UL), JOT_NUM_U64(0x4C3BCB50UL, 0x21AFCC31UL)}, /* -332 */
+    {JOT_NUM_U64(0xADDCB9E8UL, 0x3C6B1793UL), JOT_NUM_U64(0xDF4ABE24UL, 0x2A1BBF3DUL)}, /* -331 */
+    {JOT_NUM_U64(0xD953E862UL, 0x4B85DD78UL), JOT_NUM_U64(0xD71D6DADUL, 0x34A2AF0DUL)}, /* -330 */
+    {JOT_NUM_U64(0x87D4713DUL, 0x6F33AA6BUL), JOT_NUM_U64(0x8672648CUL, 0x40E5AD68UL)}, /* -329 */
+    {JOT_NUM_U64(0xA9C98D8CUL, 0xCB009506UL), JOT_NUM_U64(0x680EFDAFUL, 0x511F18C2UL)}, /* -328 */
+    {JOT_NUM_U64(0xD43BF0EFUL, 0xFDC0BA48UL), JOT_NUM_U64(0x0212BD1BUL, 0x2566DEF2UL)}, /* -327 */
+    {JOT_NUM_U64(0x84A57695UL, 0xFE98746DUL), JOT_NUM_U64(0x014BB630UL, 0xF7604B57UL)}, /* -326 */
+    {JOT_NUM_U64(0xA5CED43BUL, 0x7E3E9188UL), JOT_NUM_U64(0x419EA3BDUL, 0x35385E2DUL)}, /* -325 */
+    {JOT_NUM_U64(0xCF42894AUL, 0x5DCE35EAUL), JOT_NUM_U64(0x52064CACUL, 0x828675B9UL)}, /* -324 */
+    {JOT_NUM_U64(0x818995CEUL, 0x7AA0E1B2UL), JOT_NUM_U64(0x7343EFEBUL, 0xD1940993UL)}, /* -323 */
+    {JOT_NUM_U64(0xA1EBFB42UL, 0x19491A1FUL), JOT_NUM_U64(0x1014EBE6UL, 0xC5F90BF8UL)}, /* -322 */
+    {JOT_NUM_U64(0xCA66FA12UL, 0x9F9B60A6UL), JOT_NUM_U64(0xD41A26E0UL, 0x77774EF6UL)}, /* -321 */
+    {JOT_NUM_U64(0xFD00B897UL, 0x478238D0UL), JOT_NUM_U64(0x8920B098UL, 0x955522B4UL)}, /* -320 */
+    {JOT_NUM_U64(0x9E20735EUL, 0x8CB16382UL), JOT_NUM_U64(0x55B46E5FUL, 0x5D5535B0UL)}, /* -319 */
+    {JOT_NUM_U64(0xC5A89036UL, 0x2FDDBC62UL), JOT_NUM_U64(0xEB2189F7UL, 0x34AA831DUL)}, /* -318 */
+    {JOT_NUM_U64(0xF712B443UL, 0xBBD52B7BUL), JOT_NUM_U64(0xA5E9EC75UL, 0x01D523E4UL)}, /* -317 */
+    {JOT_NUM_U64(0x9A6BB0AAUL, 0x55653B2DUL), JOT_NUM_U64(0x47B233C9UL, 0x2125366EUL)}, /* -316 */
+    {JOT_NUM_U64(0xC1069CD4UL, 0xEABE89F8UL), JOT_NUM_U64(0x999EC0BBUL, 0x696E840AUL)}, /* -315 */
+    {JOT_NUM_U64(0xF148440AUL, 0x256E2C76UL), JOT_NUM_U64(0xC00670EAUL, 0x43CA250DUL)}, /* -314 */
+    {JOT_NUM_U64(0x96CD2A86UL, 0x5764DBCAUL), JOT_NUM_U64(0x38040692UL, 0x6A5E5728UL)}, /* -313 */
+    {JOT_NUM_U64(0xBC807527UL, 0xED3E12BCUL), JOT_NUM_U64(0xC6050837UL, 0x04F5ECF2UL)}, /* -312 */
+    {JOT_NUM_U64(0xEBA09271UL, 0xE88D976BUL), JOT_NUM_U64(0xF7864A44UL, 0xC633682EUL)}, /* -311 */
+    {JOT_NUM_U64(0x93445B87UL, 0x31587EA3UL), JOT_NUM_U64(0x7AB3EE6AUL, 0xFBE0211DUL)}, /* -310 */
+    {JOT_NUM_U64(0xB8157268UL, 0xFDAE9E4CUL), JOT_NUM_U64(0x5960EA05UL, 0xBAD82964UL)}, /* -309 */
+    {JOT_NUM_U64(0xE61ACF03UL, 0x3D1A45DFUL), JOT_NUM_U64(0x6FB92487UL, 0x298E33BDUL)}, /* -308 */
+    {JOT_NUM_U64(0x8FD0C162UL, 0x06306BABUL), JOT_NUM_U64(0xA5D3B6D4UL, 0x79F8E056UL)}, /* -307 */
+    {JOT_NUM_U64(0xB3C4F1BAUL, 0x87BC8696UL), JOT_NUM_U64(0x8F48A489UL, 0x9877186CUL)}, /* -306 */
+    {JOT_NUM_U64(0xE0B62E29UL, 0x29ABA83CUL), JOT_NUM_U64(0x331ACDABUL, 0xFE94DE87UL)}, /* -305 */
+    {JOT_NUM_U64(0x8C71DCD9UL, 0xBA0B4925UL), JOT_NUM_U64(0x9FF0C08BUL, 0x7F1D0B14UL)}, /* -304 */
+    {JOT_NUM_U64(0xAF8E5410UL, 0x288E1B6FUL), JOT_NUM_U64(0x07ECF0AEUL, 0x5EE44DD9UL)}, /* -303 */
+    {JOT_NUM_U64(0xDB71E914UL, 0x32B1A24AUL), JOT_NUM_U64(0xC9E82CD9UL, 0xF69D6150UL)}, /* -302 */
+    {JOT_NUM_U64(0x892731ACUL, 0x9FAF056EUL), JOT_NUM_U64(0xBE311C08UL, 0x3A225CD2UL)}, /* -301 */
+    {JOT_NUM_U64(0xAB70FE17UL, 0xC79AC6CAUL), JOT_NUM_U64(0x6DBD630AUL, 0x48AAF406UL)}, /* -300 */
+    {JOT_NUM_U64(0xD64D3D9DUL, 0xB981787DUL), JOT_NUM_U64(0x092CBBCCUL, 0xDAD5B108UL)}, /* -299 */
+    {JOT_NUM_U64(0x85F04682UL, 0x93F0EB4EUL), JOT_NUM_U64(0x25BBF560UL, 0x08C58EA5UL)}, /* -298 */
+    {JOT_NUM_U64(0xA76C5823UL, 0x38ED2621UL), JOT_NUM_U64(0xAF2AF2B8UL, 0x0AF6F24EUL)}, /* -297 */
+    {JOT_NUM_U64(0xD1476E2CUL, 0x07286FAAUL), JOT_NUM_U64(0x1AF5AF66UL, 0x0DB4AEE1UL)}, /* -296 */
+    {JOT_NUM_U64(0x82CCA4DBUL, 0x847945CAUL), JOT_NUM_U64(0x50D98D9FUL, 0xC890ED4DUL)}, /* -295 */
+    {JOT_NUM_U64(0xA37FCE12UL, 0x6597973CUL), JOT_NUM_U64(0xE50FF107UL, 0xBAB528A0UL)}, /* -294 */
+    {JOT_NUM_U64(0xCC5FC196UL, 0xFEFD7D0CUL), JOT_NUM_U64(0x1E53ED49UL, 0xA96272C8UL)}, /* -293 */
+    {JOT_NUM_U64(0xFF77B1FCUL, 0xBEBCDC4FUL), JOT_NUM_U64(0x25E8E89CUL, 0x13BB0F7AUL)}, /* -292 */
+    {JOT_NUM_U64(0x9FAACF3DUL, 0xF73609B1UL), JOT_NUM_U64(0x77B19161UL, 0x8C54E9ACUL)}, /* -291 */
+    {JOT_NUM_U64(0xC795830DUL, 0x75038C1DUL), JOT_NUM_U64(0xD59DF5B9UL, 0xEF6A2417UL)}, /* -290 */
+    {JOT_NUM_U64(0xF97AE3D0UL, 0xD2446F25UL), JOT_NUM_U64(0x4B057328UL, 0x6B44AD1DUL)}, /* -289 */
+    {JOT_NUM_U64(0x9BECCE62UL, 0x836AC577UL), JOT_NUM_U64(0x4EE367F9UL, 0x430AEC32UL)}, /* -288 */
+    {JOT_NUM_U64(0xC2E801FBUL, 0x244576D5UL), JOT_NUM_U64(0x229C41F7UL, 0x93CDA73FUL)}, /* -287 */
+    {JOT_NUM_U64(0xF3A20279UL, 0xED56D48AUL), JOT_NUM_U64(0x6B435275UL, 0x78C1110FUL)}, /* -286 */
+    {JOT_NUM_U64(0x9845418CUL, 0x345644D6UL), JOT_NUM_U64(0x830A1389UL, 0x6B78AAA9UL)}, /* -285 */
+    {JOT_NUM_U64(0xBE5691EFUL, 0x416BD60CUL), JOT_NUM_U64(0x23CC986BUL, 0xC656D553UL)}, /* -284 */
+    {JOT_NUM_U64(0xEDEC366BUL, 0x11C6CB8FUL), JOT_NUM_U64(0x2CBFBE86UL, 0xB7EC8AA8UL)}, /* -283 */
+    {JOT_NUM_U64(0x94B3A202UL, 0xEB1C3F39UL), JOT_NUM_U64(0x7BF7D714UL, 0x32F3D6A9UL)}, /* -282 */
+    {JOT_NUM_U64(0xB9E08A83UL, 0xA5E34F07UL), JOT_NUM_U64(0xDAF5CCD9UL, 0x3FB0CC53UL)}, /* -281 */
+    {JOT_NUM_U64(0xE858AD24UL, 0x8F5C22C9UL), JOT_NUM_U64(0xD1B3400FUL, 0x8F9CFF68UL)}, /* -280 */
+    {JOT_NUM_U64(0x91376C36UL, 0xD99995BEUL), JOT_NUM_U64(0x23100809UL, 0xB9C21FA1UL)}, /* -279 */
+    {JOT_NUM_U64(0xB5854744UL, 0x8FFFFB2DUL), JOT_NUM_U64(0xABD40A0CUL, 0x2832A78AUL)}, /* -278 */
+    {JOT_NUM_U64(0xE2E69915UL, 0xB3FFF9F9UL), JOT_NUM_U64(0x16C90C8FUL, 0x323F516CUL)}, /* -277 */
+    {JOT_NUM_U64(0x8DD01FADUL, 0x907FFC3BUL), JOT_NUM_U64(0xAE3DA7D9UL, 0x7F6792E3UL)}, /* -276 */
+    {JOT_NUM_U64(0xB1442798UL, 0xF49FFB4AUL), JOT_NUM_U64(0x99CD11CFUL, 0xDF41779CUL)}, /* -275 */
+    {JOT_NUM_U64(0xDD95317FUL, 0x31C7FA1DUL), JOT_NUM_U64(0x40405643UL, 0xD711D583UL)}, /* -274 */
+    {JOT_NUM_U64(0x8A7D3EEFUL, 0x7F1CFC52UL), JOT_NUM_U64(0x482835EAUL, 0x666B2572UL)}, /* -273 */
+    {JOT_NUM_U64(0xAD1C8EABUL, 0x5EE43B66UL), JOT_NUM_U64(0xDA324365UL, 0x0005EECFUL)}, /* -272 */
+    {JOT_NUM_U64(0xD863B256UL, 0x369D4A40UL), JOT_NUM_U64(0x90BED43EUL, 0x40076A82UL)}, /* -271 */
+    {JOT_NUM_U64(0x873E4F75UL, 0xE2224E68UL), JOT_NUM_U64(0x5A7744A6UL, 0xE804A291UL)}, /* -270 */
+    {JOT_NUM_U64(0xA90DE353UL, 0x5AAAE202UL), JOT_NUM_U64(0x711515D0UL, 0xA205CB36UL)}, /* -269 */
+    {JOT_NUM_U64(0xD3515C28UL, 0x31559A83UL), JOT_NUM_U64(0x0D5A5B44UL, 0xCA873E03UL)}, /* -268 */
+    {JOT_NUM_U64(0x8412D999UL, 0x1ED58091UL), JOT_NUM_U64(0xE858790AUL, 0xFE9486C2UL)}, /* -267 */
+    {JOT_NUM_U64(0xA5178FFFUL, 0x668AE0B6UL), JOT_NUM_U64(0x626E974DUL, 0xBE39A872UL)}, /* -266 */
+    {JOT_NUM_U64(0xCE5D73FFUL, 0x402D98E3UL), JOT_NUM_U64(0xFB0A3D21UL, 0x2DC8128FUL)}, /* -265 */
+    {JOT_NUM_U64(0x80FA687FUL, 0x881C7F8EUL), JOT_NUM_U64(0x7CE66634UL, 0xBC9D0B99UL)}, /* -264 */
+    {JOT_NUM_U64(0xA139029FUL, 0x6A239F72UL), JOT_NUM_U64(0x1C1FFFC1UL, 0xEBC44E80UL)}, /* -263 */
+    {JOT_NUM_U64(0xC9874347UL, 0x44AC874EUL), JOT_NUM_U64(0xA327FFB2UL, 0x66B56220UL)}, /* -262 */
+    {JOT_NUM_U64(0xFBE91419UL, 0x15D7A922UL), JOT_NUM_U64(0x4BF1FF9FUL, 0x0062BAA8UL)}, /* -261 */
+    {JOT_NUM_U64(0x9D71AC8FUL, 0xADA6C9B5UL), JOT_NUM_U64(0x6F773FC3UL, 0x603DB4A9UL)}, /* -260 */
+    {JOT_NUM_U64(0xC4CE17B3UL, 0x99107C22UL), JOT_NUM_U64(0xCB550FB4UL, 0x384D21D3UL)}, /* -259 */
+    {JOT_NUM_U64(0xF6019DA0UL, 0x7F549B2BUL), JOT_NUM_U64(0x7E2A53A1UL, 0x46606A48UL)}, /* -258 */
+    {JOT_NUM_U64(0x99C10284UL, 0x4F94E0FBUL), JOT_NUM_U64(0x2EDA7444UL, 0xCBFC426DUL)}, /* -257 */
+    {JOT_NUM_U64(0xC0314325UL, 0x637A1939UL), JOT_NUM_U64(0xFA911155UL, 0xFEFB5308UL)}, /* -256 */
+    {JOT_NUM_U64(0xF03D93EEUL, 0xBC589F88UL), JOT_NUM_U64(0x793555ABUL, 0x7EBA27CAUL)}, /* -255 */
+    {JOT_NUM_U64(0x96267C75UL, 0x35B763B5UL), JOT_NUM_U64(0x4BC1558BUL, 0x2F3458DEUL)}, /* -254 */
+    {JOT_NUM_U64(0xBBB01B92UL, 0x83253CA2UL), JOT_NUM_U64(0x9EB1AAEDUL, 0xFB016F16UL)}, /* -253 */
+    {JOT_NUM_U64(0xEA9C2277UL, 0x23EE8BCBUL), JOT_NUM_U64(0x465E15A9UL, 0x79C1CADCUL)}, /* -252 */
+    {JOT_NUM_U64(0x92A1958AUL, 0x7675175FUL), JOT_NUM_U64(0x0BFACD89UL, 0xEC191EC9UL)}, /* -251 */
+    {JOT_NUM_U64(0xB749FAEDUL, 0x14125D36UL), JOT_NUM_U64(0xCEF980ECUL, 0x671F667BUL)}, /* -250 */
+    {JOT_NUM_U64(0xE51C79A8UL, 0x5916F484UL), JOT_NUM_U64(0x82B7E127UL, 0x80E7401AUL)}, /* -249 */
+    {JOT_NUM_U64(0x8F31CC09UL, 0x37AE58D2UL), JOT_NUM_U64(0xD1B2ECB8UL, 0xB0908810UL)}, /* -248 */
+    {JOT_NUM_U64(0xB2FE3F0BUL, 0x8599EF07UL), JOT_NUM_U64(0x861FA7E6UL, 0xDCB4AA15UL)}, /* -247 */
+    {JOT_NUM_U64(0xDFBDCECEUL, 0x67006AC9UL), JOT_NUM_U64(0x67A791E0UL, 0x93E1D49AUL)}, /* -246 */
+    {JOT_NUM_U64(0x8BD6A141UL, 0x006042BDUL), JOT_NUM_U64(0xE0C8BB2CUL, 0x5C6D24E0UL)}, /* -245 */
+    {JOT_NUM_U64(0xAECC4991UL, 0x4078536DUL), JOT_NUM_U64(0x58FAE9F7UL, 0x73886E18UL)}, /* -244 */
+    {JOT_NUM_U64(0xDA7F5BF5UL, 0x90966848UL), JOT_NUM_U64(0xAF39A475UL, 0x506A899EUL)}, /* -243 */
+    {JOT_NUM_U64(0x888F9979UL, 0x7A5E012DUL), JOT_NUM_U64(0x6D8406C9UL, 0x52429603UL)}, /* -242 */
+    {JOT_NUM_U64(0xAAB37FD7UL, 0xD8F58178UL), JOT_NUM_U64(0xC8E5087BUL, 0xA6D33B83UL)}, /* -241 */
+    {JOT_NUM_U64(0xD5605FCDUL, 0xCF32E1D6UL), JOT_NUM_U64(0xFB1E4A9AUL, 0x90880A64UL)}, /* -240 */
+    {JOT_NUM_U64(0x855C3BE0UL, 0xA17FCD26UL), JOT_NUM_U64(0x5CF2EEA0UL, 0x9A55067FUL)}, /* -239 */
+    {JOT_NUM_U64(0xA6B34AD8UL, 0xC9DFC06FUL), JOT_NUM_U64(0xF42FAA48UL, 0xC0EA481EUL)}, /* -238 */
+    {JOT_NUM_U64(0xD0601D8EUL, 0xFC57B08BUL), JOT_NUM_U64(0xF13B94DAUL, 0xF124DA26UL)}, /* -237 */
+    {JOT_NUM_U64(0x823C1279UL, 0x5DB6CE57UL), JOT_NUM_U64(0x76C53D08UL, 0xD6B70858UL)}, /* -236 */
+    {JOT_NUM_U64(0xA2CB1717UL, 0xB52481EDUL), JOT_NUM_U64(0x54768C4BUL, 0x0C64CA6EUL)}, /* -235 */
+    {JOT_NUM_U64(0xCB7DDCDDUL, 0xA26DA268UL), JOT_NUM_U64(0xA9942F5DUL, 0xCF7DFD09UL)}, /* -234 */
+    {JOT_NUM_U64(0xFE5D5415UL, 0x0B090B02UL), JOT_NUM_U64(0xD3F93B35UL, 0x435D7C4CUL)}, /* -233 */
+    {JOT_NUM_U64(0x9EFA548DUL, 0x26E5A6E1UL), JOT_NUM_U64(0xC47BC501UL, 0x4A1A6DAFUL)}, /* -232 */
+    {JOT_NUM_U64(0xC6B8E9B0UL, 0x709F109AUL), JOT_NUM_U64(0x359AB641UL, 0x9CA1091BUL)}, /* -231 */
+    {JOT_NUM_U64(0xF867241CUL, 0x8CC6D4C0UL), JOT_NUM_U64(0xC30163D2UL, 0x03C94B62UL)}, /* -230 */
+    {JOT_NUM_U64(0x9B407691UL, 0xD7FC44F8UL), JOT_NUM_U64(0x79E0DE63UL, 0x425DCF1DUL)}, /* -229 */
+    {JOT_NUM_U64(0xC2109436UL, 0x4DFB5636UL), JOT_NUM_U64(0x985915FCUL, 0x12F542E4UL)}, /* -228 */
+    {JOT_NUM_U64(0xF294B943UL, 0xE17A2BC4UL), JOT_NUM_U64(0x3E6F5B7BUL, 0x17B2939DUL)}, /* -227 */
+    {JOT_NUM_U64(0x979CF3CAUL, 0x6CEC5B5AUL), JOT_NUM_U64(0xA705992CUL, 0xEECF9C42UL)}, /* -226 */
+    {JOT_NUM_U64(0xBD8430BDUL, 0x08277231UL), JOT_NUM_U64(0x50C6FF78UL, 0x2A838353UL)}, /* -225 */
+    {JOT_NUM_U64(0xECE53CECUL, 0x4A314EBDUL), JOT_NUM_U64(0xA4F8BF56UL, 0x35246428UL)}, /* -224 */
+    {JOT_NUM_U64(0x940F4613UL, 0xAE5ED136UL), JOT_NUM_U64(0x871B7795UL, 0xE136BE99UL)}, /* -223 */
+    {JOT_NUM_U64(0xB9131798UL, 0x99F68584UL), JOT_NUM_U64(0x28E2557BUL, 0x59846E3FUL)}, /* -222 */
+    {JOT_NUM_U64(0xE757DD7EUL, 0xC07426E5UL), JOT_NUM_U64(0x331AEADAUL, 0x2FE589CFUL)}, /* -221 */
+    {JOT_NUM_U64(0x9096EA6FUL, 0x3848984FUL), JOT_NUM_U64(0x3FF0D2C8UL, 0x5DEF7621UL)}, /* -220 */
+    {JOT_NUM_U64(0xB4BCA50BUL, 0x065ABE63UL), JOT_NUM_U64(0x0FED077AUL, 0x756B53A9UL)}, /* -219 */
+    {JOT_NUM_U64(0xE1EBCE4DUL, 0xC7F16DFBUL), JOT_NUM_U64(0xD3E84959UL, 0x12C62894UL)}, /* -218 */
+    {JOT_NUM_U64(0x8D3360F0UL, 0x9CF6E4BDUL), JOT_NUM_U64(0x64712DD7UL, 0xABBBD95CUL)}, /* -217 */
+    {JOT_NUM_U64(0xB080392CUL, 0xC4349DECUL), JOT_NUM_U64(0xBD8D794DUL, 0x96AACFB3UL)}, /* -216 */
+    {JOT_NUM_U64(0xDCA04777UL, 0xF541C567UL), JOT_NUM_U64(0xECF0D7A0UL, 0xFC5583A0UL)}, /* -215 */
+    {JOT_NUM_U64(0x89E42CAAUL, 0xF9491B60UL), JOT_NUM_U64(0xF41686C4UL, 0x9DB57244UL)}, /* -214 */
+    {JOT_NUM_U64(0xAC5D37D5UL, 0xB79B6239UL), JOT_NUM_U64(0x311C2875UL, 0xC522CED5UL)}, /* -213 */
+    {JOT_NUM_U64(0xD77485CBUL, 0x25823AC7UL), JOT_NUM_U64(0x7D633293UL, 0x366B828BUL)}, /* -212 */
+    {JOT_NUM_U64(0x86A8D39EUL, 0xF77164BCUL), JOT_NUM_U64(0xAE5DFF9CUL, 0x02033197UL)}, /* -211 */
+    {JOT_NUM_U64(0xA8530886UL, 0xB54DBDEBUL), JOT_NUM_U64(0xD9F57F83UL, 0x0283FDFCUL)}, /* -210 */
+    {JOT_NUM_U64(0xD267CAA8UL, 0x62A12D66UL), JOT_NUM_U64(0xD072DF63UL, 0xC324FD7BUL)}, /* -209 */
+    {JOT_NUM_U64(0x8380DEA9UL, 0x3DA4BC60UL), JOT_NUM_U64(0x4247CB9EUL, 0x59F71E6DUL)}, /* -208 */
+    {JOT_NUM_U64(0xA4611653UL, 0x8D0DEB78UL), JOT_NUM_U64(0x52D9BE85UL, 0xF074E608UL)}, /* -207 */
+    {JOT_NUM_U64(0xCD795BE8UL, 0x70516656UL), JOT_NUM_U64(0x67902E27UL, 0x6C921F8BUL)}, /* -206 */
+    {JOT_NUM_U64(0x806BD971UL, 0x4632DFF6UL), JOT_NUM_U64(0x00BA1CD8UL, 0xA3DB53B6UL)}, /* -205 */
+    {JOT_NUM_U64(0xA086CFCDUL, 0x97BF97F3UL), JOT_NUM_U64(0x80E8A40EUL, 0xCCD228A4UL)}, /* -204 */
+    {JOT_NUM_U64(0xC8A883C0UL, 0xFDAF7DF0UL), JOT_NUM_U64(0x6122CD12UL, 0x8006B2CDUL)}, /* -203 */
+    {JOT_NUM_U64(0xFAD2A4B1UL, 0x3D1B5D6CUL), JOT_NUM_U64(0x796B8057UL, 0x20085F81UL)}, /* -202 */
+    {JOT_NUM_U64(0x9CC3A6EEUL, 0xC6311A63UL), JOT_NUM_U64(0xCBE33036UL, 0x74053BB0UL)}, /* -201 */
+    {JOT_NUM_U64(0xC3F490AAUL, 0x77BD60FCUL), JOT_NUM_U64(0xBEDBFC44UL, 0x11068A9CUL)}, /* -200 */
+    {JOT_NUM_U64(0xF4F1B4D5UL, 0x15ACB93BUL), JOT_NUM_U64(0xEE92FB55UL, 0x15482D44UL)}, /* -199 */
+    {JOT_NUM_U64(0x99171105UL, 0x2D8BF3C5UL), JOT_NUM_U64(0x751BDD15UL, 0x2D4D1C4AUL)}, /* -198 */
+    {JOT_NUM_U64(0xBF5CD546UL, 0x78EEF0B6UL), JOT_NUM_U64(0xD262D45AUL, 0x78A0635DUL)}, /* -197 */
+    {JOT_NUM_U64(0xEF340A98UL, 0x172AACE4UL), JOT_NUM_U64(0x86FB8971UL, 0x16C87C34UL)}, /* -196 */
+    {JOT_NUM_U64(0x9580869FUL, 0x0E7AAC0EUL), JOT_NUM_U64(0xD45D35E6UL, 0xAE3D4DA0UL)}, /* -195 */
+    {JOT_NUM_U64(0xBAE0A846UL, 0xD2195712UL), JOT_NUM_U64(0x89748360UL, 0x59CCA109UL)}, /* -194 */
+    {JOT_NUM_U64(0xE998D258UL, 0x869FACD7UL), JOT_NUM_U64(0x2BD1A438UL, 0x703FC94BUL)}, /* -193 */
+    {JOT_NUM_U64(0x91FF8377UL, 0x5423CC06UL), JOT_NUM_U64(0x7B6306A3UL, 0x4627DDCFUL)}, /* -192 */
+    {JOT_NUM_U64(0xB67F6455UL, 0x292CBF08UL), JOT_NUM_U64(0x1A3BC84CUL, 0x17B1D542UL)}, /* -191 */
+    {JOT_NUM_U64(0xE41F3D6AUL, 0x7377EECAUL), JOT_NUM_U64(0x20CABA5FUL, 0x1D9E4A93UL)}, /* -190 */
+    {JOT_NUM_U64(0x8E938662UL, 0x882AF53EUL), JOT_NUM_U64(0x547EB47BUL, 0x7282EE9CUL)}, /* -189 */
+    {JOT_NUM_U64(0xB23867FBUL, 0x2A35B28DUL), JOT_NUM_U64(0xE99E619AUL, 0x4F23AA43UL)}, /* -188 */
+    {JOT_NUM_U64(0xDEC681F9UL, 0xF4C31F31UL), JOT_NUM_U64(0x6405FA00UL, 0xE2EC94D4UL)}, /* -187 */
+    {JOT_NUM_U64(0x8B3C113CUL, 0x38F9F37EUL), JOT_NUM_U64(0xDE83BC40UL, 0x8DD3DD04UL)}, /* -186 */
+    {JOT_NUM_U64(0xAE0B158BUL, 0x4738705EUL), JOT_NUM_U64(0x9624AB50UL, 0xB148D445UL)}, /* -185 */
+    {JOT_NUM_U64(0xD98DDAEEUL, 0x19068C76UL), JOT_NUM_U64(0x3BADD624UL, 0xDD9B0957UL)}, /* -184 */
+    {JOT_NUM_U64(0x87F8A8D4UL, 0xCFA417C9UL), JOT_NUM_U64(0xE54CA5D7UL, 0x0A80E5D6UL)}, /* -183 */
+    {JOT_NUM_U64(0xA9F6D30AUL, 0x038D1DBCUL), JOT_NUM_U64(0x5E9FCF4CUL, 0xCD211F4CUL)}, /* -182 */
+    {JOT_NUM_U64(0xD47487CCUL, 0x8470652BUL), JOT_NUM_U64(0x7647C320UL, 0x0069671FUL)}, /* -181 */
+    {JOT_NUM_U64(0x84C8D4DFUL, 0xD2C63F3BUL), JOT_NUM_U64(0x29ECD9F4UL, 0x0041E073UL)}, /* -180 */
+    {JOT_NUM_U64(0xA5FB0A17UL, 0xC777CF09UL), JOT_NUM_U64(0xF4681071UL, 0x00525890UL)}, /* -179 */
+    {JOT_NUM_U64(0xCF79CC9DUL, 0xB955C2CCUL), JOT_NUM_U64(0x7182148DUL, 0x4066EEB4UL)}, /* -178 */
+    {JOT_NUM_U64(0x81AC1FE2UL, 0x93D599BFUL), JOT_NUM_U64(0xC6F14CD8UL, 0x48405530UL)}, /* -177 */
+    {JOT_NUM_U64(0xA21727DBUL, 0x38CB002FUL), JOT_NUM_U64(0xB8ADA00EUL, 0x5A506A7CUL)}, /* -176 */
+    {JOT_NUM_U64(0xCA9CF1D2UL, 0x06FDC03BUL), JOT_NUM_U64(0xA6D90811UL, 0xF0E4851CUL)}, /* -175 */
+    {JOT_NUM_U64(0xFD442E46UL, 0x88BD304AUL), JOT_NUM_U64(0x908F4A16UL, 0x6D1DA663UL)}, /* -174 */
+    {JOT_NUM_U64(0x9E4A9CECUL, 0x15763E2EUL), JOT_NUM_U64(0x9A598E4EUL, 0x043287FEUL)}, /* -173 */
+    {JOT_NUM_U64(0xC5DD4427UL, 0x1AD3CDBAUL), JOT_NUM_U64(0x40EFF1E1UL, 0x853F29FDUL)}, /* -172 */
+    {JOT_NUM_U64(0xF7549530UL, 0xE188C128UL), JOT_NUM_U64(0xD12BEE59UL, 0xE68EF47CUL)}, /* -171 */
+    {JOT_NUM_U64(0x9A94DD3EUL, 0x8CF578B9UL), JOT_NUM_U64(0x82BB74F8UL, 0x301958CEUL)}, /* -170 */
+    {JOT_NUM_U64(0xC13A148EUL, 0x3032D6E7UL), JOT_NUM_U64(0xE36A5236UL, 0x3C1FAF01UL)}, /* -169 */
+    {JOT_NUM_U64(0xF18899B1UL, 0xBC3F8CA1UL), JOT_NUM_U64(0xDC44E6C3UL, 0xCB279AC1UL)}, /* -168 */
+    {JOT_NUM_U64(0x96F5600FUL, 0x15A7B7E5UL), JOT_NUM_U64(0x29AB103AUL, 0x5EF8C0B9UL)}, /* -167 */
+    {JOT_NUM_U64(0xBCB2B812UL, 0xDB11A5DEUL), JOT_NUM_U64(0x7415D448UL, 0xF6B6F0E7UL)}, /* -166 */
+    {JOT_NUM_U64(0xEBDF6617UL, 0x91D60F56UL), JOT_NUM_U64(0x111B495BUL, 0x3464AD21UL)}, /* -165 */
+    {JOT_NUM_U64(0x936B9FCEUL, 0xBB25C995UL), JOT_NUM_U64(0xCAB10DD9UL, 0x00BEEC34UL)}, /* -164 */
+    {JOT_NUM_U64(0xB84687C2UL, 0x69EF3BFBUL), JOT_NUM_U64(0x3D5D514FUL, 0x40EEA742UL)}, /* -163 */
+    {JOT_NUM_U64(0xE65829B3UL, 0x046B0AFAUL), JOT_NUM_U64(0x0CB4A5A3UL, 0x112A5112UL)}, /* -162 */
+    {JOT_NUM_U64(0x8FF71A0FUL, 0xE2C2E6DCUL), JOT_NUM_U64(0x47F0E785UL, 0xEABA72ABUL)}, /* -161 */
+    {JOT_NUM_U64(0xB3F4E093UL, 0xDB73A093UL), JOT_NUM_U64(0x59ED2167UL, 0x65690F56UL)}, /* -160 */
+    {JOT_NUM_U64(0xE0F218B8UL, 0xD25088B8UL), JOT_NUM_U64(0x306869C1UL, 0x3EC3532CUL)}, /* -159 */
+    {JOT_NUM_U64(0x8C974F73UL, 0x83725573UL), JOT_NUM_U64(0x1E414218UL, 0xC73A13FBUL)}, /* -158 */
+    {JOT_NUM_U64(0xAFBD2350UL, 0x644EEACFUL), JOT_NUM_U64(0xE5D1929EUL, 0xF90898FAUL)}, /* -157 */
+    {JOT_NUM_U64(0xDBAC6C24UL, 0x7D62A583UL), JOT_NUM_U64(0xDF45F746UL, 0xB74ABF39UL)}, /* -156 */
+    {JOT_NUM_U64(0x894BC396UL, 0xCE5DA772UL), JOT_NUM_U64(0x6B8BBA8CUL, 0x328EB783UL)}, /* -155 */
+    {JOT_NUM_U64(0xAB9EB47CUL, 0x81F5114FUL), JOT_NUM_U64(0x066EA92FUL, 0x3F326564UL)}, /* -154 */
+    {JOT_NUM_U64(0xD686619BUL, 0xA27255A2UL), JOT_NUM_U64(0xC80A537BUL, 0x0EFEFEBDUL)}, /* -153 */
+    {JOT_NUM_U64(0x8613FD01UL, 0x45877585UL), JOT_NUM_U64(0xBD06742CUL, 0xE95F5F36UL)}, /* -152 */
+    {JOT_NUM_U64(0xA798FC41UL, 0x96E952E7UL), JOT_NUM_U64(0x2C481138UL, 0x23B73704UL)}, /* -151 */
+    {JOT_NUM_U64(0xD17F3B51UL, 0xFCA3A7A0UL), JOT_NUM_U64(0xF75A1586UL, 0x2CA504C5UL)}, /* -150 */
+    {JOT_NUM_U64(0x82EF8513UL, 0x3DE648C4UL), JOT_NUM_U64(0x9A984D73UL, 0xDBE722FBUL)}, /* -149 */
+    {JOT_NUM_U64(0xA3AB6658UL, 0x0D5FDAF5UL), JOT_NUM_U64(0xC13E60D0UL, 0xD2E0EBBAUL)}, /* -148 */
+    {JOT_NUM_U64(0xCC963FEEUL, 0x10B7D1B3UL), JOT_NUM_U64(0x318DF905UL, 0x079926A8UL)}, /* -147 */
+    {JOT_NUM_U64(0xFFBBCFE9UL, 0x94E5C61FUL), JOT_NUM_U64(0xFDF17746UL, 0x497F7052UL)}, /* -146 */
+    {JOT_NUM_U64(0x9FD561F1UL, 0xFD0F9BD3UL), JOT_NUM_U64(0xFEB6EA8BUL, 0xEDEFA633UL)}, /* -145 */
+    {JOT_NUM_U64(0xC7CABA6EUL, 0x7C5382C8UL), JOT_NUM_U64(0xFE64A52EUL, 0xE96B8FC0UL)}, /* -144 */
+    {JOT_NUM_U64(0xF9BD690AUL, 0x1B68637BUL), JOT_NUM_U64(0x3DFDCE7AUL, 0xA3C673B0UL)}, /* -143 */
+    {JOT_NUM_U64(0x9C1661A6UL, 0x51213E2DUL), JOT_NUM_U64(0x06BEA10CUL, 0xA65C084EUL)}, /* -142 */
+    {JOT_NUM_U64(0xC31BFA0FUL, 0xE5698DB8UL), JOT_NUM_U64(0x486E494FUL, 0xCFF30A62UL)}, /* -141 */
+    {JOT_NUM_U64(0xF3E2F893UL, 0xDEC3F126UL), JOT_NUM_U64(0x5A89DBA3UL, 0xC3EFCCFAUL)}, /* -140 */
+    {JOT_NUM_U64(0x986DDB5CUL, 0x6B3A76B7UL), JOT_NUM_U64(0xF8962946UL, 0x5A75E01CUL)}, /* -139 */
+    {JOT_NUM_U64(0xBE895233UL, 0x86091465UL), JOT_NUM_U64(0xF6BBB397UL, 0xF1135823UL)}, /* -138 */
+    {JOT_NUM_U64(0xEE2BA6C0UL, 0x678B597FUL), JOT_NUM_U64(0x746AA07DUL, 0xED582E2CUL)}, /* -137 */
+    {JOT_NUM_U64(0x94DB4838UL, 0x40B717EFUL), JOT_NUM_U64(0xA8C2A44EUL, 0xB4571CDCUL)}, /* -136 */
+    {JOT_NUM_U64(0xBA121A46UL, 0x50E4DDEBUL), JOT_NUM_U64(0x92F34D62UL, 0x616CE413UL)}, /* -135 */
+    {JOT_NUM_U64(0xE896A0D7UL, 0xE51E1566UL), JOT_NUM_U64(0x77B020BAUL, 0xF9C81D17UL)}, /* -134 */
+    {JOT_NUM_U64(0x915E2486UL, 0xEF32CD60UL), JOT_NUM_U64(0x0ACE1474UL, 0xDC1D122EUL)}, /* -133 */
+    {JOT_NUM_U64(0xB5B5ADA8UL, 0xAAFF80B8UL), JOT_NUM_U64(0x0D819992UL, 0x132456BAUL)}, /* -132 */
+    {JOT_NUM_U64(0xE3231912UL, 0xD5BF60E6UL), JOT_NUM_U64(0x10E1FFF6UL, 0x97ED6C69UL)}, /* -131 */
+    {JOT_NUM_U64(0x8DF5EFABUL, 0xC5979C8FUL), JOT_NUM_U64(0xCA8D3FFAUL, 0x1EF463C1UL)}, /* -130 */
+    {JOT_NUM_U64(0xB1736B96UL, 0xB6FD83B3UL), JOT_NUM_U64(0xBD308FF8UL, 0xA6B17CB2UL)}, /* -129 */
+    {JOT_NUM_U64(0xDDD0467CUL, 0x64BCE4A0UL), JOT_NUM_U64(0xAC7CB3F6UL, 0xD05DDBDEUL)}, /* -128 */
+    {JOT_NUM_U64(0x8AA22C0DUL, 0xBEF60EE4UL), JOT_NUM_U64(0x6BCDF07AUL, 0x423AA96BUL)}, /* -127 */
+    {JOT_NUM_U64(0xAD4AB711UL, 0x2EB3929DUL), JOT_NUM_U64(0x86C16C98UL, 0xD2C953C6UL)}, /* -126 */
+    {JOT_NUM_U64(0xD89D64D5UL, 0x7A607744UL), JOT_NUM_U64(0xE871C7BFUL, 0x077BA8B7UL)}, /* -125 */
+    {JOT_NUM_U64(0x87625F05UL, 0x6C7C4A8BUL), JOT_NUM_U64(0x11471CD7UL, 0x64AD4972UL)}, /* -124 */
+    {JOT_NUM_U64(0xA93AF6C6UL, 0xC79B5D2DUL), JOT_NUM_U64(0xD598E40DUL, 0x3DD89BCFUL)}, /* -123 */
+    {JOT_NUM_U64(0xD389B478UL, 0x79823479UL), JOT_NUM_U64(0x4AFF1D10UL, 0x8D4EC2C3UL)}, /* -122 */
+    {JOT_NUM_U64(0x843610CBUL, 0x4BF160CBUL), JOT_NUM_U64(0xCEDF722AUL, 0x585139BAUL)}, /* -121 */
+    {JOT_NUM_U64(0xA54394FEUL, 0x1EEDB8FEUL), JOT_NUM_U64(0xC2974EB4UL, 0xEE658828UL)}, /* -120 */
+    {JOT_NUM_U64(0xCE947A3DUL, 0xA6A9273EUL), JOT_NUM_U64(0x733D2262UL, 0x29FEEA32UL)}, /* -119 */
+    {JOT_NUM_U64(0x811CCC66UL, 0x8829B887UL), JOT_NUM_U64(0x0806357DUL, 0x5A3F525FUL)}, /* -118 */
+    {JOT_NUM_U64(0xA163FF80UL, 0x2A3426A8UL), JOT_NUM_U64(0xCA07C2DCUL, 0xB0CF26F7UL)}, /* -117 */
+    {JOT_NUM_U64(0xC9BCFF60UL, 0x34C13052UL), JOT_NUM_U64(0xFC89B393UL, 0xDD02F0B5UL)}, /* -116 */
+    {JOT_NUM_U64(0xFC2C3F38UL, 0x41F17C67UL), JOT_NUM_U64(0xBBAC2078UL, 0xD443ACE2UL)}, /* -115 */
+    {JOT_NUM_U64(0x9D9BA783UL, 0x2936EDC0UL), JOT_NUM_U64(0xD54B944BUL, 0x84AA4C0DUL)}, /* -114 */
+    {JOT_NUM_U64(0xC5029163UL, 0xF384A931UL), JOT_NUM_U64(0x0A9E795EUL, 0x65D4DF11UL)}, /* -113 */
+    {JOT_NUM_U64(0xF64335BCUL, 0xF065D37DUL), JOT_NUM_U64(0x4D4617B5UL, 0xFF4A16D5UL)}, /* -112 */
+    {JOT_NUM_U64(0x99EA0196UL, 0x163FA42EUL), JOT_NUM_U64(0x504BCED1UL, 0xBF8E4E45UL)}, /* -111 */
+    {JOT_NUM_U64(0xC06481FBUL, 0x9BCF8D39UL), JOT_NUM_U64(0xE45EC286UL, 0x2F71E1D6UL)}, /* -110 */
+    {JOT_NUM_U64(0xF07DA27AUL, 0x82C37088UL), JOT_NUM_U64(0x5D767327UL, 0xBB4E5A4CUL)}, /* -109 */
+    {JOT_NUM_U64(0x964E858CUL, 0x91BA2655UL), JOT_NUM_U64(0x3A6A07F8UL, 0xD510F86FUL)}, /* -108 */
+    {JOT_NUM_U64(0xBBE226EFUL, 0xB628AFEAUL), JOT_NUM_U64(0x890489F7UL, 0x0A55368BUL)}, /* -107 */
+    {JOT_NUM_U64(0xEADAB0ABUL, 0xA3B2DBE5UL), JOT_NUM_U64(0x2B45AC74UL, 0xCCEA842EUL)}, /* -106 */
+    {JOT_NUM_U64(0x92C8AE6BUL, 0x464FC96FUL), JOT_NUM_U64(0x3B0B8BC9UL, 0x0012929DUL)}, /* -105 */
+    {JOT_NUM_U64(0xB77ADA06UL, 0x17E3BBCBUL), JOT_NUM_U64(0x09CE6EBBUL, 0x40173744UL)}, /* -104 */
+    {JOT_NUM_U64(0xE5599087UL, 0x9DDCAABDUL), JOT_NUM_U64(0xCC420A6AUL, 0x101D0515UL)}, /* -103 */
+    {JOT_NUM_U64(0x8F57FA54UL, 0xC2A9EAB6UL), JOT_NUM_U64(0x9FA94682UL, 0x4A12232DUL)}, /* -102 */
+    {JOT_NUM_U64(0xB32DF8E9UL, 0xF3546564UL), JOT_NUM_U64(0x47939822UL, 0xDC96ABF9UL)}, /* -101 */
+    {JOT_NUM_U64(0xDFF97724UL, 0x70297EBDUL), JOT_NUM_U64(0x59787E2BUL, 0x93BC56F7UL)}, /* -100 */
+    {JOT_NUM_U64(0x8BFBEA76UL, 0xC619EF36UL), JOT_NUM_U64(0x57EB4EDBUL, 0x3C55B65AUL)}, /* -99 */
+    {JOT_NUM_U64(0xAEFAE514UL, 0x77A06B03UL), JOT_NUM_U64(0xEDE62292UL, 0x0B6B23F1UL)}, /* -98 */
+    {JOT_NUM_U64(0xDAB99E59UL, 0x958885C4UL), JOT_NUM_U64(0xE95FAB36UL, 0x8E45ECEDUL)}, /* -97 */
+    {JOT_NUM_U64(0x88B402F7UL, 0xFD75539BUL), JOT_NUM_U64(0x11DBCB02UL, 0x18EBB414UL)}, /* -96 */
+    {JOT_NUM_U64(0xAAE103B5UL, 0xFCD2A881UL), JOT_NUM_U64(0xD652BDC2UL, 0x9F26A119UL)}, /* -95 */
+    {JOT_NUM_U64(0xD59944A3UL, 0x7C0752A2UL), JOT_NUM_U64(0x4BE76D33UL, 0x46F0495FUL)}, /* -94 */
+    {JOT_NUM_U64(0x857FCAE6UL, 0x2D8493A5UL), JOT_NUM_U64(0x6F70A440UL, 0x0C562DDBUL)}, /* -93 */
+    {JOT_NUM_U64(0xA6DFBD9FUL, 0xB8E5B88EUL), JOT_NUM_U64(0xCB4CCD50UL, 0x0F6BB952UL)}, /* -92 */
+    {JOT_NUM_U64(0xD097AD07UL, 0xA71F26B2UL), JOT_NUM_U64(0x7E2000A4UL, 0x1346A7A7UL)}, /* -91 */
+    {JOT_NUM_U64(0x825ECC24UL, 0xC873782FUL), JOT_NUM_U64(0x8ED40066UL, 0x8C0C28C8UL)}, /* -90 */
+    {JOT_NUM_U64(0xA2F67F2DUL, 0xFA90563BUL), JOT_NUM_U64(0x72890080UL, 0x2F0F32FAUL)}, /* -89 */
+    {JOT_NUM_U64(0xCBB41EF9UL, 0x79346BCAUL), JOT_NUM_U64(0x4F2B40A0UL, 0x3AD2FFB9UL)}, /* -88 */
+    {JOT_NUM_U64(0xFEA126B7UL, 0xD78186BCUL), JOT_NUM_U64(0xE2F610C8UL, 0x4987BFA8UL)}, /* -87 */
+    {JOT_NUM_U64(0x9F24B832UL, 0xE6B0F436UL), JOT_NUM_U64(0x0DD9CA7DUL, 0x2DF4D7C9UL)}, /* -86 */
+    {JOT_NUM_U64(0xC6EDE63FUL, 0xA05D3143UL), JOT_NUM_U64(0x91503D1CUL, 0x79720DBBUL)}, /* -85 */
+    {JOT_NUM_U64(0xF8A95FCFUL, 0x88747D94UL), JOT_NUM_U64(0x75A44C63UL, 0x97CE912AUL)}, /* -84 */
+    {JOT_NUM_U64(0x9B69DBE1UL, 0xB548CE7CUL), JOT_NUM_U64(0xC986AFBEUL, 0x3EE11ABAUL)}, /* -83 */
+    {JOT_NUM_U64(0xC24452DAUL, 0x229B021BUL), JOT_NUM_U64(0xFBE85BADUL, 0xCE996168UL)}, /* -82 */
+    {JOT_NUM_U64(0xF2D56790UL, 0xAB41C2A2UL), JOT_NUM_U64(0xFAE27299UL, 0x423FB9C3UL)}, /* -81 */
+    {JOT_NUM_U64(0x97C560BAUL, 0x6B0919A5UL), JOT_NUM_U64(0xDCCD879FUL, 0xC967D41AUL)}, /* -80 */
+    {JOT_NUM_U64(0xBDB6B8E9UL, 0x05CB600FUL), JOT_NUM_U64(0x5400E987UL, 0xBBC1C920UL)}, /* -79 */
+    {JOT_NUM_U64(0xED246723UL, 0x473E3813UL), JOT_NUM_U64(0x290123E9UL, 0xAAB23B68UL)}, /* -78 */
+    {JOT_NUM_U64(0x9436C076UL, 0x0C86E30BUL), JOT_NUM_U64(0xF9A0B672UL, 0x0AAF6521UL)}, /* -77 */
+    {JOT_NUM_U64(0xB9447093UL, 0x8FA89BCEUL), JOT_NUM_U64(0xF808E40EUL, 0x8D5B3E69UL)}, /* -76 */
+    {JOT_NUM_U64(0xE7958CB8UL, 0x7392C2C2UL), JOT_NUM_U64(0xB60B1D12UL, 0x30B20E04UL)}, /* -75 */
+    {JOT_NUM_U64(0x90BD77F3UL, 0x483BB9B9UL), JOT_NUM_U64(0xB1C6F22BUL, 0x5E6F48C2UL)}, /* -74 */
+    {JOT_NUM_U64(0xB4ECD5F0UL, 0x1A4AA828UL), JOT_NUM_U64(0x1E38AEB6UL, 0x360B1AF3UL)}, /* -73 */
+    {JOT_NUM_U64(0xE2280B6CUL, 0x20DD5232UL), JOT_NUM_U64(0x25C6DA63UL, 0xC38DE1B0UL)}, /* -72 */
+    {JOT_NUM_U64(0x8D590723UL, 0x948A535FUL), JOT_NUM_U64(0x579C487EUL, 0x5A38AD0EUL)}, /* -71 */
+    {JOT_NUM_U64(0xB0AF48ECUL, 0x79ACE837UL), JOT_NUM_U64(0x2D835A9DUL, 0xF0C6D851UL)}, /* -70 */
+    {JOT_NUM_U64(0xDCDB1B27UL, 0x98182244UL), JOT_NUM_U64(0xF8E43145UL, 0x6CF88E65UL)}, /* -69 */
+    {JOT_NUM_U64(0x8A08F0F8UL, 0xBF0F156BUL), JOT_NUM_U64(0x1B8E9ECBUL, 0x641B58FFUL)}, /* -68 */
+    {JOT_NUM_U64(0xAC8B2D36UL, 0xEED2DAC5UL), JOT_NUM_U64(0xE272467EUL, 0x3D222F3FUL)}, /* -67 */
+    {JOT_NUM_U64(0xD7ADF884UL, 0xAA879177UL), JOT_NUM_U64(0x5B0ED81DUL, 0xCC6ABB0FUL)}, /* -66 */
+    {JOT_NUM_U64(0x86CCBB52UL, 0xEA94BAEAUL), JOT_NUM_U64(0x98E94712UL, 0x9FC2B4E9UL)}, /* -65 */
+    {JOT_NUM_U64(0xA87FEA27UL, 0xA539E9A5UL), JOT_NUM_U64(0x3F2398D7UL, 0x47B36224UL)}, /* -64 */
+    {JOT_NUM_U64(0xD29FE4B1UL, 0x8E88640EUL), JOT_NUM_U64(0x8EEC7F0DUL, 0x19A03AADUL)}, /* -63 */
+    {JOT_NUM_U64(0x83A3EEEEUL, 0xF9153E89UL), JOT_NUM_U64(0x1953CF68UL, 0x300424ACUL)}, /* -62 */
+    {JOT_NUM_U64(0xA48CEAAAUL, 0xB75A8E2BUL), JOT_NUM_U64(0x5FA8C342UL, 0x3C052DD7UL)}, /* -61 */
+    {JOT_NUM_U64(0xCDB02555UL, 0x653131B6UL), JOT_NUM_U64(0x3792F412UL, 0xCB06794DUL)}, /* -60 */
+    {JOT_NUM_U64(0x808E1755UL, 0x5F3EBF11UL), JOT_NUM_U64(0xE2BBD88BUL, 0xBEE40BD0UL)}, /* -59 */
+    {JOT_NUM_U64(0xA0B19D2AUL, 0xB70E6ED6UL), JOT_NUM_U64(0x5B6ACEAEUL, 0xAE9D0EC4UL)}, /* -58 */
+    {JOT_NUM_U64(0xC8DE0475UL, 0x64D20A8BUL), JOT_NUM_U64(0xF245825AUL, 0x5A445275UL)}, /* -57 */
+    {JOT_NUM_U64(0xFB158592UL, 0xBE068D2EUL), JOT_NUM_U64(0xEED6E2F0UL, 0xF0D56712UL)}, /* -56 */
+    {JOT_NUM_U64(0x9CED737BUL, 0xB6C4183DUL), JOT_NUM_U64(0x55464DD6UL, 0x9685606BUL)}, /* -55 */
+    {JOT_NUM_U64(0xC428D05AUL, 0xA4751E4CUL), JOT_NUM_U64(0xAA97E14CUL, 0x3C26B886UL)}, /* -54 */
+    {JOT_NUM_U64(0xF5330471UL, 0x4D9265DFUL), JOT_NUM_U64(0xD53DD99FUL, 0x4B3066A8UL)}, /* -53 */
+    {JOT_NUM_U64(0x993FE2C6UL, 0xD07B7FABUL), JOT_NUM_U64(0xE546A803UL, 0x8EFE4029UL)}, /* -52 */
+    {JOT_NUM_U64(0xBF8FDB78UL, 0x849A5F96UL), JOT_NUM_U64(0xDE985204UL, 0x72BDD033UL)}, /* -51 */
+    {JOT_NUM_U64(0xEF73D256UL, 0xA5C0F77CUL), JOT_NUM_U64(0x963E6685UL, 0x8F6D4440UL)}, /* -50 */
+    {JOT_NUM_U64(0x95A86376UL, 0x27989AADUL), JOT_NUM_U64(0xDDE70013UL, 0x79A44AA8UL)}, /* -49 */
+    {JOT_NUM_U64(0xBB127C53UL, 0xB17EC159UL), JOT_NUM_U64(0x5560C018UL, 0x580D5D52UL)}, /* -48 */
+    {JOT_NUM_U64(0xE9D71B68UL, 0x9DDE71AFUL), JOT_NUM_U64(0xAAB8F01EUL, 0x6E10B4A6UL)}, /* -47 */
+    {JOT_NUM_U64(0x92267121UL, 0x62AB070DUL), JOT_NUM_U64(0xCAB39613UL, 0x04CA70E8UL)}, /* -46 */
+    {JOT_NUM_U64(0xB6B00D69UL, 0xBB55C8D1UL), JOT_NUM_U64(0x3D607B97UL, 0xC5FD0D22UL)}, /* -45 */
+    {JOT_NUM_U64(0xE45C10C4UL, 0x2A2B3B05UL), JOT_NUM_U64(0x8CB89A7DUL, 0xB77C506AUL)}, /* -44 */
+    {JOT_NUM_U64(0x8EB98A7AUL, 0x9A5B04E3UL), JOT_NUM_U64(0x77F3608EUL, 0x92ADB242UL)}, /* -43 */
+    {JOT_NUM_U64(0xB267ED19UL, 0x40F1C61CUL), JOT_NUM_U64(0x55F038B2UL, 0x37591ED3UL)}, /* -42 */
+    {JOT_NUM_U64(0xDF01E85FUL, 0x912E37A3UL), JOT_NUM_U64(0x6B6C46DEUL, 0xC52F6688UL)}, /* -41 */
+    {JOT_NUM_U64(0x8B61313BUL, 0xBABCE2C6UL), JOT_NUM_U64(0x2323AC4BUL, 0x3B3DA015UL)}, /* -40 */
+    {JOT_NUM_U64(0xAE397D8AUL, 0xA96C1B77UL), JOT_NUM_U64(0xABEC975EUL, 0x0A0D081AUL)}, /* -39 */
+    {JOT_NUM_U64(0xD9C7DCEDUL, 0x53C72255UL), JOT_NUM_U64(0x96E7BD35UL, 0x8C904A21UL)}, /* -38 */
+    {JOT_NUM_U64(0x881CEA14UL, 0x545C7575UL), JOT_NUM_U64(0x7E50D641UL, 0x77DA2E54UL)}, /* -37 */
+    {JOT_NUM_U64(0xAA242499UL, 0x697392D2UL), JOT_NUM_U64(0xDDE50BD1UL, 0xD5D0B9E9UL)}, /* -36 */
+    {JOT_NUM_U64(0xD4AD2DBFUL, 0xC3D07787UL), JOT_NUM_U64(0x955E4EC6UL, 0x4B44E864UL)}, /* -35 */
+    {JOT_NUM_U64(0x84EC3C97UL, 0xDA624AB4UL), JOT_NUM_U64(0xBD5AF13BUL, 0xEF0B113EUL)}, /* -34 */
+    {JOT_NUM_U64(0xA6274BBDUL, 0xD0FADD61UL), JOT_NUM_U64(0xECB1AD8AUL, 0xEACDD58EUL)}, /* -33 */
+    {JOT_NUM_U64(0xCFB11EADUL, 0x453994BAUL), JOT_NUM_U64(0x67DE18EDUL, 0xA5814AF2UL)}, /* -32 */
+    {JOT_NUM_U64(0x81CEB32CUL, 0x4B43FCF4UL), JOT_NUM_U64(0x80EACF94UL, 0x8770CED7UL)}, /* -31 */
+    {JOT_NUM_U64(0xA2425FF7UL, 0x5E14FC31UL), JOT_NUM_U64(0xA1258379UL, 0xA94D028DUL)}, /* -30 */
+    {JOT_NUM_U64(0xCAD2F7F5UL, 0x359A3B3EUL), JOT_NUM_U64(0x096EE458UL, 0x13A04330UL)}, /* -29 */
+    {JOT_NUM_U64(0xFD87B5F2UL, 0x8300CA0DUL), JOT_NUM_U64(0x8BCA9D6EUL, 0x188853FCUL)}, /* -28 */
+    {JOT_NUM_U64(0x9E74D1B7UL, 0x91E07E48UL), JOT_NUM_U64(0x775EA264UL, 0xCF55347EUL)}, /* -27 */
+    {JOT_NUM_U64(0xC6120625UL, 0x76589DDAUL), JOT_NUM_U64(0x95364AFEUL, 0x032A819EUL)}, /* -26 */
+    {JOT_NUM_U64(0xF79687AEUL, 0xD3EEC551UL), JOT_NUM_U64(0x3A83DDBDUL, 0x83F52205UL)}, /* -25 */
+    {JOT_NUM_U64(0x9ABE14CDUL, 0x44753B52UL), JOT_NUM_U64(0xC4926A96UL, 0x72793543UL)}, /* -24 */
+    {JOT_NUM_U64(0xC16D9A00UL, 0x95928A27UL), JOT_NUM_U64(0x75B7053CUL, 0x0F178294UL)}, /* -23 */
+    {JOT_NUM_U64(0xF1C90080UL, 0xBAF72CB1UL), JOT_NUM_U64(0x5324C68BUL, 0x12DD6339UL)}, /* -22 */
+    {JOT_NUM_U64(0x971DA050UL, 0x74DA7BEEUL), JOT_NUM_U64(0xD3F6FC16UL, 0xEBCA5E04UL)}, /* -21 */
+    {JOT_NUM_U64(0xBCE50864UL, 0x92111AEAUL), JOT_NUM_U64(0x88F4BB1CUL, 0xA6BCF585UL)}, /* -20 */
+    {JOT_NUM_U64(0xEC1E4A7DUL, 0xB69561A5UL), JOT_NUM_U64(0x2B31E9E3UL, 0xD06C32E6UL)}, /* -19 */
+    {JOT_NUM_U64(0x9392EE8EUL, 0x921D5D07UL), JOT_NUM_U64(0x3AFF322EUL, 0x62439FD0UL)}, /* -18 */
+    {JOT_NUM_U64(0xB877AA32UL, 0x36A4B449UL), JOT_NUM_U64(0x09BEFEB9UL, 0xFAD487C3UL)}, /* -17 */
+    {JOT_NUM_U64(0xE69594BEUL, 0xC44DE15BUL), JOT_NUM_U64(0x4C2EBE68UL, 0x7989A9B4UL)}, /* -16 */
+    {JOT_NUM_U64(0x901D7CF7UL, 0x3AB0ACD9UL), JOT_NUM_U64(0x0F9D3701UL, 0x4BF60A11UL)}, /* -15 */
+    {JOT_NUM_U64(0xB424DC35UL, 0x095CD80FUL), JOT_NUM_U64(0x538484C1UL, 0x9EF38C95UL)}, /* -14 */
+    {JOT_NUM_U64(0xE12E1342UL, 0x4BB40E13UL), JOT_NUM_U64(0x2865A5F2UL, 0x06B06FBAUL)}, /* -13 */
+    {JOT_NUM_U64(0x8CBCCC09UL, 0x6F5088CBUL), JOT_NUM_U64(0xF93F87B7UL, 0x442E45D4UL)}, /* -12 */
+    {JOT_NUM_U64(0xAFEBFF0BUL, 0xCB24AAFEUL), JOT_NUM_U64(0xF78F69A5UL, 0x1539D749UL)}, /* -11 */
+    {JOT_NUM_U64(0xDBE6FECEUL, 0xBDEDD5BEUL), JOT_NUM_U64(0xB573440EUL, 0x5A884D1CUL)}, /* -10 */
+    {JOT_NUM_U64(0x89705F41UL, 0x36B4A597UL), JOT_NUM_U64(0x31680A88UL, 0xF8953031UL)}, /* -9 */
+    {JOT_NUM_U64(0xABCC7711UL, 0x8461CEFCUL), JOT_NUM_U64(0xFDC20D2BUL, 0x36BA7C3EUL)}, /* -8 */
+    {JOT_NUM_U64(0xD6BF94D5UL, 0xE57A42BCUL), JOT_NUM_U64(0x3D329076UL, 0x04691B4DUL)}, /* -7 */
+    {JOT_NUM_U64(0x8637BD05UL, 0xAF6C69B5UL), JOT_NUM_U64(0xA63F9A49UL, 0xC2C1B110UL)}, /* -6 */
+    {JOT_NUM_U64(0xA7C5AC47UL, 0x1B478423UL), JOT_NUM_U64(0x0FCF80DCUL, 0x33721D54UL)}, /* -5 */
+    {JOT_NUM_U64(0xD1B71758UL, 0xE219652BUL), JOT_NUM_U64(0xD3C36113UL, 0x404EA4A9UL)}, /* -4 */
+    {JOT_NUM_U64(0x83126E97UL, 0x8D4FDF3BUL), JOT_NUM_U64(0x645A1CACUL, 0x083126EAUL)}, /* -3 */
+    {JOT_NUM_U64(0xA3D70A3DUL, 0x70A3D70AUL), JOT_NUM_U64(0x3D70A3D7UL, 0x0A3D70A4UL)}, /* -2 */
+    {JOT_NUM_U64(0xCCCCCCCCUL, 0xCCCCCCCCUL), JOT_NUM_U64(0xCCCCCCCCUL, 0xCCCCCCCDUL)}, /* -1 */
+    {JOT_NUM_U64(0x80000000UL, 0x00000000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 0 */
+    {JOT_NUM_U64(0xA0000000UL, 0x00000000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 1 */
+    {JOT_NUM_U64(0xC8000000UL, 0x00000000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 2 */
+    {JOT_NUM_U64(0xFA000000UL, 0x00000000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 3 */
+    {JOT_NUM_U64(0x9C400000UL, 0x00000000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 4 */
+    {JOT_NUM_U64(0xC3500000UL, 0x00000000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 5 */
+    {JOT_NUM_U64(0xF4240000UL, 0x00000000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 6 */
+    {JOT_NUM_U64(0x98968000UL, 0x00000000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 7 */
+    {JOT_NUM_U64(0xBEBC2000UL, 0x00000000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 8 */
+    {JOT_NUM_U64(0xEE6B2800UL, 0x00000000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 9 */
+    {JOT_NUM_U64(0x9502F900UL, 0x00000000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 10 */
+    {JOT_NUM_U64(0xBA43B740UL, 0x00000000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 11 */
+    {JOT_NUM_U64(0xE8D4A510UL, 0x00000000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 12 */
+    {JOT_NUM_U64(0x9184E72AUL, 0x00000000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 13 */
+    {JOT_NUM_U64(0xB5E620F4UL, 0x80000000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 14 */
+    {JOT_NUM_U64(0xE35FA931UL, 0xA0000000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 15 */
+    {JOT_NUM_U64(0x8E1BC9BFUL, 0x04000000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 16 */
+    {JOT_NUM_U64(0xB1A2BC2EUL, 0xC5000000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 17 */
+    {JOT_NUM_U64(0xDE0B6B3AUL, 0x76400000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 18 */
+    {JOT_NUM_U64(0x8AC72304UL, 0x89E80000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 19 */
+    {JOT_NUM_U64(0xAD78EBC5UL, 0xAC620000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 20 */
+    {JOT_NUM_U64(0xD8D726B7UL, 0x177A8000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 21 */
+    {JOT_NUM_U64(0x87867832UL, 0x6EAC9000UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 22 */
+    {JOT_NUM_U64(0xA968163FUL, 0x0A57B400UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 23 */
+    {JOT_NUM_U64(0xD3C21BCEUL, 0xCCEDA100UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 24 */
+    {JOT_NUM_U64(0x84595161UL, 0x401484A0UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 25 */
+    {JOT_NUM_U64(0xA56FA5B9UL, 0x9019A5C8UL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 26 */
+    {JOT_NUM_U64(0xCECB8F27UL, 0xF4200F3AUL), JOT_NUM_U64(0x00000000UL, 0x00000000UL)}, /* 27 */
+    {JOT_NUM_U64(0x813F3978UL, 0xF8940984UL), JOT_NUM_U64(0x40000000UL, 0x00000000UL)}, /* 28 */
+    {JOT_NUM_U64(0xA18F07D7UL, 0x36B90BE5UL), JOT_NUM_U64(0x50000000UL, 0x00000000UL)}, /* 29 */
+    {JOT_NUM_U64(0xC9F2C9CDUL, 0x04674EDEUL), JOT_NUM_U64(0xA4000000UL, 0x00000000UL)}, /* 30 */
+    {JOT_NUM_U64(0xFC6F7C40UL, 0x45812296UL), JOT_NUM_U64(0x4D000000UL, 0x00000000UL)}, /* 31 */
+    {JOT_NUM_U64(0x9DC5ADA8UL, 0x2B70B59DUL), JOT_NUM_U64(0xF0200000UL, 0x00000000UL)}, /* 32 */
+    {JOT_NUM_U64(0xC5371912UL, 0x364CE305UL), JOT_NUM_U64(0x6C280000UL, 0x00000000UL)}, /* 33 */
+    {JOT_NUM_U64(0xF684DF56UL, 0xC3E01BC6UL), JOT_NUM_U64(0xC7320000UL, 0x00000000UL)}, /* 34 */
+    {JOT_NUM_U64(0x9A130B96UL, 0x3A6C115CUL), JOT_NUM_U64(0x3C7F4000UL, 0x00000000UL)}, /* 35 */
+    {JOT_NUM_U64(0xC097CE7BUL, 0xC90715B3UL), JOT_NUM_U64(0x4B9F1000UL, 0x00000000UL)}, /* 36 */
+    {JOT_NUM_U64(0xF0BDC21AUL, 0xBB48DB20UL), JOT_NUM_U64(0x1E86D400UL, 0x00000000UL)}, /* 37 */
+    {JOT_NUM_U64(0x96769950UL, 0xB50D88F4UL), JOT_NUM_U64(0x13144480UL, 0x00000000UL)}, /* 38 */
+    {JOT_NUM_U64(0xBC143FA4UL, 0xE250EB31UL), JOT_NUM_U64(0x17D955A0UL, 0x00000000UL)}, /* 39 */
+    {JOT_NUM_U64(0xEB194F8EUL, 0x1AE525FDUL), JOT_NUM_U64(0x5DCFAB08UL, 0x00000000UL)}, /* 40 */
+    {JOT_NUM_U64(0x92EFD1B8UL, 0xD0CF37BEUL), JOT_NUM_U64(0x5AA1CAE5UL, 0x00000000UL)}, /* 41 */
+    {JOT_NUM_U64(0xB7ABC627UL, 0x050305ADUL), JOT_NUM_U64(0xF14A3D9EUL, 0x40000000UL)}, /* 42 */
+    {JOT_NUM_U64(0xE596B7B0UL, 0xC643C719UL), JOT_NUM_U64(0x6D9CCD05UL, 0xD0000000UL)}, /* 43 */
+    {JOT_NUM_U64(0x8F7E32CEUL, 0x7BEA5C6FUL), JOT_NUM_U64(0xE4820023UL, 0xA2000000UL)}, /* 44 */
+    {JOT_NUM_U64(0xB35DBF82UL, 0x1AE4F38BUL), JOT_NUM_U64(0xDDA2802CUL, 0x8A800000UL)}, /* 45 */
+    {JOT_NUM_U64(0xE0352F62UL, 0xA19E306EUL), JOT_NUM_U64(0xD50B2037UL, 0xAD200000UL)}, /* 46 */
+    {JOT_NUM_U64(0x8C213D9DUL, 0xA502DE45UL), JOT_NUM_U64(0x4526F422UL, 0xCC340000UL)}, /* 47 */
+    {JOT_NUM_U64(0xAF298D05UL, 0x0E4395D6UL), JOT_NUM_U64(0x9670B12BUL, 0x7F410000UL)}, /* 48 */
+    {JOT_NUM_U64(0xDAF3F046UL, 0x51D47B4CUL), JOT_NUM_U64(0x3C0CDD76UL, 0x5F114000UL)}, /* 49 */
+    {JOT_NUM_U64(0x88D8762BUL, 0xF324CD0FUL), JOT_NUM_U64(0xA5880A69UL, 0xFB6AC800UL)}, /* 50 */
+    {JOT_NUM_U64(0xAB0E93B6UL, 0xEFEE0053UL), JOT_NUM_U64(0x8EEA0D04UL, 0x7A457A00UL)}, /* 51 */
+    {JOT_NUM_U64(0xD5D238A4UL, 0xABE98068UL), JOT_NUM_U64(0x72A49045UL, 0x98D6D880UL)}, /* 52 */
+    {JOT_NUM_U64(0x85A36366UL, 0xEB71F041UL), JOT_NUM_U64(0x47A6DA2BUL, 0x7F864750UL)}, /* 53 */
+    {JOT_NUM_U64(0xA70C3C40UL, 0xA64E6C51UL), JOT_NUM_U64(0x999090B6UL, 0x5F67D924UL)}, /* 54 */
+    {JOT_NUM_U64(0xD0CF4B50UL, 0xCFE20765UL), JOT_NUM_U64(0xFFF4B4E3UL, 0xF741CF6DUL)}, /* 55 */
+    {JOT_NUM_U64(0x82818F12UL, 0x81ED449FUL), JOT_NUM_U64(0xBFF8F10EUL, 0x7A8921A4UL)}, /* 56 */
+    {JOT_NUM_U64(0xA321F2D7UL, 0x226895C7UL), JOT_NUM_U64(0xAFF72D52UL, 0x192B6A0DUL)}, /* 57 */
+    {JOT_NUM_U64(0xCBEA6F8CUL, 0xEB02BB39UL), JOT_NUM_U64(0x9BF4F8A6UL, 0x9F764490UL)}, /* 58 */
+    {JOT_NUM_U64(0xFEE50B70UL, 0x25C36A08UL), JOT_NUM_U64(0x02F236D0UL, 0x4753D5B4UL)}, /* 59 */
+    {JOT_NUM_U64(0x9F4F2726UL, 0x179A2245UL), JOT_NUM_U64(0x01D76242UL, 0x2C946590UL)}, /* 60 */
+    {JOT_NUM_U64(0xC722F0EFUL, 0x9D80AAD6UL), JOT_NUM_U64(0x424D3AD2UL, 0xB7B97EF5UL)}, /* 61 */
+    {JOT_NUM_U64(0xF8EBAD2BUL, 0x84E0D58BUL), JOT_NUM_U64(0xD2E08987UL, 0x65A7DEB2UL)}, /* 62 */
+    {JOT_NUM_U64(0x9B934C3BUL, 0x330C8577UL), JOT_NUM_U64(0x63CC55F4UL, 0x9F88EB2FUL)}, /* 63 */
+    {JOT_NUM_U64(0xC2781F49UL, 0xFFCFA6D5UL), JOT_NUM_U64(0x3CBF6B71UL, 0xC76B25FBUL)}, /* 64 */
+    {JOT_NUM_U64(0xF316271CUL, 0x7FC3908AUL), JOT_NUM_U64(0x8BEF464EUL, 0x3945EF7AUL)}, /* 65 */
+    {JOT_NUM_U64(0x97EDD871UL, 0xCFDA3A56UL), JOT_NUM_U64(0x97758BF0UL, 0xE3CBB5ACUL)}, /* 66 */
+    {JOT_NUM_U64(0xBDE94E8EUL, 0x43D0C8ECUL), JOT_NUM_U64(0x3D52EEEDUL, 0x1CBEA317UL)}, /* 67 */
+    {JOT_NUM_U64(0xED63A231UL, 0xD4C4FB27UL), JOT_NUM_U64(0x4CA7AAA8UL, 0x63EE4BDDUL)}, /* 68 */
+    {JOT_NUM_U64(0x945E455FUL, 0x24FB1CF8UL), JOT_NUM_U64(0x8FE8CAA9UL, 0x3E74EF6AUL)}, /* 69 */
+    {JOT_NUM_U64(0xB975D6B6UL, 0xEE39E436UL), JOT_NUM_U64(0xB3E2FD53UL, 0x8E122B44UL)}, /* 70 */
+    {JOT_NUM_U64(0xE7D34C64UL, 0xA9C85D44UL), JOT_NUM_U64(0x60DBBCA8UL, 0x7196B616UL)}, /* 71 */
+    {JOT_NUM_U64(0x90E40FBEUL, 0xEA1D3A4AUL), JOT_NUM_U64(0xBC8955E9UL, 0x46FE31CDUL)}, /* 72 */
+    {JOT_NUM_U64(0xB51D13AEUL, 0xA4A488DDUL), JOT_NUM_U64(0x6BABAB63UL, 0x98BDBE41UL)}, /* 73 */
+    {JOT_NUM_U64(0xE264589AUL, 0x4DCDAB14UL), JOT_NUM_U64(0xC696963CUL, 0x7EED2DD1UL)}, /* 74 */
+    {JOT_NUM_U64(0x8D7EB760UL, 0x70A08AECUL), JOT_NUM_U64(0xFC1E1DE5UL, 0xCF543CA2UL)}, /* 75 */
+    {JOT_NUM_U64(0xB0DE6538UL, 0x8CC8ADA8UL), JOT_NUM_U64(0x3B25A55FUL, 0x43294BCBUL)}, /* 76 */
+    {JOT_NUM_U64(0xDD15FE86UL, 0xAFFAD912UL), JOT_NUM_U64(0x49EF0EB7UL, 0x13F39EBEUL)}, /* 77 */
+    {JOT_NUM_U64(0x8A2DBF14UL, 0x2DFCC7ABUL), JOT_NUM_U64(0x6E356932UL, 0x6C784337UL)}, /* 78 */
+    {JOT_NUM_U64(0xACB92ED9UL, 0x397BF996UL), JOT_NUM_U64(0x49C2C37FUL, 0x07965404UL)}, /* 79 */
+    {JOT_NUM_U64(0xD7E77A8FUL, 0x87DAF7FBUL), JOT_NUM_U64(0xDC33745EUL, 0xC97BE906UL)}, /* 80 */
+    {JOT_NUM_U64(0x86F0AC99UL, 0xB4E8DAFDUL), JOT_NUM_U64(0x69A028BBUL, 0x3DED71A3UL)}, /* 81 */
+    {JOT_NUM_U64(0xA8ACD7C0UL, 0x222311BCUL), JOT_NUM_U64(0xC40832EAUL, 0x0D68CE0CUL)}, /* 82 */
+    {JOT_NUM_U64(0xD2D80DB0UL, 0x2AABD62BUL), JOT_NUM_U64(0xF50A3FA4UL, 0x90C30190UL)}, /* 83 */
+    {JOT_NUM_U64(0x83C7088EUL, 0x1AAB65DBUL), JOT_NUM_U64(0x792667C6UL, 0xDA79E0FAUL)}, /* 84 */
+    {JOT_NUM_U64(0xA4B8CAB1UL, 0xA1563F52UL), JOT_NUM_U64(0x577001B8UL, 0x91185938UL)}, /* 85 */
+    {JOT_NUM_U64(0xCDE6FD5EUL, 0x09ABCF26UL), JOT_NUM_U64(0xED4C0226UL, 0xB55E6F86UL)}, /* 86 */
+    {JOT_NUM_U64(0x80B05E5AUL, 0xC60B6178UL), JOT_NUM_U64(0x544F8158UL, 0x315B05B4UL)}, /* 87 */
+    {JOT_NUM_U64(0xA0DC75F1UL, 0x778E39D6UL), JOT_NUM_U64(0x696361AEUL, 0x3DB1C721UL)}, /* 88 */
+    {JOT_NUM_U64(0xC913936DUL, 0xD571C84CUL), JOT_NUM_U64(0x03BC3A19UL, 0xCD1E38E9UL)}, /* 89 */
+    {JOT_NUM_U64(0xFB587849UL, 0x4ACE3A5FUL), JOT_NUM_U64(0x04AB48A0UL, 0x4065C723UL)}, /* 90 */
+    {JOT_NUM_U64(0x9D174B2DUL, 0xCEC0E47BUL), JOT_NUM_U64(0x62EB0D64UL, 0x283F9C76UL)}, /* 91 */
+    {JOT_NUM_U64(0xC45D1DF9UL, 0x42711D9AUL), JOT_NUM_U64(0x3BA5D0BDUL, 0x324F8394UL)}, /* 92 */
+    {JOT_NUM_U64(0xF5746577UL, 0x930D6500UL), JOT_NUM_U64(0xCA8F44ECUL, 0x7EE36479UL)}, /* 93 */
+    {JOT_NUM_U64(0x9968BF6AUL, 0xBBE85F20UL), JOT_NUM_U64(0x7E998B13UL, 0xCF4E1ECBUL)}, /* 94 */
+    {JOT_NUM_U64(0xBFC2EF45UL, 0x6AE276E8UL), JOT_NUM_U64(0x9E3FEDD8UL, 0xC321A67EUL)}, /* 95 */
+    {JOT_NUM_U64(0xEFB3AB16UL, 0xC59B14A2UL), JOT_NUM_U64(0xC5CFE94EUL, 0xF3EA101EUL)}, /* 96 */
+    {JOT_NUM_U64(0x95D04AEEUL, 0x3B80ECE5UL), JOT_NUM_U64(0xBBA1F1D1UL, 0x58724A12UL)}, /* 97 */
+    {JOT_NUM_U64(0xBB445DA9UL, 0xCA61281FUL), JOT_NUM_U64(0x2A8A6E45UL, 0xAE8EDC97UL)}, /* 98 */
+    {JOT_NUM_U64(0xEA157514UL, 0x3CF97226UL), JOT_NUM_U64(0xF52D09D7UL, 0x1A3293BDUL)}, /* 99 */
+    {JOT_NUM_U64(0x924D692CUL, 0xA61BE758UL), JOT_NUM_U64(0x593C2626UL, 0x705F9C56UL)}, /* 100 */
+    {JOT_NUM_U64(0xB6E0C377UL, 0xCFA2E12EUL), JOT_NUM_U64(0x6F8B2FB0UL, 0x0C77836CUL)}, /* 101 */
+    {JOT_NUM_U64(0xE498F455UL, 0xC38B997AUL), JOT_NUM_U64(0x0B6DFB9CUL, 0x0F956447UL)}, /* 102 */
+    {JOT_NUM_U64(0x8EDF98B5UL, 0x9A373FECUL), JOT_NUM_U64(0x4724BD41UL, 0x89BD5EACUL)}, /* 103 */
+    {JOT_NUM_U64(0xB2977EE3UL, 0x00C50FE7UL), JOT_NUM_U64(0x58EDEC91UL, 0xEC2CB657UL)}, /* 104 */
+    {JOT_NUM_U64(0xDF3D5E9BUL, 0xC0F653E1UL), JOT_NUM_U64(0x2F2967B6UL, 0x6737E3EDUL)}, /* 105 */
+    {JOT_NUM_U64(0x8B865B21UL, 0x5899F46CUL), JOT_NUM_U64(0xBD79E0D2UL, 0x0082EE74UL)}, /* 106 */
+    {JOT_NUM_U64(0xAE67F1E9UL, 0xAEC07187UL), JOT_NUM_U64(0xECD85906UL, 0x80A3AA11UL)}, /* 107 */
+    {JOT_NUM_U64(0xDA01EE64UL, 0x1A708DE9UL), JOT_NUM_U64(0xE80E6F48UL, 0x20CC9495UL)}, /* 108 */
+    {JOT_NUM_U64(0x884134FEUL, 0x908658B2UL), JOT_NUM_U64(0x3109058DUL, 0x147FDCDDUL)}, /* 109 */
+    {JOT_NUM_U64(0xAA51823EUL, 0x34A7EEDEUL), JOT_NUM_U64(0xBD4B46F0UL, 0x599FD415UL)}, /* 110 */
+    {JOT_NUM_U64(0xD4E5E2CDUL, 0xC1D1EA96UL), JOT_NUM_U64(0x6C9E18ACUL, 0x7007C91AUL)}, /* 111 */
+    {JOT_NUM_U64(0x850FADC0UL, 0x9923329EUL), JOT_NUM_U64(0x03E2CF6BUL, 0xC604DDB0UL)}, /* 112 */
+    {JOT_NUM_U64(0xA6539930UL, 0xBF6BFF45UL), JOT_NUM_U64(0x84DB8346UL, 0xB786151CUL)}, /* 113 */
+    {JOT_NUM_U64(0xCFE87F7CUL, 0xEF46FF16UL), JOT_NUM_U64(0xE6126418UL, 0x65679A63UL)}, /* 114 */
+    {JOT_NUM_U64(0x81F14FAEUL, 0x158C5F6EUL), JOT_NUM_U64(0x4FCB7E8FUL, 0x3F60C07EUL)}, /* 115 */
+    {JOT_NUM_U64(0xA26DA399UL, 0x9AEF7749UL), JOT_NUM_U64(0xE3BE5E33UL, 0x0F38F09DUL)}, /* 116 */
+    {JOT_NUM_U64(0xCB090C80UL, 0x01AB551CUL), JOT_NUM_U64(0x5CADF5BFUL, 0xD3072CC5UL)}, /* 117 */
+    {JOT_NUM_U64(0xFDCB4FA0UL, 0x02162A63UL), JOT_NUM_U64(0x73D9732FUL, 0xC7C8F7F6UL)}, /* 118 */
+    {JOT_NUM_U64(0x9E9F11C4UL, 0x014DDA7EUL), JOT_NUM_U64(0x2867E7FDUL, 0xDCDD9AFAUL)}, /* 119 */
+    {JOT_NUM_U64(0xC646D635UL, 0x01A1511DUL), JOT_NUM_U64(0xB281E1FDUL, 0x541501B8UL)}, /* 120 */
+    {JOT_NUM_U64(0xF7D88BC2UL, 0x4209A565UL), JOT_NUM_U64(0x1F225A7CUL, 0xA91A4226UL)}, /* 121 */
+    {JOT_NUM_U64(0x9AE75759UL, 0x6946075FUL), JOT_NUM_U64(0x3375788DUL, 0xE9B06958UL)}, /* 122 */
+    {JOT_NUM_U64(0xC1A12D2FUL, 0xC3978937UL), JOT_NUM_U64(0x0052D6B1UL, 0x641C83AEUL)}, /* 123 */
+    {JOT_NUM_U64(0xF209787BUL, 0xB47D6B84UL), JOT_NUM_U64(0xC0678C5DUL, 0xBD23A49AUL)}, /* 124 */
+    {JOT_NUM_U64(0x9745EB4DUL, 0x50CE6332UL), JOT_NUM_U64(0xF840B7BAUL, 0x963646E0UL)}, /* 125 */
+    {JOT_NUM_U64(0xBD176620UL, 0xA501FBFFUL), JOT_NUM_U64(0xB650E5A9UL, 0x3BC3D898UL)}, /* 126 */
+    {JOT_NUM_U64(0xEC5D3FA8UL, 0xCE427AFFUL), JOT_NUM_U64(0xA3E51F13UL, 0x8AB4CEBEUL)}, /* 127 */
+    {JOT_NUM_U64(0x93BA47C9UL, 0x80E98CDFUL), JOT_NUM_U64(0xC66F336CUL, 0x36B10137UL)}, /* 128 */
+    {JOT_NUM_U64(0xB8A8D9BBUL, 0xE123F017UL), JOT_NUM_U64(0xB80B0047UL, 0x445D4184UL)}, /* 129 */
+    {JOT_NUM_U64(0xE6D3102AUL, 0xD96CEC1DUL), JOT_NUM_U64(0xA60DC059UL, 0x157491E5UL)}, /* 130 */
+    {JOT_NUM_U64(0x9043EA1AUL, 0xC7E41392UL), JOT_NUM_U64(0x87C89837UL, 0xAD68DB2FUL)}, /* 131 */
+    {JOT_NUM_U64(0xB454E4A1UL, 0x79DD1877UL), JOT_NUM_U64(0x29BABE45UL, 0x98C311FBUL)}, /* 132 */
+    {JOT_NUM_U64(0xE16A1DC9UL, 0xD8545E94UL), JOT_NUM_U64(0xF4296DD6UL, 0xFEF3D67AUL)}, /* 133 */
+    {JOT_NUM_U64(0x8CE2529EUL, 0x2734BB1DUL), JOT_NUM_U64(0x1899E4A6UL, 0x5F58660CUL)}, /* 134 */
+    {JOT_NUM_U64(0xB01AE745UL, 0xB101E9E4UL), JOT_NUM_U64(0x5EC05DCFUL, 0xF72E7F8FUL)}, /* 135 */
+    {JOT_NUM_U64(0xDC21A117UL, 0x1D42645DUL), JOT_NUM_U64(0x76707543UL, 0xF4FA1F73UL)}, /* 136 */
+    {JOT_NUM_U64(0x899504AEUL, 0x72497EBAUL), JOT_NUM_U64(0x6A06494AUL, 0x791C53A8UL)}, /* 137 */
+    {JOT_NUM_U64(0xABFA45DAUL, 0x0EDBDE69UL), JOT_NUM_U64(0x0487DB9DUL, 0x17636892UL)}, /* 138 */
+    {JOT_NUM_U64(0xD6F8D750UL, 0x9292D603UL), JOT_NUM_U64(0x45A9D284UL, 0x5D3C42B6UL)}, /* 139 */
+    {JOT_NUM_U64(0x865B8692UL, 0x5B9BC5C2UL), JOT_NUM_U64(0x0B8A2392UL, 0xBA45A9B2UL)}, /* 140 */
+    {JOT_NUM_U64(0xA7F26836UL, 0xF282B732UL), JOT_NUM_U64(0x8E6CAC77UL, 0x68D7141EUL)}, /* 141 */
+    {JOT_NUM_U64(0xD1EF0244UL, 0xAF2364FFUL), JOT_NUM_U64(0x3207D795UL, 0x430CD926UL)}, /* 142 */
+    {JOT_NUM_U64(0x8335616AUL, 0xED761F1FUL), JOT_NUM_U64(0x7F44E6BDUL, 0x49E807B8UL)}, /* 143 */
+    {JOT_NUM_U64(0xA402B9C5UL, 0xA8D3A6E7UL), JOT_NUM_U64(0x5F16206CUL, 0x9C6209A6UL)}, /* 144 */
+    {JOT_NUM_U64(0xCD036837UL, 0x130890A1UL), JOT_NUM_U64(0x36DBA887UL, 0xC37A8C0FUL)}, /* 145 */
+    {JOT_NUM_U64(0x80222122UL, 0x6BE55A64UL), JOT_NUM_U64(0xC2494954UL, 0xDA2C9789UL)}, /* 146 */
+    {JOT_NUM_U64(0xA02AA96BUL, 0x06DEB0FDUL), JOT_NUM_U64(0xF2DB9BAAUL, 0x10B7BD6CUL)}, /* 147 */
+    {JOT_NUM_U64(0xC83553C5UL, 0xC8965D3DUL), JOT_NUM_U64(0x6F928294UL, 0x94E5ACC7UL)}, /* 148 */
+    {JOT_NUM_U64(0xFA42A8B7UL, 0x3ABBF48CUL), JOT_NUM_U64(0xCB772339UL, 0xBA1F17F9UL)}, /* 149 */
+    {JOT_NUM_U64(0x9C69A972UL, 0x84B578D7UL), JOT_NUM_U64(0xFF2A7604UL, 0x14536EFBUL)}, /* 150 */
+    {JOT_NUM_U64(0xC38413CFUL, 0x25E2D70DUL), JOT_NUM_U64(0xFEF51385UL, 0x19684ABAUL)}, /* 151 */
+    {JOT_NUM_U64(0xF46518C2UL, 0xEF5B8CD1UL), JOT_NUM_U64(0x7EB25866UL, 0x5FC25D69UL)}, /* 152 */
+    {JOT_NUM_U64(0x98BF2F79UL, 0xD5993802UL), JOT_NUM_U64(0xEF2F773FUL, 0xFBD97A61UL)}, /* 153 */
+    {JOT_NUM_U64(0xBEEEFB58UL, 0x4AFF8603UL), JOT_NUM_U64(0xAAFB550FUL, 0xFACFD8FAUL)}, /* 154 */
+    {JOT_NUM_U64(0xEEAABA2EUL, 0x5DBF6784UL), JOT_NUM_U64(0x95BA2A53UL, 0xF983CF38UL)}, /* 155 */
+    {JOT_NUM_U64(0x952AB45CUL, 0xFA97A0B2UL), JOT_NUM_U64(0xDD945A74UL, 0x7BF26183UL)}, /* 156 */
+    {JOT_NUM_U64(0xBA756174UL, 0x393D88DFUL), JOT_NUM_U64(0x94F97111UL, 0x9AEEF9E4UL)}, /* 157 */
+    {JOT_NUM_U64(0xE912B9D1UL, 0x478CEB17UL), JOT_NUM_U64(0x7A37CD56UL, 0x01AAB85DUL)}, /* 158 */
+    {JOT_NUM_U64(0x91ABB422UL, 0xCCB812EEUL), JOT_NUM_U64(0xAC62E055UL, 0xC10AB33AUL)}, /* 159 */
+    {JOT_NUM_U64(0xB616A12BUL, 0x7FE617AAUL), JOT_NUM_U64(0x577B986BUL, 0x314D6009UL)}, /* 160 */
+    {JOT_NUM_U64(0xE39C4976UL, 0x5FDF9D94UL), JOT_NUM_U64(0xED5A7E85UL, 0xFDA0B80BUL)}, /* 161 */
+    {JOT_NUM_U64(0x8E41ADE9UL, 0xFBEBC27DUL), JOT_NUM_U64(0x14588F13UL, 0xBE847307UL)}, /* 162 */
+    {JOT_NUM_U64(0xB1D21964UL, 0x7AE6B31CUL), JOT_NUM_U64(0x596EB2D8UL, 0xAE258FC8UL)}, /* 163 */
+    {JOT_NUM_U64(0xDE469FBDUL, 0x99A05FE3UL), JOT_NUM_U64(0x6FCA5F8EUL, 0xD9AEF3BBUL)}, /* 164 */
+    {JOT_NUM_U64(0x8AEC23D6UL, 0x80043BEEUL), JOT_NUM_U64(0x25DE7BB9UL, 0x480D5854UL)}, /* 165 */
+    {JOT_NUM_U64(0xADA72CCCUL, 0x20054AE9UL), JOT_NUM_U64(0xAF561AA7UL, 0x9A10AE6AUL)}, /* 166 */
+    {JOT_NUM_U64(0xD910F7FFUL, 0x28069DA4UL), JOT_NUM_U64(0x1B2BA151UL, 0x8094DA04UL)}, /* 167 */
+    {JOT_NUM_U64(0x87AA9AFFUL, 0x79042286UL), JOT_NUM_U64(0x90FB44D2UL, 0xF05D0842UL)}, /* 168 */
+    {JOT_NUM_U64(0xA99541BFUL, 0x57452B28UL), JOT_NUM_U64(0x353A1607UL, 0xAC744A53UL)}, /* 169 */
+    {JOT_NUM_U64(0xD3FA922FUL, 0x2D1675F2UL), JOT_NUM_U64(0x42889B89UL, 0x97915CE8UL)}, /* 170 */
+    {JOT_NUM_U64(0x847C9B5DUL, 0x7C2E09B7UL), JOT_NUM_U64(0x69956135UL, 0xFEBADA11UL)}, /* 171 */
+    {JOT_NUM_U64(0xA59BC234UL, 0xDB398C25UL), JOT_NUM_U64(0x43FAB983UL, 0x7E699095UL)}, /* 172 */
+    {JOT_NUM_U64(0xCF02B2C2UL, 0x1207EF2EUL), JOT_NUM_U64(0x94F967E4UL, 0x5E03F4BBUL)}, /* 173 */
+    {JOT_NUM_U64(0x8161AFB9UL, 0x4B44F57DUL), JOT_NUM_U64(0x1D1BE0EEUL, 0xBAC278F5UL)}, /* 174 */
+    {JOT_NUM_U64(0xA1BA1BA7UL, 0x9E1632DCUL), JOT_NUM_U64(0x6462D92AUL, 0x69731732UL)}, /* 175 */
+    {JOT_NUM_U64(0xCA28A291UL, 0x859BBF93UL), JOT_NUM_U64(0x7D7B8F75UL, 0x03CFDCFEUL)}, /* 176 */
+    {JOT_NUM_U64(0xFCB2CB35UL, 0xE702AF78UL), JOT_NUM_U64(0x5CDA7352UL, 0x44C3D43EUL)}, /* 177 */
+    {JOT_NUM_U64(0x9DEFBF01UL, 0xB061ADABUL), JOT_NUM_U64(0x3A088813UL, 0x6AFA64A7UL)}, /* 178 */
+    {JOT_NUM_U64(0xC56BAEC2UL, 0x1C7A1916UL), JOT_NUM_U64(0x088AAA18UL, 0x45B8FDD0UL)}, /* 179 */
+    {JOT_NUM_U64(0xF6C69A72UL, 0xA3989F5BUL), JOT_NUM_U64(0x8AAD549EUL, 0x57273D45UL)}, /* 180 */
+    {JOT_NUM_U64(0x9A3C2087UL, 0xA63F6399UL), JOT_NUM_U64(0x36AC54E2UL, 0xF678864BUL)}, /* 181 */
+    {JOT_NUM_U64(0xC0CB28A9UL, 0x8FCF3C7FUL), JOT_NUM_U64(0x84576A1BUL, 0xB416A7DDUL)}, /* 182 */
+    {JOT_NUM_U64(0xF0FDF2D3UL, 0xF3C30B9FUL), JOT_NUM_U64(0x656D44A2UL, 0xA11C51D5UL)}, /* 183 */
+    {JOT_NUM_U64(0x969EB7C4UL, 0x7859E743UL), JOT_NUM_U64(0x9F644AE5UL, 0xA4B1B325UL)}, /* 184 */
+    {JOT_NUM_U64(0xBC4665B5UL, 0x96706114UL), JOT_NUM_U64(0x873D5D9FUL, 0x0DDE1FEEUL)}, /* 185 */
+    {JOT_NUM_U64(0xEB57FF22UL, 0xFC0C7959UL), JOT_NUM_U64(0xA90CB506UL, 0xD155A7EAUL)}, /* 186 */
+    {JOT_NUM_U64(0x9316FF75UL, 0xDD87CBD8UL), JOT_NUM_U64(0x09A7F124UL, 0x42D588F2UL)}, /* 187 */
+    {JOT_NUM_U64(0xB7DCBF53UL, 0x54E9BECEUL), JOT_NUM_U64(0x0C11ED6DUL, 0x538AEB2FUL)}, /* 188 */
+    {JOT_NUM_U64(0xE5D3EF28UL, 0x2A242E81UL), JOT_NUM_U64(0x8F1668C8UL, 0xA86DA5FAUL)}, /* 189 */
+    {JOT_NUM_U64(0x8FA47579UL, 0x1A569D10UL), JOT_NUM_U64(0xF96E017DUL, 0x694487BCUL)}, /* 190 */
+    {JOT_NUM_U64(0xB38D92D7UL, 0x60EC4455UL), JOT_NUM_U64(0x37C981DCUL, 0xC395A9ACUL)}, /* 191 */
+    {JOT_NUM_U64(0xE070F78DUL, 0x3927556AUL), JOT_NUM_U64(0x85BBE253UL, 0xF47B1417UL)}, /* 192 */
+    {JOT_NUM_U64(0x8C469AB8UL, 0x43B89562UL), JOT_NUM_U64(0x93956D74UL, 0x78CCEC8EUL)}, /* 193 */
+    {JOT_NUM_U64(0xAF584166UL, 0x54A6BABBUL), JOT_NUM_U64(0x387AC8D1UL, 0x970027B2UL)}, /* 194 */
+    {JOT_NUM_U64(0xDB2E51BFUL, 0xE9D0696AUL), JOT_NUM_U64(0x06997B05UL, 0xFCC0319EUL)}, /* 195 */
+    {JOT_NUM_U64(0x88FCF317UL, 0xF22241E2UL), JOT_NUM_U64(0x441FECE3UL, 0xBDF81F03UL)}, /* 196 */
+    {JOT_NUM_U64(0xAB3C2FDDUL, 0xEEAAD25AUL), JOT_NUM_U64(0xD527E81CUL, 0xAD7626C3UL)}, /* 197 */
+    {JOT_NUM_U64(0xD60B3BD5UL, 0x6A5586F1UL), JOT_NUM_U64(0x8A71E223UL, 0xD8D3B074UL)}, /* 198 */
+    {JOT_NUM_U64(0x85C70565UL, 0x62757456UL), JOT_NUM_U64(0xF6872D56UL, 0x67844E49UL)}, /* 199 */
+    {JOT_NUM_U64(0xA738C6BEUL, 0xBB12D16CUL), JOT_NUM_U64(0xB428F8ACUL, 0x016561DBUL)}, /* 200 */
+    {JOT_NUM_U64(0xD106F86EUL, 0x69D785C7UL), JOT_NUM_U64(0xE13336D7UL, 0x01BEBA52UL)}, /* 201 */
+    {JOT_NUM_U64(0x82A45B45UL, 0x0226B39CUL), JOT_NUM_U64(0xECC00246UL, 0x61173473UL)}, /* 202 */
+    {JOT_NUM_U64(0xA34D7216UL, 0x42B06084UL), JOT_NUM_U64(0x27F002D7UL, 0xF95D0190UL)}, /* 203 */
+    {JOT_NUM_U64(0xCC20CE9BUL, 0xD35C78A5UL), JOT_NUM_U64(0x31EC038DUL, 0xF7B441F4UL)}, /* 204 */
+    {JOT_NUM_U64(0xFF290242UL, 0xC83396CEUL), JOT_NUM_U64(0x7E670471UL, 0x75A15271UL)}, /* 205 */
+    {JOT_NUM_U64(0x9F79A169UL, 0xBD203E41UL), JOT_NUM_U64(0x0F0062C6UL, 0xE984D386UL)}, /* 206 */
+    {JOT_NUM_U64(0xC75809C4UL, 0x2C684DD1UL), JOT_NUM_U64(0x52C07B78UL, 0xA3E60868UL)}, /* 207 */
+    {JOT_NUM_U64(0xF92E0C35UL, 0x37826145UL), JOT_NUM_U64(0xA7709A56UL, 0xCCDF8A82UL)}, /* 208 */
+    {JOT_NUM_U64(0x9BBCC7A1UL, 0x42B17CCBUL), JOT_NUM_U64(0x88A66076UL, 0x400BB691UL)}, /* 209 */
+    {JOT_NUM_U64(0xC2ABF989UL, 0x935DDBFEUL), JOT_NUM_U64(0x6ACFF893UL, 0xD00EA435UL)}, /* 210 */
+    {JOT_NUM_U64(0xF356F7EBUL, 0xF83552FEUL), JOT_NUM_U64(0x0583F6B8UL, 0xC4124D43UL)}, /* 211 */
+    {JOT_NUM_U64(0x98165AF3UL, 0x7B2153DEUL), JOT_NUM_U64(0xC3727A33UL, 0x7A8B704AUL)}, /* 212 */
+    {JOT_NUM_U64(0xBE1BF1B0UL, 0x59E9A8D6UL), JOT_NUM_U64(0x744F18C0UL, 0x592E4C5CUL)}, /* 213 */
+    {JOT_NUM_U64(0xEDA2EE1CUL, 0x7064130CUL), JOT_NUM_U64(0x1162DEF0UL, 0x6F79DF73UL)}, /* 214 */
+    {JOT_NUM_U64(0x9485D4D1UL, 0xC63E8BE7UL), JOT_NUM_U64(0x8ADDCB56UL, 0x45AC2BA8UL)}, /* 215 */
+    {JOT_NUM_U64(0xB9A74A06UL, 0x37CE2EE1UL), JOT_NUM_U64(0x6D953E2BUL, 0xD7173692UL)}, /* 216 */
+    {JOT_NUM_U64(0xE8111C87UL, 0xC5C1BA99UL), JOT_NUM_U64(0xC8FA8DB6UL, 0xCCDD0437UL)}, /* 217 */
+    {JOT_NUM_U64(0x910AB1D4UL, 0xDB9914A0UL), JOT_NUM_U64(0x1D9C9892UL, 0x400A22A2UL)}, /* 218 */
+    {JOT_NUM_U64(0xB54D5E4AUL, 0x127F59C8UL), JOT_NUM_U64(0x2503BEB6UL, 0xD00CAB4BUL)}, /* 219 */
+    {JOT_NUM_U64(0xE2A0B5DCUL, 0x971F303AUL), JOT_NUM_U64(0x2E44AE64UL, 0x840FD61DUL)}, /* 220 */
+    {JOT_NUM_U64(0x8DA471A9UL, 0xDE737E24UL), JOT_NUM_U64(0x5CEAECFEUL, 0xD289E5D2UL)}, /* 221 */
+    {JOT_NUM_U64(0xB10D8E14UL, 0x56105DADUL), JOT_NUM_U64(0x7425A83EUL, 0x872C5F47UL)}, /* 222 */
+    {JOT_NUM_U64(0xDD50F199UL, 0x6B947518UL), JOT_NUM_U64(0xD12F124EUL, 0x28F77719UL)}, /* 223 */
+    {JOT_NUM_U64(0x8A5296FFUL, 0xE33CC92FUL), JOT_NUM_U64(0x82BD6B70UL, 0xD99AAA6FUL)}, /* 224 */
+    {JOT_NUM_U64(0xACE73CBFUL, 0xDC0BFB7BUL), JOT_NUM_U64(0x636CC64DUL, 0x1001550BUL)}, /* 225 */
+    {JOT_NUM_U64(0xD8210BEFUL, 0xD30EFA5AUL), JOT_NUM_U64(0x3C47F7E0UL, 0x5401AA4EUL)}, /* 226 */
+    {JOT_NUM_U64(0x8714A775UL, 0xE3E95C78UL), JOT_NUM_U64(0x65ACFAECUL, 0x34810A71UL)}, /* 227 */
+    {JOT_NUM_U64(0xA8D9D153UL, 0x5CE3B396UL), JOT_NUM_U64(0x7F1839A7UL, 0x41A14D0DUL)}, /* 228 */
+    {JOT_NUM_U64(0xD31045A8UL, 0x341CA07CUL), JOT_NUM_U64(0x1EDE4811UL, 0x1209A050UL)}, /* 229 */
+    {JOT_NUM_U64(0x83EA2B89UL, 0x2091E44DUL), JOT_NUM_U64(0x934AED0AUL, 0xAB460432UL)}, /* 230 */
+    {JOT_NUM_U64(0xA4E4B66BUL, 0x68B65D60UL), JOT_NUM_U64(0xF81DA84DUL, 0x5617853FUL)}, /* 231 */
+    {JOT_NUM_U64(0xCE1DE406UL, 0x42E3F4B9UL), JOT_NUM_U64(0x36251260UL, 0xAB9D668EUL)}, /* 232 */
+    {JOT_NUM_U64(0x80D2AE83UL, 0xE9CE78F3UL), JOT_NUM_U64(0xC1D72B7CUL, 0x6B426019UL)}, /* 233 */
+    {JOT_NUM_U64(0xA1075A24UL, 0xE4421730UL), JOT_NUM_U64(0xB24CF65BUL, 0x8612F81FUL)}, /* 234 */
+    {JOT_NUM_U64(0xC94930AEUL, 0x1D529CFCUL), JOT_NUM_U64(0xDEE033F2UL, 0x6797B627UL)}, /* 235 */
+    {JOT_NUM_U64(0xFB9B7CD9UL, 0xA4A7443CUL), JOT_NUM_U64(0x169840EFUL, 0x017DA3B1UL)}, /* 236 */
+    {JOT_NUM_U64(0x9D412E08UL, 0x06E88AA5UL), JOT_NUM_U64(0x8E1F2895UL, 0x60EE864EUL)}, /* 237 */
+    {JOT_NUM_U64(0xC491798AUL, 0x08A2AD4EUL), JOT_NUM_U64(0xF1A6F2BAUL, 0xB92A27E2UL)}, /* 238 */
+    {JOT_NUM_U64(0xF5B5D7ECUL, 0x8ACB58A2UL), JOT_NUM_U64(0xAE10AF69UL, 0x6774B1DBUL)}, /* 239 */
+    {JOT_NUM_U64(0x9991A6F3UL, 0xD6BF1765UL), JOT_NUM_U64(0xACCA6DA1UL, 0xE0A8EF29UL)}, /* 240 */
+    {JOT_NUM_U64(0xBFF610B0UL, 0xCC6EDD3FUL), JOT_NUM_U64(0x17FD090AUL, 0x58D32AF3UL)}, /* 241 */
+    {JOT_NUM_U64(0xEFF394DCUL, 0xFF8A948EUL), JOT_NUM_U64(0xDDFC4B4CUL, 0xEF07F5B0UL)}, /* 242 */
+    {JOT_NUM_U64(0x95F83D0AUL, 0x1FB69CD9UL), JOT_NUM_U64(0x4ABDAF10UL, 0x1564F98EUL)}, /* 243 */
+    {JOT_NUM_U64(0xBB764C4CUL, 0xA7A4440FUL), JOT_NUM_U64(0x9D6D1AD4UL, 0x1ABE37F1UL)}, /* 244 */
+    {JOT_NUM_U64(0xEA53DF5FUL, 0xD18D5513UL), JOT_NUM_U64(0x84C86189UL, 0x216DC5EDUL)}, /* 245 */
+    {JOT_NUM_U64(0x92746B9BUL, 0xE2F8552CUL), JOT_NUM_U64(0x32FD3CF5UL, 0xB4E49BB4UL)}, /* 246 */
+    {JOT_NUM_U64(0xB7118682UL, 0xDBB66A77UL), JOT_NUM_U64(0x3FBC8C33UL, 0x221DC2A1UL)}, /* 247 */
+    {JOT_NUM_U64(0xE4D5E823UL, 0x92A40515UL), JOT_NUM_U64(0x0FABAF3FUL, 0xEAA5334AUL)}, /* 248 */
+    {JOT_NUM_U64(0x8F05B116UL, 0x3BA6832DUL), JOT_NUM_U64(0x29CB4D87UL, 0xF2A7400EUL)}, /* 249 */
+    {JOT_NUM_U64(0xB2C71D5BUL, 0xCA9023F8UL), JOT_NUM_U64(0x743E20E9UL, 0xEF511012UL)}, /* 250 */
+    {JOT_NUM_U64(0xDF78E4B2UL, 0xBD342CF6UL), JOT_NUM_U64(0x914DA924UL, 0x6B255416UL)}, /* 251 */
+    {JOT_NUM_U64(0x8BAB8EEFUL, 0xB6409C1AUL), JOT_NUM_U64(0x1AD089B6UL, 0xC2F7548EUL)}, /* 252 */
+    {JOT_NUM_U64(0xAE9672ABUL, 0xA3D0C320UL), JOT_NUM_U64(0xA184AC24UL, 0x73B529B1UL)}, /* 253 */
+    {JOT_NUM_U64(0xDA3C0F56UL, 0x8CC4F3E8UL), JOT_NUM_U64(0xC9E5D72DUL, 0x90A2741EUL)}, /* 254 */
+    {JOT_NUM_U64(0x88658996UL, 0x17FB1871UL), JOT_NUM_U64(0x7E2FA67CUL, 0x7A658892UL)}, /* 255 */
+    {JOT_NUM_U64(0xAA7EEBFBUL, 0x9DF9DE8DUL), JOT_NUM_U64(0xDDBB901BUL, 0x98FEEAB7UL)}, /* 256 */
+    {JOT_NUM_U64(0xD51EA6FAUL, 0x85785631UL), JOT_NUM_U64(0x552A7422UL, 0x7F3EA565UL)}, /* 257 */
+    {JOT_NUM_U64(0x8533285CUL, 0x936B35DEUL), JOT_NUM_U64(0xD53A8895UL, 0x8F87275FUL)}, /* 258 */
+    {JOT_NUM_U64(0xA67FF273UL, 0xB8460356UL), JOT_NUM_U64(0x8A892ABAUL, 0xF368F137UL)}, /* 259 */
+    {JOT_NUM_U64(0xD01FEF10UL, 0xA657842CUL), JOT_NUM_U64(0x2D2B7569UL, 0xB0432D85UL)}, /* 260 */
+    {JOT_NUM_U64(0x8213F56AUL, 0x67F6B29BUL), JOT_NUM_U64(0x9C3B2962UL, 0x0E29FC73UL)}, /* 261 */
+    {JOT_NUM_U64(0xA298F2C5UL, 0x01F45F42UL), JOT_NUM_U64(0x8349F3BAUL, 0x91B47B8FUL)}, /* 262 */
+    {JOT_NUM_U64(0xCB3F2F76UL, 0x42717713UL), JOT_NUM_U64(0x241C70A9UL, 0x36219A73UL)}, /* 263 */
+    {JOT_NUM_U64(0xFE0EFB53UL, 0xD30DD4D7UL), JOT_NUM_U64(0xED238CD3UL, 0x83AA0110UL)}, /* 264 */
+    {JOT_NUM_U64(0x9EC95D14UL, 0x63E8A506UL), JOT_NUM_U64(0xF4363804UL, 0x324A40AAUL)}, /* 265 */
+    {JOT_NUM_U64(0xC67BB459UL, 0x7CE2CE48UL), JOT_NUM_U64(0xB143C605UL, 0x3EDCD0D5UL)}, /* 266 */
+    {JOT_NUM_U64(0xF81AA16FUL, 0xDC1B81DAUL), JOT_NUM_U64(0xDD94B786UL, 0x8E94050AUL)}, /* 267 */
+    {JOT_NUM_U64(0x9B10A4E5UL, 0xE9913128UL), JOT_NUM_U64(0xCA7CF2B4UL, 0x191C8326UL)}, /* 268 */
+    {JOT_NUM_U64(0xC1D4CE1FUL, 0x63F57D72UL), JOT_NUM_U64(0xFD1C2F61UL, 0x1F63A3F0UL)}, /* 269 */
+    {JOT_NUM_U64(0xF24A01A7UL, 0x3CF2DCCFUL), JOT_NUM_U64(0xBC633B39UL, 0x673C8CECUL)}, /* 270 */
+    {JOT_NUM_U64(0x976E4108UL, 0x8617CA01UL), JOT_NUM_U64(0xD5BE0503UL, 0xE085D813UL)}, /* 271 */
+    {JOT_NUM_U64(0xBD49D14AUL, 0xA79DBC82UL), JOT_NUM_U64(0x4B2D8644UL, 0xD8A74E18UL)}, /* 272 */
+    {JOT_NUM_U64(0xEC9C459DUL, 0x51852BA2UL), JOT_NUM_U64(0xDDF8E7D6UL, 0x0ED1219EUL)}, /* 273 */
+    {JOT_NUM_U64(0x93E1AB82UL, 0x52F33B45UL), JOT_NUM_U64(0xCABB90E5UL, 0xC942B503UL)}, /* 274 */
+    {JOT_NUM_U64(0xB8DA1662UL, 0xE7B00A17UL), JOT_NUM_U64(0x3D6A751FUL, 0x3B936243UL)}, /* 275 */
+    {JOT_NUM_U64(0xE7109BFBUL, 0xA19C0C9DUL), JOT_NUM_U64(0x0CC51267UL, 0x0A783AD4UL)}, /* 276 */
+    {JOT_NUM_U64(0x906A617DUL, 0x450187E2UL), JOT_NUM_U64(0x27FB2B80UL, 0x668B24C5UL)}, /* 277 */
+    {JOT_NUM_U64(0xB484F9DCUL, 0x9641E9DAUL), JOT_NUM_U64(0xB1F9F660UL, 0x802DEDF6UL)}, /* 278 */
+    {JOT_NUM_U64(0xE1A63853UL, 0xBBD26451UL), JOT_NUM_U64(0x5E7873F8UL, 0xA0396973UL)}, /* 279 */
+    {JOT_NUM_U64(0x8D07E334UL, 0x55637EB2UL), JOT_NUM_U64(0xDB0B487BUL, 0x6423E1E8UL)}, /* 280 */
+    {JOT_NUM_U64(0xB049DC01UL, 0x6ABC5E5FUL), JOT_NUM_U64(0x91CE1A9AUL, 0x3D2CDA62UL)}, /* 281 */
+    {JOT_NUM_U64(0xDC5C5301UL, 0xC56B75F7UL), JOT_NUM_U64(0x7641A140UL, 0xCC7810FBUL)}, /* 282 */
+    {JOT_NUM_U64(0x89B9B3E1UL, 0x1B6329BAUL), JOT_NUM_U64(0xA9E904C8UL, 0x7FCB0A9DUL)}, /* 283 */
+    {JOT_NUM_U64(0xAC2820D9UL, 0x623BF429UL), JOT_NUM_U64(0x546345FAUL, 0x9FBDCD44UL)}, /* 284 */
+    {JOT_NUM_U64(0xD732290FUL, 0xBACAF133UL), JOT_NUM_U64(0xA97C1779UL, 0x47AD4095UL)}, /* 285 */
+    {JOT_NUM_U64(0x867F59A9UL, 0xD4BED6C0UL), JOT_NUM_U64(0x49ED8EABUL, 0xCCCC485DUL)}, /* 286 */
+    {JOT_NUM_U64(0xA81F3014UL, 0x49EE8C70UL), JOT_NUM_U64(0x5C68F256UL, 0xBFFF5A74UL)}, /* 287 */
+    {JOT_NUM_U64(0xD226FC19UL, 0x5C6A2F8CUL), JOT_NUM_U64(0x73832EECUL, 0x6FFF3111UL)}, /* 288 */
+    {JOT_NUM_U64(0x83585D8FUL, 0xD9C25DB7UL), JOT_NUM_U64(0xC831FD53UL, 0xC5FF7EABUL)}, /* 289 */
+    {JOT_NUM_U64(0xA42E74F3UL, 0xD032F525UL), JOT_NUM_U64(0xBA3E7CA8UL, 0xB77F5E55UL)}, /* 290 */
+    {JOT_NUM_U64(0xCD3A1230UL, 0xC43FB26FUL), JOT_NUM_U64(0x28CE1BD2UL, 0xE55F35EBUL)}, /* 291 */
+    {JOT_NUM_U64(0x80444B5EUL, 0x7AA7CF85UL), JOT_NUM_U64(0x7980D163UL, 0xCF5B81B3UL)}, /* 292 */
+    {JOT_NUM_U64(0xA0555E36UL, 0x1951C366UL), JOT_NUM_U64(0xD7E105BCUL, 0xC332621FUL)}, /* 293 */
+    {JOT_NUM_U64(0xC86AB5C3UL, 0x9FA63440UL), JOT_NUM_U64(0x8DD9472BUL, 0xF3FEFAA7UL)}, /* 294 */
+    {JOT_NUM_U64(0xFA856334UL, 0x878FC150UL), JOT_NUM_U64(0xB14F98F6UL, 0xF0FEB951UL)}, /* 295 */
+    {JOT_NUM_U64(0x9C935E00UL, 0xD4B9D8D2UL), JOT_NUM_U64(0x6ED1BF9AUL, 0x569F33D3UL)}, /* 296 */
+    {JOT_NUM_U64(0xC3B83581UL, 0x09E84F07UL), JOT_NUM_U64(0x0A862F80UL, 0xEC4700C8UL)}, /* 297 */
+    {JOT_NUM_U64(0xF4A642E1UL, 0x4C6262C8UL), JOT_NUM_U64(0xCD27BB61UL, 0x2758C0FAUL)}, /* 298 */
+    {JOT_NUM_U64(0x98E7E9CCUL, 0xCFBD7DBDUL), JOT_NUM_U64(0x8038D51CUL, 0xB897789CUL)}, /* 299 */
+    {JOT_NUM_U64(0xBF21E440UL, 0x03ACDD2CUL), JOT_NUM_U64(0xE0470A63UL, 0xE6BD56C3UL)}, /* 300 */
+    {JOT_NUM_U64(0xEEEA5D50UL, 0x04981478UL), JOT_NUM_U64(0x1858CCFCUL, 0xE06CAC74UL)}, /* 301 */
+    {JOT_NUM_U64(0x95527A52UL, 0x02DF0CCBUL), JOT_NUM_U64(0x0F37801EUL, 0x0C43EBC8UL)}, /* 302 */
+    {JOT_NUM_U64(0xBAA718E6UL, 0x8396CFFDUL), JOT_NUM_U64(0xD3056025UL, 0x8F54E6BAUL)}, /* 303 */
+    {JOT_NUM_U64(0xE950DF20UL, 0x247C83FDUL), JOT_NUM_U64(0x47C6B82EUL, 0xF32A2069UL)}, /* 304 */
+    {JOT_NUM_U64(0x91D28B74UL, 0x16CDD27EUL), JOT_NUM_U64(0x4CDC331DUL, 0x57FA5441UL)}, /* 305 */
+    {JOT_NUM_U64(0xB6472E51UL, 0x1C81471DUL), JOT_NUM_U64(0xE0133FE4UL, 0xADF8E952UL)}, /* 306 */
+    {JOT_NUM_U64(0xE3D8F9E5UL, 0x63A198E5UL), JOT_NUM_U64(0x58180FDDUL, 0xD97723A6UL)}, /* 307 */
+    {JOT_NUM_U64(0x8E679C2FUL, 0x5E44FF8FUL), JOT_NUM_U64(0x570F09EAUL, 0xA7EA7648UL)} /* 308 */
+};
+
+#undef JOT_NUM_U64
+
+#endif
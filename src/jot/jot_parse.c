@@ -0,0 +1,1451 @@
+/*
+    jot - Parser
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+
+#include <string.h>
+
+#include "jot_parse.h"
+#include "jot_source.h"
+
+enum
+{
+    JOT_AST_MIN_CAPACITY = 1024,
+    JOT_PARSE_MIN_STACK_CAPACITY = 64,
+    JOT_PARSE_LOOKAHEAD_CAPACITY = 16,
+    
+    /* Deeper than this and the C stack is at risk. */
+    JOT_PARSE_MAX_DEPTH = 200,
+    
+    /* Binary operators bind tighter than this, and the ones past it bind tighter still. */
+    JOT_PARSE_UNARY_PRECEDENCE = 12
+};
+
+typedef struct
+{
+    jot_Allocator* allocator;
+    jot_Lookahead* lookahead;
+    jot_Ast* ast;
+    jot_ParseError* error;
+    
+    /* The current token, which stays put until jot_ParserAdvance. */
+    const jot_LookaheadToken* token;
+    /* Where the token before it ended. */
+    size_t previous_end;
+    
+    /*
+        Lists are gathered here, since their length isn't known until
+        they're done, and only then copied into a node.
+    */
+    size_t stack_count;
+    size_t stack_capacity;
+    uint32_t* stack;
+    
+    /* Where the scanned text starts in the AST's source, added to every offset. */
+    size_t origin;
+    /* Whether function bodies are skipped rather than parsed. */
+    int lazy;
+    
+    size_t depth;
+    /* Loops enclosing the current statement, within the current function. */
+    size_t loops;
+    /* Whether the current function takes '...'. */
+    int vararg;
+} jot_Parser;
+
+/* Once something has gone wrong, every token reads as this, so everything unwinds. */
+static const jot_LookaheadToken jot_parse_stop = { JOT_TOKEN_EOF, JOT_KEYWORD_NONE, 0, 0, NULL, 0, 0, 0.0, NULL, 0 };
+
+static jot_NodeRef jot_ParseExpression(jot_Parser* self);
+static jot_NodeRef jot_ParseBlock(jot_Parser* self);
+
+static jot_NodeRef jot_ParserFail(jot_Parser* self, const char* message)
+{
+    if(self->error->message == NULL)
+    {
+        self->error->message = message;
+        self->error->offset = self->origin + self->token->offset;
+        self->error->length = self->token->length;
+        if(self->token == &jot_parse_stop)
+        {
+            self->error->offset = self->origin + self->previous_end;
+        }
+    }
+    self->token = &jot_parse_stop;
+    return 0;
+}
+
+static int jot_ParserFailed(const jot_Parser* self)
+{
+    return self->error->message != NULL;
+}
+
+/* Makes token current, unless it's one that can't be parsed. */
+static void jot_ParserTake(jot_Parser* self, const jot_LookaheadToken* token)
+{
+    if(token == NULL)
+    {
+        self->token = &jot_parse_stop;
+        jot_ParserFail(self, "out of memory");
+        return;
+    }
+    self->token = token;
+    if(token->kind == JOT_TOKEN_ERROR)
+    {
+        jot_ParserFail(self, "invalid token");
+    }
+    else if((token->kind == JOT_TOKEN_IDENTIFIER || token->kind == JOT_TOKEN_STR) && token->atom == NULL)
+    {
+        jot_ParserFail(self, "out of memory");
+    }
+}
+
+/* Makes the next token current. */
+static void jot_ParserAdvance(jot_Parser* self)
+{
+    if(jot_ParserFailed(self))
+    {
+        return;
+    }
+    self->previous_end = self->token->offset + self->token->length;
+    jot_LookaheadNext(self->lookahead);
+    jot_ParserTake(self, jot_LookaheadPeek(self->lookahead, 0));
+}
+
+static int jot_ParserIs(const jot_Parser* self, jot_Token kind)
+{
+    return self->token->kind == kind;
+}
+
+static int jot_ParserIsKeyword(const jot_Parser* self, jot_Keyword keyword)
+{
+    return self->token->kind == JOT_TOKEN_KEYWORD && self->token->keyword == keyword;
+}
+
+static int jot_ParserAccept(jot_Parser* self, jot_Token kind)
+{
+    if(jot_ParserIs(self, kind))
+    {
+        jot_ParserAdvance(self);
+        return 1;
+    }
+    return 0;
+}
+
+static int jot_ParserExpect(jot_Parser* self, jot_Token kind, const char* message)
+{
+    if(jot_ParserAccept(self, kind))
+    {
+        return 1;
+    }
+    jot_ParserFail(self, message);
+    return 0;
+}
+
+static int jot_ParserExpectKeyword(jot_Parser* self, jot_Keyword keyword, const char* message)
+{
+    if(jot_ParserIsKeyword(self, keyword))
+    {
+        jot_ParserAdvance(self);
+        return 1;
+    }
+    jot_ParserFail(self, message);
+    return 0;
+}
+
+/* Whether the current token ends a block. */
+static int jot_ParserAtBlockEnd(const jot_Parser* self)
+{
+    return jot_ParserIs(self, JOT_TOKEN_EOF)
+        || jot_ParserIsKeyword(self, JOT_KEYWORD_END)
+        || jot_ParserIsKeyword(self, JOT_KEYWORD_ELSE)
+        || jot_ParserIsKeyword(self, JOT_KEYWORD_ELSEIF)
+        || jot_ParserIsKeyword(self, JOT_KEYWORD_UNTIL);
+}
+
+static int jot_ParserPush(jot_Parser* self, uint32_t word)
+{
+    if(self->stack_count == self->stack_capacity)
+    {
+        size_t capacity = self->stack_capacity * 2;
+        uint32_t* stack = jot_Realloc(self->allocator, JOT_ALLOC_PARSE, self->stack,
+            self->stack_capacity * sizeof(uint32_t), capacity * sizeof(uint32_t));
+        if(stack == NULL)
+        {
+            jot_ParserFail(self, "out of memory");
+            return 0;
+        }
+        self->stack = stack;
+        self->stack_capacity = capacity;
+    }
+    self->stack[self->stack_count++] = word;
+    return 1;
+}
+
+/* Starts a node with size words after the first two, which the caller fills in. */
+static jot_NodeRef jot_ParserNode(jot_Parser* self, jot_NodeKind kind, unsigned int op, unsigned int flags, size_t offset, size_t size)
+{
+    jot_NodeRef node;
+    
+    if(jot_ParserFailed(self))
+    {
+        return 0;
+    }
+    offset += self->origin;
+    if(offset > 0xFFFFFFFFUL || self->ast->count + size + 2 > 0xFFFFFFFFUL)
+    {
+        return jot_ParserFail(self, "source too large");
+    }
+    node = jot_AstAppend(self->ast, kind, op, flags, offset, size);
+    if(!node)
+    {
+        return jot_ParserFail(self, "out of memory");
+    }
+    return node;
+}
+
+/* Makes a node out of everything pushed since base, and pops it. */
+static jot_NodeRef jot_ParserPopNode(jot_Parser* self, jot_NodeKind kind, unsigned int op, unsigned int flags, size_t offset, size_t base)
+{
+    size_t size = self->stack_count - base;
+    jot_NodeRef node = jot_ParserNode(self, kind, op, flags, offset, size);
+    
+    if(node)
+    {
+        memcpy(self->ast->words + node + 2, self->stack + base, size * sizeof(uint32_t));
+    }
+    self->stack_count = base;
+    return node;
+}
+
+static jot_NodeRef jot_ParserNode2(jot_Parser* self, jot_NodeKind kind, unsigned int op, size_t offset, uint32_t a, uint32_t b)
+{
+    jot_NodeRef node = jot_ParserNode(self, kind, op, 0, offset, 2);
+    
+    if(node)
+    {
+        self->ast->words[node + 2] = a;
+        self->ast->words[node + 3] = b;
+    }
+    return node;
+}
+
+static int jot_ParserEnter(jot_Parser* self)
+{
+    if(++self->depth > JOT_PARSE_MAX_DEPTH)
+    {
+        jot_ParserFail(self, "nested too deeply");
+        return 0;
+    }
+    return 1;
+}
+
+/* Expects a name, and returns its atom's id. */
+static uint32_t jot_ParseName(jot_Parser* self)
+{
+    uint32_t id;
+    
+    if(!jot_ParserIs(self, JOT_TOKEN_IDENTIFIER))
+    {
+        jot_ParserFail(self, "expected a name");
+        return 0;
+    }
+    id = self->token->atom->id;
+    jot_ParserAdvance(self);
+    return id;
+}
+
+/* Expects a name, and pushes its atom's id. */
+static int jot_ParsePushName(jot_Parser* self)
+{
+    uint32_t id = jot_ParseName(self);
+    return !jot_ParserFailed(self) && jot_ParserPush(self, id);
+}
+
+/* A name used as a key, after '.' or as a table field. */
+static jot_NodeRef jot_ParseNameKey(jot_Parser* self)
+{
+    size_t offset = self->token->offset;
+    uint32_t id = jot_ParseName(self);
+    jot_NodeRef node = jot_ParserNode(self, JOT_NODE_STR, 0, 0, offset, 1);
+    
+    if(node)
+    {
+        self->ast->words[node + 2] = id;
+    }
+    return node;
+}
+
+/* Parses expressions separated by commas onto the stack, and returns how many. */
+static uint32_t jot_ParseExpressionList(jot_Parser* self)
+{
+    uint32_t count = 0;
+    
+    do
+    {
+        jot_NodeRef expression = jot_ParseExpression(self);
+        if(!expression || !jot_ParserPush(self, expression))
+        {
+            return 0;
+        }
+        count++;
+    } while(jot_ParserAccept(self, JOT_TOKEN_COMMA));
+    return count;
+}
+
+/* '(' [exprs] ')', for a call at offset whose first words are already pushed from base. */
+static jot_NodeRef jot_ParseArguments(jot_Parser* self, jot_NodeKind kind, size_t offset, size_t base)
+{
+    size_t count_index = self->stack_count;
+    uint32_t count = 0;
+    
+    if(!jot_ParserExpect(self, JOT_TOKEN_LPAREN, "expected '('") || !jot_ParserPush(self, 0))
+    {
+        return 0;
+    }
+    if(!jot_ParserIs(self, JOT_TOKEN_RPAREN) && (count = jot_ParseExpressionList(self)) == 0)
+    {
+        return 0;
+    }
+    if(!jot_ParserExpect(self, JOT_TOKEN_RPAREN, "expected ')'"))
+    {
+        return 0;
+    }
+    self->stack[count_index] = count;
+    return jot_ParserPopNode(self, kind, 0, 0, offset, base);
+}
+
+/*
+    Skips a function body, up to the 'end' that closes it, by counting the
+    keywords that open and close blocks: if, do (which while and for have
+    too), repeat, and func unless it's followed by '->'. Names and strings
+    aren't interned on the way, since nothing refers to them until the
+    body is parsed.
+*/
+static int jot_ParserSkipBody(jot_Parser* self)
+{
+    jot_Scanner* scanner = self->lookahead->scanner;
+    jot_AtomTable* atoms = scanner->atoms;
+    const jot_LookaheadToken* token = self->token;
+    size_t depth = 1;
+    /* 1 in the parameters of a func, 2 right after them. */
+    int func = 0;
+    
+    scanner->atoms = NULL;
+    for(;;)
+    {
+        if(func == 2)
+        {
+            func = 0;
+            depth += token->kind != JOT_TOKEN_ARROW;
+        }
+        if(token->kind == JOT_TOKEN_EOF)
+        {
+            break;
+        }
+        if(token->kind == JOT_TOKEN_RPAREN && func == 1)
+        {
+            func = 2;
+        }
+        else if(token->kind == JOT_TOKEN_KEYWORD)
+        {
+            switch(token->keyword)
+            {
+                case JOT_KEYWORD_FUNC:
+                    func = 1;
+                    break;
+                case JOT_KEYWORD_IF:
+                case JOT_KEYWORD_DO:
+                case JOT_KEYWORD_REPEAT:
+                    depth++;
+                    break;
+                case JOT_KEYWORD_END:
+                case JOT_KEYWORD_UNTIL:
+                    depth--;
+                    break;
+                default:
+                    break;
+            }
+            if(depth == 0)
+            {
+                break;
+            }
+        }
+        self->previous_end = token->offset + token->length;
+        jot_LookaheadNext(self->lookahead);
+        if((token = jot_LookaheadPeek(self->lookahead, 0)) == NULL)
+        {
+            scanner->atoms = atoms;
+            self->token = &jot_parse_stop;
+            jot_ParserFail(self, "out of memory");
+            return 0;
+        }
+    }
+    scanner->atoms = atoms;
+    self->token = token;
+    return 1;
+}
+
+/* Everything after 'func' and its name: parameters, then the body. */
+static jot_NodeRef jot_ParseFunction(jot_Parser* self, size_t offset, uint32_t name, unsigned int flags)
+{
+    size_t base = self->stack_count;
+    size_t loops = self->loops;
+    int vararg = self->vararg;
+    uint32_t count = 0;
+    jot_NodeRef body = 0;
+    int parsed;
+    
+    /* body offset, end offset, body, name, parameter count, parameters... */
+    if(!jot_ParserPush(self, 0) || !jot_ParserPush(self, 0) || !jot_ParserPush(self, 0)
+        || !jot_ParserPush(self, name) || !jot_ParserPush(self, 0))
+    {
+        return 0;
+    }
+    if(!jot_ParserExpect(self, JOT_TOKEN_LPAREN, "expected '('"))
+    {
+        return 0;
+    }
+    if(!jot_ParserIs(self, JOT_TOKEN_RPAREN))
+    {
+        do
+        {
+            if(jot_ParserAccept(self, JOT_TOKEN_DOT_DOT_DOT))
+            {
+                flags |= JOT_FUNC_VARARG;
+                break;
+            }
+            if(!jot_ParsePushName(self))
+            {
+                return 0;
+            }
+            count++;
+        } while(jot_ParserAccept(self, JOT_TOKEN_COMMA));
+    }
+    if(!jot_ParserExpect(self, JOT_TOKEN_RPAREN, "expected ')'"))
+    {
+        return 0;
+    }
+    self->stack[base] = (uint32_t) (self->origin + self->previous_end);
+    
+    self->loops = 0;
+    self->vararg = (flags & JOT_FUNC_VARARG) != 0;
+    if(jot_ParserIs(self, JOT_TOKEN_ARROW))
+    {
+        /* A lone expression is shorthand for a block that returns it. */
+        size_t arrow = self->token->offset;
+        jot_NodeRef value;
+        jot_ParserAdvance(self);
+        value = jot_ParseExpression(self);
+        body = value ? jot_ParserNode2(self, JOT_NODE_RETURN, 0, arrow, 1, value) : 0;
+        body = body ? jot_ParserNode2(self, JOT_NODE_BLOCK, 0, arrow, 1, body) : 0;
+        parsed = body != 0;
+    }
+    else
+    {
+        /* A skipped body is left as 0, for jot_AstFunctionBody to fill in. */
+        parsed = self->lazy ? jot_ParserSkipBody(self) : (body = jot_ParseBlock(self)) != 0;
+        parsed = parsed && jot_ParserExpectKeyword(self, JOT_KEYWORD_END, "expected 'end' to close 'func'");
+    }
+    self->loops = loops;
+    self->vararg = vararg;
+    if(!parsed)
+    {
+        return 0;
+    }
+    
+    self->stack[base + 1] = (uint32_t) (self->origin + self->previous_end);
+    self->stack[base + 2] = body;
+    self->stack[base + 4] = count;
+    return jot_ParserPopNode(self, JOT_NODE_FUNC, 0, flags, offset, base);
+}
+
+/* '{' [field {(',' | ';') field} [',' | ';']] '}' */
+static jot_NodeRef jot_ParseTable(jot_Parser* self)
+{
+    size_t offset = self->token->offset;
+    size_t base = self->stack_count;
+    uint32_t count = 0;
+    jot_NodeRef key;
+    jot_NodeRef value;
+    
+    jot_ParserAdvance(self);
+    if(!jot_ParserPush(self, 0))
+    {
+        return 0;
+    }
+    while(!jot_ParserIs(self, JOT_TOKEN_RBRACE))
+    {
+        if(jot_ParserAccept(self, JOT_TOKEN_LBRACKET))
+        {
+            key = jot_ParseExpression(self);
+            if(!key || !jot_ParserExpect(self, JOT_TOKEN_RBRACKET, "expected ']'"))
+            {
+                return 0;
+            }
+        }
+        else if((key = jot_ParseNameKey(self)) == 0)
+        {
+            return 0;
+        }
+        if(!jot_ParserExpect(self, JOT_TOKEN_COLON, "expected ':' after table key")
+            || (value = jot_ParseExpression(self)) == 0
+            || !jot_ParserPush(self, key) || !jot_ParserPush(self, value))
+        {
+            return 0;
+        }
+        count++;
+        if(!jot_ParserAccept(self, JOT_TOKEN_COMMA) && !jot_ParserAccept(self, JOT_TOKEN_SEMICOLON))
+        {
+            break;
+        }
+    }
+    if(!jot_ParserExpect(self, JOT_TOKEN_RBRACE, "expected '}'"))
+    {
+        return 0;
+    }
+    self->stack[base] = count;
+    return jot_ParserPopNode(self, JOT_NODE_TABLE, 0, 0, offset, base);
+}
+
+/* '[' [exprs [',']] ']' */
+static jot_NodeRef jot_ParseArray(jot_Parser* self)
+{
+    size_t offset = self->token->offset;
+    size_t base = self->stack_count;
+    uint32_t count = 0;
+    jot_NodeRef element;
+    
+    jot_ParserAdvance(self);
+    if(!jot_ParserPush(self, 0))
+    {
+        return 0;
+    }
+    while(!jot_ParserIs(self, JOT_TOKEN_RBRACKET))
+    {
+        if((element = jot_ParseExpression(self)) == 0 || !jot_ParserPush(self, element))
+        {
+            return 0;
+        }
+        count++;
+        if(!jot_ParserAccept(self, JOT_TOKEN_COMMA))
+        {
+            break;
+        }
+    }
+    if(!jot_ParserExpect(self, JOT_TOKEN_RBRACKET, "expected ']'"))
+    {
+        return 0;
+    }
+    self->stack[base] = count;
+    return jot_ParserPopNode(self, JOT_NODE_ARRAY, 0, 0, offset, base);
+}
+
+/* A name or parenthesized expression, then any number of indexes and calls. */
+static jot_NodeRef jot_ParseSuffixed(jot_Parser* self)
+{
+    size_t offset = self->token->offset;
+    size_t base;
+    jot_NodeRef node;
+    jot_NodeRef key;
+    
+    if(jot_ParserIs(self, JOT_TOKEN_IDENTIFIER))
+    {
+        node = jot_ParserNode(self, JOT_NODE_NAME, 0, 0, offset, 1);
+        if(node)
+        {
+            self->ast->words[node + 2] = self->token->atom->id;
+        }
+        jot_ParserAdvance(self);
+    }
+    else if(jot_ParserAccept(self, JOT_TOKEN_LPAREN))
+    {
+        node = jot_ParseExpression(self);
+        if(node && !jot_ParserExpect(self, JOT_TOKEN_RPAREN, "expected ')'"))
+        {
+            node = 0;
+        }
+    }
+    else
+    {
+        return jot_ParserFail(self, "expected an expression");
+    }
+    
+    while(node)
+    {
+        offset = self->token->offset;
+        base = self->stack_count;
+        switch(self->token->kind)
+        {
+            case JOT_TOKEN_DOT:
+                jot_ParserAdvance(self);
+                key = jot_ParseNameKey(self);
+                node = key ? jot_ParserNode2(self, JOT_NODE_INDEX, 0, offset, node, key) : 0;
+                break;
+            case JOT_TOKEN_LBRACKET:
+                jot_ParserAdvance(self);
+                key = jot_ParseExpression(self);
+                if(key && !jot_ParserExpect(self, JOT_TOKEN_RBRACKET, "expected ']'"))
+                {
+                    key = 0;
+                }
+                node = key ? jot_ParserNode2(self, JOT_NODE_INDEX, 0, offset, node, key) : 0;
+                break;
+            case JOT_TOKEN_COLON:
+                jot_ParserAdvance(self);
+                if(!jot_ParserPush(self, node) || !jot_ParsePushName(self))
+                {
+                    return 0;
+                }
+                node = jot_ParseArguments(self, JOT_NODE_METHOD_CALL, offset, base);
+                break;
+            case JOT_TOKEN_LPAREN:
+                node = jot_ParserPush(self, node) ? jot_ParseArguments(self, JOT_NODE_CALL, offset, base) : 0;
+                break;
+            default:
+                return node;
+        }
+    }
+    return 0;
+}
+
+static jot_NodeRef jot_ParseSimple(jot_Parser* self)
+{
+    const jot_LookaheadToken* token = self->token;
+    jot_NodeRef node = 0;
+    size_t offset;
+    uint64_t bits;
+    
+    switch(token->kind)
+    {
+        case JOT_TOKEN_INT:
+        case JOT_TOKEN_HEX:
+        case JOT_TOKEN_BIN:
+        case JOT_TOKEN_NUM:
+            if(token->kind == JOT_TOKEN_NUM)
+            {
+                memcpy(&bits, &token->num_value, sizeof(bits));
+                node = jot_ParserNode(self, JOT_NODE_NUM, 0, 0, token->offset, 2);
+            }
+            else
+            {
+                bits = (uint64_t) token->int_value;
+                node = jot_ParserNode(self, JOT_NODE_INT, token->kind, 0, token->offset, 2);
+            }
+            if(node)
+            {
+                self->ast->words[node + 2] = (uint32_t) bits;
+                self->ast->words[node + 3] = (uint32_t) (bits >> 32);
+            }
+            break;
+        case JOT_TOKEN_STR:
+            node = jot_ParserNode(self, JOT_NODE_STR, 0, 0, token->offset, 1);
+            if(node)
+            {
+                self->ast->words[node + 2] = token->atom->id;
+            }
+            break;
+        case JOT_TOKEN_DOT_DOT_DOT:
+            if(!self->vararg)
+            {
+                return jot_ParserFail(self, "'...' outside a function that takes it");
+            }
+            node = jot_ParserNode(self, JOT_NODE_VARARG, 0, 0, token->offset, 0);
+            break;
+        case JOT_TOKEN_LBRACE:
+            return jot_ParseTable(self);
+        case JOT_TOKEN_LBRACKET:
+            return jot_ParseArray(self);
+        case JOT_TOKEN_KEYWORD:
+            switch(token->keyword)
+            {
+                case JOT_KEYWORD_NIL:
+                    node = jot_ParserNode(self, JOT_NODE_NIL, 0, 0, token->offset, 0);
+                    break;
+                case JOT_KEYWORD_TRUE:
+                    node = jot_ParserNode(self, JOT_NODE_TRUE, 0, 0, token->offset, 0);
+                    break;
+                case JOT_KEYWORD_FALSE:
+                    node = jot_ParserNode(self, JOT_NODE_FALSE, 0, 0, token->offset, 0);
+                    break;
+                case JOT_KEYWORD_FUNC:
+                    offset = token->offset;
+                    jot_ParserAdvance(self);
+                    return jot_ParseFunction(self, offset, JOT_AST_NO_ATOM, 0);
+                default:
+                    return jot_ParserFail(self, "expected an expression");
+            }
+            break;
+        default:
+            return jot_ParseSuffixed(self);
+    }
+    jot_ParserAdvance(self);
+    return node;
+}
+
+/*
+    How tightly the current token binds as a binary operator on its left and
+    right, or 0 if it isn't one. Right associative operators bind less
+    tightly on their right.
+*/
+static int jot_ParserBinaryPrecedence(const jot_Parser* self, int* right)
+{
+    int left;
+    
+    switch(self->token->kind)
+    {
+        case JOT_TOKEN_KEYWORD:
+            left = self->token->keyword == JOT_KEYWORD_OR ? 1 : self->token->keyword == JOT_KEYWORD_AND ? 2 : 0;
+            break;
+        case JOT_TOKEN_CMP_EQ:
+        case JOT_TOKEN_CMP_NE:
+        case JOT_TOKEN_CMP_LT:
+        case JOT_TOKEN_CMP_LE:
+        case JOT_TOKEN_CMP_GT:
+        case JOT_TOKEN_CMP_GE:
+            left = 3;
+            break;
+        case JOT_TOKEN_OR:
+            left = 4;
+            break;
+        case JOT_TOKEN_XOR:
+            left = 5;
+            break;
+        case JOT_TOKEN_AND:
+            left = 6;
+            break;
+        case JOT_TOKEN_SHL:
+        case JOT_TOKEN_SHR:
+            left = 7;
+            break;
+        case JOT_TOKEN_DOT_DOT:
+            *right = 8;
+            return 9;
+        case JOT_TOKEN_ADD:
+        case JOT_TOKEN_SUB:
+            left = 10;
+            break;
+        case JOT_TOKEN_MUL:
+        case JOT_TOKEN_DIV:
+        case JOT_TOKEN_MOD:
+            left = 11;
+            break;
+        case JOT_TOKEN_EXP:
+            *right = 13;
+            return 14;
+        default:
+            left = 0;
+            break;
+    }
+    *right = left;
+    return left;
+}
+
+/* An expression made of operators that bind tighter than limit. */
+static jot_NodeRef jot_ParseSubexpression(jot_Parser* self, int limit)
+{
+    const jot_LookaheadToken* token = self->token;
+    jot_NodeRef left;
+    jot_NodeRef right;
+    int left_precedence;
+    int right_precedence;
+    
+    if(!jot_ParserEnter(self))
+    {
+        return 0;
+    }
+    if(jot_ParserIs(self, JOT_TOKEN_SUB) || jot_ParserIs(self, JOT_TOKEN_TILDE)
+        || jot_ParserIs(self, JOT_TOKEN_EXCLAIM) || jot_ParserIsKeyword(self, JOT_KEYWORD_NOT))
+    {
+        size_t offset = token->offset;
+        jot_Token op = token->kind == JOT_TOKEN_KEYWORD ? JOT_TOKEN_EXCLAIM : token->kind;
+        jot_ParserAdvance(self);
+        right = jot_ParseSubexpression(self, JOT_PARSE_UNARY_PRECEDENCE);
+        left = right ? jot_ParserNode(self, JOT_NODE_UNARY, op, 0, offset, 1) : 0;
+        if(left)
+        {
+            self->ast->words[left + 2] = right;
+        }
+    }
+    else
+    {
+        left = jot_ParseSimple(self);
+    }
+    
+    while(left && (left_precedence = jot_ParserBinaryPrecedence(self, &right_precedence)) > limit)
+    {
+        size_t offset = self->token->offset;
+        jot_NodeKind kind = JOT_NODE_BINARY;
+        jot_Token op = self->token->kind;
+        if(op == JOT_TOKEN_KEYWORD)
+        {
+            kind = self->token->keyword == JOT_KEYWORD_OR ? JOT_NODE_OR : JOT_NODE_AND;
+            op = JOT_TOKEN_NONE;
+        }
+        jot_ParserAdvance(self);
+        right = jot_ParseSubexpression(self, right_precedence);
+        left = right ? jot_ParserNode2(self, kind, op, offset, left, right) : 0;
+    }
+    self->depth--;
+    return left;
+}
+
+static jot_NodeRef jot_ParseExpression(jot_Parser* self)
+{
+    return jot_ParseSubexpression(self, 0);
+}
+
+/* 'var' names ['=' exprs] */
+static jot_NodeRef jot_ParseVar(jot_Parser* self)
+{
+    size_t offset = self->token->offset;
+    size_t base = self->stack_count;
+    size_t names;
+    uint32_t values = 0;
+    
+    jot_ParserAdvance(self);
+    if(!jot_ParserPush(self, 0) || !jot_ParserPush(self, 0))
+    {
+        return 0;
+    }
+    do
+    {
+        if(!jot_ParsePushName(self))
+        {
+            return 0;
+        }
+    } while(jot_ParserAccept(self, JOT_TOKEN_COMMA));
+    names = self->stack_count - base - 2;
+    if(jot_ParserAccept(self, JOT_TOKEN_ASSIGN) && (values = jot_ParseExpressionList(self)) == 0)
+    {
+        return 0;
+    }
+    self->stack[base] = (uint32_t) names;
+    self->stack[base + 1] = values;
+    return jot_ParserPopNode(self, JOT_NODE_VAR, 0, 0, offset, base);
+}
+
+/* 'func' name {'.' name} [':' name] body, which assigns the function to where it's named. */
+static jot_NodeRef jot_ParseFunctionStatement(jot_Parser* self)
+{
+    size_t offset = self->token->offset;
+    size_t name_offset;
+    size_t dot_offset;
+    unsigned int flags = 0;
+    uint32_t name;
+    jot_NodeRef target;
+    jot_NodeRef key;
+    jot_NodeRef function;
+    jot_NodeRef node;
+    
+    jot_ParserAdvance(self);
+    name_offset = self->token->offset;
+    name = jot_ParseName(self);
+    target = jot_ParserNode(self, JOT_NODE_NAME, 0, 0, name_offset, 1);
+    if(!target)
+    {
+        return 0;
+    }
+    self->ast->words[target + 2] = name;
+    while(jot_ParserIs(self, JOT_TOKEN_DOT) || jot_ParserIs(self, JOT_TOKEN_COLON))
+    {
+        if(jot_ParserIs(self, JOT_TOKEN_COLON))
+        {
+            flags |= JOT_FUNC_METHOD;
+        }
+        dot_offset = self->token->offset;
+        jot_ParserAdvance(self);
+        name = jot_ParserIs(self, JOT_TOKEN_IDENTIFIER) ? self->token->atom->id : 0;
+        key = jot_ParseNameKey(self);
+        target = key ? jot_ParserNode2(self, JOT_NODE_INDEX, 0, dot_offset, target, key) : 0;
+        if(!target || flags & JOT_FUNC_METHOD)
+        {
+            break;
+        }
+    }
+    function = target ? jot_ParseFunction(self, offset, name, flags) : 0;
+    node = function ? jot_ParserNode(self, JOT_NODE_ASSIGN, 0, 0, offset, 4) : 0;
+    if(node)
+    {
+        self->ast->words[node + 2] = 1;
+        self->ast->words[node + 3] = 1;
+        self->ast->words[node + 4] = target;
+        self->ast->words[node + 5] = function;
+    }
+    return node;
+}
+
+/* 'if' expr 'then' block {'elseif' expr 'then' block} ['else' block] 'end' */
+static jot_NodeRef jot_ParseIf(jot_Parser* self)
+{
+    size_t offset = self->token->offset;
+    size_t base = self->stack_count;
+    uint32_t clauses = 0;
+    jot_NodeRef condition;
+    jot_NodeRef block;
+    
+    if(!jot_ParserPush(self, 0))
+    {
+        return 0;
+    }
+    do
+    {
+        jot_ParserAdvance(self);
+        if((condition = jot_ParseExpression(self)) == 0
+            || !jot_ParserExpectKeyword(self, JOT_KEYWORD_THEN, "expected 'then'")
+            || (block = jot_ParseBlock(self)) == 0
+            || !jot_ParserPush(self, condition) || !jot_ParserPush(self, block))
+        {
+            return 0;
+        }
+        clauses++;
+    } while(jot_ParserIsKeyword(self, JOT_KEYWORD_ELSEIF));
+    block = 0;
+    if(jot_ParserIsKeyword(self, JOT_KEYWORD_ELSE))
+    {
+        jot_ParserAdvance(self);
+        if((block = jot_ParseBlock(self)) == 0)
+        {
+            return 0;
+        }
+    }
+    if(!jot_ParserPush(self, block) || !jot_ParserExpectKeyword(self, JOT_KEYWORD_END, "expected 'end' to close 'if'"))
+    {
+        return 0;
+    }
+    self->stack[base] = clauses;
+    return jot_ParserPopNode(self, JOT_NODE_IF, 0, 0, offset, base);
+}
+
+/* The body of a loop, which break and continue may appear in. */
+static jot_NodeRef jot_ParseLoopBody(jot_Parser* self)
+{
+    jot_NodeRef body;
+    
+    self->loops++;
+    body = jot_ParseBlock(self);
+    self->loops--;
+    return body;
+}
+
+/* 'while' expr 'do' block 'end' */
+static jot_NodeRef jot_ParseWhile(jot_Parser* self)
+{
+    size_t offset = self->token->offset;
+    jot_NodeRef condition;
+    jot_NodeRef body;
+    
+    jot_ParserAdvance(self);
+    if((condition = jot_ParseExpression(self)) == 0
+        || !jot_ParserExpectKeyword(self, JOT_KEYWORD_DO, "expected 'do'")
+        || (body = jot_ParseLoopBody(self)) == 0
+        || !jot_ParserExpectKeyword(self, JOT_KEYWORD_END, "expected 'end' to close 'while'"))
+    {
+        return 0;
+    }
+    return jot_ParserNode2(self, JOT_NODE_WHILE, 0, offset, condition, body);
+}
+
+/* 'repeat' block 'until' expr */
+static jot_NodeRef jot_ParseRepeat(jot_Parser* self)
+{
+    size_t offset = self->token->offset;
+    jot_NodeRef condition;
+    jot_NodeRef body;
+    
+    jot_ParserAdvance(self);
+    if((body = jot_ParseLoopBody(self)) == 0
+        || !jot_ParserExpectKeyword(self, JOT_KEYWORD_UNTIL, "expected 'until' to close 'repeat'")
+        || (condition = jot_ParseExpression(self)) == 0)
+    {
+        return 0;
+    }
+    return jot_ParserNode2(self, JOT_NODE_REPEAT, 0, offset, body, condition);
+}
+
+/* 'for' names 'in' expr 'do' block 'end' */
+static jot_NodeRef jot_ParseFor(jot_Parser* self)
+{
+    size_t offset = self->token->offset;
+    size_t base = self->stack_count;
+    jot_NodeRef iterable;
+    jot_NodeRef body;
+    
+    jot_ParserAdvance(self);
+    if(!jot_ParserPush(self, 0) || !jot_ParserPush(self, 0) || !jot_ParserPush(self, 0))
+    {
+        return 0;
+    }
+    do
+    {
+        if(!jot_ParsePushName(self))
+        {
+            return 0;
+        }
+    } while(jot_ParserAccept(self, JOT_TOKEN_COMMA));
+    if(!jot_ParserExpectKeyword(self, JOT_KEYWORD_IN, "expected 'in'")
+        || (iterable = jot_ParseExpression(self)) == 0
+        || !jot_ParserExpectKeyword(self, JOT_KEYWORD_DO, "expected 'do'")
+        || (body = jot_ParseLoopBody(self)) == 0
+        || !jot_ParserExpectKeyword(self, JOT_KEYWORD_END, "expected 'end' to close 'for'"))
+    {
+        return 0;
+    }
+    self->stack[base] = iterable;
+    self->stack[base + 1] = body;
+    self->stack[base + 2] = (uint32_t) (self->stack_count - base - 3);
+    return jot_ParserPopNode(self, JOT_NODE_FOR, 0, 0, offset, base);
+}
+
+/* '->' [exprs] */
+static jot_NodeRef jot_ParseReturn(jot_Parser* self)
+{
+    size_t offset = self->token->offset;
+    size_t base = self->stack_count;
+    uint32_t count = 0;
+    
+    jot_ParserAdvance(self);
+    if(!jot_ParserPush(self, 0))
+    {
+        return 0;
+    }
+    if(!jot_ParserAtBlockEnd(self) && !jot_ParserIs(self, JOT_TOKEN_SEMICOLON) && (count = jot_ParseExpressionList(self)) == 0)
+    {
+        return 0;
+    }
+    self->stack[base] = count;
+    return jot_ParserPopNode(self, JOT_NODE_RETURN, 0, 0, offset, base);
+}
+
+static int jot_ParserCheckTarget(jot_Parser* self, jot_NodeRef target, size_t offset)
+{
+    jot_NodeKind kind = jot_AstKind(self->ast, target);
+    
+    if(kind != JOT_NODE_NAME && kind != JOT_NODE_INDEX)
+    {
+        if(self->error->message == NULL)
+        {
+            self->error->message = "can't assign to this";
+            self->error->offset = self->origin + offset;
+            self->error->length = self->previous_end - offset;
+        }
+        self->token = &jot_parse_stop;
+        return 0;
+    }
+    return jot_ParserPush(self, target);
+}
+
+/* suffixed {',' suffixed} '=' exprs, or a call on its own. */
+static jot_NodeRef jot_ParseExpressionStatement(jot_Parser* self)
+{
+    size_t offset = self->token->offset;
+    size_t base = self->stack_count;
+    jot_NodeRef first;
+    jot_NodeRef target;
+    uint32_t values;
+    
+    if(!jot_ParserPush(self, 0) || !jot_ParserPush(self, 0) || (first = jot_ParseSuffixed(self)) == 0)
+    {
+        return 0;
+    }
+    if(!jot_ParserIs(self, JOT_TOKEN_ASSIGN) && !jot_ParserIs(self, JOT_TOKEN_COMMA))
+    {
+        self->stack_count = base;
+        if(jot_AstKind(self->ast, first) != JOT_NODE_CALL && jot_AstKind(self->ast, first) != JOT_NODE_METHOD_CALL)
+        {
+            return jot_ParserFail(self, "expected '=' or a call");
+        }
+        return first;
+    }
+    if(!jot_ParserCheckTarget(self, first, offset))
+    {
+        return 0;
+    }
+    while(jot_ParserAccept(self, JOT_TOKEN_COMMA))
+    {
+        offset = self->token->offset;
+        if((target = jot_ParseSuffixed(self)) == 0 || !jot_ParserCheckTarget(self, target, offset))
+        {
+            return 0;
+        }
+    }
+    offset = self->token->offset;
+    if(!jot_ParserExpect(self, JOT_TOKEN_ASSIGN, "expected '='") || (values = jot_ParseExpressionList(self)) == 0)
+    {
+        return 0;
+    }
+    self->stack[base] = (uint32_t) (self->stack_count - base - 2 - values);
+    self->stack[base + 1] = values;
+    return jot_ParserPopNode(self, JOT_NODE_ASSIGN, 0, 0, offset, base);
+}
+
+static jot_NodeRef jot_ParseStatement(jot_Parser* self)
+{
+    jot_NodeRef node;
+    
+    if(jot_ParserIs(self, JOT_TOKEN_ARROW))
+    {
+        return jot_ParseReturn(self);
+    }
+    if(!jot_ParserIs(self, JOT_TOKEN_KEYWORD))
+    {
+        return jot_ParseExpressionStatement(self);
+    }
+    switch(self->token->keyword)
+    {
+        case JOT_KEYWORD_VAR:
+            return jot_ParseVar(self);
+        case JOT_KEYWORD_FUNC:
+            return jot_ParseFunctionStatement(self);
+        case JOT_KEYWORD_IF:
+            return jot_ParseIf(self);
+        case JOT_KEYWORD_WHILE:
+            return jot_ParseWhile(self);
+        case JOT_KEYWORD_REPEAT:
+            return jot_ParseRepeat(self);
+        case JOT_KEYWORD_FOR:
+            return jot_ParseFor(self);
+        case JOT_KEYWORD_DO:
+            jot_ParserAdvance(self);
+            node = jot_ParseBlock(self);
+            return node && jot_ParserExpectKeyword(self, JOT_KEYWORD_END, "expected 'end' to close 'do'") ? node : 0;
+        case JOT_KEYWORD_BREAK:
+        case JOT_KEYWORD_CONTINUE:
+            if(self->loops == 0)
+            {
+                return jot_ParserFail(self, self->token->keyword == JOT_KEYWORD_BREAK
+                    ? "'break' outside a loop" : "'continue' outside a loop");
+            }
+            node = jot_ParserNode(self, self->token->keyword == JOT_KEYWORD_BREAK ? JOT_NODE_BREAK : JOT_NODE_CONTINUE,
+                0, 0, self->token->offset, 0);
+            jot_ParserAdvance(self);
+            return node;
+        default:
+            return jot_ParseExpressionStatement(self);
+    }
+}
+
+/* { statement [';'] } */
+static jot_NodeRef jot_ParseBlock(jot_Parser* self)
+{
+    size_t offset = self->token->offset;
+    size_t base = self->stack_count;
+    jot_NodeRef statement;
+    
+    if(!jot_ParserEnter(self) || !jot_ParserPush(self, 0))
+    {
+        return 0;
+    }
+    while(!jot_ParserAtBlockEnd(self))
+    {
+        if(jot_ParserAccept(self, JOT_TOKEN_SEMICOLON))
+        {
+            continue;
+        }
+        if((statement = jot_ParseStatement(self)) == 0 || !jot_ParserPush(self, statement))
+        {
+            return 0;
+        }
+    }
+    self->depth--;
+    self->stack[base] = (uint32_t) (self->stack_count - base - 1);
+    return jot_ParserPopNode(self, JOT_NODE_BLOCK, 0, 0, offset, base);
+}
+
+/*
+    Parses what scanner has left into ast, and returns the block it makes,
+    or 0 with error filled in. origin is where the scanned text starts in
+    the AST's source. A function body is followed by the 'end' closing it.
+*/
+static jot_NodeRef jot_ParseInto(jot_Ast* ast, jot_Scanner* scanner, size_t origin, int body, int vararg, jot_ParseError* error)
+{
+    jot_Parser parser;
+    jot_NodeRef root = 0;
+    
+    error->message = NULL;
+    error->offset = 0;
+    error->length = 0;
+    
+    scanner->atoms = ast->atoms;
+    parser.allocator = ast->allocator;
+    parser.lookahead = jot_LookaheadNew(scanner, JOT_PARSE_LOOKAHEAD_CAPACITY);
+    parser.ast = ast;
+    parser.error = error;
+    parser.token = &jot_parse_stop;
+    parser.previous_end = 0;
+    parser.stack_count = 0;
+    parser.stack_capacity = JOT_PARSE_MIN_STACK_CAPACITY;
+    parser.stack = jot_Alloc(parser.allocator, JOT_ALLOC_PARSE, parser.stack_capacity * sizeof(uint32_t));
+    parser.origin = origin;
+    parser.lazy = (ast->flags & JOT_PARSE_LAZY) != 0;
+    parser.depth = 0;
+    parser.loops = 0;
+    parser.vararg = vararg;
+    
+    if(parser.lookahead == NULL || parser.stack == NULL)
+    {
+        jot_ParserFail(&parser, "out of memory");
+    }
+    else
+    {
+        jot_ParserTake(&parser, jot_LookaheadPeek(parser.lookahead, 0));
+        root = jot_ParseBlock(&parser);
+        if(root && body)
+        {
+            jot_ParserExpectKeyword(&parser, JOT_KEYWORD_END, "expected 'end' to close 'func'");
+        }
+        if(root && !jot_ParserIs(&parser, JOT_TOKEN_EOF))
+        {
+            jot_ParserFail(&parser, "expected end of file");
+        }
+    }
+    
+    if(parser.lookahead != NULL)
+    {
+        jot_LookaheadFree(parser.lookahead);
+    }
+    jot_Free(parser.allocator, JOT_ALLOC_PARSE, parser.stack, parser.stack_capacity * sizeof(uint32_t));
+    return error->message == NULL ? root : 0;
+}
+
+static jot_Ast* jot_AstNew(jot_Allocator* allocator, jot_AtomTable* atoms, const char* text, size_t size, unsigned int flags)
+{
+    jot_Ast* self = jot_Alloc(allocator, JOT_ALLOC_PARSE, sizeof(jot_Ast));
+    
+    if(self == NULL)
+    {
+        return NULL;
+    }
+    self->allocator = allocator;
+    self->atoms = atoms;
+    self->text = text;
+    self->size = size;
+    self->flags = flags;
+    self->count = 1;
+    self->capacity = JOT_AST_MIN_CAPACITY;
+    self->words = jot_Alloc(allocator, JOT_ALLOC_PARSE, self->capacity * sizeof(uint32_t));
+    self->root = 0;
+    if(self->words == NULL)
+    {
+        jot_Free(allocator, JOT_ALLOC_PARSE, self, sizeof(jot_Ast));
+        return NULL;
+    }
+    self->words[0] = JOT_NODE_NONE;
+    return self;
+}
+
+/* Parses the whole of what scanner has left into a new AST, and gives back the slack. */
+static jot_Ast* jot_AstParseRoot(jot_Ast* self, jot_Scanner* scanner, jot_ParseError* error)
+{
+    uint32_t* words;
+    
+    /* The source as a whole takes whatever it's run with. */
+    self->root = jot_ParseInto(self, scanner, 0, 0, 1, error);
+    if(!self->root)
+    {
+        jot_AstFree(self);
+        return NULL;
+    }
+    words = jot_Realloc(self->allocator, JOT_ALLOC_PARSE, self->words,
+        self->capacity * sizeof(uint32_t), self->count * sizeof(uint32_t));
+    if(words != NULL)
+    {
+        self->words = words;
+        self->capacity = self->count;
+    }
+    return self;
+}
+
+jot_Ast* jot_Parse(jot_Scanner* scanner, jot_AtomTable* atoms, jot_ParseError* error)
+{
+    jot_Ast* ast = jot_AstNew(scanner->allocator, atoms, NULL, 0, 0);
+    
+    if(ast == NULL)
+    {
+        error->message = "out of memory";
+        error->offset = 0;
+        error->length = 0;
+        return NULL;
+    }
+    return jot_AstParseRoot(ast, scanner, error);
+}
+
+jot_Ast* jot_ParseText(jot_Allocator* allocator, const char* data, size_t size, jot_AtomTable* atoms, unsigned int flags, jot_ParseError* error)
+{
+    jot_Ast* ast = jot_AstNew(allocator, atoms, data, size, flags);
+    jot_Source* source = jot_StringSourceNew(allocator, "jot_ParseText", data, size);
+    jot_Scanner* scanner = source != NULL ? jot_ScannerNew(allocator, source) : NULL;
+    
+    if(ast == NULL || scanner == NULL)
+    {
+        error->message = "out of memory";
+        error->offset = 0;
+        error->length = 0;
+        if(ast != NULL)
+        {
+            jot_AstFree(ast);
+        }
+        ast = NULL;
+    }
+    else
+    {
+        ast = jot_AstParseRoot(ast, scanner, error);
+    }
+    if(scanner != NULL)
+    {
+        jot_ScannerFree(scanner);
+    }
+    if(source != NULL)
+    {
+        jot_StringSourceFree(source);
+    }
+    return ast;
+}
+
+jot_NodeRef jot_AstFunctionBody(jot_Ast* self, jot_NodeRef function, jot_ParseError* error)
+{
+    jot_NodeRef body = jot_AstWord(self, function, 2);
+    size_t start = jot_AstWord(self, function, 0);
+    size_t end = jot_AstWord(self, function, 1);
+    size_t count = self->count;
+    jot_Source* source;
+    jot_Scanner* scanner;
+    
+    error->message = NULL;
+    error->offset = 0;
+    error->length = 0;
+    if(body)
+    {
+        return body;
+    }
+    
+    source = jot_StringSourceNew(self->allocator, "jot_AstFunctionBody", self->text + start, end - start);
+    scanner = source != NULL ? jot_ScannerNew(self->allocator, source) : NULL;
+    if(scanner == NULL)
+    {
+        error->message = "out of memory";
+        error->offset = start;
+    }
+    else
+    {
+        body = jot_ParseInto(self, scanner, start, 1, (jot_AstFlags(self, function) & JOT_FUNC_VARARG) != 0, error);
+        jot_ScannerFree(scanner);
+    }
+    if(source != NULL)
+    {
+        jot_StringSourceFree(source);
+    }
+    
+    if(!body)
+    {
+        /* Drop whatever got made before the error. */
+        self->count = count;
+        return 0;
+    }
+    self->words[function + 4] = body;
+    return body;
+}
+
+void jot_AstFree(jot_Ast* self)
+{
+    jot_Free(self->allocator, JOT_ALLOC_PARSE, self->words, self->capacity * sizeof(uint32_t));
+    jot_Free(self->allocator, JOT_ALLOC_PARSE, self, sizeof(jot_Ast));
+}
+
+jot_NodeRef jot_AstAppend(jot_Ast* self, jot_NodeKind kind, unsigned int op, unsigned int flags, size_t offset, size_t size)
+{
+    jot_NodeRef node;
+    
+    if(self->count + size + 2 > 0xFFFFFFFFUL)
+    {
+        return 0;
+    }
+    if(self->capacity - self->count < size + 2)
+    {
+        size_t capacity = self->capacity > JOT_AST_MIN_CAPACITY ? self->capacity : JOT_AST_MIN_CAPACITY;
+        uint32_t* words;
+        while(capacity - self->count < size + 2)
+        {
+            capacity *= 2;
+        }
+        words = jot_Realloc(self->allocator, JOT_ALLOC_PARSE, self->words,
+            self->capacity * sizeof(uint32_t), capacity * sizeof(uint32_t));
+        if(words == NULL)
+        {
+            return 0;
+        }
+        self->words = words;
+        self->capacity = capacity;
+    }
+    node = (jot_NodeRef) self->count;
+    self->words[node] = (uint32_t) kind | (uint32_t) op << 8 | (uint32_t) flags << 16;
+    self->words[node + 1] = (uint32_t) offset;
+    self->count += size + 2;
+    return node;
+}
+
+jot_NodeKind jot_AstKind(const jot_Ast* self, jot_NodeRef node)
+{
+    return (jot_NodeKind) (self->words[node] & 0xFF);
+}
+
+jot_Token jot_AstOp(const jot_Ast* self, jot_NodeRef node)
+{
+    return (jot_Token) (self->words[node] >> 8 & 0xFF);
+}
+
+unsigned int jot_AstFlags(const jot_Ast* self, jot_NodeRef node)
+{
+    return self->words[node] >> 16;
+}
+
+size_t jot_AstOffset(const jot_Ast* self, jot_NodeRef node)
+{
+    return self->words[node + 1];
+}
+
+uint32_t jot_AstWord(const jot_Ast* self, jot_NodeRef node, size_t index)
+{
+    return self->words[node + 2 + index];
+}
+
+int64_t jot_AstInt(const jot_Ast* self, jot_NodeRef node)
+{
+    uint64_t bits = (uint64_t) jot_AstWord(self, node, 1) << 32 | jot_AstWord(self, node, 0);
+    return (int64_t) bits;
+}
+
+double jot_AstNum(const jot_Ast* self, jot_NodeRef node)
+{
+    uint64_t bits = (uint64_t) jot_AstWord(self, node, 1) << 32 | jot_AstWord(self, node, 0);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+const jot_Atom* jot_AstAtom(const jot_Ast* self, jot_NodeRef node)
+{
+    return jot_AtomTableGet(self->atoms, jot_AstWord(self, node, 0));
+}
@@ -0,0 +1,219 @@
+/*
+    jot - Parser
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#ifndef JOT_PARSE_H
+#define JOT_PARSE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "jot_alloc.h"
+#include "jot_scanlook.h"
+#include "jot_scanner.h"
+#include "jot_str.h"
+
+/*
+    The grammar, roughly (from lowest to highest precedence, binary
+    operators are or; and; comparisons; |; ^; &; << >>; .. (right
+    associative); + -; * / %; then the unary not ! - ~; then ** (right
+    associative)):
+    
+        block     = { statement [';'] }
+        statement = 'var' names ['=' exprs]
+                  | 'func' name {'.' name} [':' name] body
+                  | 'if' expr 'then' block {'elseif' expr 'then' block} ['else' block] 'end'
+                  | 'while' expr 'do' block 'end'
+                  | 'repeat' block 'until' expr
+                  | 'for' names 'in' expr 'do' block 'end'
+                  | 'do' block 'end'
+                  | 'break' | 'continue'
+                  | '->' [exprs]
+                  | suffixed {',' suffixed} '=' exprs
+                  | call
+        body      = '(' [names [',' '...'] | '...'] ')' ('->' expr | block 'end')
+        suffixed  = (name | '(' expr ')') {'.' name | '[' expr ']' | ':' name args | args}
+        args      = '(' [exprs] ')'
+        simple    = int | num | str | 'nil' | 'true' | 'false' | '...'
+                  | '{' [field {(',' | ';') field} [',' | ';']] '}'
+                  | '[' [exprs [',']] ']'
+                  | 'func' body | suffixed
+        field     = name ':' expr | '[' expr ']' ':' expr
+    
+    '->' on its own returns from a function, and a function whose body is
+    '->' expr just returns that expression. Method calls and 'func a:b'
+    pass the object along as an implicit first parameter, self.
+*/
+
+/*
+    A node is a run of 32-bit words in jot_Ast.words, and is referred to by
+    the index of its first word; 0 is never a node, so it stands for none.
+    The first word holds the jot_NodeKind in its low 8 bits, an operator
+    token in the next 8 and flags in the top 16; the second is the offset
+    in the source of the token the node is reported at. The rest depend on
+    the kind, as listed below. Lists are a count followed by that many
+    words, and names and strings are atom ids in the table the AST was
+    parsed with.
+    
+    Children come before their parents, except for the body of a function
+    parsed lazily, which is added whenever it's asked for, and whatever
+    passes over the tree add later.
+*/
+typedef enum
+{
+    JOT_NODE_NONE,
+    
+    /* Expressions. */
+    JOT_NODE_NIL,
+    JOT_NODE_TRUE,
+    JOT_NODE_FALSE,
+    JOT_NODE_VARARG,
+    JOT_NODE_INT,           /* low word, high word; op is JOT_TOKEN_INT, _HEX or _BIN */
+    JOT_NODE_NUM,           /* low word, high word of the double's bits */
+    JOT_NODE_STR,           /* atom */
+    JOT_NODE_NAME,          /* atom */
+    JOT_NODE_FUNC,          /* body offset, end offset, body block or 0, name atom, parameter count, parameter atoms... */
+    JOT_NODE_TABLE,         /* field count, key, value, key, value... */
+    JOT_NODE_ARRAY,         /* element count, elements... */
+    JOT_NODE_INDEX,         /* object, key */
+    JOT_NODE_CALL,          /* callee, argument count, arguments... */
+    JOT_NODE_METHOD_CALL,   /* object, name atom, argument count, arguments... */
+    JOT_NODE_UNARY,         /* operand; op is JOT_TOKEN_SUB, _TILDE or _EXCLAIM (for not as well) */
+    JOT_NODE_BINARY,        /* left, right; op is the operator's token */
+    JOT_NODE_AND,           /* left, right */
+    JOT_NODE_OR,            /* left, right */
+    
+    /* Statements. A call on its own is a statement too. */
+    JOT_NODE_BLOCK,         /* statement count, statements... */
+    JOT_NODE_VAR,           /* name count, value count, name atoms..., values... */
+    JOT_NODE_ASSIGN,        /* target count, value count, targets..., values... */
+    JOT_NODE_IF,            /* clause count, condition, block, condition, block..., else block or 0 */
+    JOT_NODE_WHILE,         /* condition, body */
+    JOT_NODE_REPEAT,        /* body, condition */
+    JOT_NODE_FOR,           /* iterable, body, name count, name atoms... */
+    JOT_NODE_BREAK,
+    JOT_NODE_CONTINUE,
+    JOT_NODE_RETURN,        /* value count, values... */
+    
+    JOT_NODE_KIND_COUNT
+} jot_NodeKind;
+
+/* Flags of a JOT_NODE_FUNC. */
+enum
+{
+    JOT_FUNC_VARARG = 1 << 0,   /* Takes '...' after its named parameters. */
+    JOT_FUNC_METHOD = 1 << 1    /* Defined with ':', so self comes before the named parameters. */
+};
+
+/* Stands in for the name atom of an anonymous function. */
+#define JOT_AST_NO_ATOM ((uint32_t) -1)
+
+typedef uint32_t jot_NodeRef;
+
+/* Flags for jot_ParseText. */
+enum
+{
+    /*
+        Skips over function bodies, just matching up the keywords that open
+        and close blocks to find their end, and leaves them to be parsed
+        when jot_AstFunctionBody is first asked for them. Syntax errors in
+        a body are only found then.
+    */
+    JOT_PARSE_LAZY = 1 << 0
+};
+
+/*
+    A parsed source. All nodes live in one block of words that only ever
+    grows at the end, like a bump arena, and is freed in one go. Since
+    nodes refer to each other by index rather than by pointer, the block
+    can move when it grows, and a node costs two words plus one per child.
+*/
+typedef struct
+{
+    jot_Allocator* allocator;
+    jot_AtomTable* atoms;
+    
+    /* What jot_ParseText parsed, and how, for parsing skipped bodies later. */
+    const char* text;
+    size_t size;
+    unsigned int flags;
+    
+    size_t count;
+    size_t capacity;
+    uint32_t* words;
+    
+    jot_NodeRef root;
+} jot_Ast;
+
+typedef struct
+{
+    /* A static string, or NULL if there was no error. */
+    const char* message;
+    /* The token it was found at, or the end of the source. */
+    size_t offset;
+    size_t length;
+} jot_ParseError;
+
+/*
+    Parses the rest of what scanner has to scan. Names and strings are
+    interned into atoms, which is also left set as scanner->atoms. Returns
+    NULL, with error filled in, if there's a syntax error or memory runs
+    out; parsing stops at the first error.
+*/
+jot_Ast* jot_Parse(jot_Scanner* scanner, jot_AtomTable* atoms, jot_ParseError* error);
+/*
+    Parses size bytes at data, which the caller keeps alive and unchanged
+    for as long as the AST, as it may need it again for lazy bodies.
+*/
+jot_Ast* jot_ParseText(jot_Allocator* allocator, const char* data, size_t size, jot_AtomTable* atoms, unsigned int flags, jot_ParseError* error);
+void jot_AstFree(jot_Ast* self);
+
+/*
+    Returns the body block of a JOT_NODE_FUNC, parsing it first if it was
+    skipped. Returns 0, with error filled in, if it has a syntax error or
+    memory runs out; the function stays unparsed, so asking again gives
+    the same error.
+*/
+jot_NodeRef jot_AstFunctionBody(jot_Ast* self, jot_NodeRef function, jot_ParseError* error);
+
+/*
+    Adds a node with size words after the first two, for passes that
+    rewrite the tree to fill in. Returns 0 if memory runs out.
+*/
+jot_NodeRef jot_AstAppend(jot_Ast* self, jot_NodeKind kind, unsigned int op, unsigned int flags, size_t offset, size_t size);
+
+jot_NodeKind jot_AstKind(const jot_Ast* self, jot_NodeRef node);
+jot_Token jot_AstOp(const jot_Ast* self, jot_NodeRef node);
+unsigned int jot_AstFlags(const jot_Ast* self, jot_NodeRef node);
+size_t jot_AstOffset(const jot_Ast* self, jot_NodeRef node);
+/* The index'th of the words that follow a node's first two. */
+uint32_t jot_AstWord(const jot_Ast* self, jot_NodeRef node, size_t index);
+
+int64_t jot_AstInt(const jot_Ast* self, jot_NodeRef node);
+double jot_AstNum(const jot_Ast* self, jot_NodeRef node);
+/* The atom of a JOT_NODE_STR or JOT_NODE_NAME. */
+const jot_Atom* jot_AstAtom(const jot_Ast* self, jot_NodeRef node);
+
+#endif
@@ -0,0 +1,421 @@
+/*
+    jot - Incremental Scanner
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "jot_scandoc.h"
+
+enum
+{
+    JOT_SCANDOC_MIN_TEXT_GAP = 4096,
+    JOT_SCANDOC_MIN_CAPACITY = 1024
+};
+
+/* Hands the text from position onward to the scanner, as the parts before and after the gap. */
+typedef struct
+{
+    const jot_ScanDocument* document;
+    size_t position;
+} jot_ScanDocumentReader;
+
+static const char* jot_ScanDocumentRead(jot_Source* source, size_t* bytes_read)
+{
+    jot_ScanDocumentReader* reader = source->handle;
+    const jot_ScanDocument* document = reader->document;
+    const char* data;
+    
+    if(reader->position < document->text_gap_start)
+    {
+        data = document->text + reader->position;
+        *bytes_read = document->text_gap_start - reader->position;
+    }
+    else
+    {
+        data = document->text + document->text_gap_end + (reader->position - document->text_gap_start);
+        *bytes_read = document->size - reader->position;
+    }
+    reader->position += *bytes_read;
+    return data;
+}
+
+/* Where token index actually lives in the arrays. */
+static size_t jot_ScanDocumentSlot(const jot_ScanDocument* self, size_t index)
+{
+    return index < self->gap_start ? index : index + (self->gap_end - self->gap_start);
+}
+
+static size_t jot_ScanDocumentTokenEnd(const jot_ScanDocument* self, size_t index)
+{
+    size_t slot = jot_ScanDocumentSlot(self, index);
+    
+    if(index < self->gap_start)
+    {
+        return self->offsets[slot] + self->lengths[slot];
+    }
+    return self->size - self->offsets[slot] + self->lengths[slot];
+}
+
+void jot_ScanDocumentGetToken(const jot_ScanDocument* self, size_t index, jot_ScanDocumentToken* token)
+{
+    size_t slot = jot_ScanDocumentSlot(self, index);
+    
+    token->kind = self->kinds[slot];
+    token->length = self->lengths[slot];
+    token->offset = index < self->gap_start ? self->offsets[slot] : self->size - self->offsets[slot];
+}
+
+size_t jot_ScanDocumentFind(const jot_ScanDocument* self, size_t offset)
+{
+    size_t low = 0;
+    size_t high = self->count - 1;
+    size_t middle;
+    
+    /* The end-of-file token ends at the very end, so there's always an answer. */
+    while(low < high)
+    {
+        middle = low + (high - low) / 2;
+        if(jot_ScanDocumentTokenEnd(self, middle) < offset)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+/* Moves the token gap to just before index, switching the offsets it passes between absolute and relative. */
+static void jot_ScanDocumentMoveGap(jot_ScanDocument* self, size_t index)
+{
+    size_t from, to;
+    
+    while(self->gap_start > index)
+    {
+        from = --self->gap_start;
+        to = --self->gap_end;
+        self->kinds[to] = self->kinds[from];
+        self->offsets[to] = (uint32_t) (self->size - self->offsets[from]);
+        self->lengths[to] = self->lengths[from];
+    }
+    while(self->gap_start < index)
+    {
+        from = self->gap_end++;
+        to = self->gap_start++;
+        self->kinds[to] = self->kinds[from];
+        self->offsets[to] = (uint32_t) (self->size - self->offsets[from]);
+        self->lengths[to] = self->lengths[from];
+    }
+}
+
+/* Frees token arrays that were allocated together with room for capacity tokens. */
+static void jot_ScanDocumentFreeArrays(jot_Allocator* allocator, size_t capacity, uint8_t* kinds, uint32_t* offsets, uint32_t* lengths)
+{
+    jot_Free(allocator, JOT_ALLOC_DOCUMENT, kinds, capacity);
+    jot_Free(allocator, JOT_ALLOC_DOCUMENT, offsets, capacity * sizeof(uint32_t));
+    jot_Free(allocator, JOT_ALLOC_DOCUMENT, lengths, capacity * sizeof(uint32_t));
+}
+
+/* Doubles the token arrays, keeping the tokens after the gap at the end. */
+static int jot_ScanDocumentGrow(jot_ScanDocument* self)
+{
+    size_t capacity = self->capacity ? self->capacity * 2 : JOT_SCANDOC_MIN_CAPACITY;
+    size_t tail = self->capacity - self->gap_end;
+    uint8_t* kinds = jot_Alloc(self->allocator, JOT_ALLOC_DOCUMENT, capacity);
+    uint32_t* offsets = jot_Alloc(self->allocator, JOT_ALLOC_DOCUMENT, capacity * sizeof(uint32_t));
+    uint32_t* lengths = jot_Alloc(self->allocator, JOT_ALLOC_DOCUMENT, capacity * sizeof(uint32_t));
+    
+    if(kinds == NULL || offsets == NULL || lengths == NULL)
+    {
+        jot_ScanDocumentFreeArrays(self->allocator, capacity, kinds, offsets, lengths);
+        return 0;
+    }
+    if(self->capacity > 0)
+    {
+        memcpy(kinds, self->kinds, self->gap_start);
+        memcpy(offsets, self->offsets, self->gap_start * sizeof(uint32_t));
+        memcpy(lengths, self->lengths, self->gap_start * sizeof(uint32_t));
+        memcpy(kinds + capacity - tail, self->kinds + self->gap_end, tail);
+        memcpy(offsets + capacity - tail, self->offsets + self->gap_end, tail * sizeof(uint32_t));
+        memcpy(lengths + capacity - tail, self->lengths + self->gap_end, tail * sizeof(uint32_t));
+    }
+    jot_ScanDocumentFreeArrays(self->allocator, self->capacity, self->kinds, self->offsets, self->lengths);
+    self->kinds = kinds;
+    self->offsets = offsets;
+    self->lengths = lengths;
+    self->gap_end = capacity - tail;
+    self->capacity = capacity;
+    return 1;
+}
+
+/* Replaces removed bytes at offset with the inserted ones, leaving the text gap right after them. */
+static int jot_ScanDocumentEditText(jot_ScanDocument* self, size_t offset, size_t removed,
+    const char* inserted, size_t inserted_length)
+{
+    size_t capacity;
+    size_t tail;
+    char* text;
+    
+    if(offset < self->text_gap_start)
+    {
+        memmove(self->text + self->text_gap_end - (self->text_gap_start - offset),
+            self->text + offset, self->text_gap_start - offset);
+        self->text_gap_end -= self->text_gap_start - offset;
+        self->text_gap_start = offset;
+    }
+    else if(offset > self->text_gap_start)
+    {
+        memmove(self->text + self->text_gap_start, self->text + self->text_gap_end, offset - self->text_gap_start);
+        self->text_gap_end += offset - self->text_gap_start;
+        self->text_gap_start = offset;
+    }
+    
+    if(self->text_gap_end - self->text_gap_start + removed < inserted_length)
+    {
+        capacity = self->text_capacity * 2;
+        if(capacity < self->size + inserted_length + JOT_SCANDOC_MIN_TEXT_GAP)
+        {
+            capacity = self->size + inserted_length + JOT_SCANDOC_MIN_TEXT_GAP;
+        }
+        if((text = jot_Realloc(self->allocator, JOT_ALLOC_DOCUMENT, self->text, self->text_capacity, capacity)) == NULL)
+        {
+            return 0;
+        }
+        tail = self->text_capacity - self->text_gap_end;
+        memmove(text + capacity - tail, text + self->text_gap_end, tail);
+        self->text = text;
+        self->text_gap_end = capacity - tail;
+        self->text_capacity = capacity;
+    }
+    
+    self->text_gap_end += removed;
+    memcpy(self->text + self->text_gap_start, inserted, inserted_length);
+    self->text_gap_start += inserted_length;
+    self->size = self->size - removed + inserted_length;
+    return 1;
+}
+
+jot_ScanDocument* jot_ScanDocumentNew(jot_Allocator* allocator, const char* data, size_t size)
+{
+    jot_ScanDocument* self = jot_Alloc(allocator, JOT_ALLOC_DOCUMENT, sizeof(jot_ScanDocument));
+    
+    if(self == NULL)
+    {
+        return NULL;
+    }
+    self->allocator = allocator;
+    self->text = NULL;
+    self->text_capacity = 0;
+    self->text_gap_start = 0;
+    self->text_gap_end = 0;
+    self->size = 0;
+    self->count = 0;
+    self->capacity = 0;
+    self->gap_start = 0;
+    self->gap_end = 0;
+    self->kinds = NULL;
+    self->offsets = NULL;
+    self->lengths = NULL;
+    self->lines = NULL;
+    
+    /* Start out empty, holding just an end-of-file, and insert the whole source. */
+    self->text_capacity = size + JOT_SCANDOC_MIN_TEXT_GAP;
+    self->text_gap_end = self->text_capacity;
+    if((self->text = jot_Alloc(allocator, JOT_ALLOC_DOCUMENT, self->text_capacity)) == NULL || !jot_ScanDocumentGrow(self))
+    {
+        jot_ScanDocumentFree(self);
+        return NULL;
+    }
+    self->gap_end--;
+    self->kinds[self->gap_end] = JOT_TOKEN_EOF;
+    self->offsets[self->gap_end] = 0;
+    self->lengths[self->gap_end] = 0;
+    self->count = 1;
+    if(!jot_ScanDocumentEdit(self, 0, 0, data, size, NULL))
+    {
+        jot_ScanDocumentFree(self);
+        return NULL;
+    }
+    return self;
+}
+
+void jot_ScanDocumentFree(jot_ScanDocument* self)
+{
+    jot_Free(self->allocator, JOT_ALLOC_DOCUMENT, self->text, self->text_capacity);
+    jot_ScanDocumentFreeArrays(self->allocator, self->capacity, self->kinds, self->offsets, self->lengths);
+    if(self->lines != NULL)
+    {
+        jot_LineIndexFree(self->lines);
+    }
+    jot_Free(self->allocator, JOT_ALLOC_DOCUMENT, self, sizeof(jot_ScanDocument));
+}
+
+int jot_ScanDocumentEdit(jot_ScanDocument* self, size_t offset, size_t removed,
+    const char* inserted, size_t inserted_length, jot_ScanDocumentChange* change)
+{
+    jot_ScanDocumentReader reader;
+    jot_Source source;
+    jot_Scanner* scanner;
+    jot_Token token;
+    size_t first, old_count, new_count;
+    size_t slot, end, old_end;
+    int synced;
+    int result = 1;
+    
+    if(offset > self->size || removed > self->size - offset
+        || inserted_length > 0xFFFFFFFFUL - (self->size - removed))
+    {
+        return 0;
+    }
+    
+    source.name = "(document)";
+    source.handle = &reader;
+    source.reader = jot_ScanDocumentRead;
+    if((scanner = jot_ScannerNew(self->allocator, &source)) == NULL)
+    {
+        return 0;
+    }
+    
+    /*
+        Resume at the end of the last token that ends strictly before the
+        edit. One that ends right at it was ended by looking at the first
+        edited character, so it has to be scanned again too.
+    */
+    first = jot_ScanDocumentFind(self, offset);
+    jot_ScanDocumentMoveGap(self, first);
+    reader.document = self;
+    reader.position = first > 0 ? self->offsets[first - 1] + self->lengths[first - 1] : 0;
+    
+    /* Old tokens that end inside the edit can't be kept whatever happens. */
+    old_count = 0;
+    while(self->kinds[self->gap_end] != JOT_TOKEN_EOF
+        && self->size - self->offsets[self->gap_end] + self->lengths[self->gap_end] < offset + removed)
+    {
+        self->gap_end++;
+        old_count++;
+    }
+    
+    /* Relative to the end, the offsets of the tokens after the edit stay right as the text changes. */
+    if(!jot_ScanDocumentEditText(self, offset, removed, inserted, inserted_length))
+    {
+        /* Nothing's been lost yet, the tokens skipped above just go back. */
+        self->gap_end -= old_count;
+        jot_ScannerFree(scanner);
+        return 0;
+    }
+    if(self->lines != NULL)
+    {
+        jot_LineIndexTruncate(self->lines, offset);
+    }
+    
+    scanner->offset = reader.position;
+    
+    new_count = 0;
+    synced = 0;
+    do
+    {
+        token = jot_ScannerNext(scanner);
+        if(token == JOT_TOKEN_KEYWORD)
+        {
+            token = (jot_Token) (JOT_TOKEN_KEYWORD + scanner->last_keyword - JOT_KEYWORD_AND);
+        }
+        end = scanner->last_offset + scanner->last_length;
+        
+        /*
+            Drop old tokens the new ones have got past. If one ends right where
+            this one does, everything after it is as it was, just moved.
+        */
+        while(self->gap_end < self->capacity)
+        {
+            slot = self->gap_end;
+            old_end = self->size - self->offsets[slot] + self->lengths[slot];
+            if(old_end > end || (self->kinds[slot] == JOT_TOKEN_EOF && token != JOT_TOKEN_EOF))
+            {
+                break;
+            }
+            self->gap_end++;
+            old_count++;
+            if(old_end == end && token != JOT_TOKEN_EOF)
+            {
+                synced = 1;
+                break;
+            }
+        }
+        
+        if(self->gap_start == self->gap_end && !jot_ScanDocumentGrow(self))
+        {
+            result = 0;
+            break;
+        }
+        self->kinds[self->gap_start] = (uint8_t) token;
+        self->offsets[self->gap_start] = (uint32_t) scanner->last_offset;
+        self->lengths[self->gap_start] = (uint32_t) scanner->last_length;
+        self->gap_start++;
+        new_count++;
+    } while(token != JOT_TOKEN_EOF && !synced);
+    jot_ScannerFree(scanner);
+    self->count = self->count - old_count + new_count;
+    if(change != NULL)
+    {
+        change->first = first;
+        change->old_count = old_count;
+        change->new_count = new_count;
+    }
+    return result;
+}
+
+int jot_ScanDocumentLocate(jot_ScanDocument* self, size_t offset, size_t* line, size_t* column)
+{
+    size_t end = offset < self->size ? offset + 1 : self->size;
+    size_t from;
+    
+    if(self->lines == NULL && (self->lines = jot_LineIndexNew(self->allocator)) == NULL)
+    {
+        return 0;
+    }
+    
+    /* Index just far enough to be sure which line offset is on, one side of the text gap at a time. */
+    while(self->lines->size < end)
+    {
+        from = self->lines->size;
+        if(from < self->text_gap_start)
+        {
+            if(!jot_LineIndexAppend(self->lines, self->text + from, (end < self->text_gap_start ? end : self->text_gap_start) - from))
+            {
+                return 0;
+            }
+        }
+        else if(!jot_LineIndexAppend(self->lines, self->text + self->text_gap_end + (from - self->text_gap_start), end - from))
+        {
+            return 0;
+        }
+    }
+    jot_LineIndexLocate(self->lines, offset, line, column);
+    return 1;
+}
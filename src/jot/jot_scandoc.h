@@ -0,0 +1,114 @@
+/*
+    jot - Incremental Scanner
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#ifndef JOT_SCANDOC_H
+#define JOT_SCANDOC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "jot_lines.h"
+#include "jot_scanner.h"
+
+/*
+    A source held in memory together with its tokens, which are kept up to
+    date as the source is edited, for editors and language servers.
+    
+    Every token leaves the scanner back in JOT_STATE_START (the generated
+    table only ever emits into it) at the end of the token, so each token
+    boundary doubles as a checkpoint to resume scanning from. An edit
+    resumes at the last boundary before it and stops as soon as a new token
+    ends exactly where an old one did past the edit, since from there on the
+    scanner would see the same state and the same text as before.
+    
+    Both the text and the tokens are kept in gap buffers, with the gap at the
+    last edit. Tokens after the gap store their offset back from the end of
+    the text, so the tokens after an edit move with it without being
+    touched, and an edit costs about as much as the tokens it actually
+    changes. Lines are only indexed when asked for, and only as far as the
+    offset asked about.
+*/
+typedef struct
+{
+    jot_Allocator* allocator;
+    
+    char* text;
+    size_t text_capacity;
+    size_t text_gap_start;
+    size_t text_gap_end;
+    size_t size;
+    
+    /* Token kinds are stored as in jot_TokenBuffer. */
+    size_t count;
+    size_t capacity;
+    size_t gap_start;
+    size_t gap_end;
+    uint8_t* kinds;
+    uint32_t* offsets;
+    uint32_t* lengths;
+    
+    /* NULL until jot_ScanDocumentLocate is first used. Each edit cuts it back to the edited line. */
+    jot_LineIndex* lines;
+} jot_ScanDocument;
+
+typedef struct
+{
+    uint8_t kind;
+    size_t offset;
+    size_t length;
+} jot_ScanDocumentToken;
+
+/* What an edit did to the tokens: old_count of them, starting at first, were replaced by new_count new ones. */
+typedef struct
+{
+    size_t first;
+    size_t old_count;
+    size_t new_count;
+} jot_ScanDocumentChange;
+
+/* Copies size bytes at data and scans them. Returns NULL if memory ran out, or if they're too big for 32-bit offsets. */
+jot_ScanDocument* jot_ScanDocumentNew(jot_Allocator* allocator, const char* data, size_t size);
+void jot_ScanDocumentFree(jot_ScanDocument* self);
+
+/*
+    Replaces removed bytes at offset with inserted_length bytes at inserted,
+    re-scans what's needed, and describes the token changes in change (which
+    may be NULL). Returns 0, leaving the document as it was, if the range
+    is outside the text or the text would outgrow 32-bit offsets. Also
+    returns 0 if memory ran out, after which the document can only be freed.
+*/
+int jot_ScanDocumentEdit(jot_ScanDocument* self, size_t offset, size_t removed,
+    const char* inserted, size_t inserted_length, jot_ScanDocumentChange* change);
+
+void jot_ScanDocumentGetToken(const jot_ScanDocument* self, size_t index, jot_ScanDocumentToken* token);
+
+/* Returns the index of the first token ending at or after offset: the one containing it, or else the next. */
+size_t jot_ScanDocumentFind(const jot_ScanDocument* self, size_t offset);
+
+/* Finds the line and column of the byte at offset, as jot_LineIndexLocate. Returns 0 if memory ran out. */
+int jot_ScanDocumentLocate(jot_ScanDocument* self, size_t offset, size_t* line, size_t* column);
+
+#endif
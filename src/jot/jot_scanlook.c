@@ -0,0 +1,255 @@
+/*
+    jot - Scanner Lookahead
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+
+#include <string.h>
+
+#include "jot_scanlook.h"
+
+enum
+{
+    JOT_LOOKAHEAD_MIN_CAPACITY = 4,
+    JOT_LOOKAHEAD_MIN_TEXT_CAPACITY = 1024
+};
+
+jot_Lookahead* jot_LookaheadNew(jot_Scanner* scanner, size_t capacity)
+{
+    jot_Lookahead* self = jot_Alloc(scanner->allocator, JOT_ALLOC_TOKENS, sizeof(jot_Lookahead));
+    size_t rounded = JOT_LOOKAHEAD_MIN_CAPACITY;
+    
+    if(self == NULL)
+    {
+        return NULL;
+    }
+    while(rounded < capacity)
+    {
+        rounded <<= 1;
+    }
+    self->allocator = scanner->allocator;
+    self->scanner = scanner;
+    self->capacity = rounded;
+    self->slots = jot_Alloc(self->allocator, JOT_ALLOC_TOKENS, rounded * sizeof(jot_LookaheadToken));
+    self->first = 0;
+    self->position = 0;
+    self->last = 0;
+    self->mark_depth = 0;
+    self->oldest_mark = 0;
+    self->text_capacity = JOT_LOOKAHEAD_MIN_TEXT_CAPACITY;
+    self->text = jot_Alloc(self->allocator, JOT_ALLOC_TOKENS, self->text_capacity);
+    self->text_end = 0;
+    if(self->slots == NULL || self->text == NULL)
+    {
+        jot_LookaheadFree(self);
+        return NULL;
+    }
+    return self;
+}
+
+void jot_LookaheadFree(jot_Lookahead* self)
+{
+    jot_Free(self->allocator, JOT_ALLOC_TOKENS, self->slots, self->capacity * sizeof(jot_LookaheadToken));
+    jot_Free(self->allocator, JOT_ALLOC_TOKENS, self->text, self->text_capacity);
+    jot_Free(self->allocator, JOT_ALLOC_TOKENS, self, sizeof(jot_Lookahead));
+}
+
+/* Doubles the ring. Slots are picked by token number, so every held token moves. */
+static int jot_LookaheadGrow(jot_Lookahead* self)
+{
+    size_t capacity = self->capacity * 2;
+    jot_LookaheadToken* slots = jot_Alloc(self->allocator, JOT_ALLOC_TOKENS, capacity * sizeof(jot_LookaheadToken));
+    size_t i;
+    
+    if(slots == NULL)
+    {
+        return 0;
+    }
+    for(i = self->first; i < self->last; i++)
+    {
+        slots[i & (capacity - 1)] = self->slots[i & (self->capacity - 1)];
+    }
+    jot_Free(self->allocator, JOT_ALLOC_TOKENS, self->slots, self->capacity * sizeof(jot_LookaheadToken));
+    self->slots = slots;
+    self->capacity = capacity;
+    return 1;
+}
+
+/* Points every held token's text back into the pool, after it's moved. */
+static void jot_LookaheadFixText(jot_Lookahead* self, size_t shift)
+{
+    jot_LookaheadToken* token;
+    size_t i;
+    
+    for(i = self->first; i < self->last; i++)
+    {
+        token = &self->slots[i & (self->capacity - 1)];
+        token->text_position -= shift;
+        token->text = self->text + token->text_position;
+    }
+}
+
+/*
+    Appends text to the pool and returns where it went. Text is stored in
+    the order tokens are scanned, so everything before the first held
+    token's text is free; it's reclaimed by sliding the rest down whenever
+    the end is reached, and the pool only grows if that doesn't make room.
+*/
+static int jot_LookaheadStoreText(jot_Lookahead* self, const char* text, size_t length, size_t* position)
+{
+    size_t live = self->first < self->last ? self->slots[self->first & (self->capacity - 1)].text_position : self->text_end;
+    size_t capacity;
+    char* pool;
+    
+    if(self->text_capacity - self->text_end < length)
+    {
+        memmove(self->text, self->text + live, self->text_end - live);
+        self->text_end -= live;
+        jot_LookaheadFixText(self, live);
+        
+        if(self->text_capacity - self->text_end < length)
+        {
+            capacity = self->text_capacity * 2;
+            if(capacity < self->text_end + length)
+            {
+                capacity = self->text_end + length;
+            }
+            if((pool = jot_Realloc(self->allocator, JOT_ALLOC_TOKENS, self->text, self->text_capacity, capacity)) == NULL)
+            {
+                return 0;
+            }
+            self->text = pool;
+            self->text_capacity = capacity;
+            jot_LookaheadFixText(self, 0);
+        }
+    }
+    
+    memcpy(self->text + self->text_end, text, length);
+    *position = self->text_end;
+    self->text_end += length;
+    return 1;
+}
+
+/* Scans one more token onto the end of the ring, after letting go of any that can't be needed again. */
+static int jot_LookaheadScan(jot_Lookahead* self)
+{
+    jot_Scanner* scanner = self->scanner;
+    jot_LookaheadToken* token;
+    jot_Token kind;
+    size_t text_length;
+    size_t position;
+    
+    self->first = self->mark_depth > 0 && self->oldest_mark < self->position ? self->oldest_mark : self->position;
+    if(self->last - self->first == self->capacity && !jot_LookaheadGrow(self))
+    {
+        return 0;
+    }
+    
+    kind = jot_ScannerNext(scanner);
+    if(scanner->failed)
+    {
+        return 0;
+    }
+    switch(kind)
+    {
+        case JOT_TOKEN_NUM:
+        case JOT_TOKEN_INT:
+        case JOT_TOKEN_HEX:
+        case JOT_TOKEN_BIN:
+        case JOT_TOKEN_STR:
+        case JOT_TOKEN_IDENTIFIER:
+        case JOT_TOKEN_KEYWORD:
+            text_length = scanner->last_text_length;
+            break;
+        default:
+            /* Anything else leaves last_text alone. */
+            text_length = 0;
+            break;
+    }
+    if(!jot_LookaheadStoreText(self, scanner->last_text, text_length, &position))
+    {
+        return 0;
+    }
+    
+    token = &self->slots[self->last & (self->capacity - 1)];
+    token->kind = kind;
+    token->keyword = kind == JOT_TOKEN_KEYWORD ? scanner->last_keyword : JOT_KEYWORD_NONE;
+    token->offset = scanner->last_offset;
+    token->length = scanner->last_length;
+    token->text_position = position;
+    token->text = self->text + position;
+    token->text_length = text_length;
+    token->int_value = scanner->last_int;
+    token->num_value = scanner->last_num;
+    token->atom = kind == JOT_TOKEN_IDENTIFIER || kind == JOT_TOKEN_STR ? scanner->last_atom : NULL;
+    self->last++;
+    return 1;
+}
+
+const jot_LookaheadToken* jot_LookaheadPeek(jot_Lookahead* self, size_t ahead)
+{
+    while(self->position + ahead >= self->last)
+    {
+        /* Nothing gets scanned past the end-of-file; it just repeats. */
+        if(self->last > 0 && self->slots[(self->last - 1) & (self->capacity - 1)].kind == JOT_TOKEN_EOF)
+        {
+            return &self->slots[(self->last - 1) & (self->capacity - 1)];
+        }
+        if(!jot_LookaheadScan(self))
+        {
+            return NULL;
+        }
+    }
+    return &self->slots[(self->position + ahead) & (self->capacity - 1)];
+}
+
+const jot_LookaheadToken* jot_LookaheadNext(jot_Lookahead* self)
+{
+    const jot_LookaheadToken* token = jot_LookaheadPeek(self, 0);
+    
+    if(token != NULL && token->kind != JOT_TOKEN_EOF)
+    {
+        self->position++;
+    }
+    return token;
+}
+
+size_t jot_LookaheadMark(jot_Lookahead* self)
+{
+    if(self->mark_depth++ == 0)
+    {
+        self->oldest_mark = self->position;
+    }
+    return self->position;
+}
+
+void jot_LookaheadRewind(jot_Lookahead* self, size_t mark)
+{
+    self->position = mark;
+}
+
+void jot_LookaheadRelease(jot_Lookahead* self)
+{
+    self->mark_depth--;
+}
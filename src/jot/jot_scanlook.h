@@ -0,0 +1,114 @@
+/*
+    jot - Scanner Lookahead
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#ifndef JOT_SCANLOOK_H
+#define JOT_SCANLOOK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "jot_scanner.h"
+
+/*
+    A token as kept by jot_Lookahead. Unlike the scanner's last_* fields,
+    everything here stays put while more tokens are scanned.
+*/
+typedef struct
+{
+    jot_Token kind;
+    jot_Keyword keyword;
+    /* Where the token lies in the source, as with last_offset and last_length; jot_ScannerLocate turns offset into a line and column. */
+    size_t offset;
+    size_t length;
+    /* Unescaped text of literals, identifiers and keywords, as with last_text. Not terminated. */
+    const char* text;
+    size_t text_length;
+    int64_t int_value;
+    double num_value;
+    const jot_Atom* atom;
+    
+    /* Where text is kept in the lookahead's pool, since the pool moves. */
+    size_t text_position;
+} jot_LookaheadToken;
+
+/*
+    Lets a parser look any number of tokens ahead of where it is, and go
+    back to an earlier token, without scanning anything twice. Tokens live
+    in a ring of slots that only grows when a mark or peek holds on to more
+    tokens than it has room for, and their text is copied one after another
+    into a single pool that's compacted rather than reallocated once it has
+    grown to fit the window, so steady scanning never allocates.
+    
+    Tokens are numbered from 0 in the order they're scanned. Marks are just
+    token numbers, and are released in the reverse order they were made.
+    Everything from the oldest unreleased mark on is kept; without one,
+    only tokens from the current one on are.
+*/
+typedef struct
+{
+    /* The scanner's, taken when the lookahead is made. */
+    jot_Allocator* allocator;
+    jot_Scanner* scanner;
+    
+    /* Tokens first up to last are held, in slots[number & (capacity - 1)]. */
+    size_t capacity;
+    jot_LookaheadToken* slots;
+    size_t first;
+    size_t position;
+    size_t last;
+    
+    size_t mark_depth;
+    size_t oldest_mark;
+    
+    char* text;
+    size_t text_capacity;
+    size_t text_end;
+} jot_Lookahead;
+
+/* Reads tokens from scanner, with room for capacity of them to start with. */
+jot_Lookahead* jot_LookaheadNew(jot_Scanner* scanner, size_t capacity);
+void jot_LookaheadFree(jot_Lookahead* self);
+
+/*
+    Returns the token ahead tokens past the current one (0 being the current
+    one itself), scanning up to it if need be, or NULL if memory ran out.
+    Past the end, every token is the end-of-file. The token, and its text,
+    stay valid until the next call to any of these functions but the mark
+    ones, and until it's been passed and no mark holds it after that.
+*/
+const jot_LookaheadToken* jot_LookaheadPeek(jot_Lookahead* self, size_t ahead);
+
+/* Moves past the current token and returns it, or NULL if memory ran out. */
+const jot_LookaheadToken* jot_LookaheadNext(jot_Lookahead* self);
+
+/* Returns a mark at the current token, which is kept until the mark is released. */
+size_t jot_LookaheadMark(jot_Lookahead* self);
+/* Goes back (or forward) to a marked token. The mark stays. */
+void jot_LookaheadRewind(jot_Lookahead* self, size_t mark);
+/* Releases the most recent mark. */
+void jot_LookaheadRelease(jot_Lookahead* self);
+
+#endif
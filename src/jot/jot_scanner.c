@@ -25,96 +25,21 @@
     
 */
 
-#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "jot_source.h"
-
-#define JOT_END_OF_STREAM (char)(-1)
+#include "jot_scanner.h"
+#include "jot_scantab.h"
+#include "jot_utf8.h"
 
 enum
 {
     JOT_SCAN_BUFFER_SIZE = 256,
-    JOT_SCAN_MIN_TEXT_CAPACITY = 32
+    JOT_SCAN_MIN_TEXT_CAPACITY = 32,
+    JOT_TOKEN_BUFFER_MIN_CAPACITY = 1024
 };
 
-typedef enum
-{
-    JOT_STATE_START,
-    JOT_STATE_NEWLINE,
-    JOT_STATE_ZERO,
-    JOT_STATE_INT,
-    JOT_STATE_HEX,
-    JOT_STATE_BIN,
-    JOT_STATE_NUM,
-    JOT_STATE_E_SIGN,
-    JOT_STATE_E_VALUE,
-    JOT_STATE_STR,
-    JOT_STATE_STR_BACKSLASH,
-    JOT_STATE_STR_HEX_HIGH,
-    JOT_STATE_STR_HEX_LOW,
-    JOT_STATE_IDENTIFIER,
-    JOT_STATE_HASH,
-    JOT_STATE_HASH_COMMENT,
-    JOT_STATE_HASH_HASH_COMMENT,
-    JOT_STATE_HASH_HASH_COMMENT_HASH,
-    JOT_STATE_DOT,
-    JOT_STATE_DOT_DOT,
-    JOT_STATE_LT,
-    JOT_STATE_GT,
-    JOT_STATE_EQ,
-    JOT_STATE_ASTERISK,
-    JOT_STATE_DASH,
-    JOT_STATE_EXCLAIM
-} jot_ScanState;
-
-typedef enum
-{
-    JOT_TOKEN_NONE,
-    JOT_TOKEN_EOF,
-    JOT_TOKEN_ERROR,
-    JOT_TOKEN_NUM,
-    JOT_TOKEN_INT,
-    JOT_TOKEN_HEX,
-    JOT_TOKEN_BIN,
-    JOT_TOKEN_STR,
-    JOT_TOKEN_IDENTIFIER,
-    JOT_TOKEN_COLON,
-    JOT_TOKEN_SEMICOLON,
-    JOT_TOKEN_DOT,
-    JOT_TOKEN_DOT_DOT,
-    JOT_TOKEN_DOT_DOT_DOT,
-    JOT_TOKEN_COMMA,
-    JOT_TOKEN_LPAREN,
-    JOT_TOKEN_RPAREN,
-    JOT_TOKEN_LBRACKET,
-    JOT_TOKEN_RBRACKET,
-    JOT_TOKEN_LBRACE,
-    JOT_TOKEN_RBRACE,
-    JOT_TOKEN_ASSIGN,
-    JOT_TOKEN_EXCLAIM,
-    JOT_TOKEN_CMP_EQ,
-    JOT_TOKEN_CMP_LT,
-    JOT_TOKEN_CMP_LE,
-    JOT_TOKEN_CMP_GT,
-    JOT_TOKEN_CMP_GE,
-    JOT_TOKEN_CMP_NE,
-    JOT_TOKEN_ADD,
-    JOT_TOKEN_SUB,
-    JOT_TOKEN_MUL,
-    JOT_TOKEN_DIV,
-    JOT_TOKEN_MOD,
-    JOT_TOKEN_EXP,
-    JOT_TOKEN_AND,
-    JOT_TOKEN_OR,
-    JOT_TOKEN_XOR,
-    JOT_TOKEN_TILDE,
-    JOT_TOKEN_SHL,
-    JOT_TOKEN_SHR,
-    JOT_TOKEN_ARROW
-} jot_Token;
-
 const char* token_name[] = {
     "(none?)",
     "end-of-file",
@@ -157,775 +82,576 @@ const char* token_name[] = {
     "'~'",
     "'<<'",
     "'>>'",
-    "'->'"
+    "'->'",
+    "keyword"
 };
 
-typedef enum
-{
-    JOT_KEYWORD_NONE,
-    JOT_KEYWORD_AND,
-    JOT_KEYWORD_BREAK,
-    JOT_KEYWORD_CONTINUE,
-    JOT_KEYWORD_DO,
-    JOT_KEYWORD_ELSE,
-    JOT_KEYWORD_ELSEIF,
-    JOT_KEYWORD_END,
-    JOT_KEYWORD_FALSE,
-    JOT_KEYWORD_FOR,
-    JOT_KEYWORD_FUNC,
-    JOT_KEYWORD_IF,
-    JOT_KEYWORD_IN,
-    JOT_KEYWORD_NIL,
-    JOT_KEYWORD_NOT,
-    JOT_KEYWORD_OR,
-    JOT_KEYWORD_REPEAT,
-    JOT_KEYWORD_THEN,
-    JOT_KEYWORD_TRUE,
-    JOT_KEYWORD_UNTIL,
-    JOT_KEYWORD_WHILE,
-    JOT_KEYWORD_VAR
-} jot_Keyword;
-
-typedef struct
-{
-    jot_Source* source;
-    char end_of_file;
-    char terminator;
-    char intermediate;
-    jot_ScanState previous_state;
-    jot_ScanState state;
-    size_t line;
-    size_t comment_line;
-    
-    size_t position;
-    size_t buffer_size;
-    const char* buffer;
-    
-    size_t text_length;
-    size_t text_capacity;
-    char* text;
-    
-    size_t last_text_length;
-    size_t last_text_capacity;
-    char* last_text;
-} jot_Scanner;
-
-jot_Scanner* jot_ScannerNew(jot_Source* source)
+jot_Scanner* jot_ScannerNew(jot_Allocator* allocator, jot_Source* source)
 {
-    jot_Scanner* self = malloc(sizeof(jot_Scanner));
+    jot_Scanner* self = jot_Alloc(allocator, JOT_ALLOC_SCANNER, sizeof(jot_Scanner));
     
+    if(self == NULL)
+    {
+        return NULL;
+    }
+    self->allocator = allocator;
+    self->failed = 0;
     self->source = source;
+    self->skip = jot_ScanSkipGet();
     self->end_of_file = 0;
     self->state = JOT_STATE_START;
+    self->end_state = JOT_STATE_START;
     self->terminator = 0;
     self->position = 0;
     self->buffer_size = 0;
-    self->line = 1;
-    self->comment_line = 0;
+    self->buffer = NULL;
+    self->offset = 0;
+    self->token_start = 0;
     
     self->text_length = 0;
     self->text_capacity = JOT_SCAN_MIN_TEXT_CAPACITY;
-    self->text = malloc(self->text_capacity);
+    self->text = jot_Alloc(allocator, JOT_ALLOC_SCANNER, self->text_capacity);
+    
+    self->last_scratch_capacity = JOT_SCAN_MIN_TEXT_CAPACITY;
+    self->last_scratch = jot_Alloc(allocator, JOT_ALLOC_SCANNER, self->last_scratch_capacity);
     
+    self->last_span = 0;
     self->last_text_length = 0;
-    self->last_text_capacity = JOT_SCAN_MIN_TEXT_CAPACITY;
-    self->last_text = malloc(self->last_text_capacity);
+    self->last_text = self->last_scratch;
+    self->last_offset = 0;
+    self->last_length = 0;
+    self->last_keyword = JOT_KEYWORD_NONE;
+    self->atoms = NULL;
+    self->last_atom = NULL;
+    self->last_int = 0;
+    self->last_num = 0.0;
+    self->lines = NULL;
+    self->lines_position = 0;
+    self->invalid_utf8 = (size_t) -1;
+    self->utf8_error = (size_t) -1;
+    self->utf8_carry_offset = 0;
+    self->utf8_carry_length = 0;
+    self->string_utf8_error = 0;
+    self->identifier_utf8 = 0;
     
+    if(self->text == NULL || self->last_scratch == NULL)
+    {
+        jot_ScannerFree(self);
+        return NULL;
+    }
     return self;
 }
 
 void jot_ScannerFree(jot_Scanner* self)
 {
-    free(self->last_text);
-    free(self->text);
-    free(self);
+    jot_Allocator* allocator = self->allocator;
+    jot_Free(allocator, JOT_ALLOC_SCANNER, self->last_scratch, self->last_scratch_capacity);
+    jot_Free(allocator, JOT_ALLOC_SCANNER, self->text, self->text_capacity);
+    jot_Free(allocator, JOT_ALLOC_SCANNER, self, sizeof(jot_Scanner));
+}
+
+/* Makes room for length more bytes of text, or marks the scanner failed and returns 0. */
+static int jot_ScannerReserveText(jot_Scanner* self, size_t length)
+{
+    size_t capacity = self->text_capacity;
+    char* text;
+    
+    if(capacity - self->text_length < length)
+    {
+        while(capacity - self->text_length < length)
+        {
+            capacity <<= 1;
+        }
+        if((text = jot_Realloc(self->allocator, JOT_ALLOC_SCANNER, self->text, self->text_capacity, capacity)) == NULL)
+        {
+            self->failed = 1;
+            return 0;
+        }
+        self->text = text;
+        self->text_capacity = capacity;
+    }
+    return 1;
 }
 
 void jot_ScannerAddTextChar(jot_Scanner* self, char c)
 {
-    if(self->text_length == self->text_capacity)
+    if(jot_ScannerReserveText(self, 1))
+    {
+        self->text[self->text_length++] = c;
+    }
+}
+
+/*
+    Copies the pending span (token_start up to the current position) into the
+    scratch text. Only needed when the token can't stay a span: before an
+    escape or separator, or before the chunk it lives in gets replaced.
+*/
+static void jot_ScannerSpillText(jot_Scanner* self)
+{
+    size_t length;
+    
+    if(self->position > self->token_start)
     {
-        self->text_capacity <<= 1;
-        self->text = realloc(self->text, self->text_capacity);
+        length = self->position - self->token_start;
+        if(jot_ScannerReserveText(self, length))
+        {
+            memcpy(self->text + self->text_length, self->buffer + self->token_start, length);
+            self->text_length += length;
+        }
     }
-    self->text[self->text_length++] = c;
+    self->token_start = self->position;
+}
+
+/* Drops the current character (a separator or escape) from the token text. */
+static void jot_ScannerSkipTextChar(jot_Scanner* self)
+{
+    jot_ScannerSpillText(self);
+    self->token_start = self->position + 1;
 }
 
 void jot_ScannerFlushText(jot_Scanner* self)
 {
-    if(self->last_text_capacity < self->text_capacity)
+    char* scratch;
+    size_t capacity;
+    
+    if(self->text_length == 0)
     {
-        self->last_text_capacity = self->text_capacity;
-        self->last_text = realloc(self->last_text, self->last_text_capacity);
+        /* Nothing was copied, so the text is still a span of the chunk. */
+        self->last_span = 1;
+        self->last_text = self->buffer + self->token_start;
+        self->last_text_length = self->position - self->token_start;
+        return;
     }
-    memcpy(self->last_text, self->text, self->text_length);
+    
+    jot_ScannerSpillText(self);
+    
+    /* Swap scratch buffers instead of copying the finished text over. */
+    scratch = self->last_scratch;
+    capacity = self->last_scratch_capacity;
+    self->last_scratch = self->text;
+    self->last_scratch_capacity = self->text_capacity;
+    self->text = scratch;
+    self->text_capacity = capacity;
+    
+    self->last_span = 0;
+    self->last_text = self->last_scratch;
     self->last_text_length = self->text_length;
     self->text_length = 0;
 }
 
+static int jot_ScannerInString(const jot_Scanner* self)
+{
+    return self->state >= JOT_STATE_STR && self->state <= JOT_STATE_STR_HEX_LOW;
+}
+
+static void jot_ScannerUtf8Error(jot_Scanner* self, size_t offset)
+{
+    if(self->invalid_utf8 == (size_t) -1)
+    {
+        self->invalid_utf8 = offset;
+    }
+}
+
+/*
+    Finds the next bad byte in the chunk from position on. A sequence cut
+    short by the end of the chunk isn't bad yet, just held back until the
+    next chunk says whether it's finished properly.
+*/
+static void jot_ScannerFindUtf8Error(jot_Scanner* self, size_t position)
+{
+    size_t size = self->buffer_size;
+    
+    position += self->skip->utf8(self->buffer + position, size - position);
+    self->utf8_error = (size_t) -1;
+    if(position == size)
+    {
+        return;
+    }
+    if(size - position <= sizeof(self->utf8_carry) && jot_Utf8IsTruncated(self->buffer + position, size - position))
+    {
+        memcpy(self->utf8_carry, self->buffer + position, size - position);
+        self->utf8_carry_length = size - position;
+        self->utf8_carry_offset = self->offset + position;
+        return;
+    }
+    self->utf8_error = self->offset + position;
+    jot_ScannerUtf8Error(self, self->utf8_error);
+}
+
+/*
+    The held back sequence turned out bad. Its bytes are all non-ASCII, so
+    they all belong to whatever token was in progress at the end of the chunk.
+*/
+static void jot_ScannerCarryError(jot_Scanner* self)
+{
+    jot_ScannerUtf8Error(self, self->utf8_carry_offset);
+    if(jot_ScannerInString(self) && self->utf8_carry_offset >= self->last_offset)
+    {
+        self->string_utf8_error = 1;
+    }
+    self->utf8_carry_length = 0;
+}
+
+/* Validates a freshly read chunk, starting with whatever the last one held back. */
+static void jot_ScannerCheckChunk(jot_Scanner* self)
+{
+    size_t position = 0;
+    
+    if(self->utf8_carry_length)
+    {
+        char sequence[4];
+        uint32_t code_point;
+        size_t length = self->utf8_carry_length;
+        size_t more = sizeof(sequence) - length < self->buffer_size ? sizeof(sequence) - length : self->buffer_size;
+        size_t count;
+        
+        memcpy(sequence, self->utf8_carry, length);
+        memcpy(sequence + length, self->buffer, more);
+        if((count = jot_Utf8Decode(sequence, length + more, &code_point)) != 0)
+        {
+            self->utf8_carry_length = 0;
+            position = count - length;
+        }
+        else if(jot_Utf8IsTruncated(sequence, length + more))
+        {
+            /* A chunk this small doesn't even finish it. */
+            memcpy(self->utf8_carry, sequence, length + more);
+            self->utf8_carry_length = length + more;
+            self->utf8_error = (size_t) -1;
+            return;
+        }
+        else
+        {
+            jot_ScannerCarryError(self);
+        }
+    }
+    jot_ScannerFindUtf8Error(self, position);
+}
+
+/*
+    Whether the string that was just scanned is valid UTF-8. The chunk's bad
+    bytes up to its end are used up on the way, those before it having been
+    in comments, or in strings already dealt with.
+*/
+static int jot_ScannerCheckString(jot_Scanner* self)
+{
+    size_t end = self->last_offset + self->last_length;
+    int valid = !self->string_utf8_error;
+    
+    self->string_utf8_error = 0;
+    while(self->utf8_error < end)
+    {
+        if(self->utf8_error >= self->last_offset)
+        {
+            valid = 0;
+        }
+        jot_ScannerFindUtf8Error(self, self->utf8_error - self->offset + 1);
+    }
+    return valid;
+}
+
+/* Looks up the atom for the token just flushed, while its text is still hot in cache. */
+static void jot_ScannerInternText(jot_Scanner* self)
+{
+    if(self->atoms)
+    {
+        self->last_atom = jot_AtomTableIntern(self->atoms, self->last_text, self->last_text_length,
+            jot_StrHash(self->last_text, self->last_text_length));
+    }
+}
+
+/*
+    Works out the value of a literal from its text, while it's still hot in
+    cache. Integers that don't fit in 64 bits become errors.
+*/
+static jot_Token jot_ScannerConvertText(jot_Scanner* self, jot_Token token)
+{
+    switch(token)
+    {
+        case JOT_TOKEN_INT:
+            return jot_NumParseInt(self->last_text, self->last_text_length, 10, &self->last_int) ? token : JOT_TOKEN_ERROR;
+        case JOT_TOKEN_HEX:
+            return jot_NumParseInt(self->last_text, self->last_text_length, 16, &self->last_int) ? token : JOT_TOKEN_ERROR;
+        case JOT_TOKEN_BIN:
+            return jot_NumParseInt(self->last_text, self->last_text_length, 2, &self->last_int) ? token : JOT_TOKEN_ERROR;
+        case JOT_TOKEN_NUM:
+            self->last_num = jot_NumParseDecimal(self->last_text, self->last_text_length);
+            return token;
+        case JOT_TOKEN_STR:
+            if(!jot_ScannerCheckString(self))
+            {
+                return JOT_TOKEN_ERROR;
+            }
+            jot_ScannerInternText(self);
+            return token;
+        default:
+            return token;
+    }
+}
+
+int jot_ScannerTokenSpan(const jot_Scanner* self, size_t* offset, size_t* length)
+{
+    if(!self->last_span)
+    {
+        return 0;
+    }
+    *offset = self->last_text - self->buffer;
+    *length = self->last_text_length;
+    return 1;
+}
+
+void jot_ScannerLocate(jot_Scanner* self, size_t offset, size_t* line, size_t* column)
+{
+    if(self->lines == NULL || self->lines->failed)
+    {
+        *line = 0;
+        *column = 0;
+        return;
+    }
+    /* Catch up on the current chunk, as far as the scanner has got through it. */
+    if(!self->end_of_file && self->position > self->lines_position)
+    {
+        jot_LineIndexAppend(self->lines, self->buffer + self->lines_position, self->position - self->lines_position);
+        self->lines_position = self->position;
+    }
+    jot_LineIndexLocate(self->lines, offset, line, column);
+}
+
+jot_Keyword jot_KeywordLookup(const char* text, size_t length)
+{
+    unsigned int slot;
+    
+    if(length < JOT_SCAN_KEYWORD_MIN_LENGTH || length > JOT_SCAN_KEYWORD_MAX_LENGTH)
+    {
+        return JOT_KEYWORD_NONE;
+    }
+    slot = ((unsigned char) text[0] * JOT_SCAN_KEYWORD_A
+        + (unsigned char) text[length - 1] * JOT_SCAN_KEYWORD_B
+        + (unsigned int) length) & (JOT_SCAN_KEYWORD_SLOTS - 1);
+    if(jot_scan_keywords[slot].length == length
+        && memcmp(jot_scan_keywords[slot].text, text, length) == 0)
+    {
+        return (jot_Keyword) jot_scan_keywords[slot].keyword;
+    }
+    return JOT_KEYWORD_NONE;
+}
+
+static int jot_HexDigitValue(unsigned char c)
+{
+    return c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10;
+}
+
 jot_Token jot_ScannerNext(jot_Scanner* self)
 {
-    char c;
+    const unsigned char* classes;
+    const unsigned char* buffer;
+    size_t position;
+    size_t size;
+    unsigned int state;
+    unsigned int entry;
+    unsigned char c;
     
     if(self->source == NULL)
     {
         return JOT_TOKEN_EOF;
     }
+    /* Past the end, every read sees the end-of-stream class instead of a byte. */
+    classes = self->end_of_file ? jot_scan_eos_classes : jot_scan_classes;
     do
     {
-        while(self->position < self->buffer_size)
+        buffer = (const unsigned char*) self->buffer;
+        position = self->position;
+        size = self->buffer_size;
+        state = self->state;
+        
+        while(position < size)
         {
-            if(self->end_of_file)
-            {
-                c = JOT_END_OF_STREAM;
-            }
-            else
+            c = buffer[position];
+            entry = jot_scan_transitions[state][classes[c]];
+            state = entry & JOT_SCAN_STATE_MASK;
+            if((entry & JOT_SCAN_ACTION_MASK) == 0)
             {
-                c = self->buffer[self->position];
+                position++;
+                continue;
             }
             
-            switch(self->state)
+            switch((entry & JOT_SCAN_ACTION_MASK) >> JOT_SCAN_ACTION_SHIFT)
             {
-                case JOT_STATE_START:
-                    switch(c)
-                    {
-                        case '0':
-                            self->state = JOT_STATE_ZERO;
-                            jot_ScannerAddTextChar(self, c);
-                            break;
-                        case '1': case '2': case '3':
-                        case '4': case '5': case '6':
-                        case '7': case '8': case '9':
-                            /* '1' .. '9' */
-                            self->state = JOT_STATE_INT;
-                            jot_ScannerAddTextChar(self, c);
-                            break;
-                        case '\'':
-                        case '\"':
-                            self->terminator = c;
-                            self->state = JOT_STATE_STR;
-                            break;
-                        case 'a': case 'b': case 'c': case 'd': case 'e':
-                        case 'f': case 'g': case 'h': case 'i': case 'j':
-                        case 'k': case 'l': case 'm': case 'n': case 'o':
-                        case 'p': case 'q': case 'r': case 's': case 't':
-                        case 'u': case 'v': case 'w': case 'x': case 'y':
-                        case 'z': case '_': case 'A': case 'B': case 'C':
-                        case 'D': case 'E': case 'F': case 'G': case 'H':
-                        case 'I': case 'J': case 'K': case 'L': case 'M':
-                        case 'N': case 'O': case 'P': case 'Q': case 'R':
-                        case 'S': case 'T': case 'U': case 'V': case 'W':
-                        case 'X': case 'Y': case 'Z':
-                            /* 'a' .. 'z' | '_' | 'A' .. 'Z' */
-                            self->state = JOT_STATE_IDENTIFIER;
-                            jot_ScannerAddTextChar(self, c);
-                            break;
-                        case ' ': case '\t':
-                        case '\r': case '\n':
-                            /* Ignore whitespace (lines are tracked elsewhere) */
-                            break;
-                        case '#':
-                            self->state = JOT_STATE_HASH;
-                            break;
-                        case ':': self->position++; return JOT_TOKEN_COLON;
-                        case ';': self->position++; return JOT_TOKEN_SEMICOLON;
-                        case '.':
-                            self->state = JOT_STATE_DOT;
-                            break;
-                        case ',': self->position++; return JOT_TOKEN_COMMA;
-                        case '(': self->position++; return JOT_TOKEN_LPAREN;
-                        case ')': self->position++; return JOT_TOKEN_RPAREN;
-                        case '[': self->position++; return JOT_TOKEN_LBRACKET;
-                        case ']': self->position++; return JOT_TOKEN_RBRACKET;
-                        case '{': self->position++; return JOT_TOKEN_LBRACE;
-                        case '}': self->position++; return JOT_TOKEN_RBRACE;
-                        case '<':
-                            self->state = JOT_STATE_LT;
-                            break;
-                        case '>':
-                            self->state = JOT_STATE_GT;
-                            break;
-                        case '=':
-                            self->state = JOT_STATE_EQ;
-                            break;
-                        case '*':
-                            self->state = JOT_STATE_ASTERISK;
-                            break;
-                        case '-':
-                            self->state = JOT_STATE_DASH;
-                            break;
-                        case '!':
-                            self->state = JOT_STATE_EXCLAIM;
-                            break;
-                        case '+': self->position++; return JOT_TOKEN_ADD;
-                        case '/': self->position++; return JOT_TOKEN_DIV;
-                        case '%': self->position++; return JOT_TOKEN_MOD;
-                        case '&': self->position++; return JOT_TOKEN_AND;
-                        case '|': self->position++; return JOT_TOKEN_OR;
-                        case '^': self->position++; return JOT_TOKEN_XOR;
-                        case '~': self->position++; return JOT_TOKEN_TILDE;                        
-                        case JOT_END_OF_STREAM: break;
-                        default:
-                            /* error: illegal character %c (%d) found. */
-                            return JOT_TOKEN_ERROR;
-                    }
+                case JOT_SCAN_BEGIN:
+                    self->token_start = position;
+                    self->last_offset = self->offset + position;
                     break;
-                case JOT_STATE_ZERO:
-                    switch(c)
+                case JOT_SCAN_BEGIN_IDENTIFIER:
+                    self->last_offset = self->offset + position;
+                    self->token_start = position++;
+                    if(position < size)
                     {
-                        case '0': case '1': case '2': case '3': case '4':
-                        case '5': case '6': case '7': case '8': case '9':
-                            /* '0' .. '9' */
-                            self->state = JOT_STATE_INT;
-                            jot_ScannerAddTextChar(self, c);
-                            break;
-                        case '_':
-                            /* '_' place separator -- skip over, but switch states */
-                            self->state = JOT_STATE_INT;
-                            break;
-                        case '.':
-                            /* '.' decimal point */
-                            jot_ScannerAddTextChar(self, c);
-                            self->state = JOT_STATE_NUM;
-                            break;
-                        case 'e': case 'E':
-                            /* exp */
-                            jot_ScannerAddTextChar(self, c);
-                            self->state = JOT_STATE_E_SIGN;
-                            break;
-                        case 'x':
-                            /* hex literal */
-                            self->state = JOT_STATE_HEX;
-                            break;
-                        case 'b':
-                            /* binary literal */
-                            self->state = JOT_STATE_BIN;
-                            break;
-                        default:
-                            self->state = JOT_STATE_START;
-                            jot_ScannerFlushText(self);
-                            return JOT_TOKEN_INT;
-                    }
-                    break;
-                case JOT_STATE_INT:
-                    switch(c)
-                    {
-                        case '0': case '1': case '2': case '3': case '4':
-                        case '5': case '6': case '7': case '8': case '9':
-                            /* '0' .. '9' */
-                            jot_ScannerAddTextChar(self, c);
-                            break;
-                        case '_':
-                            /* '_' place separator -- skip over */
-                            break;
-                        case '.':
-                            /* '.' decimal point */
-                            jot_ScannerAddTextChar(self, c);
-                            self->state = JOT_STATE_NUM;
-                            break;
-                        case 'e': case 'E':
-                            /* exp */
-                            jot_ScannerAddTextChar(self, c);
-                            self->state = JOT_STATE_E_SIGN;
-                            break;
-                        default:
-                            self->state = JOT_STATE_START;
-                            jot_ScannerFlushText(self);
-                            return JOT_TOKEN_INT;
-                    }
-                    break;
-                case JOT_STATE_NUM:
-                    switch(c)
-                    {
-                        case '0': case '1': case '2': case '3': case '4':
-                        case '5': case '6': case '7': case '8': case '9':
-                            /* '0' .. '9' */
-                            jot_ScannerAddTextChar(self, c);
-                            break;
-                        case '_':
-                            /* '_' place separator -- skip over */
-                            break;
-                        case 'e': case 'E':
-                            /* exp */
-                            jot_ScannerAddTextChar(self, c);
-                            self->state = JOT_STATE_E_SIGN;
-                            break;
-                        default:
-                            self->state = JOT_STATE_START;
-                            jot_ScannerFlushText(self);
-                            return JOT_TOKEN_NUM;
-                    }
-                    break;
-                case JOT_STATE_E_SIGN:
-                    switch(c)
-                    {
-                        case '0': case '1': case '2': case '3': case '4':
-                        case '5': case '6': case '7': case '8': case '9':
-                        case '+': case '-':
-                            /* ('+'|'-')? digits */
-                            jot_ScannerAddTextChar(self, c);
-                            self->state = JOT_STATE_E_VALUE;
-                            break;
-                        case '_':
-                            /* '_' place separator -- skip over, but switch states */
-                            self->state = JOT_STATE_E_VALUE;
-                            break;
-                        default:
-                            self->state = JOT_STATE_START;
-                            jot_ScannerFlushText(self);
-                            return JOT_TOKEN_NUM;
-                    }
-                    break;
-                case JOT_STATE_E_VALUE:
-                    switch(c)
-                    {
-                        case '0': case '1': case '2': case '3': case '4':
-                        case '5': case '6': case '7': case '8': case '9':
-                            /* '0' .. '9' */
-                            jot_ScannerAddTextChar(self, c);
-                            break;
-                        case '_':
-                            /* '_' place separator -- skip over */
-                            break;
-                        default:
-                            self->state = JOT_STATE_START;
-                            jot_ScannerFlushText(self);
-                            return JOT_TOKEN_NUM;
-                    }
-                    break;
-                case JOT_STATE_HEX:
-                    switch(c)
-                    {
-                        case '0': case '1': case '2': case '3': case '4':
-                        case '5': case '6': case '7': case '8': case '9':
-                        case 'a': case 'b': case 'c': case 'd': case 'e': case 'f':
-                        case 'A': case 'B': case 'C': case 'D': case 'E': case 'F':
-                            /* '0' .. '9' | 'a' .. 'f' | 'A' .. 'F' */
-                            jot_ScannerAddTextChar(self, c);
-                            break;
-                        case '_':
-                            /* '_' place separator -- skip over */
-                            break;
-                        default:
-                            self->state = JOT_STATE_START;
-                            jot_ScannerFlushText(self);
-                            return JOT_TOKEN_HEX;
-                    }
-                    break;
-                case JOT_STATE_BIN:
-                    switch(c)
-                    {
-                        case '0': case '1':
-                            /* '0' .. '1' */
-                            jot_ScannerAddTextChar(self, c);
-                            break;
-                        case '_':
-                            /* '_' place separator -- skip over */
-                            break;
-                        default:
-                            self->state = JOT_STATE_START;
-                            jot_ScannerFlushText(self);
-                            return JOT_TOKEN_BIN;
-                    }
-                    break;
-                case JOT_STATE_STR:
-                    switch(c)
-                    {
-                        case '\"':
-                        case '\'':
-                            if(c == self->terminator)
-                            {
-                                self->state = JOT_STATE_START;
-                                self->position++;
-                                jot_ScannerFlushText(self);
-                                return JOT_TOKEN_STR;
-                            }
-                            else
-                            {
-                                jot_ScannerAddTextChar(self, c);
-                            }
-                            break;
-                        case '\\':
-                            self->state = JOT_STATE_STR_BACKSLASH;
-                            break;
-                        case '\r':
-                        case '\n':
-                            /* error: expected closing {{terminator}} but got end-of-line. */
-                            self->state = JOT_STATE_START;
-                            jot_ScannerFlushText(self);
-                            return JOT_TOKEN_STR;
-                        case JOT_END_OF_STREAM:
-                            /* error: expected closing {{terminator}} but got end-of-file. */
-                            self->state = JOT_STATE_START;
-                            jot_ScannerFlushText(self);
-                            return JOT_TOKEN_STR;
-                        default:
-                            jot_ScannerAddTextChar(self, c);
-                            break;
+                        position += self->skip->identifier((const char*) buffer + position, size - position);
                     }
+                    continue;
+                case JOT_SCAN_RUN_SPACE:
+                    position += self->skip->space((const char*) buffer + position, size - position);
+                    continue;
+                case JOT_SCAN_RUN_LINE_COMMENT:
+                    position += self->skip->line_comment((const char*) buffer + position, size - position);
+                    continue;
+                case JOT_SCAN_RUN_BLOCK_COMMENT:
+                    position += self->skip->block_comment((const char*) buffer + position, size - position);
+                    continue;
+                case JOT_SCAN_RUN_STR:
+                    position += self->skip->string((const char*) buffer + position, size - position, self->terminator);
+                    continue;
+                case JOT_SCAN_BEGIN_UTF8_IDENTIFIER:
+                    self->token_start = position;
+                    self->last_offset = self->offset + position;
+                    self->identifier_utf8 = 1;
                     break;
-                case JOT_STATE_STR_BACKSLASH:
-                    self->state = JOT_STATE_STR;
-                    switch(c)
-                    {
-                        case '\\':
-                        case '\'':
-                        case '\"':
-                            jot_ScannerAddTextChar(self, c); break;
-                        case 'a': jot_ScannerAddTextChar(self, '\a'); break;
-                        case 'b': jot_ScannerAddTextChar(self, '\b'); break;
-                        case 'f': jot_ScannerAddTextChar(self, '\f'); break;
-                        case 'n': jot_ScannerAddTextChar(self, '\n'); break;
-                        case 'r': jot_ScannerAddTextChar(self, '\r'); break;
-                        case 't': jot_ScannerAddTextChar(self, '\t'); break;
-                        case 'v': jot_ScannerAddTextChar(self, '\v'); break;
-                        case 'x':
-                            self->intermediate = 0;
-                            self->state = JOT_STATE_STR_HEX_HIGH;
-                            break;
-                        case '\r':
-                        case '\n':
-                            /* error: expected escape sequence but got end-of-line. */
-                            self->state = JOT_STATE_START;
-                            jot_ScannerFlushText(self);
-                            return JOT_TOKEN_STR;
-                        case JOT_END_OF_STREAM:
-                            /* error: expected escape sequence but got end-of-file. */
-                            self->state = JOT_STATE_START;
-                            jot_ScannerFlushText(self);
-                            return JOT_TOKEN_STR;
-                        default:
-                            /* error: invalid escape sequence. */
-                            break;
-                    }
+                case JOT_SCAN_UTF8_IDENTIFIER:
+                    self->identifier_utf8 = 1;
                     break;
-                case JOT_STATE_STR_HEX_HIGH:
-                    self->state = JOT_STATE_STR_HEX_LOW;
-                    switch(c)
-                    {
-                        case '0': case '1': case '2': case '3': case '4':
-                        case '5': case '6': case '7': case '8': case '9':
-                            /* '0' .. '9' */
-                            self->intermediate = (c - '0') << 4;
-                            break;
-                        case 'a': case 'b': case 'c': case 'd': case 'e': case 'f':
-                            /* 'a' .. 'f' */
-                            self->intermediate = (c - 'a' + 10) << 4;
-                            break;
-                        case 'A': case 'B': case 'C': case 'D': case 'E': case 'F':
-                            /* 'A' .. 'F' */
-                            self->intermediate = (c - 'A' + 10) << 4;
-                            break;
-                        case '\r':
-                        case '\n':
-                            /* error: expected hex escape sequence but got end-of-line. */
-                            self->state = JOT_STATE_START;
-                            jot_ScannerFlushText(self);
-                            return JOT_TOKEN_STR;
-                        case JOT_END_OF_STREAM:
-                            /* error: expected hex escape sequence but got end-of-file. */
-                            self->state = JOT_STATE_START;
-                            jot_ScannerFlushText(self);
-                            return JOT_TOKEN_STR;
-                        default:
-                            /* error: invalid hex digit in escape sequence. */
-                            self->state = JOT_STATE_STR;
-                            break;
-                    }
+                case JOT_SCAN_BEGIN_STR:
+                    self->terminator = c;
+                    self->token_start = position + 1;
+                    self->last_offset = self->offset + position;
                     break;
-                case JOT_STATE_STR_HEX_LOW:
-                    self->state = JOT_STATE_STR;
-                    switch(c)
-                    {
-                        case '0': case '1': case '2': case '3': case '4':
-                        case '5': case '6': case '7': case '8': case '9':
-                            /* '0' .. '9' */
-                            self->intermediate |= c - '0';
-                            jot_ScannerAddTextChar(self, self->intermediate);
-                            break;
-                        case 'a': case 'b': case 'c': case 'd': case 'e': case 'f':
-                            /* 'a' .. 'f' */
-                            self->intermediate |= c - 'a' + 10;
-                            jot_ScannerAddTextChar(self, self->intermediate);
-                            break;
-                        case 'A': case 'B': case 'C': case 'D': case 'E': case 'F':
-                            /* 'A' .. 'F' */
-                            self->intermediate |= c - 'A' + 10;
-                            jot_ScannerAddTextChar(self, self->intermediate);
-                            break;
-                        case '\r':
-                        case '\n':
-                            /* error: expected hex escape sequence but got end-of-line. */
-                            self->state = JOT_STATE_START;
-                            jot_ScannerFlushText(self);
-                            return JOT_TOKEN_STR;
-                        case JOT_END_OF_STREAM:
-                            /* error: expected hex escape sequence but got end-of-file. */
-                            self->state = JOT_STATE_START;
-                            jot_ScannerFlushText(self);
-                            return JOT_TOKEN_STR;
-                        default:
-                            /* error: invalid hex digit in escape sequence. */
-                            break;
-                    }
+                case JOT_SCAN_SKIP:
+                    self->position = position;
+                    jot_ScannerSkipTextChar(self);
                     break;
-                case JOT_STATE_IDENTIFIER:
-                    switch(c)
-                    {
-                        case '0': case '1': case '2': case '3': case '4':
-                        case '5': case '6': case '7': case '8': case '9':
-                        case 'a': case 'b': case 'c': case 'd': case 'e':
-                        case 'f': case 'g': case 'h': case 'i': case 'j':
-                        case 'k': case 'l': case 'm': case 'n': case 'o':
-                        case 'p': case 'q': case 'r': case 's': case 't':
-                        case 'u': case 'v': case 'w': case 'x': case 'y':
-                        case 'z': case '_': case 'A': case 'B': case 'C':
-                        case 'D': case 'E': case 'F': case 'G': case 'H':
-                        case 'I': case 'J': case 'K': case 'L': case 'M':
-                        case 'N': case 'O': case 'P': case 'Q': case 'R':
-                        case 'S': case 'T': case 'U': case 'V': case 'W':
-                        case 'X': case 'Y': case 'Z':
-                            /* '0' .. '9' | 'a' .. 'z' | '_' | 'A' .. 'Z' */
-                            jot_ScannerAddTextChar(self, c);
-                            break;
-                        default:
-                            self->state = JOT_STATE_START;
-                            jot_ScannerFlushText(self);
-                            return JOT_TOKEN_IDENTIFIER;
-                    }
+                case JOT_SCAN_PREFIX:
+                    self->text_length = 0;
+                    self->token_start = position + 1;
                     break;
-                case JOT_STATE_HASH:
-                    if(c == '#')
-                    {
-                        /* ## block comment ##*/
-                        self->state = JOT_STATE_HASH_HASH_COMMENT;
-                    }
-                    else
-                    {
-                        /* # line comment */
-                        self->state = JOT_STATE_HASH_COMMENT;
-                    }
+                case JOT_SCAN_DROP_TEXT:
+                    self->text_length = 0;
                     break;
-                case JOT_STATE_HASH_COMMENT:
-                    /* Ignore input (end-of-line handling done elsewhere). */
+                case JOT_SCAN_ESCAPE:
+                    jot_ScannerAddTextChar(self, jot_scan_escapes[c]);
+                    self->token_start = position + 1;
                     break;
-                case JOT_STATE_HASH_HASH_COMMENT:
-                    /* Handle # specially (might be a closing ##), ignore all else. */
-                    if(c == '#')
-                    {
-                        self->state = JOT_STATE_HASH_HASH_COMMENT_HASH;
-                    }
-                    else if(c == JOT_END_OF_STREAM)
-                    {
-                        /* error: expected closing ## but got end-of-file. */
-                        self->state = JOT_STATE_START;
-                    }
+                case JOT_SCAN_DROP_ESCAPE:
+                    /* error: invalid escape sequence (unless it's the x of \x). */
+                    self->token_start = position + 1;
                     break;
-                case JOT_STATE_HASH_HASH_COMMENT_HASH:
-                    if(c == '#')
-                    {
-                        /* ## closes a ## */
-                        self->state = JOT_STATE_START;
-                    }
-                    else if(c == JOT_END_OF_STREAM)
-                    {
-                        /* error: expected closing ## but got end-of-file. */
-                        self->state = JOT_STATE_START;
-                    }
-                    else
-                    {
-                        /* False alarm, return to previous state */
-                        self->state = JOT_STATE_HASH_HASH_COMMENT;
-                    }
+                case JOT_SCAN_HEX_HIGH:
+                    self->intermediate = (char) (jot_HexDigitValue(c) << 4);
+                    self->token_start = position + 1;
                     break;
-                case JOT_STATE_DOT:
-                    switch(c)
-                    {
-                        case '0': case '1': case '2': case '3': case '4':
-                        case '5': case '6': case '7': case '8': case '9':
-                            /* '.' followed by digits, a number */
-                            self->state = JOT_STATE_NUM;
-                            /* Add a decimal point and then the digit */
-                            jot_ScannerAddTextChar(self, '.');
-                            jot_ScannerAddTextChar(self, c);
-                            break;
-                        case '.':
-                            /* '..' */
-                            self->state = JOT_STATE_DOT_DOT;
-                            break;
-                        default:
-                            /* '.' something else */
-                            self->state = JOT_STATE_START;
-                            return JOT_TOKEN_DOT;
-                    }
+                case JOT_SCAN_HEX_LOW:
+                    self->intermediate |= jot_HexDigitValue(c);
+                    jot_ScannerAddTextChar(self, self->intermediate);
+                    self->token_start = position + 1;
                     break;
-                case JOT_STATE_DOT_DOT:
-                    if(c == '.')
+                case JOT_SCAN_QUOTE:
+                    if(c == (unsigned char) self->terminator)
                     {
-                        /* '...' */
                         self->state = JOT_STATE_START;
+                        self->position = position;
+                        self->last_length = self->offset + position + 1 - self->last_offset;
+                        jot_ScannerFlushText(self);
                         self->position++;
-                        return JOT_TOKEN_DOT_DOT_DOT;
-                    }
-                    else
-                    {
-                        /* '..' something else */
-                        self->state = JOT_STATE_START;
-                        return JOT_TOKEN_DOT_DOT;
-                    }
-                    break;
-                case JOT_STATE_LT:
-                    if(c == '=')
-                    {
-                        /* '<=' */
-                        self->state = JOT_STATE_START;
-                        self->position++;
-                        return JOT_TOKEN_CMP_LE;
-                    }
-                    else if(c == '<')
-                    {
-                        /* '<<' */
-                        self->state = JOT_STATE_START;
-                        self->position++;
-                        return JOT_TOKEN_SHL;
-                    }
-                    else
-                    {
-                        /* '<' something else */
-                        self->state = JOT_STATE_START;
-                        return JOT_TOKEN_CMP_LT;
-                    }
-                    break;
-                case JOT_STATE_GT:
-                    if(c == '=')
-                    {
-                        /* '>=' */
-                        self->state = JOT_STATE_START;
-                        self->position++;
-                        return JOT_TOKEN_CMP_GE;
-                    }
-                    else if(c == '>')
-                    {
-                        /* '>>' */
-                        self->state = JOT_STATE_START;
-                        self->position++;
-                        return JOT_TOKEN_SHR;
-                    }
-                    else
-                    {
-                        /* '>' something else */
-                        self->state = JOT_STATE_START;
-                        return JOT_TOKEN_CMP_GT;
-                    }
-                    break;
-                case JOT_STATE_EQ:
-                    if(c == '=')
-                    {
-                        /* '==' */
-                        self->state = JOT_STATE_START;
-                        self->position++;
-                        return JOT_TOKEN_CMP_EQ;
-                    }
-                    else
-                    {
-                        /* '=' something else */
-                        self->state = JOT_STATE_START;
-                        return JOT_TOKEN_ASSIGN;
-                    }
-                    break;
-                case JOT_STATE_ASTERISK:
-                    if(c == '*')
-                    {
-                        /* '**' */
-                        self->state = JOT_STATE_START;
-                        self->position++;
-                        return JOT_TOKEN_EXP;
-                    }
-                    else
-                    {
-                        /* '*' something else */
-                        self->state = JOT_STATE_START;
-                        return JOT_TOKEN_MUL;
-                    }
-                    break;
-                case JOT_STATE_DASH:
-                    if(c == '>')
-                    {
-                        /* '->' */
-                        self->state = JOT_STATE_START;
-                        self->position++;
-                        return JOT_TOKEN_ARROW;
-                    }
-                    else
-                    {
-                        /* '-' something else */
-                        self->state = JOT_STATE_START;
-                        return JOT_TOKEN_SUB;
+                        if(!jot_ScannerCheckString(self))
+                        {
+                            return JOT_TOKEN_ERROR;
+                        }
+                        jot_ScannerInternText(self);
+                        return JOT_TOKEN_STR;
                     }
                     break;
-                case JOT_STATE_EXCLAIM:
-                    if(c == '=')
-                    {
-                        /* '!=' */
-                        self->state = JOT_STATE_START;
-                        self->position++;
-                        return JOT_TOKEN_CMP_NE;
+                /*
+                    Returning without consuming has the effect of letting delimiter characters be read twice
+                    (once to know a token ended, once to start the next token).
+                */
+                case JOT_SCAN_EMIT:
+                    self->state = state;
+                    self->position = position;
+                    self->last_length = self->offset + position - self->last_offset;
+                    self->text_length = 0;
+                    return entry >> JOT_SCAN_TOKEN_SHIFT;
+                case JOT_SCAN_EMIT_NEXT:
+                    self->state = state;
+                    self->position = position + 1;
+                    self->last_length = self->offset + position + 1 - self->last_offset;
+                    return entry >> JOT_SCAN_TOKEN_SHIFT;
+                case JOT_SCAN_EMIT_PUNCT:
+                    self->state = state;
+                    self->position = position + 1;
+                    self->last_offset = self->offset + position;
+                    self->last_length = 1;
+                    return jot_scan_punct[c];
+                case JOT_SCAN_EMIT_TEXT:
+                    self->state = state;
+                    self->position = position;
+                    self->last_length = self->offset + position - self->last_offset;
+                    jot_ScannerFlushText(self);
+                    return jot_ScannerConvertText(self, entry >> JOT_SCAN_TOKEN_SHIFT);
+                case JOT_SCAN_EMIT_IDENTIFIER:
+                    self->state = state;
+                    self->position = position;
+                    self->last_length = self->offset + position - self->last_offset;
+                    jot_ScannerFlushText(self);
+                    if(self->identifier_utf8)
+                    {
+                        /* Keywords are all ASCII. */
+                        self->identifier_utf8 = 0;
+                        self->last_keyword = JOT_KEYWORD_NONE;
+                        if(!jot_Utf8IsIdentifier(self->last_text, self->last_text_length))
+                        {
+                            return JOT_TOKEN_ERROR;
+                        }
+                        jot_ScannerInternText(self);
+                        return JOT_TOKEN_IDENTIFIER;
                     }
-                    else
+                    self->last_keyword = jot_KeywordLookup(self->last_text, self->last_text_length);
+                    if(self->last_keyword != JOT_KEYWORD_NONE)
                     {
-                        /* '!' something else */
-                        self->state = JOT_STATE_START;
-                        return JOT_TOKEN_EXCLAIM;
+                        return JOT_TOKEN_KEYWORD;
                     }
-                    break;
+                    jot_ScannerInternText(self);
+                    return JOT_TOKEN_IDENTIFIER;
                 default:
                     break;
             }
-            
-            if(self->state == JOT_STATE_NEWLINE)
+            position++;
+        }
+        self->state = state;
+        
+        /* The chunk is about to be replaced, so any pending token text has to be copied out. */
+        if((state >= JOT_STATE_ZERO && state <= JOT_STATE_IDENTIFIER)
+            || state == JOT_STATE_DOT)
+        {
+            self->position = position;
+            jot_ScannerSpillText(self);
+        }
+        /* Bad text left in the chunk has to be charged to an unfinished string now, while it's known where it is. */
+        if(jot_ScannerInString(self))
+        {
+            while(self->utf8_error != (size_t) -1 && self->utf8_error < self->last_offset)
             {
-                self->state = self->previous_state;
-                if(self->state == JOT_STATE_HASH
-                    || self->state == JOT_STATE_HASH_COMMENT)
-                {
-                    self->state = JOT_STATE_START;
-                }
-                /* Repeat last character if it wasn't a newline. */
-                if(c != '\n')
-                {
-                    continue;
-                }
+                jot_ScannerFindUtf8Error(self, self->utf8_error - self->offset + 1);
             }
-            else
+            if(self->utf8_error != (size_t) -1)
             {
-                if(c == '\n')
-                {
-                    self->line++;
-                    if(self->state == JOT_STATE_HASH
-                        || self->state == JOT_STATE_HASH_COMMENT)
-                    {
-                        self->state = JOT_STATE_START;
-                    }
-                }
-                else if(c == '\r')
-                {
-                    self->line++;
-                    self->previous_state = self->state;
-                    self->state = JOT_STATE_NEWLINE;
-                }
+                self->string_utf8_error = 1;
             }
-            
-            /*
-                If we didn't return/continue yet, increment position.
-                Returning has the effect of letting delimiter characters be read twice
-                (once to know a token ended, once to start the next token).
-            */
-            self->position++;
         }
-        
         self->position = 0;
+        self->token_start = 0;
+        if(!self->end_of_file)
+        {
+            if(self->lines)
+            {
+                jot_LineIndexAppend(self->lines, self->buffer + self->lines_position, self->buffer_size - self->lines_position);
+                self->lines_position = 0;
+            }
+            self->offset += self->buffer_size;
+        }
         self->buffer = self->source->reader(self->source, &self->buffer_size);
-        if(self->buffer_size == 0)
+        if(self->buffer_size != 0)
+        {
+            jot_ScannerCheckChunk(self);
+        }
+        else
         {   
             /*
                 If we've already seen EOF in the lexer then now we can return it as token.
@@ -933,6 +659,8 @@ jot_Token jot_ScannerNext(jot_Scanner* self)
             */
             if(self->end_of_file)
             {
+                self->last_offset = self->offset;
+                self->last_length = 0;
                 return JOT_TOKEN_EOF;
             }
             else
@@ -942,7 +670,15 @@ jot_Token jot_ScannerNext(jot_Scanner* self)
                     Set the buffer to size 1 so it will read the end-of-stream marker.
                 */
                 self->end_of_file = 1;
+                self->end_state = (jot_ScanState) state;
+                if(self->utf8_carry_length)
+                {
+                    jot_ScannerCarryError(self);
+                }
+                self->utf8_error = (size_t) -1;
+                self->buffer = "";
                 self->buffer_size = 1;
+                classes = jot_scan_eos_classes;
             }
         }
     } while(1);
@@ -950,36 +686,102 @@ jot_Token jot_ScannerNext(jot_Scanner* self)
     return JOT_TOKEN_EOF;
 }
 
-int main(int argc, char** argv)
+jot_TokenBuffer* jot_TokenBufferNew(jot_Allocator* allocator)
 {
-    jot_Token token;
-    jot_Source* source;
-    jot_Scanner* scanner;
+    jot_TokenBuffer* self = jot_Alloc(allocator, JOT_ALLOC_TOKENS, sizeof(jot_TokenBuffer));
+    
+    if(self == NULL)
+    {
+        return NULL;
+    }
+    self->allocator = allocator;
+    self->count = 0;
+    self->capacity = 0;
+    self->kinds = NULL;
+    self->offsets = NULL;
+    self->lengths = NULL;
+    return self;
+}
+
+/* Frees arrays that were allocated together with room for capacity tokens. */
+static void jot_TokenBufferFreeArrays(jot_Allocator* allocator, size_t capacity, uint8_t* kinds, uint32_t* offsets, uint32_t* lengths)
+{
+    jot_Free(allocator, JOT_ALLOC_TOKENS, kinds, capacity);
+    jot_Free(allocator, JOT_ALLOC_TOKENS, offsets, capacity * sizeof(uint32_t));
+    jot_Free(allocator, JOT_ALLOC_TOKENS, lengths, capacity * sizeof(uint32_t));
+}
 
-    source = jot_FileSourceNew("hello.txt");
-    scanner = jot_ScannerNew(source);
-    printf("eof %d\n", JOT_END_OF_STREAM);
-    while(token = jot_ScannerNext(scanner), token != JOT_TOKEN_EOF)
+void jot_TokenBufferFree(jot_TokenBuffer* self)
+{
+    jot_TokenBufferFreeArrays(self->allocator, self->capacity, self->kinds, self->offsets, self->lengths);
+    jot_Free(self->allocator, JOT_ALLOC_TOKENS, self, sizeof(jot_TokenBuffer));
+}
+
+static int jot_TokenBufferGrow(jot_TokenBuffer* self)
+{
+    size_t capacity = self->capacity ? self->capacity * 2 : JOT_TOKEN_BUFFER_MIN_CAPACITY;
+    uint8_t* kinds = jot_Alloc(self->allocator, JOT_ALLOC_TOKENS, capacity);
+    uint32_t* offsets = jot_Alloc(self->allocator, JOT_ALLOC_TOKENS, capacity * sizeof(uint32_t));
+    uint32_t* lengths = jot_Alloc(self->allocator, JOT_ALLOC_TOKENS, capacity * sizeof(uint32_t));
+    
+    /* All three arrays move together, so they always share one capacity. */
+    if(kinds == NULL || offsets == NULL || lengths == NULL)
+    {
+        jot_TokenBufferFreeArrays(self->allocator, capacity, kinds, offsets, lengths);
+        return 0;
+    }
+    /* jot_ScannerTokenizeAll only updates count at the end, so everything is kept, as realloc would. */
+    if(self->capacity > 0)
+    {
+        memcpy(kinds, self->kinds, self->capacity);
+        memcpy(offsets, self->offsets, self->capacity * sizeof(uint32_t));
+        memcpy(lengths, self->lengths, self->capacity * sizeof(uint32_t));
+    }
+    jot_TokenBufferFreeArrays(self->allocator, self->capacity, self->kinds, self->offsets, self->lengths);
+    self->kinds = kinds;
+    self->offsets = offsets;
+    self->lengths = lengths;
+    self->capacity = capacity;
+    return 1;
+}
+
+int jot_TokenBufferReserve(jot_TokenBuffer* self, size_t count)
+{
+    while(self->capacity < count)
     {
-        printf("%d Token: %d %s", scanner->line, token, token_name[token]);
-        /* printf(" [%d %d]", scanner->text_capacity, scanner->last_text_capacity); */
-        switch(token)
+        if(!jot_TokenBufferGrow(self))
         {
-            case JOT_TOKEN_INT:
-            case JOT_TOKEN_HEX:
-            case JOT_TOKEN_BIN:
-            case JOT_TOKEN_NUM:
-            case JOT_TOKEN_STR:
-            case JOT_TOKEN_IDENTIFIER:
-                printf(" -- '");
-                fwrite(scanner->last_text, 1, scanner->last_text_length, stdout);
-                printf("'");
-            default:
-                printf("\n");
+            return 0;
         }
     }
-    jot_ScannerFree(scanner);
-    jot_FileSourceFree(source);
+    return 1;
+}
+
+int jot_ScannerTokenizeAll(jot_Scanner* self, jot_TokenBuffer* tokens)
+{
+    jot_Token token;
+    size_t count = 0;
+    int result = 1;
+    
+    do
+    {
+        token = jot_ScannerNext(self);
+        if(self->last_offset + self->last_length > 0xFFFFFFFFUL
+            || (count == tokens->capacity && !jot_TokenBufferGrow(tokens)))
+        {
+            result = 0;
+            break;
+        }
+        if(token == JOT_TOKEN_KEYWORD)
+        {
+            token = (jot_Token) (JOT_TOKEN_KEYWORD + self->last_keyword - JOT_KEYWORD_AND);
+        }
+        tokens->kinds[count] = (uint8_t) token;
+        tokens->offsets[count] = (uint32_t) self->last_offset;
+        tokens->lengths[count] = (uint32_t) self->last_length;
+        count++;
+    } while(token != JOT_TOKEN_EOF);
     
-    return 0;
+    tokens->count = count;
+    return result && !self->failed;
 }
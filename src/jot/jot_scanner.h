@@ -0,0 +1,347 @@
+/*
+    jot - Lexical Scanner
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#ifndef JOT_SCANNER_H
+#define JOT_SCANNER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "jot_alloc.h"
+#include "jot_lines.h"
+#include "jot_num.h"
+#include "jot_source.h"
+#include "jot_scanskip.h"
+#include "jot_str.h"
+
+typedef enum
+{
+    JOT_STATE_START,
+    JOT_STATE_ZERO,
+    JOT_STATE_INT,
+    JOT_STATE_HEX,
+    JOT_STATE_BIN,
+    JOT_STATE_NUM,
+    JOT_STATE_E_SIGN,
+    JOT_STATE_E_VALUE,
+    JOT_STATE_STR,
+    JOT_STATE_STR_BACKSLASH,
+    JOT_STATE_STR_HEX_HIGH,
+    JOT_STATE_STR_HEX_LOW,
+    JOT_STATE_IDENTIFIER,
+    JOT_STATE_HASH,
+    JOT_STATE_HASH_COMMENT,
+    JOT_STATE_HASH_HASH_COMMENT,
+    JOT_STATE_HASH_HASH_COMMENT_HASH,
+    JOT_STATE_DOT,
+    JOT_STATE_DOT_DOT,
+    JOT_STATE_LT,
+    JOT_STATE_GT,
+    JOT_STATE_EQ,
+    JOT_STATE_ASTERISK,
+    JOT_STATE_DASH,
+    JOT_STATE_EXCLAIM
+} jot_ScanState;
+
+/*
+    Side effects of a scanner transition. The transition table in
+    jot_scantab.h (generated by src/tools/jot_scangen.c) packs the next
+    state, one of these and an optional token into each 16-bit entry.
+*/
+typedef enum
+{
+    JOT_SCAN_NEXT,                  /* Just consume the character. */
+    JOT_SCAN_BEGIN,                 /* Token text starts at this character. */
+    JOT_SCAN_BEGIN_STR,             /* Opening quote, text starts after it. */
+    JOT_SCAN_SKIP,                  /* Leave this character out of the text ('_', '\'). */
+    JOT_SCAN_PREFIX,                /* 0x/0b prefix, text restarts after it. */
+    JOT_SCAN_DROP_TEXT,             /* Pending text turned out not to be needed. */
+    JOT_SCAN_ESCAPE,                /* Single character escape sequence. */
+    JOT_SCAN_DROP_ESCAPE,           /* Escape character that produces no text. */
+    JOT_SCAN_HEX_HIGH,              /* First digit of a \x escape. */
+    JOT_SCAN_HEX_LOW,               /* Second digit of a \x escape. */
+    JOT_SCAN_QUOTE,                 /* Quote inside a string, ends it if it's the terminator. */
+    JOT_SCAN_EMIT,                  /* Return a token, re-read this character next time. */
+    JOT_SCAN_EMIT_NEXT,             /* Return a token that ends with this character. */
+    JOT_SCAN_EMIT_PUNCT,            /* Return the single character token for this character. */
+    JOT_SCAN_EMIT_TEXT,             /* Return a token with text, re-read this character next time. */
+    JOT_SCAN_BEGIN_IDENTIFIER,      /* Identifier starts here, skip the rest of it in bulk. */
+    JOT_SCAN_RUN_SPACE,             /* Skip whitespace, line ends included, in bulk. */
+    JOT_SCAN_RUN_LINE_COMMENT,      /* Skip to the end of the line in bulk. */
+    JOT_SCAN_RUN_BLOCK_COMMENT,     /* Skip to the next '#' in bulk. */
+    JOT_SCAN_RUN_STR,               /* Skip to the next terminator, escape or line end in bulk. */
+    JOT_SCAN_EMIT_IDENTIFIER,       /* Return an identifier or keyword, re-read this character next time. */
+    JOT_SCAN_BEGIN_UTF8_IDENTIFIER, /* Identifier starts here with a non-ASCII character. */
+    JOT_SCAN_UTF8_IDENTIFIER        /* Non-ASCII character inside an identifier. */
+} jot_ScanAction;
+
+enum
+{
+    JOT_SCAN_ACTION_SHIFT = 5,
+    JOT_SCAN_TOKEN_SHIFT = 10,
+    JOT_SCAN_STATE_MASK = (1 << JOT_SCAN_ACTION_SHIFT) - 1,
+    JOT_SCAN_ACTION_MASK = (1 << JOT_SCAN_TOKEN_SHIFT) - (1 << JOT_SCAN_ACTION_SHIFT)
+};
+
+typedef enum
+{
+    JOT_TOKEN_NONE,
+    JOT_TOKEN_EOF,
+    JOT_TOKEN_ERROR,
+    JOT_TOKEN_NUM,
+    JOT_TOKEN_INT,
+    JOT_TOKEN_HEX,
+    JOT_TOKEN_BIN,
+    JOT_TOKEN_STR,
+    JOT_TOKEN_IDENTIFIER,
+    JOT_TOKEN_COLON,
+    JOT_TOKEN_SEMICOLON,
+    JOT_TOKEN_DOT,
+    JOT_TOKEN_DOT_DOT,
+    JOT_TOKEN_DOT_DOT_DOT,
+    JOT_TOKEN_COMMA,
+    JOT_TOKEN_LPAREN,
+    JOT_TOKEN_RPAREN,
+    JOT_TOKEN_LBRACKET,
+    JOT_TOKEN_RBRACKET,
+    JOT_TOKEN_LBRACE,
+    JOT_TOKEN_RBRACE,
+    JOT_TOKEN_ASSIGN,
+    JOT_TOKEN_EXCLAIM,
+    JOT_TOKEN_CMP_EQ,
+    JOT_TOKEN_CMP_LT,
+    JOT_TOKEN_CMP_LE,
+    JOT_TOKEN_CMP_GT,
+    JOT_TOKEN_CMP_GE,
+    JOT_TOKEN_CMP_NE,
+    JOT_TOKEN_ADD,
+    JOT_TOKEN_SUB,
+    JOT_TOKEN_MUL,
+    JOT_TOKEN_DIV,
+    JOT_TOKEN_MOD,
+    JOT_TOKEN_EXP,
+    JOT_TOKEN_AND,
+    JOT_TOKEN_OR,
+    JOT_TOKEN_XOR,
+    JOT_TOKEN_TILDE,
+    JOT_TOKEN_SHL,
+    JOT_TOKEN_SHR,
+    JOT_TOKEN_ARROW,
+    JOT_TOKEN_KEYWORD
+} jot_Token;
+
+extern const char* token_name[];
+
+typedef enum
+{
+    JOT_KEYWORD_NONE,
+    JOT_KEYWORD_AND,
+    JOT_KEYWORD_BREAK,
+    JOT_KEYWORD_CONTINUE,
+    JOT_KEYWORD_DO,
+    JOT_KEYWORD_ELSE,
+    JOT_KEYWORD_ELSEIF,
+    JOT_KEYWORD_END,
+    JOT_KEYWORD_FALSE,
+    JOT_KEYWORD_FOR,
+    JOT_KEYWORD_FUNC,
+    JOT_KEYWORD_IF,
+    JOT_KEYWORD_IN,
+    JOT_KEYWORD_NIL,
+    JOT_KEYWORD_NOT,
+    JOT_KEYWORD_OR,
+    JOT_KEYWORD_REPEAT,
+    JOT_KEYWORD_THEN,
+    JOT_KEYWORD_TRUE,
+    JOT_KEYWORD_UNTIL,
+    JOT_KEYWORD_WHILE,
+    JOT_KEYWORD_VAR
+} jot_Keyword;
+
+typedef struct
+{
+    jot_Allocator* allocator;
+    /*
+        Set once memory for token text has run out. Tokens keep coming, but
+        their text may be cut short from then on.
+    */
+    char failed;
+    
+    jot_Source* source;
+    const jot_ScanSkip* skip;
+    char end_of_file;
+    char terminator;
+    char intermediate;
+    jot_ScanState state;
+    /*
+        The state the source ended in, before end-of-stream was dealt with.
+        Anything but JOT_STATE_START after the last token of a source ending
+        in a newline means it ended inside a block comment.
+    */
+    jot_ScanState end_state;
+    
+    size_t position;
+    size_t buffer_size;
+    const char* buffer;
+    /* Offset of buffer[0] from the start of the source. */
+    size_t offset;
+    
+    /* Position in buffer where the not-yet-copied part of the token begins. */
+    size_t token_start;
+    
+    /* Scratch for escaped text and text that crosses a chunk boundary. */
+    size_t text_length;
+    size_t text_capacity;
+    char* text;
+    
+    size_t last_scratch_capacity;
+    char* last_scratch;
+    
+    /*
+        Text of the most recent token. Points either into the current source
+        chunk (a span, when last_span is set) or into last_scratch, and stays
+        valid until the next call to jot_ScannerNext.
+    */
+    char last_span;
+    size_t last_text_length;
+    const char* last_text;
+    
+    /*
+        Where the last token lies in the source, counting quotes and 0x/0b
+        prefixes, as a byte offset from the start of the source and a length.
+    */
+    size_t last_offset;
+    size_t last_length;
+    
+    /* Which keyword the last JOT_TOKEN_KEYWORD was. */
+    jot_Keyword last_keyword;
+    
+    /* Value of the last JOT_TOKEN_INT, JOT_TOKEN_HEX or JOT_TOKEN_BIN. */
+    int64_t last_int;
+    /* Value of the last JOT_TOKEN_NUM. */
+    double last_num;
+    
+    /*
+        When atoms is set, every identifier and string is interned into it as
+        it's scanned, and last_atom is the atom of the last such token (NULL if
+        the table ran out of memory). The table may be shared between scanners
+        and outlive them; the scanner never frees it.
+    */
+    jot_AtomTable* atoms;
+    const jot_Atom* last_atom;
+    
+    /*
+        Lines aren't tracked while scanning. When lines is set, the scanner
+        appends each chunk of the source to it as it finishes with it, since
+        the text is gone by the time anyone could ask, and jot_ScannerLocate
+        works. Like atoms, it's never freed by the scanner. lines_position
+        is how much of the current chunk has been appended.
+    */
+    jot_LineIndex* lines;
+    size_t lines_position;
+    
+    /*
+        Offset of the first byte of the source that isn't valid UTF-8, or
+        (size_t) -1 if there's been none so far. Bad text in a comment
+        doesn't stop scanning, so this is what to check to reject a source
+        outright. A string with bad text in it comes out as JOT_TOKEN_ERROR,
+        as does an identifier that isn't XID_Start XID_Continue*.
+    */
+    size_t invalid_utf8;
+    
+    /*
+        Each chunk is validated as it's read in. utf8_error is the offset of
+        the next bad byte in it that no string has been checked against yet
+        ((size_t) -1 for none), and utf8_carry holds a sequence cut short by
+        the end of the previous chunk, which started at utf8_carry_offset.
+        string_utf8_error is set when the string being scanned had bad text in
+        an earlier chunk, identifier_utf8 when the identifier being scanned
+        has non-ASCII characters.
+    */
+    size_t utf8_error;
+    size_t utf8_carry_offset;
+    size_t utf8_carry_length;
+    char utf8_carry[3];
+    char string_utf8_error;
+    char identifier_utf8;
+} jot_Scanner;
+
+/*
+    A whole source's worth of tokens, kept as parallel arrays so passes over
+    them stay cache friendly. kinds[i] is a jot_Token, except for keywords,
+    which are stored as JOT_TOKEN_KEYWORD + (keyword - JOT_KEYWORD_AND) so
+    that no extra lookup is needed to tell them apart. Tokens are located by
+    offsets[i] and lengths[i] into the source, as with last_offset and
+    last_length. The last token is always JOT_TOKEN_EOF. Lines and columns
+    come from a jot_LineIndex over the same source, when they're wanted.
+    
+    A buffer can be passed to jot_ScannerTokenizeAll again and again, and only
+    grows its arrays when a source has more tokens than any before it.
+*/
+typedef struct
+{
+    jot_Allocator* allocator;
+    size_t count;
+    size_t capacity;
+    uint8_t* kinds;
+    uint32_t* offsets;
+    uint32_t* lengths;
+} jot_TokenBuffer;
+
+/* Returns NULL if memory ran out. The source is never freed by the scanner. */
+jot_Scanner* jot_ScannerNew(jot_Allocator* allocator, jot_Source* source);
+void jot_ScannerFree(jot_Scanner* self);
+jot_Token jot_ScannerNext(jot_Scanner* self);
+
+/*
+    If the last token's text needed no unescaping and lies within a single
+    source chunk, stores its offset into self->buffer and its length, and
+    returns 1. Otherwise the text only exists in scratch and this returns 0.
+*/
+int jot_ScannerTokenSpan(const jot_Scanner* self, size_t* offset, size_t* length);
+
+/*
+    Finds the line and column of the byte at offset, which can be anywhere
+    up to the end of the last token. Only works if lines was set before
+    scanning began; otherwise both come out as 0.
+*/
+void jot_ScannerLocate(jot_Scanner* self, size_t offset, size_t* line, size_t* column);
+
+/*
+    Scans the rest of the source into tokens, replacing what was there. Returns
+    0 if memory ran out, or if the source is too big for 32-bit offsets.
+*/
+int jot_ScannerTokenizeAll(jot_Scanner* self, jot_TokenBuffer* tokens);
+
+jot_TokenBuffer* jot_TokenBufferNew(jot_Allocator* allocator);
+void jot_TokenBufferFree(jot_TokenBuffer* self);
+/* Makes room for at least count tokens. Returns 0 if memory ran out. */
+int jot_TokenBufferReserve(jot_TokenBuffer* self, size_t count);
+
+/* Returns the keyword spelled by text, or JOT_KEYWORD_NONE. */
+jot_Keyword jot_KeywordLookup(const char* text, size_t length);
+
+#endif
@@ -0,0 +1,309 @@
+/*
+    jot - Parallel Tokenizer
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+
+/*
+    The source is cut into one chunk per thread, each lexed on its own and
+    then stitched back together in order.
+    
+    A chunk can only be lexed on its own if the state it starts in is known.
+    Cutting just after a '\n' narrows that down to two: strings and line
+    comments can't cross a line end, so the previous chunk ends either
+    between tokens (JOT_STATE_START) or inside a ## block comment. Workers
+    first speculate on JOT_STATE_START for every chunk. If some chunk turns
+    out to end inside a block comment, every chunk after it is lexed again
+    in parallel, this time from inside a block comment, since which of the
+    two each one really starts in depends on all the chunks before it. Once
+    both are known for every chunk, stitching just follows the end states
+    along and shifts each chunk's offsets into place.
+*/
+#include <stdlib.h>
+#include <string.h>
+
+#include "jot_scanpar.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define JOT_HAVE_PTHREADS
+#endif
+
+#ifdef JOT_HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
+/* Below this, a chunk isn't worth the cost of a thread. Overridable for testing. */
+#ifndef JOT_SCANPAR_MIN_CHUNK_SIZE
+#define JOT_SCANPAR_MIN_CHUNK_SIZE (1 << 20)
+#endif
+
+enum
+{
+    JOT_SCANPAR_MAX_CHUNKS = 64,
+    
+    /* The two states a chunk can start in. */
+    JOT_SCANPAR_FROM_START = 0,
+    JOT_SCANPAR_FROM_COMMENT = 1
+};
+
+/* The outcome of lexing a chunk from one particular start state. */
+typedef struct
+{
+    jot_TokenBuffer* tokens;
+    jot_ScanState end_state;
+    int result;
+} jot_ScanChunkRun;
+
+typedef struct
+{
+    const char* data;
+    size_t size;
+    
+    /* Which start state to lex from next. */
+    int from;
+    jot_ScanChunkRun runs[2];
+    
+    /* Hands the whole chunk to the scanner in one read. */
+    jot_Source source;
+    size_t consumed;
+    
+    /* Chunks lexed on other threads allocate through a fork of the caller's allocator. */
+    jot_Allocator* allocator;
+    jot_Allocator forked;
+} jot_ScanChunk;
+
+static const char* jot_ScanChunkReader(jot_Source* source, size_t* bytes_read)
+{
+    jot_ScanChunk* chunk = source->handle;
+    
+    *bytes_read = chunk->size - chunk->consumed;
+    chunk->consumed = chunk->size;
+    return chunk->data;
+}
+
+static void jot_ScanChunkLex(jot_ScanChunk* chunk)
+{
+    jot_ScanChunkRun* run = &chunk->runs[chunk->from];
+    jot_Scanner* scanner;
+    
+    if(run->tokens == NULL && (run->tokens = jot_TokenBufferNew(chunk->allocator)) == NULL)
+    {
+        run->result = 0;
+        return;
+    }
+    
+    chunk->source.name = "(chunk)";
+    chunk->source.handle = chunk;
+    chunk->source.reader = jot_ScanChunkReader;
+    chunk->consumed = 0;
+    
+    if((scanner = jot_ScannerNew(chunk->allocator, &chunk->source)) == NULL)
+    {
+        run->result = 0;
+        return;
+    }
+    scanner->state = chunk->from == JOT_SCANPAR_FROM_COMMENT ? JOT_STATE_HASH_HASH_COMMENT : JOT_STATE_START;
+    run->result = jot_ScannerTokenizeAll(scanner, run->tokens);
+    run->end_state = scanner->end_state;
+    jot_ScannerFree(scanner);
+}
+
+#ifdef JOT_HAVE_PTHREADS
+static void* jot_ScanChunkThread(void* chunk)
+{
+    jot_ScanChunkLex(chunk);
+    return NULL;
+}
+#endif
+
+/* Lexes chunks[0 .. count - 1], the first on the calling thread and the rest on threads of their own. */
+static void jot_ScanChunkLexAll(jot_ScanChunk* chunks, size_t count)
+{
+#ifdef JOT_HAVE_PTHREADS
+    pthread_t threads[JOT_SCANPAR_MAX_CHUNKS];
+    char started[JOT_SCANPAR_MAX_CHUNKS];
+#endif
+    size_t i;
+    
+#ifdef JOT_HAVE_PTHREADS
+    for(i = 1; i < count; i++)
+    {
+        started[i] = pthread_create(&threads[i], NULL, jot_ScanChunkThread, &chunks[i]) == 0;
+    }
+#endif
+    jot_ScanChunkLex(&chunks[0]);
+    for(i = 1; i < count; i++)
+    {
+#ifdef JOT_HAVE_PTHREADS
+        if(started[i])
+        {
+            pthread_join(threads[i], NULL);
+            continue;
+        }
+#endif
+        /* No thread to be had, so just do it here. */
+        jot_ScanChunkLex(&chunks[i]);
+    }
+}
+
+/* Appends a run's tokens, minus its end-of-file unless it's the last, moved to where the chunk sits in the whole source. */
+static int jot_ScanChunkAppend(const jot_TokenBuffer* part, size_t offset, jot_TokenBuffer* tokens, int last)
+{
+    size_t count = last ? part->count : part->count - 1;
+    size_t i;
+    
+    if(!jot_TokenBufferReserve(tokens, tokens->count + count))
+    {
+        return 0;
+    }
+    
+    memcpy(tokens->kinds + tokens->count, part->kinds, count);
+    memcpy(tokens->lengths + tokens->count, part->lengths, count * sizeof(uint32_t));
+    for(i = 0; i < count; i++)
+    {
+        tokens->offsets[tokens->count + i] = (uint32_t) (part->offsets[i] + offset);
+    }
+    tokens->count += count;
+    return 1;
+}
+
+int jot_ScannerTokenizeParallel(const char* data, size_t size, unsigned int thread_count, jot_TokenBuffer* tokens)
+{
+    jot_ScanChunk chunks[JOT_SCANPAR_MAX_CHUNKS];
+    const char* line_end;
+    size_t chunk_count;
+    size_t chunk_size;
+    size_t offset;
+    size_t i;
+    int from;
+    int result = 1;
+    
+    if(size > 0xFFFFFFFFUL)
+    {
+        return 0;
+    }
+    
+    chunk_count = thread_count < JOT_SCANPAR_MAX_CHUNKS ? thread_count : JOT_SCANPAR_MAX_CHUNKS;
+    if(chunk_count > size / JOT_SCANPAR_MIN_CHUNK_SIZE)
+    {
+        chunk_count = size / JOT_SCANPAR_MIN_CHUNK_SIZE;
+    }
+    if(chunk_count == 0)
+    {
+        chunk_count = 1;
+    }
+    
+    /* Cut just after the first line end past each even split. Running out of line ends leaves fewer chunks. */
+    chunk_size = size / chunk_count;
+    offset = 0;
+    i = 0;
+    do
+    {
+        chunks[i].data = data + offset;
+        chunks[i].size = size - offset;
+        if(i < chunk_count - 1 && chunk_size < size - offset
+            && (line_end = memchr(data + offset + chunk_size, '\n', size - offset - chunk_size)) != NULL)
+        {
+            chunks[i].size = line_end + 1 - (data + offset);
+        }
+        chunks[i].from = JOT_SCANPAR_FROM_START;
+        chunks[i].runs[JOT_SCANPAR_FROM_START].tokens = i == 0 ? tokens : NULL;
+        chunks[i].runs[JOT_SCANPAR_FROM_COMMENT].tokens = NULL;
+        chunks[i].runs[JOT_SCANPAR_FROM_COMMENT].result = 0;
+        chunks[i].allocator = tokens->allocator;
+        if(i > 0 && tokens->allocator != NULL)
+        {
+            jot_AllocatorFork(tokens->allocator, &chunks[i].forked);
+            chunks[i].allocator = &chunks[i].forked;
+        }
+        offset += chunks[i++].size;
+    } while(offset < size);
+    chunk_count = i;
+    
+    /* Pick the skip routines before any threads race to. */
+    jot_ScanSkipGet();
+    jot_ScanChunkLexAll(chunks, chunk_count);
+    
+    /* Find the first chunk that really starts inside a block comment, and speculate on everything from there. */
+    for(i = 1; i < chunk_count; i++)
+    {
+        if(chunks[i - 1].runs[JOT_SCANPAR_FROM_START].end_state != JOT_STATE_START)
+        {
+            break;
+        }
+    }
+    if(i < chunk_count)
+    {
+        size_t first = i;
+        for(i = first; i < chunk_count; i++)
+        {
+            chunks[i].from = JOT_SCANPAR_FROM_COMMENT;
+        }
+        jot_ScanChunkLexAll(chunks + first, chunk_count - first);
+    }
+    
+    /*
+        The first chunk was lexed straight into tokens, from the right state.
+        The rest get appended, each from whichever run started in the state
+        the chunk before it really ended in.
+    */
+    result = chunks[0].runs[JOT_SCANPAR_FROM_START].result;
+    if(result && chunk_count > 1)
+    {
+        /* Drop the first chunk's end-of-file. */
+        tokens->count--;
+    }
+    from = chunks[0].runs[JOT_SCANPAR_FROM_START].end_state == JOT_STATE_START ? JOT_SCANPAR_FROM_START : JOT_SCANPAR_FROM_COMMENT;
+    offset = chunks[0].size;
+    for(i = 1; i < chunk_count && result; i++)
+    {
+        result = chunks[i].runs[from].result
+            && jot_ScanChunkAppend(chunks[i].runs[from].tokens, offset, tokens, i == chunk_count - 1);
+        from = chunks[i].runs[from].end_state == JOT_STATE_START ? JOT_SCANPAR_FROM_START : JOT_SCANPAR_FROM_COMMENT;
+        offset += chunks[i].size;
+    }
+    
+    for(i = 1; i < chunk_count; i++)
+    {
+        if(chunks[i].runs[JOT_SCANPAR_FROM_START].tokens != NULL)
+        {
+            jot_TokenBufferFree(chunks[i].runs[JOT_SCANPAR_FROM_START].tokens);
+        }
+    }
+    for(i = 0; i < chunk_count; i++)
+    {
+        if(chunks[i].runs[JOT_SCANPAR_FROM_COMMENT].tokens != NULL)
+        {
+            jot_TokenBufferFree(chunks[i].runs[JOT_SCANPAR_FROM_COMMENT].tokens);
+        }
+    }
+    for(i = 1; i < chunk_count; i++)
+    {
+        if(chunks[i].allocator != tokens->allocator)
+        {
+            jot_AllocatorJoin(tokens->allocator, chunks[i].allocator);
+        }
+    }
+    return result;
+}
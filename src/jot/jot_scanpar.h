@@ -0,0 +1,47 @@
+/*
+    jot - Parallel Tokenizer
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#ifndef JOT_SCANPAR_H
+#define JOT_SCANPAR_H
+
+#include <stddef.h>
+
+#include "jot_scanner.h"
+
+/*
+    Tokenizes size bytes at data into tokens, exactly as jot_ScannerTokenizeAll
+    would, but splits the work over up to thread_count threads. Sources too
+    small to be worth splitting are scanned on the calling thread. Returns 0
+    if memory ran out, or if the source is too big for 32-bit offsets.
+    
+    Everything is allocated through tokens->allocator, from several threads
+    at once; see jot_AllocatorFork.
+    
+    Without pthreads (JOT_HAVE_PTHREADS), everything runs on the calling thread.
+*/
+int jot_ScannerTokenizeParallel(const char* data, size_t size, unsigned int thread_count, jot_TokenBuffer* tokens);
+
+#endif
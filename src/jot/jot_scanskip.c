@@ -0,0 +1,599 @@
+/*
+    jot - Scanner Run Skipping
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#include <stddef.h>
+
+#include "jot_scanskip.h"
+
+#if !defined(JOT_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define JOT_SCANSKIP_X86
+#include <immintrin.h>
+#endif
+
+static size_t ScalarSpace(const char* data, size_t length)
+{
+    size_t i;
+    for(i = 0; i < length && (data[i] == ' ' || data[i] == '\t' || data[i] == '\r' || data[i] == '\n'); i++)
+    {
+    }
+    return i;
+}
+
+static int IsIdentifierChar(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+static size_t ScalarIdentifier(const char* data, size_t length)
+{
+    size_t i;
+    for(i = 0; i < length && IsIdentifierChar(data[i]); i++)
+    {
+    }
+    return i;
+}
+
+static size_t ScalarLineComment(const char* data, size_t length)
+{
+    size_t i;
+    for(i = 0; i < length && data[i] != '\r' && data[i] != '\n'; i++)
+    {
+    }
+    return i;
+}
+
+static size_t ScalarBlockComment(const char* data, size_t length)
+{
+    size_t i;
+    for(i = 0; i < length && data[i] != '#'; i++)
+    {
+    }
+    return i;
+}
+
+static size_t ScalarString(const char* data, size_t length, char terminator)
+{
+    size_t i;
+    for(i = 0; i < length; i++)
+    {
+        char c = data[i];
+        if(c == terminator || c == '\\' || c == '\r' || c == '\n')
+        {
+            break;
+        }
+    }
+    return i;
+}
+
+/* Length of the valid UTF-8 sequence at p, or 0 if it's invalid or cut short. */
+static size_t Utf8SequenceLength(const unsigned char* p, size_t length)
+{
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;
+    size_t count;
+    size_t i;
+    
+    if(p[0] < 0x80)
+    {
+        return 1;
+    }
+    else if(p[0] >= 0xC2 && p[0] <= 0xDF)
+    {
+        count = 2;
+    }
+    else if(p[0] >= 0xE0 && p[0] <= 0xEF)
+    {
+        /* Overlong forms and surrogates. */
+        count = 3;
+        low = p[0] == 0xE0 ? 0xA0 : 0x80;
+        high = p[0] == 0xED ? 0x9F : 0xBF;
+    }
+    else if(p[0] >= 0xF0 && p[0] <= 0xF4)
+    {
+        /* Overlong forms and anything past U+10FFFF. */
+        count = 4;
+        low = p[0] == 0xF0 ? 0x90 : 0x80;
+        high = p[0] == 0xF4 ? 0x8F : 0xBF;
+    }
+    else
+    {
+        return 0;
+    }
+    if(length < count || p[1] < low || p[1] > high)
+    {
+        return 0;
+    }
+    for(i = 2; i < count; i++)
+    {
+        if((p[i] & 0xC0) != 0x80)
+        {
+            return 0;
+        }
+    }
+    return count;
+}
+
+static size_t ScalarUtf8(const char* data, size_t length)
+{
+    const unsigned char* p = (const unsigned char*) data;
+    size_t i = 0;
+    size_t count;
+    while(i < length)
+    {
+        if(p[i] < 0x80)
+        {
+            i++;
+        }
+        else if((count = Utf8SequenceLength(p + i, length - i)) != 0)
+        {
+            i += count;
+        }
+        else
+        {
+            break;
+        }
+    }
+    return i;
+}
+
+static const jot_ScanSkip scalar_skip = {
+    "scalar",
+    ScalarSpace,
+    ScalarIdentifier,
+    ScalarLineComment,
+    ScalarBlockComment,
+    ScalarString,
+    ScalarUtf8
+};
+
+#ifdef JOT_SCANSKIP_X86
+/*
+    Each SIMD version compares a whole vector at once and builds a bitmask of
+    the bytes that end the run; the run length is the index of the lowest set
+    bit. Whatever doesn't fill a whole vector is left to the scalar version,
+    so nothing is ever read past the end of the data.
+*/
+#define JOT_SSE2 __attribute__((target("sse2")))
+#define JOT_AVX2 __attribute__((target("avx2")))
+
+JOT_SSE2 static size_t Sse2Space(const char* data, size_t length)
+{
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i lf = _mm_set1_epi8('\n');
+    size_t i;
+    for(i = 0; i + 16 <= length; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*) (data + i));
+        unsigned int stop = ~_mm_movemask_epi8(_mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)),
+            _mm_or_si128(_mm_cmpeq_epi8(v, cr), _mm_cmpeq_epi8(v, lf)))) & 0xFFFF;
+        if(stop)
+        {
+            return i + __builtin_ctz(stop);
+        }
+    }
+    return i + ScalarSpace(data + i, length - i);
+}
+
+/*
+    Bytes >= 0x80 compare as negative, so they fall outside every range.
+    Or-ing in 0x20 folds upper case onto lower case without pulling in any
+    other byte that lands in 'a' .. 'z'.
+*/
+JOT_SSE2 static __m128i Sse2IdentifierMask(__m128i v)
+{
+    __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+    __m128i alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+    __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+    __m128i underscore = _mm_cmpeq_epi8(v, _mm_set1_epi8('_'));
+    return _mm_or_si128(_mm_or_si128(alpha, digit), underscore);
+}
+
+JOT_SSE2 static size_t Sse2Identifier(const char* data, size_t length)
+{
+    size_t i;
+    for(i = 0; i + 16 <= length; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*) (data + i));
+        unsigned int stop = ~_mm_movemask_epi8(Sse2IdentifierMask(v)) & 0xFFFF;
+        if(stop)
+        {
+            return i + __builtin_ctz(stop);
+        }
+    }
+    return i + ScalarIdentifier(data + i, length - i);
+}
+
+JOT_SSE2 static size_t Sse2LineComment(const char* data, size_t length)
+{
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i lf = _mm_set1_epi8('\n');
+    size_t i;
+    for(i = 0; i + 16 <= length; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*) (data + i));
+        unsigned int stop = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, cr), _mm_cmpeq_epi8(v, lf)));
+        if(stop)
+        {
+            return i + __builtin_ctz(stop);
+        }
+    }
+    return i + ScalarLineComment(data + i, length - i);
+}
+
+JOT_SSE2 static size_t Sse2BlockComment(const char* data, size_t length)
+{
+    const __m128i hash = _mm_set1_epi8('#');
+    size_t i;
+    for(i = 0; i + 16 <= length; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*) (data + i));
+        unsigned int stop = _mm_movemask_epi8(_mm_cmpeq_epi8(v, hash));
+        if(stop)
+        {
+            return i + __builtin_ctz(stop);
+        }
+    }
+    return i + ScalarBlockComment(data + i, length - i);
+}
+
+JOT_SSE2 static size_t Sse2String(const char* data, size_t length, char terminator)
+{
+    const __m128i quote = _mm_set1_epi8(terminator);
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i lf = _mm_set1_epi8('\n');
+    size_t i;
+    for(i = 0; i + 16 <= length; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*) (data + i));
+        unsigned int stop = _mm_movemask_epi8(_mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+            _mm_or_si128(_mm_cmpeq_epi8(v, cr), _mm_cmpeq_epi8(v, lf))));
+        if(stop)
+        {
+            return i + __builtin_ctz(stop);
+        }
+    }
+    return i + ScalarString(data + i, length - i, terminator);
+}
+
+/*
+    SSE2 has no byte shuffle to do table lookups with, so this only goes
+    wide over ASCII. A vector with anything else in it is checked a sequence
+    at a time, which can run a few bytes into the next vector.
+*/
+JOT_SSE2 static size_t Sse2Utf8(const char* data, size_t length)
+{
+    const unsigned char* p = (const unsigned char*) data;
+    size_t i = 0;
+    size_t end;
+    size_t count;
+    while(i + 16 <= length)
+    {
+        if(!_mm_movemask_epi8(_mm_loadu_si128((const __m128i*) (data + i))))
+        {
+            i += 16;
+            continue;
+        }
+        for(end = i + 16; i < end; i += count)
+        {
+            if((count = Utf8SequenceLength(p + i, length - i)) == 0)
+            {
+                return i;
+            }
+        }
+    }
+    return i + ScalarUtf8(data + i, length - i);
+}
+
+static const jot_ScanSkip sse2_skip = {
+    "sse2",
+    Sse2Space,
+    Sse2Identifier,
+    Sse2LineComment,
+    Sse2BlockComment,
+    Sse2String,
+    Sse2Utf8
+};
+
+JOT_AVX2 static size_t Avx2Space(const char* data, size_t length)
+{
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i cr = _mm256_set1_epi8('\r');
+    const __m256i lf = _mm256_set1_epi8('\n');
+    size_t i;
+    for(i = 0; i + 32 <= length; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (data + i));
+        unsigned int stop = ~(unsigned int) _mm256_movemask_epi8(_mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(v, tab)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, cr), _mm256_cmpeq_epi8(v, lf))));
+        if(stop)
+        {
+            return i + __builtin_ctz(stop);
+        }
+    }
+    return i + Sse2Space(data + i, length - i);
+}
+
+JOT_AVX2 static size_t Avx2Identifier(const char* data, size_t length)
+{
+    size_t i;
+    for(i = 0; i + 32 <= length; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (data + i));
+        __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+        __m256i alpha = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), lower));
+        __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), v));
+        __m256i underscore = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_'));
+        unsigned int stop = ~(unsigned int) _mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(alpha, digit), underscore));
+        if(stop)
+        {
+            return i + __builtin_ctz(stop);
+        }
+    }
+    return i + Sse2Identifier(data + i, length - i);
+}
+
+JOT_AVX2 static size_t Avx2LineComment(const char* data, size_t length)
+{
+    const __m256i cr = _mm256_set1_epi8('\r');
+    const __m256i lf = _mm256_set1_epi8('\n');
+    size_t i;
+    for(i = 0; i + 32 <= length; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (data + i));
+        unsigned int stop = (unsigned int) _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, cr), _mm256_cmpeq_epi8(v, lf)));
+        if(stop)
+        {
+            return i + __builtin_ctz(stop);
+        }
+    }
+    return i + Sse2LineComment(data + i, length - i);
+}
+
+JOT_AVX2 static size_t Avx2BlockComment(const char* data, size_t length)
+{
+    const __m256i hash = _mm256_set1_epi8('#');
+    size_t i;
+    for(i = 0; i + 32 <= length; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (data + i));
+        unsigned int stop = (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, hash));
+        if(stop)
+        {
+            return i + __builtin_ctz(stop);
+        }
+    }
+    return i + Sse2BlockComment(data + i, length - i);
+}
+
+JOT_AVX2 static size_t Avx2String(const char* data, size_t length, char terminator)
+{
+    const __m256i quote = _mm256_set1_epi8(terminator);
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i cr = _mm256_set1_epi8('\r');
+    const __m256i lf = _mm256_set1_epi8('\n');
+    size_t i;
+    for(i = 0; i + 32 <= length; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (data + i));
+        unsigned int stop = (unsigned int) _mm256_movemask_epi8(_mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, cr), _mm256_cmpeq_epi8(v, lf))));
+        if(stop)
+        {
+            return i + __builtin_ctz(stop);
+        }
+    }
+    return i + Sse2String(data + i, length - i, terminator);
+}
+
+/*
+    Keiser and Lemire's lookup algorithm ("Validating UTF-8 in less than one
+    instruction per byte"). Nearly every error shows up in the first two
+    bytes of a sequence, so each byte is classified by three 16-entry tables,
+    indexed by the high and low nibbles of the byte before it and the high
+    nibble of the byte itself, and and-ing the three together leaves a bit
+    set only where some error applies. What's left over is that the third
+    and fourth bytes of long sequences have to be continuations, which is
+    checked against the bytes two and three back.
+    
+    This only says whether a vector holds an error, not where. On the first
+    one, the sequence it might belong to is found by backing up over at most
+    three bytes, and the exact position is left to the SSE2 version, as is
+    whatever doesn't fill a whole vector.
+*/
+enum
+{
+    UTF8_TOO_SHORT = 1 << 0,      /* A lead not followed by a continuation. */
+    UTF8_TOO_LONG = 1 << 1,       /* A continuation not following a lead. */
+    UTF8_OVERLONG_3 = 1 << 2,
+    UTF8_TOO_LARGE = 1 << 3,
+    UTF8_SURROGATE = 1 << 4,
+    UTF8_OVERLONG_2 = 1 << 5,
+    UTF8_TOO_LARGE_1000 = 1 << 6,
+    UTF8_OVERLONG_4 = 1 << 6,
+    UTF8_TWO_CONTS = 1 << 7,      /* Two continuations in a row, only fine in long sequences. */
+    UTF8_CARRY = UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS
+};
+
+/* The bytes n places before each byte of input, reaching back into the previous vector. */
+#define JOT_AVX2_PREVIOUS(input, previous, n) \
+    _mm256_alignr_epi8((input), _mm256_permute2x128_si256((previous), (input), 0x21), 16 - (n))
+
+static const unsigned char utf8_byte_1_high[16] = {
+    UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+    UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+    UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+    UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+    UTF8_TOO_SHORT,
+    UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+    UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4
+};
+
+static const unsigned char utf8_byte_1_low[16] = {
+    UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4,
+    UTF8_CARRY | UTF8_OVERLONG_2,
+    UTF8_CARRY,
+    UTF8_CARRY,
+    UTF8_CARRY | UTF8_TOO_LARGE,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000
+};
+
+static const unsigned char utf8_byte_2_high[16] = {
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE,
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT
+};
+
+/* The same 16 entries in both halves, since the byte shuffle only looks within each one. */
+#define JOT_AVX2_TABLE(table) _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) (table)))
+
+JOT_AVX2 static __m256i Avx2Utf8Errors(__m256i input, __m256i previous)
+{
+    const __m256i byte_1_high = JOT_AVX2_TABLE(utf8_byte_1_high);
+    const __m256i byte_1_low = JOT_AVX2_TABLE(utf8_byte_1_low);
+    const __m256i byte_2_high = JOT_AVX2_TABLE(utf8_byte_2_high);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i previous_1 = JOT_AVX2_PREVIOUS(input, previous, 1);
+    __m256i special = _mm256_and_si256(
+        _mm256_and_si256(
+            _mm256_shuffle_epi8(byte_1_high, _mm256_and_si256(_mm256_srli_epi16(previous_1, 4), nibble)),
+            _mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(previous_1, nibble))),
+        _mm256_shuffle_epi8(byte_2_high, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+    /* Saturating subtraction leaves the top bit set only for bytes >= 0xE0 and >= 0xF0 respectively. */
+    __m256i third = _mm256_subs_epu8(JOT_AVX2_PREVIOUS(input, previous, 2), _mm256_set1_epi8(0xE0 - 0x80));
+    __m256i fourth = _mm256_subs_epu8(JOT_AVX2_PREVIOUS(input, previous, 3), _mm256_set1_epi8((char) (0xF0 - 0x80)));
+    __m256i must_be_continuation = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char) 0x80));
+    return _mm256_xor_si256(must_be_continuation, special);
+}
+
+#undef JOT_AVX2_TABLE
+#undef JOT_AVX2_PREVIOUS
+
+JOT_AVX2 static size_t Avx2Utf8(const char* data, size_t length)
+{
+    /* A lead this close to the end of a vector needs bytes from the next one. */
+    const __m256i incomplete_limit = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char) (0xF0 - 1), (char) (0xE0 - 1), (char) (0xC0 - 1));
+    const unsigned char* p = (const unsigned char*) data;
+    __m256i previous = _mm256_setzero_si256();
+    int incomplete = 0;
+    size_t i;
+    size_t start;
+    for(i = 0; i + 32 <= length; i += 32)
+    {
+        __m256i input = _mm256_loadu_si256((const __m256i*) (data + i));
+        __m256i errors;
+        __m256i leads;
+        if(!_mm256_movemask_epi8(input) && !incomplete)
+        {
+            previous = input;
+            continue;
+        }
+        errors = Avx2Utf8Errors(input, previous);
+        if(!_mm256_testz_si256(errors, errors))
+        {
+            break;
+        }
+        leads = _mm256_subs_epu8(input, incomplete_limit);
+        incomplete = !_mm256_testz_si256(leads, leads);
+        previous = input;
+    }
+    
+    /* Everything before i is valid except maybe a sequence that runs into it, so start over from its lead. */
+    start = i;
+    while(start > 0 && i - start < 3 && (p[start - 1] & 0xC0) == 0x80)
+    {
+        start--;
+    }
+    if(start > 0 && p[start - 1] >= 0xC0 && i - start < (p[start - 1] >= 0xF0 ? 3u : p[start - 1] >= 0xE0 ? 2u : 1u))
+    {
+        start--;
+    }
+    else
+    {
+        start = i;
+    }
+    return start + Sse2Utf8(data + start, length - start);
+}
+
+static const jot_ScanSkip avx2_skip = {
+    "avx2",
+    Avx2Space,
+    Avx2Identifier,
+    Avx2LineComment,
+    Avx2BlockComment,
+    Avx2String,
+    Avx2Utf8
+};
+#endif
+
+static const jot_ScanSkip* selected_skip = NULL;
+
+const jot_ScanSkip* jot_ScanSkipGet(void)
+{
+    if(selected_skip == NULL)
+    {
+        /* Racing threads all pick the same table, so no locking needed. */
+#ifdef JOT_SCANSKIP_X86
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2"))
+        {
+            selected_skip = &avx2_skip;
+        }
+        else if(__builtin_cpu_supports("sse2"))
+        {
+            selected_skip = &sse2_skip;
+        }
+        else
+#endif
+        {
+            selected_skip = &scalar_skip;
+        }
+    }
+    return selected_skip;
+}
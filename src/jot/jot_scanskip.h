@@ -0,0 +1,64 @@
+/*
+    jot - Scanner Run Skipping
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#ifndef JOT_SCANSKIP_H
+#define JOT_SCANSKIP_H
+
+#include <stddef.h>
+
+/*
+    Bulk skipping for the long runs that make up most source text. Each
+    function returns how many bytes at the start of data (at most length)
+    belong to the run, so the scanner can jump straight past them.
+*/
+typedef struct
+{
+    const char* name;
+    /* ' ', '\t', '\r' and '\n' */
+    size_t (*space)(const char* data, size_t length);
+    /* 'a' .. 'z' | 'A' .. 'Z' | '0' .. '9' | '_' */
+    size_t (*identifier)(const char* data, size_t length);
+    /* Anything up to a '\r' or '\n'. */
+    size_t (*line_comment)(const char* data, size_t length);
+    /* Anything up to a '#'. */
+    size_t (*block_comment)(const char* data, size_t length);
+    /* Anything up to the terminator, a '\\', '\r' or '\n'. */
+    size_t (*string)(const char* data, size_t length, char terminator);
+    /*
+        Valid UTF-8, stopping at the first sequence that's invalid or cut
+        short by the end of the data. Unlike the others this is meant to run
+        over whole chunks, so it's mostly about getting through ASCII fast.
+    */
+    size_t (*utf8)(const char* data, size_t length);
+} jot_ScanSkip;
+
+/*
+    Picks the widest implementation the CPU supports (AVX2, SSE2, then plain C)
+    on first use. Define JOT_NO_SIMD to always use plain C.
+*/
+const jot_ScanSkip* jot_ScanSkipGet(void);
+
+#endif
@@ -0,0 +1,303 @@
+/* Generated by src/tools/jot_scangen.c -- do not edit. */
+#ifndef JOT_SCANTAB_H
+#define JOT_SCANTAB_H
+
+enum
+{
+    JOT_SCAN_CLASS_EOS = 27,
+    JOT_SCAN_CLASS_COUNT = 28,
+    JOT_SCAN_STATE_COUNT = 25,
+    JOT_SCAN_KEYWORD_SLOTS = 64,
+    JOT_SCAN_KEYWORD_A = 3,
+    JOT_SCAN_KEYWORD_B = 13,
+    JOT_SCAN_KEYWORD_MIN_LENGTH = 2,
+    JOT_SCAN_KEYWORD_MAX_LENGTH = 8
+};
+
+static const unsigned char jot_scan_classes[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   1,   2,   0,   0,   2,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      1,  23,  14,  16,   0,  25,  25,  14,  25,  25,  21,  24,  25,  22,  17,  25,
+      3,   4,   5,   5,   5,   5,   5,   5,   5,   5,  25,  25,  18,  20,  19,   0,
+      0,   6,   6,   6,   6,   9,   6,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+     12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  25,  15,  25,  25,  13,
+      0,   7,   8,   6,   6,   9,   7,  12,  12,  12,  12,  12,  12,  12,  10,  12,
+     12,  12,  10,  12,  10,  12,  10,  12,  11,  12,  12,  25,  25,  25,  25,   0,
+     26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,
+     26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,
+     26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,
+     26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,
+     26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,
+     26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,
+     26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,
+     26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26
+};
+
+/* Stands in for jot_scan_classes once the source is exhausted. */
+static const unsigned char jot_scan_eos_classes[256] = {
+     27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,
+     27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,
+     27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,
+     27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,
+     27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,
+     27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,
+     27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,
+     27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,
+     27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,
+     27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,
+     27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,
+     27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,
+     27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,
+     27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,
+     27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,
+     27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27,  27
+};
+
+static const unsigned char jot_scan_escapes[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,  34,   0,   0,   0,   0,  39,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  92,   0,   0,   0,
+      0,   7,   8,   0,   0,   0,  12,   0,   0,   0,   0,   0,   0,   0,  10,   0,
+      0,   0,  13,   0,   9,   0,  11,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0
+};
+
+static const unsigned char jot_scan_punct[256] = {
+      2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,
+      2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,
+      2,   2,   2,   2,   2,  33,  35,   2,  15,  16,   2,  29,  14,   2,   2,  32,
+      2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   9,  10,   2,   2,   2,   2,
+      2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,
+      2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,  17,   2,  18,  37,   2,
+      2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,
+      2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,  19,  36,  20,  38,   2,
+      2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,
+      2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,
+      2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,
+      2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,
+      2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,
+      2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,
+      2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,
+      2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2
+};
+
+/* next state | action << 5 | token << 10, by state then class:
+
+     0 other,  1 space,  2 line end,  3 zero,  4 one,  5 digit
+     6 hex letter,  7 hex escape,  8 b,  9 e, 10 escape, 11 x
+    12 letter, 13 underscore, 14 quote, 15 backslash, 16 hash, 17 dot
+    18 lt, 19 gt, 20 eq, 21 asterisk, 22 dash, 23 exclaim
+    24 plus, 25 punct, 26 utf8, 27 eos
+*/
+static const unsigned short jot_scan_transitions[25][28] = {
+    /* START */
+    {0x01A0, 0x0200, 0x0200, 0x0021, 0x0022, 0x0022, 0x01EC, 0x01EC,
+     0x01EC, 0x01EC, 0x01EC, 0x01EC, 0x01EC, 0x01EC, 0x0048, 0x01A0,
+     0x000D, 0x0031, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037, 0x0038,
+     0x01A0, 0x01A0, 0x02AC, 0x0000},
+    /* ZERO */
+    {0x11C0, 0x11C0, 0x11C0, 0x0002, 0x0002, 0x0002, 0x11C0, 0x11C0,
+     0x0084, 0x0006, 0x11C0, 0x0083, 0x11C0, 0x0062, 0x11C0, 0x11C0,
+     0x11C0, 0x0005, 0x11C0, 0x11C0, 0x11C0, 0x11C0, 0x11C0, 0x11C0,
+     0x11C0, 0x11C0, 0x11C0, 0x11C0},
+    /* INT */
+    {0x11C0, 0x11C0, 0x11C0, 0x0002, 0x0002, 0x0002, 0x11C0, 0x11C0,
+     0x11C0, 0x0006, 0x11C0, 0x11C0, 0x11C0, 0x0062, 0x11C0, 0x11C0,
+     0x11C0, 0x0005, 0x11C0, 0x11C0, 0x11C0, 0x11C0, 0x11C0, 0x11C0,
+     0x11C0, 0x11C0, 0x11C0, 0x11C0},
+    /* HEX */
+    {0x15C0, 0x15C0, 0x15C0, 0x0003, 0x0003, 0x0003, 0x0003, 0x0003,
+     0x0003, 0x0003, 0x15C0, 0x15C0, 0x15C0, 0x0063, 0x15C0, 0x15C0,
+     0x15C0, 0x15C0, 0x15C0, 0x15C0, 0x15C0, 0x15C0, 0x15C0, 0x15C0,
+     0x15C0, 0x15C0, 0x15C0, 0x15C0},
+    /* BIN */
+    {0x19C0, 0x19C0, 0x19C0, 0x0004, 0x0004, 0x19C0, 0x19C0, 0x19C0,
+     0x19C0, 0x19C0, 0x19C0, 0x19C0, 0x19C0, 0x0064, 0x19C0, 0x19C0,
+     0x19C0, 0x19C0, 0x19C0, 0x19C0, 0x19C0, 0x19C0, 0x19C0, 0x19C0,
+     0x19C0, 0x19C0, 0x19C0, 0x19C0},
+    /* NUM */
+    {0x0DC0, 0x0DC0, 0x0DC0, 0x0005, 0x0005, 0x0005, 0x0DC0, 0x0DC0,
+     0x0DC0, 0x0006, 0x0DC0, 0x0DC0, 0x0DC0, 0x0065, 0x0DC0, 0x0DC0,
+     0x0DC0, 0x0DC0, 0x0DC0, 0x0DC0, 0x0DC0, 0x0DC0, 0x0DC0, 0x0DC0,
+     0x0DC0, 0x0DC0, 0x0DC0, 0x0DC0},
+    /* E_SIGN */
+    {0x0DC0, 0x0DC0, 0x0DC0, 0x0007, 0x0007, 0x0007, 0x0DC0, 0x0DC0,
+     0x0DC0, 0x0DC0, 0x0DC0, 0x0DC0, 0x0DC0, 0x0067, 0x0DC0, 0x0DC0,
+     0x0DC0, 0x0DC0, 0x0DC0, 0x0DC0, 0x0DC0, 0x0DC0, 0x0007, 0x0DC0,
+     0x0007, 0x0DC0, 0x0DC0, 0x0DC0},
+    /* E_VALUE */
+    {0x0DC0, 0x0DC0, 0x0DC0, 0x0007, 0x0007, 0x0007, 0x0DC0, 0x0DC0,
+     0x0DC0, 0x0DC0, 0x0DC0, 0x0DC0, 0x0DC0, 0x0067, 0x0DC0, 0x0DC0,
+     0x0DC0, 0x0DC0, 0x0DC0, 0x0DC0, 0x0DC0, 0x0DC0, 0x0DC0, 0x0DC0,
+     0x0DC0, 0x0DC0, 0x0DC0, 0x0DC0},
+    /* STR */
+    {0x0268, 0x0268, 0x1DC0, 0x0268, 0x0268, 0x0268, 0x0268, 0x0268,
+     0x0268, 0x0268, 0x0268, 0x0268, 0x0268, 0x0268, 0x0148, 0x0069,
+     0x0268, 0x0268, 0x0268, 0x0268, 0x0268, 0x0268, 0x0268, 0x0268,
+     0x0268, 0x0268, 0x0268, 0x1DC0},
+    /* STR_BACKSLASH */
+    {0x00E8, 0x00E8, 0x1DC0, 0x00E8, 0x00E8, 0x00E8, 0x00E8, 0x00C8,
+     0x00C8, 0x00E8, 0x00C8, 0x00EA, 0x00E8, 0x00E8, 0x00C8, 0x00C8,
+     0x00E8, 0x00E8, 0x00E8, 0x00E8, 0x00E8, 0x00E8, 0x00E8, 0x00E8,
+     0x00E8, 0x00E8, 0x0008, 0x1DC0},
+    /* STR_HEX_HIGH */
+    {0x00E8, 0x00E8, 0x1DC0, 0x010B, 0x010B, 0x010B, 0x010B, 0x010B,
+     0x010B, 0x010B, 0x00E8, 0x00E8, 0x00E8, 0x00E8, 0x00E8, 0x00E8,
+     0x00E8, 0x00E8, 0x00E8, 0x00E8, 0x00E8, 0x00E8, 0x00E8, 0x00E8,
+     0x00E8, 0x00E8, 0x0008, 0x1DC0},
+    /* STR_HEX_LOW */
+    {0x00E8, 0x00E8, 0x1DC0, 0x0128, 0x0128, 0x0128, 0x0128, 0x0128,
+     0x0128, 0x0128, 0x00E8, 0x00E8, 0x00E8, 0x00E8, 0x00E8, 0x00E8,
+     0x00E8, 0x00E8, 0x00E8, 0x00E8, 0x00E8, 0x00E8, 0x00E8, 0x00E8,
+     0x00E8, 0x00E8, 0x0008, 0x1DC0},
+    /* IDENTIFIER */
+    {0x0280, 0x0280, 0x0280, 0x000C, 0x000C, 0x000C, 0x000C, 0x000C,
+     0x000C, 0x000C, 0x000C, 0x000C, 0x000C, 0x000C, 0x0280, 0x0280,
+     0x0280, 0x0280, 0x0280, 0x0280, 0x0280, 0x0280, 0x0280, 0x0280,
+     0x0280, 0x0280, 0x02CC, 0x0280},
+    /* HASH */
+    {0x000E, 0x000E, 0x0000, 0x000E, 0x000E, 0x000E, 0x000E, 0x000E,
+     0x000E, 0x000E, 0x000E, 0x000E, 0x000E, 0x000E, 0x000E, 0x000E,
+     0x000F, 0x000E, 0x000E, 0x000E, 0x000E, 0x000E, 0x000E, 0x000E,
+     0x000E, 0x000E, 0x000E, 0x000E},
+    /* HASH_COMMENT */
+    {0x022E, 0x022E, 0x0000, 0x022E, 0x022E, 0x022E, 0x022E, 0x022E,
+     0x022E, 0x022E, 0x022E, 0x022E, 0x022E, 0x022E, 0x022E, 0x022E,
+     0x022E, 0x022E, 0x022E, 0x022E, 0x022E, 0x022E, 0x022E, 0x022E,
+     0x022E, 0x022E, 0x022E, 0x000E},
+    /* HASH_HASH_COMMENT */
+    {0x024F, 0x024F, 0x024F, 0x024F, 0x024F, 0x024F, 0x024F, 0x024F,
+     0x024F, 0x024F, 0x024F, 0x024F, 0x024F, 0x024F, 0x024F, 0x024F,
+     0x0010, 0x024F, 0x024F, 0x024F, 0x024F, 0x024F, 0x024F, 0x024F,
+     0x024F, 0x024F, 0x024F, 0x0000},
+    /* HASH_HASH_COMMENT_HASH */
+    {0x000F, 0x000F, 0x000F, 0x000F, 0x000F, 0x000F, 0x000F, 0x000F,
+     0x000F, 0x000F, 0x000F, 0x000F, 0x000F, 0x000F, 0x000F, 0x000F,
+     0x0000, 0x000F, 0x000F, 0x000F, 0x000F, 0x000F, 0x000F, 0x000F,
+     0x000F, 0x000F, 0x000F, 0x0000},
+    /* DOT */
+    {0x2D60, 0x2D60, 0x2D60, 0x0005, 0x0005, 0x0005, 0x2D60, 0x2D60,
+     0x2D60, 0x2D60, 0x2D60, 0x2D60, 0x2D60, 0x2D60, 0x2D60, 0x2D60,
+     0x2D60, 0x00B2, 0x2D60, 0x2D60, 0x2D60, 0x2D60, 0x2D60, 0x2D60,
+     0x2D60, 0x2D60, 0x2D60, 0x2D60},
+    /* DOT_DOT */
+    {0x3160, 0x3160, 0x3160, 0x3160, 0x3160, 0x3160, 0x3160, 0x3160,
+     0x3160, 0x3160, 0x3160, 0x3160, 0x3160, 0x3160, 0x3160, 0x3160,
+     0x3160, 0x3580, 0x3160, 0x3160, 0x3160, 0x3160, 0x3160, 0x3160,
+     0x3160, 0x3160, 0x3160, 0x3160},
+    /* LT */
+    {0x6160, 0x6160, 0x6160, 0x6160, 0x6160, 0x6160, 0x6160, 0x6160,
+     0x6160, 0x6160, 0x6160, 0x6160, 0x6160, 0x6160, 0x6160, 0x6160,
+     0x6160, 0x6160, 0x9D80, 0x6160, 0x6580, 0x6160, 0x6160, 0x6160,
+     0x6160, 0x6160, 0x6160, 0x6160},
+    /* GT */
+    {0x6960, 0x6960, 0x6960, 0x6960, 0x6960, 0x6960, 0x6960, 0x6960,
+     0x6960, 0x6960, 0x6960, 0x6960, 0x6960, 0x6960, 0x6960, 0x6960,
+     0x6960, 0x6960, 0x6960, 0xA180, 0x6D80, 0x6960, 0x6960, 0x6960,
+     0x6960, 0x6960, 0x6960, 0x6960},
+    /* EQ */
+    {0x5560, 0x5560, 0x5560, 0x5560, 0x5560, 0x5560, 0x5560, 0x5560,
+     0x5560, 0x5560, 0x5560, 0x5560, 0x5560, 0x5560, 0x5560, 0x5560,
+     0x5560, 0x5560, 0x5560, 0x5560, 0x5D80, 0x5560, 0x5560, 0x5560,
+     0x5560, 0x5560, 0x5560, 0x5560},
+    /* ASTERISK */
+    {0x7D60, 0x7D60, 0x7D60, 0x7D60, 0x7D60, 0x7D60, 0x7D60, 0x7D60,
+     0x7D60, 0x7D60, 0x7D60, 0x7D60, 0x7D60, 0x7D60, 0x7D60, 0x7D60,
+     0x7D60, 0x7D60, 0x7D60, 0x7D60, 0x7D60, 0x8980, 0x7D60, 0x7D60,
+     0x7D60, 0x7D60, 0x7D60, 0x7D60},
+    /* DASH */
+    {0x7960, 0x7960, 0x7960, 0x7960, 0x7960, 0x7960, 0x7960, 0x7960,
+     0x7960, 0x7960, 0x7960, 0x7960, 0x7960, 0x7960, 0x7960, 0x7960,
+     0x7960, 0x7960, 0x7960, 0xA580, 0x7960, 0x7960, 0x7960, 0x7960,
+     0x7960, 0x7960, 0x7960, 0x7960},
+    /* EXCLAIM */
+    {0x5960, 0x5960, 0x5960, 0x5960, 0x5960, 0x5960, 0x5960, 0x5960,
+     0x5960, 0x5960, 0x5960, 0x5960, 0x5960, 0x5960, 0x5960, 0x5960,
+     0x5960, 0x5960, 0x5960, 0x5960, 0x7180, 0x5960, 0x5960, 0x5960,
+     0x5960, 0x5960, 0x5960, 0x5960}
+};
+
+/* Slot (first * A + last * B + length) % SLOTS holds the only keyword that can match. */
+static const struct
+{
+    const char* text;
+    unsigned char length;
+    unsigned char keyword;
+} jot_scan_keywords[64] = {
+    {"repeat", 6, 16},
+    {"true", 4, 18},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"end", 3, 7},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"nil", 3, 13},
+    {"", 0, 0},
+    {"while", 5, 20},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"do", 2, 4},
+    {"continue", 8, 3},
+    {"in", 2, 12},
+    {"else", 4, 5},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"false", 5, 8},
+    {"or", 2, 15},
+    {"break", 5, 2},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"until", 5, 19},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"elseif", 6, 6},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"if", 2, 11},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"var", 3, 21},
+    {"", 0, 0},
+    {"not", 3, 14},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"then", 4, 17},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"and", 3, 1},
+    {"", 0, 0},
+    {"", 0, 0},
+    {"func", 4, 10},
+    {"", 0, 0},
+    {"for", 3, 9}
+};
+
+#endif
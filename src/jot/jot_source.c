@@ -24,19 +24,42 @@
     THE SOFTWARE.
     
 */
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+/* For fdopen and posix_madvise, which strict C89 hides otherwise. */
+#define _POSIX_C_SOURCE 200112L
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "jot_source.h"
 
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+#define JOT_HAVE_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#define JOT_HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
 enum
 {
-    FILE_SOURCE_BUFFER_SIZE = 1024
+    FILE_SOURCE_BUFFER_SIZE = 1024,
+    PREFETCH_SEGMENT_SIZE = 256 * 1024,
+    PREFETCH_SEGMENT_COUNT = 4
 };
 
 typedef struct
 {
+    jot_Allocator* allocator;
     FILE* file;
+    /* Standard input is left open. */
+    char close_file;
     char buffer[FILE_SOURCE_BUFFER_SIZE];
 } FileSourceHandle;
 
@@ -47,44 +70,440 @@ static const char* FileSourceReader(jot_Source* source, size_t* bytes_read)
     return handle->buffer;
 }
 
-jot_Source* jot_FileSourceNew(const char* filename)
+/* Reads a file that's already open through a buffer, closing it along with the source if close_file is set. The caller still owns file if this fails. */
+static jot_Source* jot_FileSourceWrap(jot_Allocator* allocator, const char* name, FILE* file, char close_file)
 {
     jot_Source* self;
     FileSourceHandle* handle;
     
-    handle = malloc(sizeof(FileSourceHandle));
-    if(handle == NULL)
+    handle = jot_Alloc(allocator, JOT_ALLOC_SOURCE, sizeof(FileSourceHandle));
+    self = jot_Alloc(allocator, JOT_ALLOC_SOURCE, sizeof(jot_Source));
+    if(handle == NULL || self == NULL)
+    {
+        jot_Free(allocator, JOT_ALLOC_SOURCE, handle, sizeof(FileSourceHandle));
+        jot_Free(allocator, JOT_ALLOC_SOURCE, self, sizeof(jot_Source));
+        return NULL;
+    }
+    
+    handle->allocator = allocator;
+    handle->file = file;
+    handle->close_file = close_file;
+    self->name = name;
+    self->handle = handle;
+    self->reader = FileSourceReader;
+    return self;
+}
+
+jot_Source* jot_FileSourceNew(jot_Allocator* allocator, const char* filename)
+{
+    jot_Source* self;
+    FILE* file;
+    
+    file = fopen(filename, "rb");
+    if(file == NULL)
+    {
+        return NULL;
+    }
+    self = jot_FileSourceWrap(allocator, filename, file, 1);
+    if(self == NULL)
+    {
+        fclose(file);
+    }
+    return self;
+}
+
+void jot_FileSourceFree(jot_Source* self)
+{
+    FileSourceHandle* handle = self->handle;
+    jot_Allocator* allocator = handle->allocator;
+    if(handle->close_file)
+    {
+        fclose(handle->file);
+    }
+    jot_Free(allocator, JOT_ALLOC_SOURCE, handle, sizeof(FileSourceHandle));
+    jot_Free(allocator, JOT_ALLOC_SOURCE, self, sizeof(jot_Source));
+}
+
+#ifdef JOT_HAVE_MMAP
+typedef struct
+{
+    jot_Allocator* allocator;
+    const char* data;
+    size_t size;
+    char consumed;
+} MmapSourceHandle;
+
+static const char* MmapSourceReader(jot_Source* source, size_t* bytes_read)
+{
+    MmapSourceHandle* handle = source->handle;
+    if(handle->consumed)
+    {
+        *bytes_read = 0;
+    }
+    else
+    {
+        /* The entire mapping goes out in one chunk. */
+        handle->consumed = 1;
+        *bytes_read = handle->size;
+    }
+    return handle->data;
+}
+
+/* Maps the file open as fd, and closes fd, or returns NULL and leaves fd open to be read some other way. */
+static jot_Source* jot_MmapSourceMap(jot_Allocator* allocator, const char* filename, int fd)
+{
+    jot_Source* self;
+    MmapSourceHandle* handle;
+    struct stat info;
+    void* data;
+    size_t size;
+    
+    /* Only regular, non-empty files that fit in the address space get mapped. */
+    if(fstat(fd, &info) == -1
+        || !S_ISREG(info.st_mode)
+        || info.st_size <= 0
+        || (off_t)(size_t) info.st_size != info.st_size)
+    {
+        return NULL;
+    }
+    size = (size_t) info.st_size;
+    
+    data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(data == MAP_FAILED)
     {
         return NULL;
     }
+#ifdef POSIX_MADV_SEQUENTIAL
+    /* The scanner only ever walks forward, so ask for aggressive read-ahead. */
+    posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+#endif
     
-    handle->file = fopen(filename, "rb");
-    if(handle->file == NULL)
+    handle = jot_Alloc(allocator, JOT_ALLOC_SOURCE, sizeof(MmapSourceHandle));
+    self = jot_Alloc(allocator, JOT_ALLOC_SOURCE, sizeof(jot_Source));
+    if(handle == NULL || self == NULL)
     {
-        free(handle);
+        jot_Free(allocator, JOT_ALLOC_SOURCE, handle, sizeof(MmapSourceHandle));
+        jot_Free(allocator, JOT_ALLOC_SOURCE, self, sizeof(jot_Source));
+        munmap(data, size);
         return NULL;
     }
     
-    self = malloc(sizeof(jot_Source));
+    handle->allocator = allocator;
+    handle->data = data;
+    handle->size = size;
+    handle->consumed = 0;
+    self->name = filename;
+    self->handle = handle;
+    self->reader = MmapSourceReader;
+    /* The mapping keeps its own reference to the file. */
+    close(fd);
+    return self;
+}
+#endif
+
+jot_Source* jot_MmapSourceNew(jot_Allocator* allocator, const char* filename)
+{
+#ifdef JOT_HAVE_MMAP
+    jot_Source* self;
+    FILE* file;
+    int fd;
+    
+    fd = open(filename, O_RDONLY);
+    if(fd == -1)
+    {
+        return NULL;
+    }
+    self = jot_MmapSourceMap(allocator, filename, fd);
     if(self)
     {
-        self->name = filename;
-        self->handle = handle;
-        self->reader = FileSourceReader;
         return self;
     }
+    /*
+        Pipes, devices and empty files are read through a buffer, from the
+        descriptor that's already open: opening a FIFO by name again would
+        drop the writer the first open waited for, and wait for another.
+    */
+    file = fdopen(fd, "rb");
+    if(file == NULL)
+    {
+        close(fd);
+        return NULL;
+    }
+    self = jot_FileSourceWrap(allocator, filename, file, 1);
+    if(self == NULL)
+    {
+        fclose(file);
+    }
+    return self;
+#else
+    /* No mmap support: read through a buffer. */
+    return jot_FileSourceNew(allocator, filename);
+#endif
+}
+
+void jot_MmapSourceFree(jot_Source* self)
+{
+#ifdef JOT_HAVE_MMAP
+    if(self->reader == MmapSourceReader)
+    {
+        MmapSourceHandle* handle = self->handle;
+        jot_Allocator* allocator = handle->allocator;
+        munmap((void*) handle->data, handle->size);
+        jot_Free(allocator, JOT_ALLOC_SOURCE, handle, sizeof(MmapSourceHandle));
+        jot_Free(allocator, JOT_ALLOC_SOURCE, self, sizeof(jot_Source));
+        return;
+    }
+#endif
+    jot_FileSourceFree(self);
+}
+
+typedef struct
+{
+    jot_Allocator* allocator;
+    const char* data;
+    size_t size;
+    char consumed;
+} StringSourceHandle;
+
+static const char* StringSourceReader(jot_Source* source, size_t* bytes_read)
+{
+    StringSourceHandle* handle = source->handle;
+    *bytes_read = handle->consumed ? 0 : handle->size;
+    handle->consumed = 1;
+    return handle->data;
+}
+
+jot_Source* jot_StringSourceNew(jot_Allocator* allocator, const char* name, const char* data, size_t size)
+{
+    jot_Source* self;
+    StringSourceHandle* handle;
+    
+    handle = jot_Alloc(allocator, JOT_ALLOC_SOURCE, sizeof(StringSourceHandle));
+    self = jot_Alloc(allocator, JOT_ALLOC_SOURCE, sizeof(jot_Source));
+    if(handle == NULL || self == NULL)
+    {
+        jot_Free(allocator, JOT_ALLOC_SOURCE, handle, sizeof(StringSourceHandle));
+        jot_Free(allocator, JOT_ALLOC_SOURCE, self, sizeof(jot_Source));
+        return NULL;
+    }
+    
+    handle->allocator = allocator;
+    handle->data = data;
+    handle->size = size;
+    handle->consumed = 0;
+    self->name = name;
+    self->handle = handle;
+    self->reader = StringSourceReader;
+    return self;
+}
+
+void jot_StringSourceFree(jot_Source* self)
+{
+    StringSourceHandle* handle = self->handle;
+    jot_Allocator* allocator = handle->allocator;
+    jot_Free(allocator, JOT_ALLOC_SOURCE, handle, sizeof(StringSourceHandle));
+    jot_Free(allocator, JOT_ALLOC_SOURCE, self, sizeof(jot_Source));
+}
+
+#ifdef JOT_HAVE_PTHREADS
+/*
+    The reader thread fills segments in ring order. A segment is in use from
+    when it's filled until the scanner asks for the one after it, since the
+    scanner may still be looking at the last chunk it was handed.
+*/
+typedef struct
+{
+    jot_Allocator* allocator;
+    FILE* file;
+    char close_file;
+    
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t filled;
+    pthread_cond_t emptied;
+    
+    /* Everything below is guarded by lock. */
+    size_t used;
+    size_t next_fill;
+    size_t next_read;
+    char holding;
+    char finished;
+    char stopping;
+    size_t sizes[PREFETCH_SEGMENT_COUNT];
+    char* segments;
+} PrefetchSourceHandle;
+
+static void* PrefetchSourceThread(void* data)
+{
+    PrefetchSourceHandle* handle = data;
+    char* segment;
+    size_t size;
+    
+    pthread_mutex_lock(&handle->lock);
+    while(1)
+    {
+        while(handle->used == PREFETCH_SEGMENT_COUNT && !handle->stopping)
+        {
+            pthread_cond_wait(&handle->emptied, &handle->lock);
+        }
+        if(handle->stopping)
+        {
+            break;
+        }
+        
+        /* Nobody else touches a segment until it's counted as used, so read without the lock. */
+        segment = handle->segments + handle->next_fill * PREFETCH_SEGMENT_SIZE;
+        pthread_mutex_unlock(&handle->lock);
+        size = fread(segment, 1, PREFETCH_SEGMENT_SIZE, handle->file);
+        pthread_mutex_lock(&handle->lock);
+        
+        if(size > 0)
+        {
+            handle->sizes[handle->next_fill] = size;
+            handle->next_fill = (handle->next_fill + 1) % PREFETCH_SEGMENT_COUNT;
+            handle->used++;
+        }
+        /* A short read means end of file (or an error, which ends the source all the same). */
+        if(size < PREFETCH_SEGMENT_SIZE)
+        {
+            handle->finished = 1;
+        }
+        pthread_cond_signal(&handle->filled);
+        if(handle->finished)
+        {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&handle->lock);
+    return NULL;
+}
+
+static const char* PrefetchSourceReader(jot_Source* source, size_t* bytes_read)
+{
+    PrefetchSourceHandle* handle = source->handle;
+    const char* segment;
+    
+    pthread_mutex_lock(&handle->lock);
+    if(handle->holding)
+    {
+        /* The scanner is done with the last segment it was given. */
+        handle->holding = 0;
+        handle->used--;
+        pthread_cond_signal(&handle->emptied);
+    }
+    while(handle->used == 0 && !handle->finished)
+    {
+        pthread_cond_wait(&handle->filled, &handle->lock);
+    }
+    if(handle->used == 0)
+    {
+        *bytes_read = 0;
+        segment = handle->segments;
+    }
     else
     {
-        fclose(handle->file);
-        free(handle);
+        segment = handle->segments + handle->next_read * PREFETCH_SEGMENT_SIZE;
+        *bytes_read = handle->sizes[handle->next_read];
+        handle->next_read = (handle->next_read + 1) % PREFETCH_SEGMENT_COUNT;
+        handle->holding = 1;
+    }
+    pthread_mutex_unlock(&handle->lock);
+    return segment;
+}
+
+jot_Source* jot_PrefetchSourceNew(jot_Allocator* allocator, const char* filename)
+{
+    jot_Source* self;
+    PrefetchSourceHandle* handle;
+    FILE* file;
+    
+    file = filename ? fopen(filename, "rb") : stdin;
+    if(file == NULL)
+    {
+        return NULL;
+    }
+    
+    handle = jot_Alloc(allocator, JOT_ALLOC_SOURCE, sizeof(PrefetchSourceHandle));
+    self = jot_Alloc(allocator, JOT_ALLOC_SOURCE, sizeof(jot_Source));
+    if(handle == NULL || self == NULL
+        || (handle->segments = jot_Alloc(allocator, JOT_ALLOC_SOURCE, PREFETCH_SEGMENT_SIZE * PREFETCH_SEGMENT_COUNT)) == NULL)
+    {
+        jot_Free(allocator, JOT_ALLOC_SOURCE, handle, sizeof(PrefetchSourceHandle));
+        jot_Free(allocator, JOT_ALLOC_SOURCE, self, sizeof(jot_Source));
+        if(filename)
+        {
+            fclose(file);
+        }
+        return NULL;
+    }
+    
+    handle->allocator = allocator;
+    handle->file = file;
+    handle->close_file = filename != NULL;
+    handle->used = 0;
+    handle->next_fill = 0;
+    handle->next_read = 0;
+    handle->holding = 0;
+    handle->finished = 0;
+    handle->stopping = 0;
+    pthread_mutex_init(&handle->lock, NULL);
+    pthread_cond_init(&handle->filled, NULL);
+    pthread_cond_init(&handle->emptied, NULL);
+    if(pthread_create(&handle->thread, NULL, PrefetchSourceThread, handle) != 0)
+    {
+        pthread_cond_destroy(&handle->emptied);
+        pthread_cond_destroy(&handle->filled);
+        pthread_mutex_destroy(&handle->lock);
+        jot_Free(allocator, JOT_ALLOC_SOURCE, handle->segments, PREFETCH_SEGMENT_SIZE * PREFETCH_SEGMENT_COUNT);
+        jot_Free(allocator, JOT_ALLOC_SOURCE, handle, sizeof(PrefetchSourceHandle));
+        jot_Free(allocator, JOT_ALLOC_SOURCE, self, sizeof(jot_Source));
+        if(filename)
+        {
+            fclose(file);
+        }
         return NULL;
     }
+    
+    self->name = filename ? filename : "(stdin)";
+    self->handle = handle;
+    self->reader = PrefetchSourceReader;
+    return self;
 }
 
-void jot_FileSourceFree(jot_Source* self)
+void jot_PrefetchSourceFree(jot_Source* self)
 {
-    FileSourceHandle* handle = self->handle;
-    fclose(handle->file);
-    free(handle);
-    free(self);
+    PrefetchSourceHandle* handle = self->handle;
+    jot_Allocator* allocator = handle->allocator;
+    
+    pthread_mutex_lock(&handle->lock);
+    handle->stopping = 1;
+    pthread_cond_signal(&handle->emptied);
+    pthread_mutex_unlock(&handle->lock);
+    pthread_join(handle->thread, NULL);
+    
+    pthread_cond_destroy(&handle->emptied);
+    pthread_cond_destroy(&handle->filled);
+    pthread_mutex_destroy(&handle->lock);
+    if(handle->close_file)
+    {
+        fclose(handle->file);
+    }
+    jot_Free(allocator, JOT_ALLOC_SOURCE, handle->segments, PREFETCH_SEGMENT_SIZE * PREFETCH_SEGMENT_COUNT);
+    jot_Free(allocator, JOT_ALLOC_SOURCE, handle, sizeof(PrefetchSourceHandle));
+    jot_Free(allocator, JOT_ALLOC_SOURCE, self, sizeof(jot_Source));
+}
+#else
+jot_Source* jot_PrefetchSourceNew(jot_Allocator* allocator, const char* filename)
+{
+    if(filename == NULL)
+    {
+        return jot_FileSourceWrap(allocator, "(stdin)", stdin, 0);
+    }
+    return jot_FileSourceNew(allocator, filename);
+}
+
+void jot_PrefetchSourceFree(jot_Source* self)
+{
+    jot_FileSourceFree(self);
 }
+#endif
@@ -29,6 +29,8 @@
 
 #include <stddef.h>
 
+#include "jot_alloc.h"
+
 struct jot_Source;
 typedef struct jot_Source jot_Source;
 typedef const char* jot_SourceReader(jot_Source* source, size_t* bytes_read);
@@ -40,7 +42,37 @@ struct jot_Source
     jot_SourceReader* reader;
 };
 
-jot_Source* jot_FileSourceNew(const char* filename);
+/*
+    The sources below are all allocated through allocator (which may be
+    NULL, for malloc), and remember it for when they're freed.
+*/
+jot_Source* jot_FileSourceNew(jot_Allocator* allocator, const char* filename);
 void jot_FileSourceFree(jot_Source* self);
 
+/*
+    Maps the whole file into memory and hands it out in a single read.
+    Falls back to the buffered file source for pipes, empty files, and other
+    inputs that can't be mapped. Always release with jot_MmapSourceFree.
+*/
+jot_Source* jot_MmapSourceNew(jot_Allocator* allocator, const char* filename);
+void jot_MmapSourceFree(jot_Source* self);
+
+/*
+    Hands out size bytes at data, which the caller keeps alive and unchanged
+    until the source is freed, in a single read. Nothing is copied. The name
+    is only used in messages.
+*/
+jot_Source* jot_StringSourceNew(jot_Allocator* allocator, const char* name, const char* data, size_t size);
+void jot_StringSourceFree(jot_Source* self);
+
+/*
+    Reads the file (or standard input, if filename is NULL) on a background
+    thread, into a ring of large segments that it keeps filled ahead of the
+    scanner, so waiting on pipes and disks overlaps with scanning. Without
+    pthreads it's the buffered file source. Always release with
+    jot_PrefetchSourceFree, which waits for any read in progress to finish.
+*/
+jot_Source* jot_PrefetchSourceNew(jot_Allocator* allocator, const char* filename);
+void jot_PrefetchSourceFree(jot_Source* self);
+
 #endif
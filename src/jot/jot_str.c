@@ -0,0 +1,497 @@
+/*
+    jot - Strings
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "jot_num.h"
+#include "jot_str.h"
+
+enum
+{
+    JOT_ATOM_MIN_CAPACITY = 64,
+    JOT_ATOM_BLOCK_SIZE = 16384,
+    JOT_STRING_MIN_BUFFER = 64
+};
+
+struct jot_AtomBlock
+{
+    jot_AtomBlock* next;
+    /* Bytes of atoms the block has room for. */
+    size_t size;
+    /* Keeps the atoms that follow suitably aligned. */
+    union
+    {
+        void* pointer;
+        size_t size;
+        double number;
+    } align;
+};
+
+#define JOT_HASH_MULTIPLIER ((uint64_t) 0xFF51AFD7UL << 32 | 0xED558CCDUL)
+
+/*
+    Word-at-a-time multiplicative hash. It's not meant to resist attacks,
+    only to be cheap on the short names that dominate scripts.
+*/
+uint32_t jot_StrHash(const char* text, size_t length)
+{
+    uint64_t h = (uint64_t) length * JOT_HASH_MULTIPLIER;
+    uint64_t word;
+    
+    while(length >= 8)
+    {
+        memcpy(&word, text, 8);
+        h = (h ^ word) * JOT_HASH_MULTIPLIER;
+        h ^= h >> 32;
+        text += 8;
+        length -= 8;
+    }
+    if(length > 0)
+    {
+        word = 0;
+        memcpy(&word, text, length);
+        h = (h ^ word) * JOT_HASH_MULTIPLIER;
+    }
+    h ^= h >> 33;
+    h *= JOT_HASH_MULTIPLIER;
+    h ^= h >> 29;
+    return (uint32_t) h;
+}
+
+/* Allocates the slot arrays for capacity atoms, with every slot empty. */
+static int jot_AtomTableAllocSlots(jot_Allocator* allocator, size_t capacity, uint32_t** hashes, jot_Atom*** slots)
+{
+    size_t i;
+    
+    *hashes = jot_Alloc(allocator, JOT_ALLOC_ATOMS, capacity * sizeof(uint32_t));
+    *slots = jot_Alloc(allocator, JOT_ALLOC_ATOMS, capacity * sizeof(jot_Atom*));
+    if(*hashes == NULL || *slots == NULL)
+    {
+        jot_Free(allocator, JOT_ALLOC_ATOMS, *hashes, capacity * sizeof(uint32_t));
+        jot_Free(allocator, JOT_ALLOC_ATOMS, *slots, capacity * sizeof(jot_Atom*));
+        return 0;
+    }
+    for(i = 0; i < capacity; i++)
+    {
+        (*slots)[i] = NULL;
+    }
+    return 1;
+}
+
+jot_AtomTable* jot_AtomTableNew(jot_Allocator* allocator)
+{
+    jot_AtomTable* self = jot_Alloc(allocator, JOT_ALLOC_ATOMS, sizeof(jot_AtomTable));
+    if(self == NULL)
+    {
+        return NULL;
+    }
+    
+    self->allocator = allocator;
+    self->capacity = JOT_ATOM_MIN_CAPACITY;
+    self->count = 0;
+    self->atoms_capacity = JOT_ATOM_MIN_CAPACITY;
+    self->atoms = jot_Alloc(allocator, JOT_ALLOC_ATOMS, self->atoms_capacity * sizeof(jot_Atom*));
+    self->blocks = NULL;
+    self->block_used = 0;
+    self->block_size = 0;
+    
+    if(self->atoms == NULL || !jot_AtomTableAllocSlots(allocator, self->capacity, &self->hashes, &self->slots))
+    {
+        jot_Free(allocator, JOT_ALLOC_ATOMS, self->atoms, self->atoms_capacity * sizeof(jot_Atom*));
+        jot_Free(allocator, JOT_ALLOC_ATOMS, self, sizeof(jot_AtomTable));
+        return NULL;
+    }
+    return self;
+}
+
+void jot_AtomTableFree(jot_AtomTable* self)
+{
+    jot_Allocator* allocator = self->allocator;
+    jot_AtomBlock* block = self->blocks;
+    while(block)
+    {
+        jot_AtomBlock* next = block->next;
+        jot_Free(allocator, JOT_ALLOC_ATOMS, block, offsetof(jot_AtomBlock, align) + block->size);
+        block = next;
+    }
+    jot_Free(allocator, JOT_ALLOC_ATOMS, self->atoms, self->atoms_capacity * sizeof(jot_Atom*));
+    jot_Free(allocator, JOT_ALLOC_ATOMS, self->slots, self->capacity * sizeof(jot_Atom*));
+    jot_Free(allocator, JOT_ALLOC_ATOMS, self->hashes, self->capacity * sizeof(uint32_t));
+    jot_Free(allocator, JOT_ALLOC_ATOMS, self, sizeof(jot_AtomTable));
+}
+
+static size_t jot_AtomTableProbe(const jot_AtomTable* self, const char* text, size_t length, uint32_t hash)
+{
+    size_t mask = self->capacity - 1;
+    size_t i = hash & mask;
+    
+    while(self->slots[i])
+    {
+        if(self->hashes[i] == hash
+            && self->slots[i]->length == length
+            && memcmp(self->slots[i]->text, text, length) == 0)
+        {
+            break;
+        }
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+static int jot_AtomTableGrow(jot_AtomTable* self)
+{
+    size_t capacity = self->capacity << 1;
+    size_t mask = capacity - 1;
+    uint32_t* hashes;
+    jot_Atom** slots;
+    size_t i, j;
+    
+    if(!jot_AtomTableAllocSlots(self->allocator, capacity, &hashes, &slots))
+    {
+        return 0;
+    }
+    for(i = 0; i < self->capacity; i++)
+    {
+        if(self->slots[i])
+        {
+            j = self->hashes[i] & mask;
+            while(slots[j])
+            {
+                j = (j + 1) & mask;
+            }
+            hashes[j] = self->hashes[i];
+            slots[j] = self->slots[i];
+        }
+    }
+    jot_Free(self->allocator, JOT_ALLOC_ATOMS, self->hashes, self->capacity * sizeof(uint32_t));
+    jot_Free(self->allocator, JOT_ALLOC_ATOMS, self->slots, self->capacity * sizeof(jot_Atom*));
+    self->hashes = hashes;
+    self->slots = slots;
+    self->capacity = capacity;
+    return 1;
+}
+
+static jot_Atom* jot_AtomTableAllocate(jot_AtomTable* self, size_t length)
+{
+    /* Round up so the next atom in the block stays aligned. */
+    size_t align = sizeof(((jot_AtomBlock*) 0)->align);
+    size_t size = (offsetof(jot_Atom, text) + length + 1 + align - 1) / align * align;
+    jot_AtomBlock* block;
+    
+    if(self->blocks == NULL || self->block_size - self->block_used < size)
+    {
+        size_t block_size = size > JOT_ATOM_BLOCK_SIZE ? size : JOT_ATOM_BLOCK_SIZE;
+        block = jot_Alloc(self->allocator, JOT_ALLOC_ATOMS, offsetof(jot_AtomBlock, align) + block_size);
+        if(block == NULL)
+        {
+            return NULL;
+        }
+        block->size = block_size;
+        if(size > JOT_ATOM_BLOCK_SIZE && self->blocks)
+        {
+            /* An oversized atom gets its own block, behind the current one. */
+            block->next = self->blocks->next;
+            self->blocks->next = block;
+            return (jot_Atom*) &block->align;
+        }
+        block->next = self->blocks;
+        self->blocks = block;
+        self->block_used = 0;
+        self->block_size = block_size;
+    }
+    self->block_used += size;
+    return (jot_Atom*) ((char*) &self->blocks->align + self->block_used - size);
+}
+
+const jot_Atom* jot_AtomTableIntern(jot_AtomTable* self, const char* text, size_t length, uint32_t hash)
+{
+    jot_Atom* atom;
+    size_t i = jot_AtomTableProbe(self, text, length, hash);
+    
+    if(self->slots[i])
+    {
+        return self->slots[i];
+    }
+    
+    /* Keep the load factor under 1/2 so probe sequences stay short. */
+    if((self->count + 1) * 2 > self->capacity)
+    {
+        if(jot_AtomTableGrow(self))
+        {
+            i = jot_AtomTableProbe(self, text, length, hash);
+        }
+        else if(self->count + 2 > self->capacity)
+        {
+            /* Probing relies on there always being an empty slot. */
+            return NULL;
+        }
+    }
+    if(self->count == self->atoms_capacity)
+    {
+        jot_Atom** atoms = jot_Realloc(self->allocator, JOT_ALLOC_ATOMS, self->atoms,
+            self->atoms_capacity * sizeof(jot_Atom*), (self->atoms_capacity << 1) * sizeof(jot_Atom*));
+        if(atoms == NULL)
+        {
+            return NULL;
+        }
+        self->atoms = atoms;
+        self->atoms_capacity <<= 1;
+    }
+    atom = jot_AtomTableAllocate(self, length);
+    if(atom == NULL)
+    {
+        return NULL;
+    }
+    atom->hash = hash;
+    atom->id = (uint32_t) self->count;
+    atom->length = length;
+    memcpy(atom->text, text, length);
+    atom->text[length] = '\0';
+    
+    self->atoms[self->count++] = atom;
+    self->hashes[i] = hash;
+    self->slots[i] = atom;
+    return atom;
+}
+
+const jot_Atom* jot_AtomTableFind(const jot_AtomTable* self, const char* text, size_t length, uint32_t hash)
+{
+    return self->slots[jot_AtomTableProbe(self, text, length, hash)];
+}
+
+const jot_Atom* jot_AtomTableGet(const jot_AtomTable* self, uint32_t id)
+{
+    return id < self->count ? self->atoms[id] : NULL;
+}
+
+/* The size of a string with its text inline. */
+static size_t jot_StringSize(size_t length)
+{
+    return offsetof(jot_String, data) + length + 1;
+}
+
+/* Makes a string with room for length bytes inline, for the caller to fill in and hash. */
+static jot_String* jot_StringAllocate(jot_Heap* heap, size_t length)
+{
+    jot_String* self;
+    
+    if(length > (size_t) -1 - jot_StringSize(0))
+    {
+        return NULL;
+    }
+    self = (jot_String*) jot_HeapAllocate(heap, JOT_TYPE_STR, jot_StringSize(length));
+    if(self == NULL)
+    {
+        return NULL;
+    }
+    self->length = length;
+    self->text = self->data.text;
+    self->data.text[length] = '\0';
+    return self;
+}
+
+/* Makes a string of the first length bytes of buffer, which it then holds a reference to. */
+static jot_String* jot_StringInBuffer(jot_Heap* heap, jot_StringBuffer* buffer, size_t length)
+{
+    jot_String* self = (jot_String*) jot_HeapAllocate(heap, JOT_TYPE_STR, sizeof(jot_String));
+    
+    if(self == NULL)
+    {
+        return NULL;
+    }
+    self->hash = 0;
+    self->hashed = 0;
+    self->length = length;
+    self->text = buffer->text;
+    self->data.buffer = buffer;
+    buffer->references++;
+    return self;
+}
+
+static size_t jot_StringBufferSize(size_t capacity)
+{
+    return offsetof(jot_StringBuffer, text) + capacity;
+}
+
+jot_String* jot_StringNew(jot_Heap* heap, const char* text, size_t length)
+{
+    jot_String* self = jot_StringAllocate(heap, length);
+    
+    if(self == NULL)
+    {
+        return NULL;
+    }
+    memcpy(self->data.text, text, length);
+    self->hash = jot_StrHash(self->text, length);
+    self->hashed = 1;
+    return self;
+}
+
+jot_String* jot_StringConcat(jot_Heap* heap, const char* a, size_t a_length, const char* b, size_t b_length)
+{
+    jot_StringBuffer* buffer;
+    jot_String* self;
+    size_t length, capacity;
+    
+    if(a_length > (size_t) -1 - b_length)
+    {
+        return NULL;
+    }
+    length = a_length + b_length;
+    if(length <= JOT_STRING_SHORT_LENGTH)
+    {
+        self = jot_StringAllocate(heap, length);
+        if(self == NULL)
+        {
+            return NULL;
+        }
+        memcpy(self->data.text, a, a_length);
+        memcpy(self->data.text + a_length, b, b_length);
+        self->hash = jot_StrHash(self->text, length);
+        self->hashed = 1;
+        return self;
+    }
+    /* Twice the room needed, so appending onto it again and again copies each byte only a few times over. */
+    capacity = length < JOT_STRING_MIN_BUFFER / 2 ? JOT_STRING_MIN_BUFFER : length;
+    if(capacity <= ((size_t) -1 - jot_StringBufferSize(0)) / 2)
+    {
+        capacity *= 2;
+    }
+    else if(capacity > (size_t) -1 - jot_StringBufferSize(0))
+    {
+        return NULL;
+    }
+    buffer = (jot_StringBuffer*) jot_HeapResize(heap, JOT_ALLOC_OBJECTS, NULL, 0, jot_StringBufferSize(capacity));
+    if(buffer == NULL)
+    {
+        return NULL;
+    }
+    buffer->references = 0;
+    buffer->used = length;
+    buffer->capacity = capacity;
+    memcpy(buffer->text, a, a_length);
+    memcpy(buffer->text + a_length, b, b_length);
+    self = jot_StringInBuffer(heap, buffer, length);
+    if(self == NULL)
+    {
+        jot_HeapRelease(heap, JOT_ALLOC_OBJECTS, buffer, jot_StringBufferSize(capacity));
+        return NULL;
+    }
+    return self;
+}
+
+jot_String* jot_StringAppend(jot_Heap* heap, const jot_String* a, const char* text, size_t length)
+{
+    jot_StringBuffer* buffer = a->text != a->data.text ? a->data.buffer : NULL;
+    jot_String* self;
+    
+    /* Only the newest string in a buffer ends where the free space starts. */
+    if(buffer != NULL && buffer->used == a->length && length <= buffer->capacity - buffer->used)
+    {
+        self = jot_StringInBuffer(heap, buffer, a->length + length);
+        if(self == NULL)
+        {
+            return NULL;
+        }
+        memcpy(buffer->text + buffer->used, text, length);
+        buffer->used += length;
+        return self;
+    }
+    return jot_StringConcat(heap, a->text, a->length, text, length);
+}
+
+jot_String* jot_StringFromValue(jot_Heap* heap, jot_Value value)
+{
+    char buffer[JOT_NUM_FORMAT_SIZE + 64];
+    size_t length;
+    
+    switch(JOT_VALUE_TYPE(value))
+    {
+        case JOT_TYPE_NIL:
+            return jot_StringNew(heap, "nil", 3);
+        case JOT_TYPE_BOOL:
+            return JOT_AS_BOOL(value) ? jot_StringNew(heap, "true", 4) : jot_StringNew(heap, "false", 5);
+        case JOT_TYPE_INT:
+            length = jot_NumFormatInt(JOT_AS_INT(value), buffer);
+            return jot_StringNew(heap, buffer, length);
+        case JOT_TYPE_NUM:
+            length = jot_NumFormat(JOT_AS_NUM(value), buffer);
+            return jot_StringNew(heap, buffer, length);
+        case JOT_TYPE_STR:
+            return (jot_String*) JOT_AS_OBJECT(value);
+        default:
+            sprintf(buffer, "%s: %p", jot_TypeName(JOT_VALUE_TYPE(value)), (void*) JOT_AS_OBJECT(value));
+            return jot_StringNew(heap, buffer, strlen(buffer));
+    }
+}
+
+void jot_StringFree(jot_Heap* heap, jot_String* self)
+{
+    jot_StringBuffer* buffer;
+    
+    if(self->text == self->data.text)
+    {
+        jot_HeapFreeObject(heap, &self->object, jot_StringSize(self->length));
+        return;
+    }
+    buffer = self->data.buffer;
+    if(--buffer->references == 0)
+    {
+        jot_HeapRelease(heap, JOT_ALLOC_OBJECTS, buffer, jot_StringBufferSize(buffer->capacity));
+    }
+    jot_HeapFreeObject(heap, &self->object, sizeof(jot_String));
+}
+
+uint32_t jot_StringHash(const jot_String* self)
+{
+    /* The hash is only kept to save working it out again, so filling it in doesn't change the string. */
+    jot_String* string = (jot_String*) self;
+    
+    if(!string->hashed)
+    {
+        string->hash = jot_StrHash(string->text, string->length);
+        string->hashed = 1;
+    }
+    return string->hash;
+}
+
+int jot_StringEqual(const jot_String* a, const jot_String* b)
+{
+    return a == b || (a->length == b->length && JOT_STRING_HASH(a) == JOT_STRING_HASH(b) && memcmp(a->text, b->text, a->length) == 0);
+}
+
+int jot_StringCompare(const jot_String* a, const jot_String* b)
+{
+    int result = memcmp(a->text, b->text, a->length < b->length ? a->length : b->length);
+    
+    if(result != 0)
+    {
+        return result;
+    }
+    return a->length < b->length ? -1 : a->length > b->length;
+}
@@ -0,0 +1,143 @@
+/*
+    jot - Strings
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#ifndef JOT_STR_H
+#define JOT_STR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "jot_alloc.h"
+#include "jot_value.h"
+
+/*
+    An interned name or string. There is exactly one atom per distinct text
+    in a table, so atoms can be compared by pointer or by id, and the hash
+    never has to be computed again.
+*/
+typedef struct
+{
+    uint32_t hash;
+    uint32_t id;
+    size_t length;
+    /* NUL-terminated, but may also contain NULs. */
+    char text[1];
+} jot_Atom;
+
+typedef struct jot_AtomBlock jot_AtomBlock;
+
+typedef struct
+{
+    jot_Allocator* allocator;
+    
+    /* Open addressing: hashes[i] caches slots[i]->hash so probes rarely touch the atom. */
+    size_t capacity;
+    uint32_t* hashes;
+    jot_Atom** slots;
+    
+    /* Atoms in the order they were interned, indexed by id. */
+    size_t count;
+    size_t atoms_capacity;
+    jot_Atom** atoms;
+    
+    /* Atom storage, carved out of large blocks so atoms never move. */
+    jot_AtomBlock* blocks;
+    size_t block_used;
+    size_t block_size;
+} jot_AtomTable;
+
+uint32_t jot_StrHash(const char* text, size_t length);
+
+jot_AtomTable* jot_AtomTableNew(jot_Allocator* allocator);
+void jot_AtomTableFree(jot_AtomTable* self);
+
+/* Returns the atom for text, adding it if needed. hash must be jot_StrHash(text, length). */
+const jot_Atom* jot_AtomTableIntern(jot_AtomTable* self, const char* text, size_t length, uint32_t hash);
+/* Returns the atom for text if it was already interned, or NULL. */
+const jot_Atom* jot_AtomTableFind(const jot_AtomTable* self, const char* text, size_t length, uint32_t hash);
+const jot_Atom* jot_AtomTableGet(const jot_AtomTable* self, uint32_t id);
+
+/*
+    Text that long strings made by concatenation share. Each string uses
+    the first length bytes of it, and the buffer never moves or shrinks,
+    so a string made by appending onto the end of the newest one can add
+    its bytes where they already are, rather than copying the lot.
+*/
+typedef struct
+{
+    /* How many strings use it. */
+    size_t references;
+    /* How many bytes have been written, which is the length of the newest string to use it. */
+    size_t used;
+    size_t capacity;
+    char text[1];
+} jot_StringBuffer;
+
+/*
+    A string value. Strings are never changed once they're made. Short
+    ones, and any made in one go, keep their text inline after the header,
+    and have their hash worked out up front. Long ones made by
+    concatenation keep theirs in a jot_StringBuffer, and work out the hash
+    the first time it's needed, since most are only ever added to again.
+*/
+typedef struct
+{
+    jot_Object object;
+    uint32_t hash;
+    /* Whether hash has been worked out yet. */
+    uint32_t hashed;
+    size_t length;
+    /* May contain NULs, and is only NUL-terminated when inline. */
+    const char* text;
+    union
+    {
+        jot_StringBuffer* buffer;
+        /* Runs on for as long as the text is. */
+        char text[sizeof(jot_StringBuffer*)];
+    } data;
+} jot_String;
+
+/* Concatenations up to this long are made inline; longer ones go in a buffer. */
+#define JOT_STRING_SHORT_LENGTH 22
+
+#define JOT_STRING_HASH(s) ((s)->hashed ? (s)->hash : jot_StringHash(s))
+
+/* These return NULL if memory runs out. */
+jot_String* jot_StringNew(jot_Heap* heap, const char* text, size_t length);
+jot_String* jot_StringConcat(jot_Heap* heap, const char* a, size_t a_length, const char* b, size_t b_length);
+/* Concatenates text onto a, adding it to a's buffer in place if a's the newest string there. */
+jot_String* jot_StringAppend(jot_Heap* heap, const jot_String* a, const char* text, size_t length);
+/* Turns any value into a string, the way tostring and .. do. */
+jot_String* jot_StringFromValue(jot_Heap* heap, jot_Value value);
+void jot_StringFree(jot_Heap* heap, jot_String* self);
+
+/* Works out and keeps the hash, if it hasn't been already; JOT_STRING_HASH only calls this when it has to. */
+uint32_t jot_StringHash(const jot_String* self);
+int jot_StringEqual(const jot_String* a, const jot_String* b);
+/* Orders strings by their bytes, like memcmp, with a prefix first. */
+int jot_StringCompare(const jot_String* a, const jot_String* b);
+
+#endif
@@ -0,0 +1,569 @@
+/*
+    jot - Tables
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#include "jot_num.h"
+#include "jot_table.h"
+
+#define JOT_TABLE_HASH_MULTIPLIER ((uint64_t) 0x9E3779B9UL << 32 | 0x7F4A7C15UL)
+
+enum
+{
+    JOT_TABLE_MIN_CAPACITY = 4,
+    /* Distances that don't fit in a byte are all kept as this, which searches never stop early at. */
+    JOT_TABLE_FAR = 255,
+    /* The array part never gets bigger than 2^JOT_TABLE_MAX_ARRAY_BITS. */
+    JOT_TABLE_MAX_ARRAY_BITS = 26
+};
+
+static uint32_t jot_TableHashBits(uint64_t bits)
+{
+    bits *= JOT_TABLE_HASH_MULTIPLIER;
+    return (uint32_t) (bits >> 32);
+}
+
+static uint32_t jot_TableHash(jot_Value key)
+{
+    int64_t integer;
+    
+    if(JOT_IS_SMALL_INT(key))
+    {
+        return jot_TableHashBits((uint64_t) JOT_AS_SMALL_INT(key));
+    }
+    if(JOT_IS_STR(key))
+    {
+        return JOT_STRING_HASH((const jot_String*) JOT_AS_OBJECT(key));
+    }
+    /* Equal numbers hash the same, boxed or not, int or float. */
+    if(JOT_IS_NUM(key))
+    {
+        if(jot_NumToInt(JOT_AS_NUM(key), &integer))
+        {
+            return jot_TableHashBits((uint64_t) integer);
+        }
+        return jot_TableHashBits(key.bits);
+    }
+    if(JOT_IS_INT(key))
+    {
+        return jot_TableHashBits((uint64_t) JOT_AS_INT(key));
+    }
+    return jot_TableHashBits(key.bits);
+}
+
+/*
+    Floats that are integers are looked up as those integers. The ones
+    too big to store without boxing stay floats, which find the same
+    entries anyway, since they hash and compare like the int; only
+    jot_TableSet boxes them, when one becomes a key.
+*/
+static jot_Value jot_TableKey(jot_Value key)
+{
+    int64_t integer;
+    
+    if(JOT_IS_NUM(key) && jot_NumToInt(JOT_AS_NUM(key), &integer) && JOT_FITS_SMALL_INT(integer))
+    {
+        JOT_SET_SMALL_INT(&key, integer);
+    }
+    return key;
+}
+
+static int jot_TableSameKey(jot_Value a, jot_Value b)
+{
+    if(a.bits == b.bits)
+    {
+        return 1;
+    }
+    if(JOT_IS_STR(a))
+    {
+        return JOT_IS_STR(b) && jot_StringEqual((const jot_String*) JOT_AS_OBJECT(a), (const jot_String*) JOT_AS_OBJECT(b));
+    }
+    /* Anything else with different bits is only the same if it's a boxed int or a big float. */
+    return JOT_VALUE_TAG(a) != JOT_VALUE_TAG_INT && JOT_VALUE_TAG(b) != JOT_VALUE_TAG_INT && jot_ValueEqual(a, b);
+}
+
+/* The hash part is one block: the entries, then a distance byte for each of them. */
+static size_t jot_TableHashBytes(size_t capacity)
+{
+    return capacity * (sizeof(jot_TableEntry) + 1);
+}
+
+/* Makes an empty hash part with room for count keys, without going over three quarters full. */
+static int jot_TableHashNew(jot_Heap* heap, size_t count, jot_TableEntry** entries, unsigned char** distances, size_t* capacity)
+{
+    size_t size = JOT_TABLE_MIN_CAPACITY;
+    size_t i;
+    
+    *entries = NULL;
+    *distances = NULL;
+    *capacity = 0;
+    if(count == 0)
+    {
+        return 1;
+    }
+    while(size - size / 4 < count)
+    {
+        if(size >= ((size_t) -1 / 2) / (sizeof(jot_TableEntry) + 1))
+        {
+            return 0;
+        }
+        size *= 2;
+    }
+    *entries = (jot_TableEntry*) jot_HeapResize(heap, JOT_ALLOC_OBJECTS, NULL, 0, jot_TableHashBytes(size));
+    if(*entries == NULL)
+    {
+        return 0;
+    }
+    *distances = (unsigned char*) (*entries + size);
+    /* Empty slots have nil keys, which are never looked up, so a probe can compare keys before distances. */
+    for(i = 0; i < size; i++)
+    {
+        JOT_SET_NIL(&(*entries)[i].key);
+        (*distances)[i] = 0;
+    }
+    *capacity = size;
+    return 1;
+}
+
+jot_Table* jot_TableNew(jot_Heap* heap, size_t capacity)
+{
+    jot_Table* self = (jot_Table*) jot_HeapAllocate(heap, JOT_TYPE_TABLE, sizeof(jot_Table));
+    
+    if(self == NULL)
+    {
+        return NULL;
+    }
+    self->items = NULL;
+    self->array_size = 0;
+    self->count = 0;
+    /* Without room, the table just starts out empty, and finds out about memory when it's first set. */
+    if(!jot_TableHashNew(heap, capacity, &self->entries, &self->distances, &self->capacity))
+    {
+        self->entries = NULL;
+        self->distances = NULL;
+        self->capacity = 0;
+    }
+    return self;
+}
+
+void jot_TableFree(jot_Heap* heap, jot_Table* self)
+{
+    jot_HeapRelease(heap, JOT_ALLOC_OBJECTS, self->items, self->array_size * sizeof(jot_Value));
+    jot_HeapRelease(heap, JOT_ALLOC_OBJECTS, self->entries, jot_TableHashBytes(self->capacity));
+    jot_HeapFreeObject(heap, &self->object, sizeof(jot_Table));
+}
+
+/* The entry key is in, or NULL if there isn't one. The hash part must have room. */
+static jot_TableEntry* jot_TableFindEntry(const jot_Table* self, jot_Value key, uint32_t hash)
+{
+    size_t mask = self->capacity - 1;
+    size_t i = hash & mask;
+    size_t distance;
+    size_t expected;
+    
+    /* Small ints and objects other than strings and boxed ints are only ever the same key as their own bits. */
+    if(JOT_IS_SMALL_INT(key) || !(JOT_IS_NUM(key) || JOT_IS_INT(key) || JOT_IS_STR(key)))
+    {
+        for(distance = 1;; distance++)
+        {
+            if(self->entries[i].key.bits == key.bits)
+            {
+                return &self->entries[i];
+            }
+            /* Anything closer to home would have been moved along for key, so it isn't any further on. */
+            expected = distance < JOT_TABLE_FAR ? distance : JOT_TABLE_FAR;
+            if(self->distances[i] < expected)
+            {
+                return NULL;
+            }
+            i = (i + 1) & mask;
+        }
+    }
+    for(distance = 1;; distance++)
+    {
+        expected = distance < JOT_TABLE_FAR ? distance : JOT_TABLE_FAR;
+        if(self->distances[i] == expected)
+        {
+            if(jot_TableSameKey(self->entries[i].key, key))
+            {
+                return &self->entries[i];
+            }
+        }
+        else if(self->distances[i] < expected)
+        {
+            return NULL;
+        }
+        i = (i + 1) & mask;
+    }
+}
+
+/* Adds a key that isn't in the hash part yet, which must have room for it. */
+static void jot_TableInsert(jot_Heap* heap, jot_Table* self, jot_Value key, jot_Value value, uint32_t hash)
+{
+    size_t mask = self->capacity - 1;
+    size_t i = hash & mask;
+    size_t distance = 1;
+    size_t mine;
+    jot_TableEntry entry;
+    jot_TableEntry evicted;
+    
+    entry.key = key;
+    entry.value = value;
+    for(;; i = (i + 1) & mask, distance++)
+    {
+        mine = distance < JOT_TABLE_FAR ? distance : JOT_TABLE_FAR;
+        if(self->distances[i] == 0)
+        {
+            self->entries[i] = entry;
+            self->distances[i] = (unsigned char) mine;
+            return;
+        }
+        /* Whichever entry is closer to home gives up its place, and carries on looking. */
+        if(self->distances[i] < mine)
+        {
+            evicted = self->entries[i];
+            self->entries[i] = entry;
+            entry = evicted;
+            distance = self->distances[i];
+            self->distances[i] = (unsigned char) mine;
+        }
+        /* Wrapping around carries an entry back to where a scan part way through the table may already have been. */
+        if(i == mask)
+        {
+            JOT_GC_BARRIER(heap, &self->object, entry.key);
+            JOT_GC_BARRIER(heap, &self->object, entry.value);
+        }
+    }
+}
+
+jot_Value* jot_TableFind(const jot_Table* self, jot_Value key)
+{
+    jot_TableEntry* entry;
+    
+    key = jot_TableKey(key);
+    if(JOT_IS_SMALL_INT(key) && (uint64_t) JOT_AS_SMALL_INT(key) < self->array_size)
+    {
+        return &self->items[JOT_AS_SMALL_INT(key)];
+    }
+    if(self->capacity == 0 || JOT_IS_NIL(key))
+    {
+        return NULL;
+    }
+    entry = jot_TableFindEntry(self, key, jot_TableHash(key));
+    return entry != NULL ? &entry->value : NULL;
+}
+
+jot_Value* jot_TableFindString(const jot_Table* self, const jot_String* key)
+{
+    size_t mask = self->capacity - 1;
+    size_t i;
+    size_t distance;
+    size_t expected;
+    jot_TableEntry* entry;
+    jot_Value same;
+    
+    if(self->capacity == 0)
+    {
+        return NULL;
+    }
+    /* Keys are usually the very string looked up with, which one compare finds. */
+    JOT_SET_OBJECT(&same, key);
+    for(i = JOT_STRING_HASH(key) & mask, distance = 1;; i = (i + 1) & mask, distance++)
+    {
+        entry = &self->entries[i];
+        if(entry->key.bits == same.bits)
+        {
+            return &entry->value;
+        }
+        expected = distance < JOT_TABLE_FAR ? distance : JOT_TABLE_FAR;
+        if(self->distances[i] == expected)
+        {
+            if(JOT_IS_STR(entry->key) && jot_StringEqual((const jot_String*) JOT_AS_OBJECT(entry->key), key))
+            {
+                return &entry->value;
+            }
+        }
+        else if(self->distances[i] < expected)
+        {
+            return NULL;
+        }
+    }
+}
+
+/*
+    Counts key into nums, if it could go in an array part: key k is
+    counted in nums[b] when k + 1 is more than 2^(b - 1) and at most 2^b.
+    Returns whether it was counted.
+*/
+static int jot_TableCountIndex(jot_Value key, size_t* nums)
+{
+    uint64_t position;
+    unsigned int bits = 0;
+    
+    if(!JOT_IS_SMALL_INT(key) || JOT_AS_SMALL_INT(key) < 0 || JOT_AS_SMALL_INT(key) >= (int64_t) 1 << JOT_TABLE_MAX_ARRAY_BITS)
+    {
+        return 0;
+    }
+    position = (uint64_t) JOT_AS_SMALL_INT(key) + 1;
+    while(((uint64_t) 1 << bits) < position)
+    {
+        bits++;
+    }
+    nums[bits]++;
+    return 1;
+}
+
+/*
+    The biggest power of two that more than half of the counted keys below
+    it would fill, or 0. *used gets how many of them would be there.
+*/
+static size_t jot_TableArraySize(const size_t* nums, size_t total, size_t* used)
+{
+    size_t size = 0;
+    size_t below = 0;
+    size_t power = 1;
+    unsigned int bits;
+    
+    *used = 0;
+    for(bits = 0; bits <= JOT_TABLE_MAX_ARRAY_BITS && power / 2 < total; bits++, power *= 2)
+    {
+        below += nums[bits];
+        if(below > power / 2)
+        {
+            size = power;
+            *used = below;
+        }
+    }
+    return size;
+}
+
+/*
+    Gives the table an array part of array_size and a new hash part with
+    room for count keys, and moves every key that wasn't removed into
+    whichever part it now belongs in.
+*/
+static int jot_TableResize(jot_Heap* heap, jot_Table* self, size_t array_size, size_t count)
+{
+    jot_Value* old_items = self->items;
+    size_t old_array_size = self->array_size;
+    jot_TableEntry* old_entries = self->entries;
+    unsigned char* old_distances = self->distances;
+    size_t old_capacity = self->capacity;
+    jot_Value* items = old_items;
+    jot_TableEntry* entries;
+    unsigned char* distances;
+    size_t capacity;
+    jot_Value key;
+    size_t i;
+    
+    if(!jot_TableHashNew(heap, count, &entries, &distances, &capacity))
+    {
+        return 0;
+    }
+    if(array_size == 0)
+    {
+        items = NULL;
+    }
+    else if(array_size != old_array_size)
+    {
+        items = (jot_Value*) jot_HeapResize(heap, JOT_ALLOC_OBJECTS, NULL, 0, array_size * sizeof(jot_Value));
+        if(items == NULL)
+        {
+            jot_HeapRelease(heap, JOT_ALLOC_OBJECTS, entries, jot_TableHashBytes(capacity));
+            return 0;
+        }
+        for(i = 0; i < array_size; i++)
+        {
+            if(i < old_array_size)
+            {
+                items[i] = old_items[i];
+            }
+            else
+            {
+                JOT_SET_NIL(&items[i]);
+            }
+        }
+    }
+    /* Entries that a scan part way through the table hadn't got to yet may land where it already has. */
+    jot_GcMoved(heap, &self->object);
+    self->items = items;
+    self->array_size = array_size;
+    self->entries = entries;
+    self->distances = distances;
+    self->capacity = capacity;
+    self->count = 0;
+    /* What's left past the end of a smaller array part goes in the hash part. */
+    for(i = array_size; i < old_array_size; i++)
+    {
+        if(!JOT_IS_NIL(old_items[i]))
+        {
+            JOT_SET_SMALL_INT(&key, i);
+            jot_TableInsert(heap, self, key, old_items[i], jot_TableHash(key));
+            self->count++;
+        }
+    }
+    for(i = 0; i < old_capacity; i++)
+    {
+        if(old_distances[i] == 0 || JOT_IS_NIL(old_entries[i].value))
+        {
+            continue;
+        }
+        key = old_entries[i].key;
+        if(JOT_IS_SMALL_INT(key) && (uint64_t) JOT_AS_SMALL_INT(key) < array_size)
+        {
+            items[JOT_AS_SMALL_INT(key)] = old_entries[i].value;
+        }
+        else
+        {
+            jot_TableInsert(heap, self, key, old_entries[i].value, jot_TableHash(key));
+            self->count++;
+        }
+    }
+    if(items != old_items)
+    {
+        jot_HeapRelease(heap, JOT_ALLOC_OBJECTS, old_items, old_array_size * sizeof(jot_Value));
+    }
+    jot_HeapRelease(heap, JOT_ALLOC_OBJECTS, old_entries, jot_TableHashBytes(old_capacity));
+    return 1;
+}
+
+/*
+    Sizes both parts again for the keys that weren't removed, and key,
+    which is about to be added. Removed keys only take up room until this
+    happens, and the array part only ever grows or shrinks here, which
+    happens half as often each time a table doubles.
+*/
+static int jot_TableRehash(jot_Heap* heap, jot_Table* self, jot_Value key)
+{
+    size_t nums[JOT_TABLE_MAX_ARRAY_BITS + 1];
+    size_t live = 1;
+    size_t indexes = 0;
+    size_t used;
+    size_t array_size;
+    jot_Value index;
+    size_t i;
+    
+    for(i = 0; i <= JOT_TABLE_MAX_ARRAY_BITS; i++)
+    {
+        nums[i] = 0;
+    }
+    for(i = 0; i < self->array_size; i++)
+    {
+        if(!JOT_IS_NIL(self->items[i]))
+        {
+            JOT_SET_SMALL_INT(&index, i);
+            indexes += jot_TableCountIndex(index, nums);
+            live++;
+        }
+    }
+    for(i = 0; i < self->capacity; i++)
+    {
+        if(self->distances[i] != 0 && !JOT_IS_NIL(self->entries[i].value))
+        {
+            indexes += jot_TableCountIndex(self->entries[i].key, nums);
+            live++;
+        }
+    }
+    indexes += jot_TableCountIndex(key, nums);
+    array_size = jot_TableArraySize(nums, indexes, &used);
+    return jot_TableResize(heap, self, array_size, live - used);
+}
+
+int jot_TableSet(jot_Heap* heap, jot_Table* self, jot_Value key, jot_Value value)
+{
+    jot_TableEntry* entry;
+    uint32_t hash;
+    int64_t integer;
+    
+    key = jot_TableKey(key);
+    JOT_GC_BARRIER(heap, &self->object, key);
+    JOT_GC_BARRIER(heap, &self->object, value);
+    if(JOT_IS_SMALL_INT(key) && (uint64_t) JOT_AS_SMALL_INT(key) < self->array_size)
+    {
+        self->items[JOT_AS_SMALL_INT(key)] = value;
+        return 1;
+    }
+    hash = jot_TableHash(key);
+    if(self->capacity > 0)
+    {
+        entry = jot_TableFindEntry(self, key, hash);
+        if(entry != NULL)
+        {
+            entry->value = value;
+            return 1;
+        }
+    }
+    if(JOT_IS_NIL(value))
+    {
+        return 1;
+    }
+    if(self->count + 1 > self->capacity - self->capacity / 4)
+    {
+        if(!jot_TableRehash(heap, self, key))
+        {
+            return 0;
+        }
+        /* The array part may have grown to take it. */
+        if(JOT_IS_SMALL_INT(key) && (uint64_t) JOT_AS_SMALL_INT(key) < self->array_size)
+        {
+            self->items[JOT_AS_SMALL_INT(key)] = value;
+            return 1;
+        }
+    }
+    if(JOT_IS_NUM(key) && jot_NumToInt(JOT_AS_NUM(key), &integer) && !jot_ValueSetInt(heap, &key, integer))
+    {
+        return 0;
+    }
+    jot_TableInsert(heap, self, key, value, hash);
+    self->count++;
+    return 1;
+}
+
+int jot_TableNext(const jot_Table* self, size_t* index, jot_Value* key, jot_Value* value)
+{
+    size_t i;
+    
+    for(i = *index; i < self->array_size; i++)
+    {
+        if(!JOT_IS_NIL(self->items[i]))
+        {
+            JOT_SET_SMALL_INT(key, i);
+            *value = self->items[i];
+            *index = i + 1;
+            return 1;
+        }
+    }
+    for(; i - self->array_size < self->capacity; i++)
+    {
+        if(self->distances[i - self->array_size] != 0 && !JOT_IS_NIL(self->entries[i - self->array_size].value))
+        {
+            *key = self->entries[i - self->array_size].key;
+            *value = self->entries[i - self->array_size].value;
+            *index = i + 1;
+            return 1;
+        }
+    }
+    *index = i;
+    return 0;
+}
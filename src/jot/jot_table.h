@@ -0,0 +1,94 @@
+/*
+    jot - Tables
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#ifndef JOT_TABLE_H
+#define JOT_TABLE_H
+
+#include <stddef.h>
+
+#include "jot_str.h"
+#include "jot_value.h"
+
+typedef struct
+{
+    jot_Value key;
+    jot_Value value;
+} jot_TableEntry;
+
+/*
+    A table from any value but nil and NaN to any value, in two parts.
+
+    Int keys from 0 up go in the array part, a plain array of values, where
+    nil means the key isn't there. Everything else goes in the hash part,
+    which uses open addressing with Robin Hood probing: an entry that has
+    come further from where it hashed to takes the place of one that
+    hasn't, which keeps probes short, and lets a search for a missing key
+    stop as soon as it meets an entry that's closer to home than the key
+    would be. Each entry's distance is kept in a byte of its own, after the
+    entries; a probe compares the key it lands on first, and only reads
+    distances when that isn't it.
+
+    Setting a key in the hash part to nil leaves the entry in place with a
+    nil value, so probes carry on past it, and an iteration can remove keys
+    as it goes. Removed entries are only dropped when the table is
+    rehashed, which is also when the array part is sized again, to the
+    biggest power of two that's more than half used.
+*/
+typedef struct
+{
+    jot_Object object;
+    /* The array part: keys 0 to array_size - 1. */
+    jot_Value* items;
+    size_t array_size;
+    /* Entries in the hash part with a key, removed or not. */
+    size_t count;
+    /* 0, or a power of two. */
+    size_t capacity;
+    jot_TableEntry* entries;
+    /* How far each entry is from where its key hashed to, plus 1, or 0 for no entry. */
+    unsigned char* distances;
+} jot_Table;
+
+jot_Table* jot_TableNew(jot_Heap* heap, size_t capacity);
+void jot_TableFree(jot_Heap* heap, jot_Table* self);
+
+/*
+    Returns where key's value is kept, or NULL if it's not in the table
+    (the value may still be nil, if it was removed). Floats that are
+    integers are the same keys as those integers.
+*/
+jot_Value* jot_TableFind(const jot_Table* self, jot_Value key);
+jot_Value* jot_TableFindString(const jot_Table* self, const jot_String* key);
+/* key must not be nil or NaN. Returns 0 if memory runs out. */
+int jot_TableSet(jot_Heap* heap, jot_Table* self, jot_Value key, jot_Value value);
+/*
+    Gets the first key at or after *index that hasn't been removed and
+    moves *index past it, or returns 0 if there are no more. Start at 0;
+    the array part comes first, in order.
+*/
+int jot_TableNext(const jot_Table* self, size_t* index, jot_Value* key, jot_Value* value);
+
+#endif
@@ -0,0 +1,164 @@
+/*
+    jot - UTF-8
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+
+#include "jot_scanskip.h"
+#include "jot_utf8.h"
+#include "jot_utf8tab.h"
+
+/*
+    How many bytes a sequence starting with lead takes, and the range its
+    second byte has to fall in. The range is what rules out overlong forms,
+    surrogates and anything past U+10FFFF. Returns 0 for bytes that can't
+    start a sequence.
+*/
+static size_t jot_Utf8Lead(unsigned char lead, unsigned char* low, unsigned char* high)
+{
+    *low = 0x80;
+    *high = 0xBF;
+    if(lead < 0x80)
+    {
+        return 1;
+    }
+    else if(lead >= 0xC2 && lead <= 0xDF)
+    {
+        return 2;
+    }
+    else if(lead >= 0xE0 && lead <= 0xEF)
+    {
+        *low = lead == 0xE0 ? 0xA0 : 0x80;
+        *high = lead == 0xED ? 0x9F : 0xBF;
+        return 3;
+    }
+    else if(lead >= 0xF0 && lead <= 0xF4)
+    {
+        *low = lead == 0xF0 ? 0x90 : 0x80;
+        *high = lead == 0xF4 ? 0x8F : 0xBF;
+        return 4;
+    }
+    return 0;
+}
+
+/* How many of the length bytes at p are a valid start of the sequence p begins. */
+static size_t jot_Utf8ValidPrefix(const unsigned char* p, size_t length, size_t count, unsigned char low, unsigned char high)
+{
+    size_t i;
+    
+    for(i = 1; i < count && i < length; i++)
+    {
+        if(i == 1 ? p[i] < low || p[i] > high : (p[i] & 0xC0) != 0x80)
+        {
+            break;
+        }
+    }
+    return i;
+}
+
+size_t jot_Utf8Decode(const char* data, size_t length, uint32_t* code_point)
+{
+    static const unsigned char lead_masks[5] = { 0, 0x7F, 0x1F, 0x0F, 0x07 };
+    const unsigned char* p = (const unsigned char*) data;
+    unsigned char low;
+    unsigned char high;
+    uint32_t value;
+    size_t count;
+    size_t i;
+    
+    if(length == 0 || (count = jot_Utf8Lead(p[0], &low, &high)) == 0
+        || jot_Utf8ValidPrefix(p, length, count, low, high) != count)
+    {
+        return 0;
+    }
+    value = p[0] & lead_masks[count];
+    for(i = 1; i < count; i++)
+    {
+        value = value << 6 | (p[i] & 0x3F);
+    }
+    *code_point = value;
+    return count;
+}
+
+int jot_Utf8IsTruncated(const char* data, size_t length)
+{
+    const unsigned char* p = (const unsigned char*) data;
+    unsigned char low;
+    unsigned char high;
+    size_t count;
+    
+    if(length == 0 || (count = jot_Utf8Lead(p[0], &low, &high)) <= length)
+    {
+        return 0;
+    }
+    return jot_Utf8ValidPrefix(p, length, count, low, high) == length;
+}
+
+size_t jot_Utf8Validate(const char* data, size_t length)
+{
+    return jot_ScanSkipGet()->utf8(data, length);
+}
+
+static int jot_Utf8HasProperty(const unsigned char* pages, uint32_t code_point)
+{
+    const unsigned char* page;
+    
+    if(code_point >> JOT_UTF8_PAGE_BITS >= JOT_UTF8_PAGE_COUNT)
+    {
+        return 0;
+    }
+    page = jot_utf8_pages[pages[code_point >> JOT_UTF8_PAGE_BITS]];
+    return page[(code_point & 0xFF) >> 3] >> (code_point & 7) & 1;
+}
+
+int jot_Utf8IsXidStart(uint32_t code_point)
+{
+    return jot_Utf8HasProperty(jot_utf8_xid_start, code_point);
+}
+
+int jot_Utf8IsXidContinue(uint32_t code_point)
+{
+    return jot_Utf8HasProperty(jot_utf8_xid_continue, code_point);
+}
+
+int jot_Utf8IsIdentifier(const char* data, size_t length)
+{
+    uint32_t code_point;
+    size_t position = 0;
+    size_t count;
+    
+    while(position < length)
+    {
+        if((count = jot_Utf8Decode(data + position, length - position, &code_point)) == 0)
+        {
+            return 0;
+        }
+        if(position == 0 ? !jot_Utf8IsXidStart(code_point) && code_point != '_' : !jot_Utf8IsXidContinue(code_point))
+        {
+            return 0;
+        }
+        position += count;
+    }
+    return length > 0;
+}
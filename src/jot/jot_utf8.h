@@ -0,0 +1,64 @@
+/*
+    jot - UTF-8
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#ifndef JOT_UTF8_H
+#define JOT_UTF8_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+    Source text is UTF-8. Outside of string literals and comments only ASCII
+    means anything to the scanner, so the rest of it is about identifiers,
+    which follow Unicode's XID_Start XID_Continue* (UAX #31), with '_'
+    allowed to start one as well.
+    
+    Valid here means what the standard means: no overlong forms, no
+    surrogates, nothing past U+10FFFF, no stray or missing continuation bytes.
+*/
+
+/*
+    Decodes the sequence at the start of data into *code_point and returns
+    how many bytes it took, or 0 if it's invalid or cut short by length.
+*/
+size_t jot_Utf8Decode(const char* data, size_t length, uint32_t* code_point);
+
+/*
+    Whether data (length bytes, at most 3) is a valid start of a sequence
+    that only needs more bytes to be complete.
+*/
+int jot_Utf8IsTruncated(const char* data, size_t length);
+
+/* Returns how many bytes at the start of data are valid UTF-8, all of it if it's valid throughout. */
+size_t jot_Utf8Validate(const char* data, size_t length);
+
+int jot_Utf8IsXidStart(uint32_t code_point);
+int jot_Utf8IsXidContinue(uint32_t code_point);
+
+/* Whether the text is valid UTF-8 that spells a single identifier. */
+int jot_Utf8IsIdentifier(const char* data, size_t length);
+
+#endif
@@ -0,0 +1,304 @@
+/*
+    jot - Values
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#include <string.h>
+
+#include "jot_array.h"
+#include "jot_func.h"
+#include "jot_num.h"
+#include "jot_str.h"
+#include "jot_table.h"
+#include "jot_value.h"
+
+static const char* const jot_type_names[JOT_TYPE_COUNT] =
+{
+    "nil",
+    "bool",
+    "int",
+    "num",
+    "str",
+    "table",
+    "array",
+    "func",
+    "func",
+    "proto",
+    "upvalue",
+    "int"
+};
+
+const uint64_t jot_value_tags[JOT_TYPE_COUNT] =
+{
+    0,
+    0,
+    0,
+    0,
+    JOT_VALUE_TAG_STR,
+    JOT_VALUE_TAG_TABLE,
+    JOT_VALUE_TAG_ARRAY,
+    JOT_VALUE_TAG_FUNC,
+    JOT_VALUE_TAG_OBJECT,
+    JOT_VALUE_TAG_OBJECT,
+    JOT_VALUE_TAG_OBJECT,
+    JOT_VALUE_TAG_OBJECT
+};
+
+const jot_Type jot_value_tag_types[8] =
+{
+    JOT_TYPE_NIL,
+    JOT_TYPE_INT,
+    JOT_TYPE_BOOL,
+    JOT_TYPE_STR,
+    JOT_TYPE_TABLE,
+    JOT_TYPE_ARRAY,
+    JOT_TYPE_FUNC,
+    JOT_TYPE_NATIVE
+};
+
+enum
+{
+    JOT_GC_DEFAULT_PAUSE = 200,
+    JOT_GC_DEFAULT_MULTIPLIER = 200,
+    JOT_GC_DEFAULT_STEP_SIZE = 8192,
+    JOT_GC_DEFAULT_BUDGET = 16384,
+    /* The heap the first cycle waits for, since there's no last one to go by. */
+    JOT_GC_FIRST_THRESHOLD = 1 << 18
+};
+
+void jot_HeapInit(jot_Heap* self, jot_Allocator* allocator)
+{
+    self->allocator = allocator;
+    self->objects = NULL;
+    self->count = 0;
+    self->bytes = 0;
+    memset(&self->gc, 0, sizeof(jot_Gc));
+    self->gc.pause = JOT_GC_DEFAULT_PAUSE;
+    self->gc.multiplier = JOT_GC_DEFAULT_MULTIPLIER;
+    self->gc.step_size = JOT_GC_DEFAULT_STEP_SIZE;
+    self->gc.budget = JOT_GC_DEFAULT_BUDGET;
+    self->gc.clock = NULL;
+    self->gc.phase = JOT_GC_PAUSE;
+    self->gc.threshold = JOT_GC_FIRST_THRESHOLD;
+    self->gc.rescan = NULL;
+    self->gc.sweep = NULL;
+}
+
+void jot_ObjectFree(jot_Heap* self, jot_Object* object)
+{
+    switch(object->type)
+    {
+        case JOT_TYPE_STR:
+            jot_StringFree(self, (jot_String*) object);
+            break;
+        case JOT_TYPE_TABLE:
+            jot_TableFree(self, (jot_Table*) object);
+            break;
+        case JOT_TYPE_ARRAY:
+            jot_ArrayFree(self, (jot_Array*) object);
+            break;
+        case JOT_TYPE_FUNC:
+            jot_ClosureFree(self, (jot_Closure*) object);
+            break;
+        case JOT_TYPE_NATIVE:
+            jot_NativeFree(self, (jot_Native*) object);
+            break;
+        case JOT_TYPE_PROTO:
+            jot_ProtoFree(self, (jot_Proto*) object);
+            break;
+        case JOT_TYPE_UPVALUE:
+            jot_UpvalueFree(self, (jot_Upvalue*) object);
+            break;
+        case JOT_TYPE_INT_BOX:
+            jot_HeapFreeObject(self, object, sizeof(jot_IntBox));
+            break;
+        default:
+            break;
+    }
+}
+
+void jot_HeapFree(jot_Heap* self)
+{
+    jot_Object* object = self->objects;
+    jot_Object* next;
+    
+    while(object != NULL)
+    {
+        next = object->next;
+        jot_ObjectFree(self, object);
+        object = next;
+    }
+    self->objects = NULL;
+    jot_Free(self->allocator, JOT_ALLOC_GC, self->gc.gray.items, self->gc.gray.capacity * sizeof(jot_GcGray));
+    self->gc.gray.items = NULL;
+    self->gc.gray.count = 0;
+    self->gc.gray.capacity = 0;
+    self->gc.overflowed = 0;
+    self->gc.phase = JOT_GC_PAUSE;
+    self->gc.rescan = NULL;
+    self->gc.sweep = NULL;
+}
+
+jot_Object* jot_HeapAllocate(jot_Heap* self, jot_Type type, size_t size)
+{
+    jot_Object* object = (jot_Object*) jot_Alloc(self->allocator, JOT_ALLOC_OBJECTS, size);
+    
+    if(object == NULL)
+    {
+        return NULL;
+    }
+    /* Values only have room for 48 bits of pointer. */
+    if(((uint64_t) (uintptr_t) object & JOT_VALUE_TAG_MASK) != 0)
+    {
+        jot_Free(self->allocator, JOT_ALLOC_OBJECTS, object, size);
+        return NULL;
+    }
+    object->next = self->objects;
+    object->type = type;
+    /* Anything made while marking has nothing white in it yet, and anything stored in it after goes through the barrier. */
+    object->color = self->gc.phase == JOT_GC_PROPAGATE || self->gc.phase == JOT_GC_ATOMIC ? JOT_GC_BLACK : JOT_GC_WHITE;
+    /* New objects go at the front, which sweeping has to be past, or it would free them, white as they are, before anything could refer to them. */
+    if(self->gc.sweep == &self->objects)
+    {
+        self->gc.sweep = &object->next;
+    }
+    self->objects = object;
+    self->count++;
+    self->bytes += size;
+    return object;
+}
+
+void jot_HeapFreeObject(jot_Heap* self, jot_Object* object, size_t size)
+{
+    jot_Free(self->allocator, JOT_ALLOC_OBJECTS, object, size);
+    self->count--;
+    self->bytes -= size;
+}
+
+void* jot_HeapResize(jot_Heap* self, jot_AllocSubsystem subsystem, void* pointer, size_t old_size, size_t size)
+{
+    void* result = jot_Realloc(self->allocator, subsystem, pointer, old_size, size);
+    
+    if(result != NULL)
+    {
+        self->bytes = self->bytes - old_size + size;
+    }
+    return result;
+}
+
+void jot_HeapRelease(jot_Heap* self, jot_AllocSubsystem subsystem, void* pointer, size_t size)
+{
+    if(pointer != NULL)
+    {
+        jot_Free(self->allocator, subsystem, pointer, size);
+        self->bytes -= size;
+    }
+}
+
+const char* jot_TypeName(jot_Type type)
+{
+    return type < JOT_TYPE_COUNT ? jot_type_names[type] : "?";
+}
+
+int jot_ValueEqual(jot_Value a, jot_Value b)
+{
+    if(a.bits == b.bits)
+    {
+        /* Unless it's a NaN, which isn't equal to anything. */
+        return !JOT_IS_NUM(a) || JOT_AS_NUM(a) == JOT_AS_NUM(a);
+    }
+    if(JOT_IS_NUM(a))
+    {
+        if(JOT_IS_NUM(b))
+        {
+            return JOT_AS_NUM(a) == JOT_AS_NUM(b);
+        }
+        return JOT_IS_INT(b) && jot_NumIntEqualNum(JOT_AS_INT(b), JOT_AS_NUM(a));
+    }
+    if(JOT_IS_INT(a))
+    {
+        if(JOT_IS_NUM(b))
+        {
+            return jot_NumIntEqualNum(JOT_AS_INT(a), JOT_AS_NUM(b));
+        }
+        /* Small ints are only equal if their bits are, but two boxes can hold the same int. */
+        return !JOT_IS_SMALL_INT(a) && JOT_VALUE_TAG(b) == JOT_VALUE_TAG_OBJECT
+            && JOT_AS_OBJECT(b)->type == JOT_TYPE_INT_BOX && JOT_AS_INT(a) == JOT_AS_INT(b);
+    }
+    if(JOT_IS_STR(a) && JOT_IS_STR(b))
+    {
+        return jot_StringEqual((const jot_String*) JOT_AS_OBJECT(a), (const jot_String*) JOT_AS_OBJECT(b));
+    }
+    return 0;
+}
+
+jot_Type jot_ValueType(jot_Value value)
+{
+    jot_Type type;
+    
+    if(JOT_IS_NUM(value))
+    {
+        return JOT_TYPE_NUM;
+    }
+    switch(JOT_VALUE_TAG(value))
+    {
+        case JOT_VALUE_TAG_SPECIAL:
+            return JOT_IS_NIL(value) ? JOT_TYPE_NIL : JOT_TYPE_BOOL;
+        case JOT_VALUE_TAG_OBJECT:
+            type = JOT_AS_OBJECT(value)->type;
+            return type == JOT_TYPE_INT_BOX ? JOT_TYPE_INT : type;
+        default:
+            return jot_value_tag_types[value.bits >> 48 & 7];
+    }
+}
+
+int jot_ValueSetInt(jot_Heap* heap, jot_Value* value, int64_t integer)
+{
+    jot_IntBox* box;
+    
+    if(JOT_FITS_SMALL_INT(integer))
+    {
+        JOT_SET_SMALL_INT(value, integer);
+        return 1;
+    }
+    box = (jot_IntBox*) jot_HeapAllocate(heap, JOT_TYPE_INT_BOX, sizeof(jot_IntBox));
+    if(box == NULL)
+    {
+        return 0;
+    }
+    box->value = integer;
+    JOT_SET_OBJECT(value, box);
+    return 1;
+}
+
+void jot_ValueSetNum(jot_Value* value, double number)
+{
+    if(number != number)
+    {
+        /* Whichever NaN 0/0 makes, it stays clear of the tags. */
+        number = 0.0;
+        number /= number;
+    }
+    JOT_SET_NUM(value, number);
+}
@@ -0,0 +1,314 @@
+/*
+    jot - Values
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#ifndef JOT_VALUE_H
+#define JOT_VALUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "jot_alloc.h"
+
+typedef enum
+{
+    JOT_TYPE_NIL,
+    JOT_TYPE_BOOL,
+    JOT_TYPE_INT,
+    JOT_TYPE_NUM,
+    
+    /* Everything from here on is a jot_Object. */
+    JOT_TYPE_STR,
+    JOT_TYPE_TABLE,
+    JOT_TYPE_ARRAY,
+    JOT_TYPE_FUNC,      /* a jot_Closure */
+    JOT_TYPE_NATIVE,    /* a jot_Native; a func too, as far as scripts can tell */
+    
+    /* Objects that are never a value, only part of a function. */
+    JOT_TYPE_PROTO,
+    JOT_TYPE_UPVALUE,
+    
+    /* An int too big to fit in a value, which holds one of these instead. Scripts only ever see an int. */
+    JOT_TYPE_INT_BOX,
+    
+    JOT_TYPE_COUNT
+} jot_Type;
+
+/*
+    The header every object starts with. Objects are only ever made
+    through a jot_Heap, which links them all together so it can free them.
+*/
+typedef struct jot_Object
+{
+    struct jot_Object* next;
+    jot_Type type;
+    /* JOT_GC_WHITE, JOT_GC_GRAY or JOT_GC_BLACK. */
+    unsigned char color;
+} jot_Object;
+
+/*
+    A value, as held in registers, constants, tables and arrays: one 64-bit
+    word. Doubles are stored as they are. Everything else hides in the NaN
+    space, with a tag in the top 16 bits and a payload in the other 48:
+
+        0x7FF9  an int, plus 2^47 so that it's never negative
+        0x7FFA  nil (payload 0), false (1) or true (3)
+        0x7FFB  a str          0x7FFC  a table
+        0x7FFD  an array       0x7FFE  a func (a jot_Closure)
+        0x7FFF  any other object, whose header says what it is
+
+    Ints that don't fit in 48 bits go in a jot_IntBox. Only an int that
+    doesn't fit is ever boxed, so two ints are equal exactly when their
+    values are, unless both are boxed.
+
+    The NaNs that floating point arithmetic makes (0x7FF8... and
+    0xFFF8...) stay clear of the tags. A NaN with a payload from outside
+    has to be stored with jot_ValueSetNum, which quiets it, rather than
+    JOT_SET_NUM. Pointers have to fit in 48 bits, which jot_HeapAllocate
+    makes sure of.
+
+    Only use a value through the macros below, which are all that would
+    need to change if the representation did.
+*/
+typedef union
+{
+    uint64_t bits;
+    double number;
+} jot_Value;
+
+typedef struct
+{
+    jot_Object object;
+    int64_t value;
+} jot_IntBox;
+
+#define JOT_VALUE_BITS(high) ((uint64_t) (high) << 32)
+#define JOT_VALUE_TAG_MASK JOT_VALUE_BITS(0xFFFF0000UL)
+#define JOT_VALUE_PAYLOAD_MASK (~JOT_VALUE_TAG_MASK)
+#define JOT_VALUE_TAG_INT JOT_VALUE_BITS(0x7FF90000UL)
+#define JOT_VALUE_TAG_SPECIAL JOT_VALUE_BITS(0x7FFA0000UL)
+#define JOT_VALUE_TAG_STR JOT_VALUE_BITS(0x7FFB0000UL)
+#define JOT_VALUE_TAG_TABLE JOT_VALUE_BITS(0x7FFC0000UL)
+#define JOT_VALUE_TAG_ARRAY JOT_VALUE_BITS(0x7FFD0000UL)
+#define JOT_VALUE_TAG_FUNC JOT_VALUE_BITS(0x7FFE0000UL)
+#define JOT_VALUE_TAG_OBJECT JOT_VALUE_BITS(0x7FFF0000UL)
+#define JOT_VALUE_NIL (JOT_VALUE_TAG_SPECIAL | 0)
+#define JOT_VALUE_FALSE (JOT_VALUE_TAG_SPECIAL | 1)
+#define JOT_VALUE_TRUE (JOT_VALUE_TAG_SPECIAL | 3)
+/* Ints are stored biased by this, which makes reading or writing one a single add. */
+#define JOT_VALUE_INT_BIAS (JOT_VALUE_TAG_INT | JOT_VALUE_BITS(0x8000UL))
+
+#define JOT_VALUE_TAG(v) ((v).bits & JOT_VALUE_TAG_MASK)
+/* Most tags say the type outright. Nil and bools share theirs, and the last one needs the header read. */
+#define JOT_VALUE_TYPE(v) (JOT_IS_NUM(v) ? JOT_TYPE_NUM \
+    : JOT_VALUE_TAG(v) == JOT_VALUE_TAG_SPECIAL || JOT_VALUE_TAG(v) == JOT_VALUE_TAG_OBJECT ? jot_ValueType(v) \
+    : jot_value_tag_types[(v).bits >> 48 & 7])
+/* Anything outside the seven tags is a double, which one unsigned compare can tell. */
+#define JOT_IS_NUM(v) ((v).bits - JOT_VALUE_TAG_INT > JOT_VALUE_TAG_OBJECT - JOT_VALUE_TAG_INT + JOT_VALUE_PAYLOAD_MASK)
+#define JOT_IS_NIL(v) ((v).bits == JOT_VALUE_NIL)
+#define JOT_IS_BOOL(v) (((v).bits & ~(uint64_t) 2) == JOT_VALUE_FALSE)
+#define JOT_IS_SMALL_INT(v) ((v).bits - JOT_VALUE_TAG_INT <= JOT_VALUE_PAYLOAD_MASK)
+#define JOT_IS_INT(v) (JOT_IS_SMALL_INT(v) || (JOT_VALUE_TAG(v) == JOT_VALUE_TAG_OBJECT && JOT_AS_OBJECT(v)->type == JOT_TYPE_INT_BOX))
+#define JOT_IS_STR(v) (JOT_VALUE_TAG(v) == JOT_VALUE_TAG_STR)
+#define JOT_IS_TABLE(v) (JOT_VALUE_TAG(v) == JOT_VALUE_TAG_TABLE)
+#define JOT_IS_ARRAY(v) (JOT_VALUE_TAG(v) == JOT_VALUE_TAG_ARRAY)
+#define JOT_IS_OBJECT(v) ((v).bits - JOT_VALUE_TAG_STR <= JOT_VALUE_TAG_OBJECT - JOT_VALUE_TAG_STR + JOT_VALUE_PAYLOAD_MASK)
+/* Only nil and false are false. */
+#define JOT_IS_TRUTHY(v) (((v).bits | 1) != JOT_VALUE_FALSE)
+
+#define JOT_AS_BOOL(v) ((v).bits == JOT_VALUE_TRUE)
+#define JOT_AS_SMALL_INT(v) ((int64_t) ((v).bits - JOT_VALUE_INT_BIAS))
+#define JOT_AS_INT(v) (JOT_IS_SMALL_INT(v) ? JOT_AS_SMALL_INT(v) : ((const jot_IntBox*) JOT_AS_OBJECT(v))->value)
+#define JOT_AS_NUM(v) ((v).number)
+#define JOT_AS_OBJECT(v) ((jot_Object*) (uintptr_t) ((v).bits & JOT_VALUE_PAYLOAD_MASK))
+
+/* Whether an int fits in a value without being boxed. */
+#define JOT_FITS_SMALL_INT(i) ((uint64_t) (i) + JOT_VALUE_BITS(0x8000UL) <= JOT_VALUE_PAYLOAD_MASK)
+
+/* These store into the jot_Value that p points at. Ints that might not fit go through jot_ValueSetInt. */
+#define JOT_SET_NIL(p) ((p)->bits = JOT_VALUE_NIL)
+#define JOT_SET_BOOL(p, b) ((p)->bits = (b) ? JOT_VALUE_TRUE : JOT_VALUE_FALSE)
+#define JOT_SET_SMALL_INT(p, i) ((p)->bits = (uint64_t) (i) + JOT_VALUE_INT_BIAS)
+#define JOT_SET_NUM(p, n) ((p)->number = (n))
+#define JOT_SET_OBJECT(p, o) ((p)->bits = jot_value_tags[((jot_Object*) (o))->type] | (uint64_t) (uintptr_t) (o))
+
+/* The tag each type of object is stored with, and the type of each tag, by its low three bits. */
+extern const uint64_t jot_value_tags[JOT_TYPE_COUNT];
+extern const jot_Type jot_value_tag_types[8];
+
+/* Where the collector is in a cycle; see jot_gc.h. */
+typedef enum
+{
+    JOT_GC_PAUSE,
+    JOT_GC_PROPAGATE,
+    JOT_GC_ATOMIC,
+    JOT_GC_SWEEP
+} jot_GcPhase;
+
+enum
+{
+    /* Not reached yet this cycle, and freed at the end of it if it still hasn't been. */
+    JOT_GC_WHITE,
+    /* Reached, but what it refers to still has to be looked at. */
+    JOT_GC_GRAY,
+    /* Reached, and everything it refers to has been too. */
+    JOT_GC_BLACK,
+    
+    /* Pause times are counted in buckets of powers of two microseconds, up to about 4 seconds. */
+    JOT_GC_HISTOGRAM_SIZE = 24
+};
+
+/* An object waiting to be scanned, and how far a big one has already got. */
+typedef struct
+{
+    jot_Object* object;
+    size_t position;
+} jot_GcGray;
+
+typedef struct
+{
+    jot_GcGray* items;
+    size_t count;
+    size_t capacity;
+} jot_GcGrayStack;
+
+/* The collector's settings, progress and statistics, which every heap has. */
+typedef struct
+{
+    /*
+        How big the heap can get before a cycle starts, as a percentage of
+        what was left after the last one: 200 waits until it's doubled.
+    */
+    unsigned int pause;
+    /*
+        How much work a step does for what's been allocated since the last
+        one, as a percentage: at 100, a step looks at one value for each 8
+        bytes.
+    */
+    unsigned int multiplier;
+    /* Bytes allocated between steps. */
+    size_t step_size;
+    /* The most work any step does, however far behind the collector is; see jot_gc.h for what isn't counted. */
+    size_t budget;
+    /* Stops steps from happening on their own; jot_GcStep and jot_GcCollect still work. */
+    int stopped;
+    /* What pauses are timed with, in seconds, or NULL for clock(). */
+    double (*clock)(void);
+    
+    jot_GcPhase phase;
+    /* A step is due once the heap's bytes reach this. */
+    size_t threshold;
+    jot_GcGrayStack gray;
+    /* Set when there wasn't memory to push a gray object, which leaves it to be found by a walk over the heap. */
+    int overflowed;
+    /* The link to the next object that walk looks at, or NULL if there isn't one under way. */
+    jot_Object** rescan;
+    /* The link to the next object to sweep. */
+    jot_Object** sweep;
+    
+    unsigned long cycles;
+    unsigned long steps;
+    size_t freed;
+    /* How many steps took less than 1 microsecond, then 1 to 2, 2 to 4, and so on, and the longest. */
+    unsigned long pauses[JOT_GC_HISTOGRAM_SIZE];
+    double longest;
+} jot_Gc;
+
+/*
+    Owns every object made through it, and frees whatever's left of them
+    with itself. A VM collects the ones it can't reach any more as it goes
+    (see jot_gc.h); without one, nothing is freed before then. bytes counts
+    the objects and all the memory they hang on to.
+*/
+typedef struct
+{
+    jot_Allocator* allocator;
+    jot_Object* objects;
+    size_t count;
+    size_t bytes;
+    jot_Gc gc;
+} jot_Heap;
+
+void jot_HeapInit(jot_Heap* self, jot_Allocator* allocator);
+void jot_HeapFree(jot_Heap* self);
+
+/* Makes an object of size bytes with its header filled in, or returns NULL if memory runs out. */
+jot_Object* jot_HeapAllocate(jot_Heap* self, jot_Type type, size_t size);
+/* Frees an object made with jot_HeapAllocate, which must be size bytes. */
+void jot_HeapFreeObject(jot_Heap* self, jot_Object* object, size_t size);
+/* Memory an object hangs on to, like the entries of a table. */
+void* jot_HeapResize(jot_Heap* self, jot_AllocSubsystem subsystem, void* pointer, size_t old_size, size_t size);
+void jot_HeapRelease(jot_Heap* self, jot_AllocSubsystem subsystem, void* pointer, size_t size);
+/* Frees an object of any type, which has to have been unlinked from the heap. */
+void jot_ObjectFree(jot_Heap* heap, jot_Object* object);
+
+/*
+    Tells the collector value is being stored in object o, so that if o
+    has already been scanned, what's stored in it gets marked too. Every
+    store of a value that could be an object into an object needs one,
+    before the collector next gets to take a step, which is only ever
+    where a VM lets it; see jot_gc.h. JOT_GC_BARRIER_OBJECT is the same,
+    for storing an object pointer p.
+*/
+#define JOT_GC_BARRIER(heap, o, value) \
+    do { \
+        if((o)->color == JOT_GC_BLACK && JOT_IS_OBJECT(value) && JOT_AS_OBJECT(value)->color == JOT_GC_WHITE) \
+        { \
+            jot_GcBarrier(heap, JOT_AS_OBJECT(value)); \
+        } \
+    } while(0)
+
+#define JOT_GC_BARRIER_OBJECT(heap, o, p) \
+    do { \
+        if((o)->color == JOT_GC_BLACK && (p)->color == JOT_GC_WHITE) \
+        { \
+            jot_GcBarrier(heap, p); \
+        } \
+    } while(0)
+
+void jot_GcBarrier(jot_Heap* heap, jot_Object* stored);
+/*
+    Tells the collector what's in an object has been moved around inside
+    it, as a table's entries are when it's rehashed, so a scan that was
+    part way through it has to start over.
+*/
+void jot_GcMoved(jot_Heap* heap, jot_Object* object);
+
+/* The name scripts know a type by. */
+const char* jot_TypeName(jot_Type type);
+/*
+    Whether two values are ==: numbers are equal if they are the same
+    number, even when one is an integer and the other a float, strings if
+    they have the same text, and anything else only if it's the same object.
+*/
+int jot_ValueEqual(jot_Value a, jot_Value b);
+/* The type scripts see a value as, which is JOT_TYPE_INT for a boxed int. */
+jot_Type jot_ValueType(jot_Value value);
+/* Stores an int, boxing it if it doesn't fit. Returns 0 if memory runs out. */
+int jot_ValueSetInt(jot_Heap* heap, jot_Value* value, int64_t integer);
+/* Stores a double, turning any NaN into the one arithmetic makes. */
+void jot_ValueSetNum(jot_Value* value, double number);
+
+#endif
@@ -0,0 +1,1606 @@
+/*
+    jot - Virtual Machine
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "jot_array.h"
+#include "jot_compile.h"
+#include "jot_fold.h"
+#include "jot_gc.h"
+#include "jot_num.h"
+#include "jot_parse.h"
+#include "jot_vm.h"
+
+/*
+    Threaded dispatch jumps straight from the end of one instruction to the
+    next one's code, through a table of label addresses, which gives each
+    instruction a branch of its own to predict. Compilers that can't take
+    the address of a label get a switch in a loop instead. GCC needs
+    -fno-gcse -fno-crossjumping to keep the jumps apart, rather than
+    merging them back into one.
+*/
+#if defined(__GNUC__) && !defined(JOT_VM_NO_COMPUTED_GOTO)
+#define JOT_VM_COMPUTED_GOTO
+#endif
+
+enum
+{
+    JOT_VM_MIN_STACK = 256,
+    JOT_VM_MAX_STACK = 1 << 22,
+    JOT_VM_MIN_FRAMES = 16,
+    JOT_VM_MAX_FRAMES = 1 << 18,
+    /* Script functions running under C, each of which takes some C stack. */
+    JOT_VM_MAX_DEPTH = 200
+};
+
+static int jot_VmExecute(jot_Vm* self, size_t entry);
+
+const char* jot_VmDispatch(void)
+{
+#ifdef JOT_VM_COMPUTED_GOTO
+    return "computed goto";
+#else
+    return "switch";
+#endif
+}
+
+int jot_VmFail(jot_Vm* self, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    vsprintf(self->error, format, args);
+    va_end(args);
+    self->error_source = NULL;
+    self->error_offset = 0;
+    self->error_located = 0;
+    return -1;
+}
+
+/* Points the error at what the innermost script function was running, unless it's already been pointed somewhere. */
+static void jot_VmLocate(jot_Vm* self)
+{
+    const jot_Frame* frame;
+    const jot_Proto* proto;
+    
+    if(self->error_located || self->frame_count == 0)
+    {
+        return;
+    }
+    frame = &self->frames[self->frame_count - 1];
+    proto = frame->closure->proto;
+    self->error_source = proto->source;
+    self->error_offset = proto->offsets[frame->pc - proto->code - 1];
+    self->error_located = 1;
+}
+
+/* For error messages: "nil", or the type with an article, like "a table" or "an int". */
+static const char* jot_VmDescribe(const jot_Value* value)
+{
+    switch(JOT_VALUE_TYPE(*value))
+    {
+        case JOT_TYPE_NIL: return "nil";
+        case JOT_TYPE_BOOL: return "a bool";
+        case JOT_TYPE_INT: return "an int";
+        case JOT_TYPE_NUM: return "a num";
+        case JOT_TYPE_STR: return "a str";
+        case JOT_TYPE_TABLE: return "a table";
+        case JOT_TYPE_ARRAY: return "an array";
+        default: return "a func";
+    }
+}
+
+/* Compiling may swap a comparison's operands around, so they're named in the same order either way. */
+static void jot_VmFailCompare(jot_Vm* self, const jot_Value* a, const jot_Value* b)
+{
+    if(JOT_VALUE_TYPE(*a) > JOT_VALUE_TYPE(*b))
+    {
+        jot_VmFailCompare(self, b, a);
+        return;
+    }
+    jot_VmFail(self, "can't compare %s with %s", jot_VmDescribe(a), jot_VmDescribe(b));
+}
+
+/* Makes sure the stack has count slots from index on. The stack may move, which open upvalues follow. */
+static int jot_VmReserve(jot_Vm* self, size_t index, size_t count)
+{
+    jot_Value* stack;
+    jot_Upvalue* upvalue;
+    size_t size;
+    size_t i;
+    
+    if(index + count <= self->stack_size)
+    {
+        return 1;
+    }
+    if(index + count > JOT_VM_MAX_STACK)
+    {
+        jot_VmFail(self, "stack overflow");
+        return 0;
+    }
+    size = self->stack_size ? self->stack_size : JOT_VM_MIN_STACK;
+    while(size < index + count)
+    {
+        size *= 2;
+    }
+    if(size > JOT_VM_MAX_STACK)
+    {
+        size = JOT_VM_MAX_STACK;
+    }
+    stack = jot_Realloc(self->allocator, JOT_ALLOC_VM, self->stack, self->stack_size * sizeof(jot_Value), size * sizeof(jot_Value));
+    if(stack == NULL)
+    {
+        jot_VmFail(self, "out of memory");
+        return 0;
+    }
+    for(i = self->stack_size; i < size; i++)
+    {
+        JOT_SET_NIL(&stack[i]);
+    }
+    self->stack = stack;
+    self->stack_size = size;
+    for(upvalue = self->open_upvalues; upvalue != NULL; upvalue = upvalue->next_open)
+    {
+        upvalue->value = stack + upvalue->index;
+    }
+    return 1;
+}
+
+static jot_Frame* jot_VmPushFrame(jot_Vm* self)
+{
+    jot_Frame* frames;
+    size_t capacity;
+    
+    if(self->frame_count == self->frame_capacity)
+    {
+        if(self->frame_capacity >= JOT_VM_MAX_FRAMES)
+        {
+            jot_VmFail(self, "stack overflow");
+            return NULL;
+        }
+        capacity = self->frame_capacity ? self->frame_capacity * 2 : JOT_VM_MIN_FRAMES;
+        frames = jot_Realloc(self->allocator, JOT_ALLOC_VM, self->frames, self->frame_capacity * sizeof(jot_Frame), capacity * sizeof(jot_Frame));
+        if(frames == NULL)
+        {
+            jot_VmFail(self, "out of memory");
+            return NULL;
+        }
+        self->frames = frames;
+        self->frame_capacity = capacity;
+    }
+    return &self->frames[self->frame_count++];
+}
+
+/* The first slot that nothing running is using, where C can put a call. */
+static size_t jot_VmFreeSlot(const jot_Vm* self)
+{
+    const jot_Frame* frame;
+    size_t slot = self->native_top;
+    size_t end;
+    
+    if(self->frame_count > 0)
+    {
+        frame = &self->frames[self->frame_count - 1];
+        end = frame->base + frame->closure->proto->register_count;
+        if(end > slot)
+        {
+            slot = end;
+        }
+    }
+    return slot;
+}
+
+/* The open upvalue for stack slot index, made if there isn't one yet. */
+static jot_Upvalue* jot_VmCapture(jot_Vm* self, size_t index)
+{
+    jot_Upvalue** link = &self->open_upvalues;
+    jot_Upvalue* upvalue;
+    
+    while((upvalue = *link) != NULL && upvalue->index > index)
+    {
+        link = &upvalue->next_open;
+    }
+    if(upvalue != NULL && upvalue->index == index)
+    {
+        return upvalue;
+    }
+    upvalue = jot_UpvalueNew(&self->heap, self->stack + index, index);
+    if(upvalue == NULL)
+    {
+        return NULL;
+    }
+    upvalue->next_open = *link;
+    *link = upvalue;
+    return upvalue;
+}
+
+/* Closes the upvalues of stack slot index and above, which are going out of scope. */
+static void jot_VmClose(jot_Vm* self, size_t index)
+{
+    jot_Upvalue* upvalue;
+    
+    while((upvalue = self->open_upvalues) != NULL && upvalue->index >= index)
+    {
+        JOT_GC_BARRIER(&self->heap, &upvalue->object, *upvalue->value);
+        upvalue->closed = *upvalue->value;
+        upvalue->value = &upvalue->closed;
+        self->open_upvalues = upvalue->next_open;
+        upvalue->next_open = NULL;
+    }
+}
+
+/*
+    Moves count values at stack slot from down to slot to. If wanted is -1,
+    they all go, and the top is left after them; otherwise exactly wanted
+    go, padded out with nils.
+*/
+static void jot_VmMoveResults(jot_Vm* self, size_t from, size_t to, size_t count, int wanted)
+{
+    jot_Value* stack = self->stack;
+    size_t i;
+    
+    if(wanted < 0)
+    {
+        for(i = 0; i < count; i++)
+        {
+            stack[to + i] = stack[from + i];
+        }
+        self->top = to + count;
+    }
+    else
+    {
+        for(i = 0; i < (size_t) wanted; i++)
+        {
+            if(i < count)
+            {
+                stack[to + i] = stack[from + i];
+            }
+            else
+            {
+                JOT_SET_NIL(&stack[to + i]);
+            }
+        }
+    }
+}
+
+/*
+    Starts calling what's in stack slot function, with the count values
+    after it as arguments, wanting results results (or -1 for all). A
+    native runs straight away, leaving its results from slot function on,
+    and this returns 0. A script function gets a frame for the interpreter
+    loop to run, and this returns 1. Returns -1 if the call fails.
+*/
+static int jot_VmPrecall(jot_Vm* self, size_t function, size_t count, int results)
+{
+    jot_Value* callee = &self->stack[function];
+    jot_Closure* closure;
+    jot_Native* native;
+    jot_Proto* proto;
+    jot_Frame* frame;
+    jot_Value* stack;
+    size_t base;
+    size_t native_top;
+    size_t i;
+    int n;
+    
+    switch(JOT_VALUE_TYPE(*callee))
+    {
+        case JOT_TYPE_FUNC:
+            closure = (jot_Closure*) JOT_AS_OBJECT(*callee);
+            proto = closure->proto;
+            if(!jot_VmReserve(self, function + 1, count + proto->register_count))
+            {
+                return -1;
+            }
+            stack = self->stack;
+            base = function + 1;
+            if(proto->vararg)
+            {
+                /* The named parameters are copied above the arguments, so that what's left over stays where it was for '...'. */
+                base += count;
+                for(i = 0; i < proto->param_count; i++)
+                {
+                    if(i < count)
+                    {
+                        stack[base + i] = stack[function + 1 + i];
+                    }
+                    else
+                    {
+                        JOT_SET_NIL(&stack[base + i]);
+                    }
+                }
+                i = proto->param_count;
+            }
+            else
+            {
+                i = count < proto->param_count ? count : proto->param_count;
+            }
+            for(; i < proto->register_count; i++)
+            {
+                JOT_SET_NIL(&stack[base + i]);
+            }
+            frame = jot_VmPushFrame(self);
+            if(frame == NULL)
+            {
+                return -1;
+            }
+            frame->closure = closure;
+            frame->pc = proto->code;
+            frame->function = function;
+            frame->base = base;
+            frame->varargs = function + 1 + proto->param_count;
+            frame->vararg_count = proto->vararg && count > proto->param_count ? count - proto->param_count : 0;
+            frame->results = results;
+            return 1;
+        case JOT_TYPE_NATIVE:
+            native = (jot_Native*) JOT_AS_OBJECT(*callee);
+            if(!jot_VmReserve(self, function + 1, count + JOT_NATIVE_MIN_RESULTS))
+            {
+                return -1;
+            }
+            /* The room for results is cleared, since the collector would look at it if the native ran a script. */
+            for(i = count; i < count + JOT_NATIVE_MIN_RESULTS; i++)
+            {
+                JOT_SET_NIL(&self->stack[function + 1 + i]);
+            }
+            native_top = self->native_top;
+            self->native_top = function + 1 + count + JOT_NATIVE_MIN_RESULTS;
+            n = native->function(self, &self->stack[function + 1], (int) count);
+            self->native_top = native_top;
+            if(n < 0)
+            {
+                return -1;
+            }
+            jot_VmMoveResults(self, function + 1, function, (size_t) n, results);
+            return 0;
+        default:
+            jot_VmFail(self, "can't call %s", jot_VmDescribe(callee));
+            return -1;
+    }
+}
+
+/* Calls what's in stack slot function from C, and runs it to the end. */
+static int jot_VmCallAt(jot_Vm* self, size_t function, size_t count, int results)
+{
+    int ok;
+    
+    if(self->depth >= JOT_VM_MAX_DEPTH)
+    {
+        jot_VmFail(self, "too many nested calls");
+        return 0;
+    }
+    switch(jot_VmPrecall(self, function, count, results))
+    {
+        case 0:
+            return 1;
+        case 1:
+            self->depth++;
+            ok = jot_VmExecute(self, self->frame_count - 1);
+            self->depth--;
+            return ok;
+        default:
+            return 0;
+    }
+}
+
+/* An integer, for bitwise operators and array indexes: floats only do if they're whole. */
+static int jot_VmToInt(const jot_Value* value, int64_t* result)
+{
+    if(JOT_IS_INT(*value))
+    {
+        *result = JOT_AS_INT(*value);
+        return 1;
+    }
+    return JOT_IS_NUM(*value) && jot_NumToInt(JOT_AS_NUM(*value), result);
+}
+
+/* Stores an int, boxing it if it has to. */
+static int jot_VmSetInt(jot_Vm* self, jot_Value* result, int64_t integer)
+{
+    if(JOT_FITS_SMALL_INT(integer))
+    {
+        JOT_SET_SMALL_INT(result, integer);
+        return 1;
+    }
+    if(!jot_ValueSetInt(&self->heap, result, integer))
+    {
+        jot_VmFail(self, "out of memory");
+        return 0;
+    }
+    return 1;
+}
+
+/* Floored, like the integer %: the result takes the divisor's sign. */
+static double jot_VmFloatMod(double value, double divisor)
+{
+    double result = fmod(value, divisor);
+    if(result != 0 && (result < 0) != (divisor < 0))
+    {
+        result += divisor;
+    }
+    return result;
+}
+
+/* Arithmetic and bitwise operators, for whatever the interpreter loop doesn't do itself. */
+static int jot_VmArith(jot_Vm* self, jot_Op op, const jot_Value* a, const jot_Value* b, jot_Value* result)
+{
+    const jot_Value* bad;
+    int64_t x, y;
+    double p, q;
+    
+    if(op >= JOT_OP_BAND && op <= JOT_OP_SHR)
+    {
+        if(!jot_VmToInt(a, &x) || !jot_VmToInt(b, &y))
+        {
+            bad = jot_VmToInt(a, &x) ? b : a;
+            if(JOT_IS_NUM(*bad))
+            {
+                jot_VmFail(self, "number has no integer value");
+            }
+            else
+            {
+                jot_VmFail(self, "can't do bitwise operations on %s", jot_VmDescribe(bad));
+            }
+            return 0;
+        }
+        switch(op)
+        {
+            case JOT_OP_BAND: x &= y; break;
+            case JOT_OP_BOR: x |= y; break;
+            case JOT_OP_BXOR: x ^= y; break;
+            case JOT_OP_SHL: x = jot_NumShiftLeft(x, y); break;
+            default: x = y <= -64 ? 0 : jot_NumShiftLeft(x, -y); break;
+        }
+        return jot_VmSetInt(self, result, x);
+    }
+    if(JOT_IS_INT(*a) && JOT_IS_INT(*b))
+    {
+        x = JOT_AS_INT(*a);
+        y = JOT_AS_INT(*b);
+        switch(op)
+        {
+            case JOT_OP_ADD: return jot_VmSetInt(self, result, (int64_t) ((uint64_t) x + (uint64_t) y));
+            case JOT_OP_SUB: return jot_VmSetInt(self, result, (int64_t) ((uint64_t) x - (uint64_t) y));
+            case JOT_OP_MUL: return jot_VmSetInt(self, result, (int64_t) ((uint64_t) x * (uint64_t) y));
+            case JOT_OP_MOD:
+                if(y == 0)
+                {
+                    jot_VmFail(self, "integer modulo by zero");
+                    return 0;
+                }
+                return jot_VmSetInt(self, result, jot_NumMod(x, y));
+            default:
+                break;
+        }
+    }
+    if(!(JOT_IS_INT(*a) || JOT_IS_NUM(*a)) || !(JOT_IS_INT(*b) || JOT_IS_NUM(*b)))
+    {
+        jot_VmFail(self, "can't do arithmetic on %s", jot_VmDescribe(JOT_IS_INT(*a) || JOT_IS_NUM(*a) ? b : a));
+        return 0;
+    }
+    p = JOT_IS_INT(*a) ? (double) JOT_AS_INT(*a) : JOT_AS_NUM(*a);
+    q = JOT_IS_INT(*b) ? (double) JOT_AS_INT(*b) : JOT_AS_NUM(*b);
+    switch(op)
+    {
+        case JOT_OP_ADD: p += q; break;
+        case JOT_OP_SUB: p -= q; break;
+        case JOT_OP_MUL: p *= q; break;
+        case JOT_OP_DIV: p /= q; break;
+        case JOT_OP_MOD: p = jot_VmFloatMod(p, q); break;
+        default: p = pow(p, q); break;
+    }
+    JOT_SET_NUM(result, p);
+    return 1;
+}
+
+/* a < b, or a <= b if or_equal, for anything but two integers or two floats. Returns -1 if they can't be compared. */
+static int jot_VmLess(jot_Vm* self, const jot_Value* a, const jot_Value* b, int or_equal)
+{
+    int order;
+    
+    switch(JOT_VALUE_TYPE(*a))
+    {
+        case JOT_TYPE_INT:
+            if(JOT_IS_INT(*b))
+            {
+                return or_equal ? JOT_AS_INT(*a) <= JOT_AS_INT(*b) : JOT_AS_INT(*a) < JOT_AS_INT(*b);
+            }
+            if(JOT_IS_NUM(*b))
+            {
+                return or_equal ? jot_NumIntLessEqualNum(JOT_AS_INT(*a), JOT_AS_NUM(*b)) : jot_NumIntLessNum(JOT_AS_INT(*a), JOT_AS_NUM(*b));
+            }
+            break;
+        case JOT_TYPE_NUM:
+            if(JOT_IS_NUM(*b))
+            {
+                return or_equal ? JOT_AS_NUM(*a) <= JOT_AS_NUM(*b) : JOT_AS_NUM(*a) < JOT_AS_NUM(*b);
+            }
+            if(JOT_IS_INT(*b))
+            {
+                return or_equal ? jot_NumNumLessEqualInt(JOT_AS_NUM(*a), JOT_AS_INT(*b)) : jot_NumNumLessInt(JOT_AS_NUM(*a), JOT_AS_INT(*b));
+            }
+            break;
+        case JOT_TYPE_STR:
+            if(JOT_VALUE_TYPE(*b) == JOT_TYPE_STR)
+            {
+                order = jot_StringCompare((const jot_String*) JOT_AS_OBJECT(*a), (const jot_String*) JOT_AS_OBJECT(*b));
+                return or_equal ? order <= 0 : order < 0;
+            }
+            break;
+        default:
+            break;
+    }
+    jot_VmFailCompare(self, a, b);
+    return -1;
+}
+
+/* R[A] against a small integer operand, for LTI and the like. Returns -1 if R[A] isn't a number. */
+static int jot_VmCompareImmediate(jot_Vm* self, jot_Op op, const jot_Value* a, int b)
+{
+    jot_Value immediate;
+    double p;
+    
+    if(JOT_IS_INT(*a))
+    {
+        switch(op)
+        {
+            case JOT_OP_LTI: return JOT_AS_INT(*a) < b;
+            case JOT_OP_LEI: return JOT_AS_INT(*a) <= b;
+            case JOT_OP_GTI: return JOT_AS_INT(*a) > b;
+            default: return JOT_AS_INT(*a) >= b;
+        }
+    }
+    if(!JOT_IS_NUM(*a))
+    {
+        JOT_SET_SMALL_INT(&immediate, b);
+        jot_VmFailCompare(self, a, &immediate);
+        return -1;
+    }
+    /* Small enough to be exact as a double. */
+    p = JOT_AS_NUM(*a);
+    switch(op)
+    {
+        case JOT_OP_LTI: return p < b;
+        case JOT_OP_LEI: return p <= b;
+        case JOT_OP_GTI: return p > b;
+        default: return p >= b;
+    }
+}
+
+static int jot_VmGetIndex(jot_Vm* self, const jot_Value* object, const jot_Value* key, jot_Value* result)
+{
+    const jot_Array* array;
+    const jot_Value* found;
+    int64_t index;
+    
+    switch(JOT_VALUE_TYPE(*object))
+    {
+        case JOT_TYPE_TABLE:
+            found = jot_TableFind((const jot_Table*) JOT_AS_OBJECT(*object), *key);
+            if(found != NULL)
+            {
+                *result = *found;
+            }
+            else
+            {
+                JOT_SET_NIL(result);
+            }
+            return 1;
+        case JOT_TYPE_ARRAY:
+            array = (const jot_Array*) JOT_AS_OBJECT(*object);
+            if(!jot_VmToInt(key, &index))
+            {
+                jot_VmFail(self, "can't index an array with %s", jot_VmDescribe(key));
+                return 0;
+            }
+            if(index >= 0 && (uint64_t) index < array->count)
+            {
+                JOT_ARRAY_GET(array, (size_t) index, result);
+            }
+            else
+            {
+                JOT_SET_NIL(result);
+            }
+            return 1;
+        default:
+            jot_VmFail(self, "can't index %s", jot_VmDescribe(object));
+            return 0;
+    }
+}
+
+static int jot_VmSetIndex(jot_Vm* self, const jot_Value* object, const jot_Value* key, const jot_Value* value)
+{
+    jot_Array* array;
+    int64_t index;
+    
+    switch(JOT_VALUE_TYPE(*object))
+    {
+        case JOT_TYPE_TABLE:
+            if(JOT_IS_NIL(*key))
+            {
+                jot_VmFail(self, "table key is nil");
+                return 0;
+            }
+            if(JOT_IS_NUM(*key) && JOT_AS_NUM(*key) != JOT_AS_NUM(*key))
+            {
+                jot_VmFail(self, "table key is NaN");
+                return 0;
+            }
+            if(!jot_TableSet(&self->heap, (jot_Table*) JOT_AS_OBJECT(*object), *key, *value))
+            {
+                jot_VmFail(self, "out of memory");
+                return 0;
+            }
+            return 1;
+        case JOT_TYPE_ARRAY:
+            array = (jot_Array*) JOT_AS_OBJECT(*object);
+            if(!jot_VmToInt(key, &index))
+            {
+                jot_VmFail(self, "can't index an array with %s", jot_VmDescribe(key));
+                return 0;
+            }
+            if(index >= 0 && (uint64_t) index < array->count)
+            {
+                if(!jot_ArraySet(&self->heap, array, (size_t) index, *value))
+                {
+                    jot_VmFail(self, "out of memory");
+                    return 0;
+                }
+                return 1;
+            }
+            /* Storing just past the end appends. */
+            if((uint64_t) index != array->count)
+            {
+                jot_VmFail(self, "array index out of range");
+                return 0;
+            }
+            if(!jot_ArrayPush(&self->heap, array, *value))
+            {
+                jot_VmFail(self, "out of memory");
+                return 0;
+            }
+            return 1;
+        default:
+            jot_VmFail(self, "can't index %s", jot_VmDescribe(object));
+            return 0;
+    }
+}
+
+/* The text a value has when concatenated, which numbers are formatted into buffer for. */
+static int jot_VmConcatText(const jot_Value* value, char* buffer, const char** text, size_t* length)
+{
+    const jot_String* string;
+    
+    switch(JOT_VALUE_TYPE(*value))
+    {
+        case JOT_TYPE_STR:
+            string = (const jot_String*) JOT_AS_OBJECT(*value);
+            *text = string->text;
+            *length = string->length;
+            return 1;
+        case JOT_TYPE_INT:
+            *text = buffer;
+            *length = jot_NumFormatInt(JOT_AS_INT(*value), buffer);
+            return 1;
+        case JOT_TYPE_NUM:
+            *text = buffer;
+            *length = jot_NumFormat(JOT_AS_NUM(*value), buffer);
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static int jot_VmConcat(jot_Vm* self, const jot_Value* a, const jot_Value* b, jot_Value* result)
+{
+    char a_buffer[JOT_NUM_FORMAT_SIZE];
+    char b_buffer[JOT_NUM_FORMAT_SIZE];
+    const char* a_text;
+    const char* b_text;
+    size_t a_length, b_length;
+    jot_String* string;
+    
+    if(!jot_VmConcatText(a, a_buffer, &a_text, &a_length))
+    {
+        jot_VmFail(self, "can't concatenate %s", jot_VmDescribe(a));
+        return 0;
+    }
+    if(!jot_VmConcatText(b, b_buffer, &b_text, &b_length))
+    {
+        jot_VmFail(self, "can't concatenate %s", jot_VmDescribe(b));
+        return 0;
+    }
+    /* Building a string up a piece at a time can then add each piece where it already is. */
+    if(JOT_IS_STR(*a))
+    {
+        string = jot_StringAppend(&self->heap, (const jot_String*) JOT_AS_OBJECT(*a), b_text, b_length);
+    }
+    else
+    {
+        string = jot_StringConcat(&self->heap, a_text, a_length, b_text, b_length);
+    }
+    if(string == NULL)
+    {
+        jot_VmFail(self, "out of memory");
+        return 0;
+    }
+    JOT_SET_OBJECT(result, string);
+    return 1;
+}
+
+/*
+    Steps a for loop over the value at stack slot index, with the value
+    after it as the loop's state, leaving names values after that. Returns
+    1 if there was another step, 0 if the loop is done, and -1 if it
+    failed.
+*/
+static int jot_VmForNext(jot_Vm* self, size_t index, unsigned int names)
+{
+    jot_Value* state = self->stack + index;
+    const jot_Array* array;
+    jot_Value key, value;
+    size_t position;
+    int64_t step;
+    unsigned int i;
+    
+    step = JOT_IS_SMALL_INT(state[1]) ? JOT_AS_SMALL_INT(state[1]) : JOT_IS_INT(state[1]) ? JOT_AS_INT(state[1]) : 0;
+    /* Counting up to an int is the loop there's most of, so it doesn't wait on the full type check. */
+    switch(JOT_IS_SMALL_INT(state[0]) ? JOT_TYPE_INT : JOT_VALUE_TYPE(state[0]))
+    {
+        case JOT_TYPE_INT:
+            if(step >= JOT_AS_INT(state[0]))
+            {
+                return 0;
+            }
+            if(!jot_VmSetInt(self, &state[2], step))
+            {
+                return -1;
+            }
+            i = 1;
+            break;
+        case JOT_TYPE_ARRAY:
+            array = (const jot_Array*) JOT_AS_OBJECT(state[0]);
+            if((uint64_t) step >= array->count)
+            {
+                return 0;
+            }
+            /* One name gets the element, and two get the index as well. */
+            if(names == 1)
+            {
+                JOT_ARRAY_GET(array, (size_t) step, &state[2]);
+            }
+            else
+            {
+                JOT_SET_SMALL_INT(&state[2], step);
+                JOT_ARRAY_GET(array, (size_t) step, &state[3]);
+            }
+            i = 2;
+            break;
+        case JOT_TYPE_TABLE:
+            position = (size_t) step;
+            if(!jot_TableNext((const jot_Table*) JOT_AS_OBJECT(state[0]), &position, &key, &value))
+            {
+                return 0;
+            }
+            state[2] = key;
+            if(names > 1)
+            {
+                state[3] = value;
+            }
+            step = (int64_t) position - 1;
+            i = 2;
+            break;
+        case JOT_TYPE_FUNC:
+        case JOT_TYPE_NATIVE:
+            /* Called with nothing until it gives back nil. */
+            state[2] = state[0];
+            if(!jot_VmCallAt(self, index + 2, 0, (int) names))
+            {
+                return -1;
+            }
+            state = self->stack + index;
+            return !JOT_IS_NIL(state[2]);
+        default:
+            jot_VmFail(self, "can't iterate over %s", jot_VmDescribe(&state[0]));
+            return -1;
+    }
+    for(; i < names; i++)
+    {
+        JOT_SET_NIL(&state[2 + i]);
+    }
+    return jot_VmSetInt(self, &state[1], step + 1) ? 1 : -1;
+}
+
+/* __extension__ keeps -pedantic from warning about label addresses, which aren't standard C. */
+#ifdef JOT_VM_COMPUTED_GOTO
+#define JOT_VM_LABEL(name) __extension__ &&jot_vm_op_##name,
+#define JOT_VM_CASE(name) jot_vm_op_##name:
+#define JOT_VM_NEXT() \
+    do { \
+        i = *pc++; \
+        count++; \
+        __extension__ ({ goto *jot_vm_labels[JOT_CODE_OP(i)]; }); \
+    } while(0)
+#else
+#define JOT_VM_CASE(name) case JOT_OP_##name:
+#define JOT_VM_NEXT() continue
+#endif
+
+/*
+    Lets the collector take a step if one is due. This is only done after
+    instructions that allocate, and at jumps and loops, and only where the
+    registers of the calls in progress are all the values there are.
+*/
+#define JOT_VM_COLLECT() \
+    do { \
+        if(self->heap.bytes >= self->heap.gc.threshold) \
+        { \
+            jot_GcStep(self); \
+        } \
+    } while(0)
+
+/* jot_VmSetInt, with the common case written out where the interpreter loop can't miss it. */
+#define JOT_VM_SET_INT(p, integer) \
+    do { \
+        if(JOT_FITS_SMALL_INT(integer)) \
+        { \
+            JOT_SET_SMALL_INT(p, integer); \
+        } \
+        else if(!jot_VmSetInt(self, p, integer)) \
+        { \
+            goto failed; \
+        } \
+    } while(0)
+
+/* Runs the frame at entry, and everything it calls, until it returns. */
+static int jot_VmExecute(jot_Vm* self, size_t entry)
+{
+#ifdef JOT_VM_COMPUTED_GOTO
+    static const void* const jot_vm_labels[JOT_OP_COUNT] = {
+        JOT_OPCODES(JOT_VM_LABEL)
+    };
+#endif
+    jot_Frame* frame;
+    jot_Closure* closure;
+    jot_Closure* made;
+    jot_Proto* proto;
+    const jot_Instruction* pc;
+    const jot_Value* k;
+    jot_Value* r;
+    jot_Instruction i;
+    uint64_t count = 0;
+    const jot_Value* rb;
+    const jot_Value* rc;
+    jot_Value* found;
+    jot_Value value;
+    jot_Table* table;
+    jot_Array* array;
+    int64_t x, y;
+    double p, q;
+    size_t a, n, j;
+    int result;
+    
+reenter:
+    frame = &self->frames[self->frame_count - 1];
+    closure = frame->closure;
+    pc = frame->pc;
+    k = closure->proto->constants;
+    r = self->stack + frame->base;
+    
+#ifdef JOT_VM_COMPUTED_GOTO
+    JOT_VM_NEXT();
+#else
+    for(;;)
+    {
+        i = *pc++;
+        count++;
+        switch(JOT_CODE_OP(i))
+        {
+#endif
+            JOT_VM_CASE(MOVE)
+                r[JOT_CODE_A(i)] = r[JOT_CODE_B(i)];
+                JOT_VM_NEXT();
+            JOT_VM_CASE(LOADK)
+                r[JOT_CODE_A(i)] = k[JOT_CODE_BX(i)];
+                JOT_VM_NEXT();
+            JOT_VM_CASE(LOADI)
+                JOT_SET_SMALL_INT(&r[JOT_CODE_A(i)], JOT_CODE_SBX(i));
+                JOT_VM_NEXT();
+            JOT_VM_CASE(LOADNIL)
+                a = JOT_CODE_A(i);
+                for(n = JOT_CODE_B(i) + 1; n > 0; n--)
+                {
+                    JOT_SET_NIL(&r[a++]);
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(LOADFALSE)
+                JOT_SET_BOOL(&r[JOT_CODE_A(i)], 0);
+                JOT_VM_NEXT();
+            JOT_VM_CASE(LOADTRUE)
+                JOT_SET_BOOL(&r[JOT_CODE_A(i)], 1);
+                JOT_VM_NEXT();
+            JOT_VM_CASE(GETUPVAL)
+                r[JOT_CODE_A(i)] = *closure->upvalues[JOT_CODE_B(i)]->value;
+                JOT_VM_NEXT();
+            JOT_VM_CASE(SETUPVAL)
+                JOT_GC_BARRIER(&self->heap, &closure->upvalues[JOT_CODE_B(i)]->object, r[JOT_CODE_A(i)]);
+                *closure->upvalues[JOT_CODE_B(i)]->value = r[JOT_CODE_A(i)];
+                JOT_VM_NEXT();
+            JOT_VM_CASE(GETGLOBAL)
+                found = jot_TableFindString(self->globals, (const jot_String*) JOT_AS_OBJECT(k[JOT_CODE_BX(i)]));
+                if(found != NULL)
+                {
+                    r[JOT_CODE_A(i)] = *found;
+                }
+                else
+                {
+                    JOT_SET_NIL(&r[JOT_CODE_A(i)]);
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(SETGLOBAL)
+                if(!jot_TableSet(&self->heap, self->globals, k[JOT_CODE_BX(i)], r[JOT_CODE_A(i)]))
+                {
+                    jot_VmFail(self, "out of memory");
+                    goto failed;
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(GETINDEX)
+                rb = &r[JOT_CODE_B(i)];
+                rc = &r[JOT_CODE_C(i)];
+                if(JOT_IS_ARRAY(*rb) && JOT_IS_SMALL_INT(*rc)
+                    && (uint64_t) JOT_AS_SMALL_INT(*rc) < ((jot_Array*) JOT_AS_OBJECT(*rb))->count)
+                {
+                    array = (jot_Array*) JOT_AS_OBJECT(*rb);
+                    JOT_ARRAY_GET(array, (size_t) JOT_AS_SMALL_INT(*rc), &r[JOT_CODE_A(i)]);
+                }
+                else if(JOT_IS_TABLE(*rb) && JOT_IS_SMALL_INT(*rc)
+                    && (uint64_t) JOT_AS_SMALL_INT(*rc) < ((jot_Table*) JOT_AS_OBJECT(*rb))->array_size)
+                {
+                    r[JOT_CODE_A(i)] = ((jot_Table*) JOT_AS_OBJECT(*rb))->items[JOT_AS_SMALL_INT(*rc)];
+                }
+                else if(!jot_VmGetIndex(self, rb, rc, &r[JOT_CODE_A(i)]))
+                {
+                    goto failed;
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(GETFIELD)
+                rb = &r[JOT_CODE_B(i)];
+                if(JOT_IS_TABLE(*rb))
+                {
+                    found = jot_TableFindString((jot_Table*) JOT_AS_OBJECT(*rb), (const jot_String*) JOT_AS_OBJECT(k[JOT_CODE_C(i)]));
+                    if(found != NULL)
+                    {
+                        r[JOT_CODE_A(i)] = *found;
+                    }
+                    else
+                    {
+                        JOT_SET_NIL(&r[JOT_CODE_A(i)]);
+                    }
+                }
+                else if(!jot_VmGetIndex(self, rb, &k[JOT_CODE_C(i)], &r[JOT_CODE_A(i)]))
+                {
+                    goto failed;
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(SETINDEX)
+                rb = &r[JOT_CODE_A(i)];
+                rc = &r[JOT_CODE_B(i)];
+                if(JOT_IS_ARRAY(*rb) && JOT_IS_SMALL_INT(*rc)
+                    && (uint64_t) JOT_AS_SMALL_INT(*rc) < ((jot_Array*) JOT_AS_OBJECT(*rb))->count)
+                {
+                    array = (jot_Array*) JOT_AS_OBJECT(*rb);
+                    /* Storing what the array already keeps doesn't need to go through jot_ArraySet. */
+                    if(array->kind == JOT_ARRAY_VALUES)
+                    {
+                        JOT_GC_BARRIER(&self->heap, &array->object, r[JOT_CODE_C(i)]);
+                        array->items.values[JOT_AS_SMALL_INT(*rc)] = r[JOT_CODE_C(i)];
+                    }
+                    else if(array->kind == JOT_ARRAY_INTS && JOT_IS_SMALL_INT(r[JOT_CODE_C(i)]))
+                    {
+                        array->items.ints[JOT_AS_SMALL_INT(*rc)] = JOT_AS_SMALL_INT(r[JOT_CODE_C(i)]);
+                    }
+                    else if(array->kind == JOT_ARRAY_NUMS && JOT_IS_NUM(r[JOT_CODE_C(i)]))
+                    {
+                        array->items.nums[JOT_AS_SMALL_INT(*rc)] = JOT_AS_NUM(r[JOT_CODE_C(i)]);
+                    }
+                    else if(!jot_ArraySet(&self->heap, array, (size_t) JOT_AS_SMALL_INT(*rc), r[JOT_CODE_C(i)]))
+                    {
+                        jot_VmFail(self, "out of memory");
+                        goto failed;
+                    }
+                }
+                else if(JOT_IS_TABLE(*rb) && JOT_IS_SMALL_INT(*rc)
+                    && (uint64_t) JOT_AS_SMALL_INT(*rc) < ((jot_Table*) JOT_AS_OBJECT(*rb))->array_size)
+                {
+                    table = (jot_Table*) JOT_AS_OBJECT(*rb);
+                    JOT_GC_BARRIER(&self->heap, &table->object, r[JOT_CODE_C(i)]);
+                    table->items[JOT_AS_SMALL_INT(*rc)] = r[JOT_CODE_C(i)];
+                }
+                else if(!jot_VmSetIndex(self, rb, rc, &r[JOT_CODE_C(i)]))
+                {
+                    goto failed;
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(SETFIELD)
+                if(!jot_VmSetIndex(self, &r[JOT_CODE_A(i)], &k[JOT_CODE_B(i)], &r[JOT_CODE_C(i)]))
+                {
+                    goto failed;
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(NEWTABLE)
+                table = jot_TableNew(&self->heap, JOT_CODE_B(i));
+                if(table == NULL)
+                {
+                    jot_VmFail(self, "out of memory");
+                    goto failed;
+                }
+                JOT_SET_OBJECT(&r[JOT_CODE_A(i)], table);
+                JOT_VM_COLLECT();
+                JOT_VM_NEXT();
+            JOT_VM_CASE(NEWARRAY)
+                array = jot_ArrayNew(&self->heap, JOT_CODE_B(i));
+                if(array == NULL)
+                {
+                    jot_VmFail(self, "out of memory");
+                    goto failed;
+                }
+                JOT_SET_OBJECT(&r[JOT_CODE_A(i)], array);
+                JOT_VM_COLLECT();
+                JOT_VM_NEXT();
+            JOT_VM_CASE(APPEND)
+                a = JOT_CODE_A(i);
+                n = JOT_CODE_B(i) ? JOT_CODE_B(i) - 1 : self->top - (frame->base + a + 1);
+                if(!jot_ArrayAppend(&self->heap, (jot_Array*) JOT_AS_OBJECT(r[a]), &r[a + 1], n))
+                {
+                    jot_VmFail(self, "out of memory");
+                    goto failed;
+                }
+                JOT_VM_COLLECT();
+                JOT_VM_NEXT();
+            JOT_VM_CASE(SELF)
+                a = JOT_CODE_A(i);
+                value = r[JOT_CODE_B(i)];
+                r[a + 1] = value;
+                if(JOT_IS_TABLE(value))
+                {
+                    found = jot_TableFindString((jot_Table*) JOT_AS_OBJECT(value), (const jot_String*) JOT_AS_OBJECT(k[JOT_CODE_C(i)]));
+                    if(found != NULL)
+                    {
+                        r[a] = *found;
+                    }
+                    else
+                    {
+                        JOT_SET_NIL(&r[a]);
+                    }
+                }
+                else if(!jot_VmGetIndex(self, &value, &k[JOT_CODE_C(i)], &r[a]))
+                {
+                    goto failed;
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(ADD)
+                rb = &r[JOT_CODE_B(i)];
+                rc = &r[JOT_CODE_C(i)];
+                if(JOT_IS_SMALL_INT(*rb) && JOT_IS_SMALL_INT(*rc))
+                {
+                    x = JOT_AS_SMALL_INT(*rb) + JOT_AS_SMALL_INT(*rc);
+                    JOT_VM_SET_INT(&r[JOT_CODE_A(i)], x);
+                }
+                else if(JOT_IS_NUM(*rb) && JOT_IS_NUM(*rc))
+                {
+                    p = JOT_AS_NUM(*rb);
+                    q = JOT_AS_NUM(*rc);
+                    JOT_SET_NUM(&r[JOT_CODE_A(i)], p + q);
+                }
+                else if(!jot_VmArith(self, JOT_OP_ADD, rb, rc, &r[JOT_CODE_A(i)]))
+                {
+                    goto failed;
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(SUB)
+                rb = &r[JOT_CODE_B(i)];
+                rc = &r[JOT_CODE_C(i)];
+                if(JOT_IS_SMALL_INT(*rb) && JOT_IS_SMALL_INT(*rc))
+                {
+                    x = JOT_AS_SMALL_INT(*rb) - JOT_AS_SMALL_INT(*rc);
+                    JOT_VM_SET_INT(&r[JOT_CODE_A(i)], x);
+                }
+                else if(JOT_IS_NUM(*rb) && JOT_IS_NUM(*rc))
+                {
+                    p = JOT_AS_NUM(*rb);
+                    q = JOT_AS_NUM(*rc);
+                    JOT_SET_NUM(&r[JOT_CODE_A(i)], p - q);
+                }
+                else if(!jot_VmArith(self, JOT_OP_SUB, rb, rc, &r[JOT_CODE_A(i)]))
+                {
+                    goto failed;
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(MUL)
+                rb = &r[JOT_CODE_B(i)];
+                rc = &r[JOT_CODE_C(i)];
+                if(JOT_IS_SMALL_INT(*rb) && JOT_IS_SMALL_INT(*rc))
+                {
+                    x = JOT_AS_SMALL_INT(*rb);
+                    y = JOT_AS_SMALL_INT(*rc);
+                    x = (int64_t) ((uint64_t) x * (uint64_t) y);
+                    JOT_VM_SET_INT(&r[JOT_CODE_A(i)], x);
+                }
+                else if(JOT_IS_NUM(*rb) && JOT_IS_NUM(*rc))
+                {
+                    p = JOT_AS_NUM(*rb);
+                    q = JOT_AS_NUM(*rc);
+                    JOT_SET_NUM(&r[JOT_CODE_A(i)], p * q);
+                }
+                else if(!jot_VmArith(self, JOT_OP_MUL, rb, rc, &r[JOT_CODE_A(i)]))
+                {
+                    goto failed;
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(MOD)
+                rb = &r[JOT_CODE_B(i)];
+                rc = &r[JOT_CODE_C(i)];
+                if(JOT_IS_SMALL_INT(*rb) && JOT_IS_SMALL_INT(*rc) && JOT_AS_SMALL_INT(*rc) != 0)
+                {
+                    /* Never bigger than what it's divided by. */
+                    x = JOT_AS_SMALL_INT(*rb);
+                    y = JOT_AS_SMALL_INT(*rc);
+                    JOT_SET_SMALL_INT(&r[JOT_CODE_A(i)], jot_NumMod(x, y));
+                }
+                else if(!jot_VmArith(self, JOT_OP_MOD, rb, rc, &r[JOT_CODE_A(i)]))
+                {
+                    goto failed;
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(DIV)
+            JOT_VM_CASE(POW)
+            JOT_VM_CASE(BAND)
+            JOT_VM_CASE(BOR)
+            JOT_VM_CASE(BXOR)
+            JOT_VM_CASE(SHL)
+            JOT_VM_CASE(SHR)
+                if(!jot_VmArith(self, JOT_CODE_OP(i), &r[JOT_CODE_B(i)], &r[JOT_CODE_C(i)], &r[JOT_CODE_A(i)]))
+                {
+                    goto failed;
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(CONCAT)
+                if(!jot_VmConcat(self, &r[JOT_CODE_B(i)], &r[JOT_CODE_C(i)], &r[JOT_CODE_A(i)]))
+                {
+                    goto failed;
+                }
+                JOT_VM_COLLECT();
+                JOT_VM_NEXT();
+            JOT_VM_CASE(ADDI)
+                rb = &r[JOT_CODE_B(i)];
+                if(JOT_IS_INT(*rb))
+                {
+                    x = (int64_t) ((uint64_t) JOT_AS_INT(*rb) + (uint64_t) (int64_t) JOT_CODE_SC(i));
+                    JOT_VM_SET_INT(&r[JOT_CODE_A(i)], x);
+                }
+                else if(JOT_IS_NUM(*rb))
+                {
+                    p = JOT_AS_NUM(*rb);
+                    JOT_SET_NUM(&r[JOT_CODE_A(i)], p + JOT_CODE_SC(i));
+                }
+                else
+                {
+                    jot_VmFail(self, "can't do arithmetic on %s", jot_VmDescribe(rb));
+                    goto failed;
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(UNM)
+                rb = &r[JOT_CODE_B(i)];
+                if(JOT_IS_INT(*rb))
+                {
+                    x = (int64_t) (0 - (uint64_t) JOT_AS_INT(*rb));
+                    JOT_VM_SET_INT(&r[JOT_CODE_A(i)], x);
+                }
+                else if(JOT_IS_NUM(*rb))
+                {
+                    p = JOT_AS_NUM(*rb);
+                    JOT_SET_NUM(&r[JOT_CODE_A(i)], -p);
+                }
+                else
+                {
+                    jot_VmFail(self, "can't do arithmetic on %s", jot_VmDescribe(rb));
+                    goto failed;
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(BNOT)
+                rb = &r[JOT_CODE_B(i)];
+                if(!jot_VmToInt(rb, &x))
+                {
+                    if(JOT_IS_NUM(*rb))
+                    {
+                        jot_VmFail(self, "number has no integer value");
+                    }
+                    else
+                    {
+                        jot_VmFail(self, "can't do bitwise operations on %s", jot_VmDescribe(rb));
+                    }
+                    goto failed;
+                }
+                x = ~x;
+                JOT_VM_SET_INT(&r[JOT_CODE_A(i)], x);
+                JOT_VM_NEXT();
+            JOT_VM_CASE(NOT)
+                rb = &r[JOT_CODE_B(i)];
+                JOT_SET_BOOL(&r[JOT_CODE_A(i)], !JOT_IS_TRUTHY(*rb));
+                JOT_VM_NEXT();
+            JOT_VM_CASE(JMP)
+                pc += JOT_CODE_SJ(i);
+                JOT_VM_COLLECT();
+                JOT_VM_NEXT();
+            JOT_VM_CASE(EQ)
+                rb = &r[JOT_CODE_A(i)];
+                rc = &r[JOT_CODE_B(i)];
+                if(JOT_IS_SMALL_INT(*rb) && JOT_IS_SMALL_INT(*rc))
+                {
+                    result = rb->bits == rc->bits;
+                }
+                else
+                {
+                    result = jot_ValueEqual(*rb, *rc);
+                }
+                if(result != (int) JOT_CODE_C(i))
+                {
+                    pc++;
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(LT)
+                rb = &r[JOT_CODE_A(i)];
+                rc = &r[JOT_CODE_B(i)];
+                if(JOT_IS_SMALL_INT(*rb) && JOT_IS_SMALL_INT(*rc))
+                {
+                    result = JOT_AS_SMALL_INT(*rb) < JOT_AS_SMALL_INT(*rc);
+                }
+                else if((result = jot_VmLess(self, rb, rc, 0)) < 0)
+                {
+                    goto failed;
+                }
+                if(result != (int) JOT_CODE_C(i))
+                {
+                    pc++;
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(LE)
+                rb = &r[JOT_CODE_A(i)];
+                rc = &r[JOT_CODE_B(i)];
+                if(JOT_IS_SMALL_INT(*rb) && JOT_IS_SMALL_INT(*rc))
+                {
+                    result = JOT_AS_SMALL_INT(*rb) <= JOT_AS_SMALL_INT(*rc);
+                }
+                else if((result = jot_VmLess(self, rb, rc, 1)) < 0)
+                {
+                    goto failed;
+                }
+                if(result != (int) JOT_CODE_C(i))
+                {
+                    pc++;
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(EQI)
+                rb = &r[JOT_CODE_A(i)];
+                if(JOT_IS_SMALL_INT(*rb))
+                {
+                    result = JOT_AS_SMALL_INT(*rb) == JOT_CODE_SB(i);
+                }
+                else
+                {
+                    result = JOT_IS_NUM(*rb) && JOT_AS_NUM(*rb) == JOT_CODE_SB(i);
+                }
+                if(result != (int) JOT_CODE_C(i))
+                {
+                    pc++;
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(LTI)
+                rb = &r[JOT_CODE_A(i)];
+                if(JOT_IS_SMALL_INT(*rb))
+                {
+                    result = JOT_AS_SMALL_INT(*rb) < JOT_CODE_SB(i);
+                }
+                else if((result = jot_VmCompareImmediate(self, JOT_OP_LTI, rb, JOT_CODE_SB(i))) < 0)
+                {
+                    goto failed;
+                }
+                if(result != (int) JOT_CODE_C(i))
+                {
+                    pc++;
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(LEI)
+            JOT_VM_CASE(GTI)
+            JOT_VM_CASE(GEI)
+                if((result = jot_VmCompareImmediate(self, JOT_CODE_OP(i), &r[JOT_CODE_A(i)], JOT_CODE_SB(i))) < 0)
+                {
+                    goto failed;
+                }
+                if(result != (int) JOT_CODE_C(i))
+                {
+                    pc++;
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(TEST)
+                rb = &r[JOT_CODE_A(i)];
+                if(JOT_IS_TRUTHY(*rb) != (int) JOT_CODE_C(i))
+                {
+                    pc++;
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(CALL)
+                a = frame->base + JOT_CODE_A(i);
+                n = JOT_CODE_B(i) ? JOT_CODE_B(i) - 1 : self->top - a - 1;
+                frame->pc = pc;
+                result = jot_VmPrecall(self, a, n, (int) JOT_CODE_C(i) - 1);
+                if(result > 0)
+                {
+                    goto reenter;
+                }
+                /* A native may have run scripts, which can move the stack and the frames. */
+                frame = &self->frames[self->frame_count - 1];
+                r = self->stack + frame->base;
+                if(result < 0)
+                {
+                    goto failed;
+                }
+                /* Unless all the results are wanted, which can run past the registers until what takes them. */
+                if(JOT_CODE_C(i) != 0)
+                {
+                    JOT_VM_COLLECT();
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(RETURN)
+                a = frame->base + JOT_CODE_A(i);
+                n = JOT_CODE_B(i) ? JOT_CODE_B(i) - 1 : self->top - a;
+                if(self->open_upvalues != NULL)
+                {
+                    jot_VmClose(self, frame->base);
+                }
+                jot_VmMoveResults(self, a, frame->function, n, frame->results);
+                self->frame_count--;
+                if(self->frame_count == entry)
+                {
+                    self->instructions += count;
+                    return 1;
+                }
+                goto reenter;
+            JOT_VM_CASE(VARARG)
+                a = frame->base + JOT_CODE_A(i);
+                n = JOT_CODE_B(i) ? JOT_CODE_B(i) - 1 : frame->vararg_count;
+                if(!JOT_CODE_B(i))
+                {
+                    if(!jot_VmReserve(self, a, n))
+                    {
+                        goto failed;
+                    }
+                    r = self->stack + frame->base;
+                    self->top = a + n;
+                }
+                for(j = 0; j < n; j++)
+                {
+                    if(j < frame->vararg_count)
+                    {
+                        self->stack[a + j] = self->stack[frame->varargs + j];
+                    }
+                    else
+                    {
+                        JOT_SET_NIL(&self->stack[a + j]);
+                    }
+                }
+                JOT_VM_NEXT();
+            JOT_VM_CASE(CLOSURE)
+                proto = closure->proto->protos[JOT_CODE_BX(i)];
+                made = jot_ClosureNew(&self->heap, proto);
+                if(made == NULL)
+                {
+                    jot_VmFail(self, "out of memory");
+                    goto failed;
+                }
+                /* Its proto and upvalues were already there. */
+                JOT_GC_BARRIER_OBJECT(&self->heap, &made->object, &proto->object);
+                for(j = 0; j < proto->upvalue_count; j++)
+                {
+                    n = proto->upvalues[j * 2 + 1];
+                    if(proto->upvalues[j * 2])
+                    {
+                        made->upvalues[j] = jot_VmCapture(self, frame->base + n);
+                        if(made->upvalues[j] == NULL)
+                        {
+                            jot_VmFail(self, "out of memory");
+                            goto failed;
+                        }
+                    }
+                    else
+                    {
+                        made->upvalues[j] = closure->upvalues[n];
+                    }
+                    JOT_GC_BARRIER_OBJECT(&self->heap, &made->object, &made->upvalues[j]->object);
+                }
+                JOT_SET_OBJECT(&r[JOT_CODE_A(i)], made);
+                JOT_VM_COLLECT();
+                JOT_VM_NEXT();
+            JOT_VM_CASE(CLOSE)
+                jot_VmClose(self, frame->base + JOT_CODE_A(i));
+                JOT_VM_NEXT();
+            JOT_VM_CASE(FORNEXT)
+                frame->pc = pc;
+                result = jot_VmForNext(self, frame->base + JOT_CODE_A(i), JOT_CODE_C(i));
+                frame = &self->frames[self->frame_count - 1];
+                r = self->stack + frame->base;
+                if(result < 0)
+                {
+                    goto failed;
+                }
+                pc += result;
+                JOT_VM_COLLECT();
+                JOT_VM_NEXT();
+#ifndef JOT_VM_COMPUTED_GOTO
+            default:
+                break;
+        }
+    }
+#endif
+    
+failed:
+    frame->pc = pc;
+    jot_VmLocate(self);
+    jot_VmClose(self, self->frames[entry].base);
+    self->frame_count = entry;
+    self->instructions += count;
+    return 0;
+}
+
+jot_Vm* jot_VmNew(jot_Allocator* allocator)
+{
+    jot_Vm* self = jot_Alloc(allocator, JOT_ALLOC_VM, sizeof(jot_Vm));
+    if(self == NULL)
+    {
+        return NULL;
+    }
+    memset(self, 0, sizeof(jot_Vm));
+    self->allocator = allocator;
+    jot_HeapInit(&self->heap, allocator);
+    self->atoms = jot_AtomTableNew(allocator);
+    self->globals = jot_TableNew(&self->heap, 0);
+    if(self->atoms == NULL || self->globals == NULL || !jot_VmReserve(self, 0, JOT_VM_MIN_STACK))
+    {
+        jot_VmFree(self);
+        return NULL;
+    }
+    return self;
+}
+
+void jot_VmFree(jot_Vm* self)
+{
+    if(self == NULL)
+    {
+        return;
+    }
+    jot_HeapFree(&self->heap);
+    if(self->atoms != NULL)
+    {
+        jot_AtomTableFree(self->atoms);
+    }
+    jot_Free(self->allocator, JOT_ALLOC_VM, self->stack, self->stack_size * sizeof(jot_Value));
+    jot_Free(self->allocator, JOT_ALLOC_VM, self->frames, self->frame_capacity * sizeof(jot_Frame));
+    jot_Free(self->allocator, JOT_ALLOC_VM, self, sizeof(jot_Vm));
+}
+
+int jot_VmLoad(jot_Vm* self, const char* name, const char* text, size_t size, jot_Value* function)
+{
+    jot_ParseError error;
+    jot_String* source;
+    jot_Ast* ast;
+    jot_Proto* proto = NULL;
+    jot_Closure* closure;
+    
+    source = jot_StringNew(&self->heap, name, strlen(name));
+    if(source == NULL)
+    {
+        jot_VmFail(self, "out of memory");
+        return 0;
+    }
+    /* Not lazily, since jot_Compile would only parse every skipped body anyway; see jot_compile.h. */
+    ast = jot_ParseText(self->allocator, text, size, self->atoms, 0, &error);
+    if(ast != NULL)
+    {
+        /* Running out of memory while folding leaves the tree meaning the same, so compiling can go on. */
+        jot_Fold(ast, ast->root);
+        proto = jot_Compile(&self->heap, ast, source, &error);
+        jot_AstFree(ast);
+    }
+    if(proto == NULL)
+    {
+        jot_VmFail(self, "%s", error.message);
+        self->error_source = source;
+        self->error_offset = error.offset;
+        self->error_located = 1;
+        return 0;
+    }
+    closure = jot_ClosureNew(&self->heap, proto);
+    if(closure == NULL)
+    {
+        jot_VmFail(self, "out of memory");
+        return 0;
+    }
+    JOT_SET_OBJECT(function, closure);
+    return 1;
+}
+
+int jot_VmCall(jot_Vm* self, jot_Value function, const jot_Value* args, int count, jot_Value* results, int result_count)
+{
+    size_t slot = jot_VmFreeSlot(self);
+    int i;
+    
+    if(!jot_VmReserve(self, slot, 1 + (size_t) count + (size_t) result_count))
+    {
+        return 0;
+    }
+    self->stack[slot] = function;
+    for(i = 0; i < count; i++)
+    {
+        self->stack[slot + 1 + i] = args[i];
+    }
+    if(!jot_VmCallAt(self, slot, (size_t) count, result_count))
+    {
+        return 0;
+    }
+    for(i = 0; i < result_count; i++)
+    {
+        results[i] = self->stack[slot + i];
+    }
+    return 1;
+}
+
+int jot_VmSetGlobal(jot_Vm* self, const char* name, jot_Value value)
+{
+    jot_String* key = jot_StringNew(&self->heap, name, strlen(name));
+    jot_Value key_value;
+    
+    if(key == NULL)
+    {
+        return 0;
+    }
+    JOT_SET_OBJECT(&key_value, key);
+    return jot_TableSet(&self->heap, self->globals, key_value, value);
+}
+
+int jot_VmRegister(jot_Vm* self, const char* name, jot_NativeFunction* function)
+{
+    jot_Native* native = jot_NativeNew(&self->heap, name, function);
+    jot_Value value;
+    
+    if(native == NULL)
+    {
+        return 0;
+    }
+    JOT_SET_OBJECT(&value, native);
+    return jot_VmSetGlobal(self, name, value);
+}
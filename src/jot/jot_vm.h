@@ -0,0 +1,137 @@
+/*
+    jot - Virtual Machine
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+#ifndef JOT_VM_H
+#define JOT_VM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "jot_alloc.h"
+#include "jot_func.h"
+#include "jot_str.h"
+#include "jot_table.h"
+#include "jot_value.h"
+
+/* A call in progress to a function compiled from a script. */
+typedef struct
+{
+    jot_Closure* closure;
+    /* Where it carries on from, kept up to date whenever it calls something. */
+    const jot_Instruction* pc;
+    /* Where the function being called is on the stack, and its register 0. */
+    size_t function;
+    size_t base;
+    /* Arguments past the named parameters, for '...'. */
+    size_t varargs;
+    size_t vararg_count;
+    /* How many results the caller wants, or -1 for all of them. */
+    int results;
+} jot_Frame;
+
+enum
+{
+    JOT_VM_ERROR_SIZE = 256
+};
+
+/*
+    Runs compiled functions. Every frame's registers are a window onto one
+    stack of values, which grows as calls need it to; calls between
+    script functions don't recurse in C.
+*/
+struct jot_Vm
+{
+    jot_Allocator* allocator;
+    jot_Heap heap;
+    /* What every source loaded is parsed with. */
+    jot_AtomTable* atoms;
+    jot_Table* globals;
+    
+    jot_Value* stack;
+    size_t stack_size;
+    /* Where the values end after an instruction that made a variable number of them. */
+    size_t top;
+    /* Where a native that's running has its arguments and results end. */
+    size_t native_top;
+    
+    jot_Frame* frames;
+    size_t frame_count;
+    size_t frame_capacity;
+    
+    /* Upvalues still pointing at the stack, from the highest index down. */
+    jot_Upvalue* open_upvalues;
+    /* Script functions running on the C stack under another, like an iterator a for loop calls. */
+    unsigned int depth;
+    
+    /* Instructions run, over every call so far. */
+    uint64_t instructions;
+    
+    /*
+        The last error, and where it was: the source a script function came
+        from, and the offset in it of what failed, or NULL if no script
+        function was running.
+    */
+    char error[JOT_VM_ERROR_SIZE];
+    jot_String* error_source;
+    size_t error_offset;
+    int error_located;
+};
+
+jot_Vm* jot_VmNew(jot_Allocator* allocator);
+void jot_VmFree(jot_Vm* self);
+
+/*
+    Parses, folds and compiles size bytes of text, and gives back a
+    function that runs it, taking any arguments as '...'. name is what
+    errors say the source is called. Returns 0, with the error set, if the
+    source has a syntax error or memory runs out. Like any object a host
+    keeps, the function can be collected during a later call unless the VM
+    can reach it, from a global for instance; see jot_gc.h.
+*/
+int jot_VmLoad(jot_Vm* self, const char* name, const char* text, size_t size, jot_Value* function);
+
+/*
+    Calls function with count arguments, and copies its first result_count
+    results (padded out with nils) to results. Returns 0, with the error
+    set, if the function raised one.
+*/
+int jot_VmCall(jot_Vm* self, jot_Value function, const jot_Value* args, int count, jot_Value* results, int result_count);
+
+/* These return 0 if memory runs out. */
+int jot_VmSetGlobal(jot_Vm* self, const char* name, jot_Value value);
+/* name has to be a static string. */
+int jot_VmRegister(jot_Vm* self, const char* name, jot_NativeFunction* function);
+
+/*
+    Sets the error, formatted as sprintf would, which must fit in
+    JOT_VM_ERROR_SIZE. Returns -1, so natives can return it straight away.
+*/
+int jot_VmFail(jot_Vm* self, const char* format, ...);
+
+/* How the interpreter loop dispatches instructions: "computed goto" or "switch". */
+const char* jot_VmDispatch(void);
+
+#endif
@@ -0,0 +1,244 @@
+/*
+    jot - Number Table Generator
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+
+/*
+    Builds the table of 128-bit truncated powers of five that jot_NumParseDecimal
+    uses to convert decimal literals (see jot_num.c), and writes it out as C
+    source:
+
+        cc jot_numgen.c -o jot_numgen
+        ./jot_numgen > ../jot/jot_numtab.h
+
+    Entry q holds the 128 most significant bits of 5^q, normalized so the top
+    bit is set. Negative powers hold the reciprocal, rounded up; that's the
+    form the Eisel-Lemire error bounds are worked out for.
+*/
+#include <stdio.h>
+#include <string.h>
+
+enum
+{
+    POW5_MIN = -342,
+    POW5_MAX = 308,
+    
+    /* Big enough for 2^b / 5^342 below, with b around 1720. */
+    LIMB_BITS = 16,
+    LIMB_COUNT = 128
+};
+
+/* Little-endian 16-bit limbs, so limb products fit in an unsigned long. */
+typedef struct
+{
+    unsigned long limbs[LIMB_COUNT];
+} BigInt;
+
+static void BigSet(BigInt* a, unsigned long value)
+{
+    memset(a, 0, sizeof(*a));
+    a->limbs[0] = value;
+}
+
+static void BigMultiplySmall(BigInt* a, unsigned long factor)
+{
+    unsigned long carry = 0;
+    int i;
+    for(i = 0; i < LIMB_COUNT; i++)
+    {
+        carry += a->limbs[i] * factor;
+        a->limbs[i] = carry & 0xFFFF;
+        carry >>= LIMB_BITS;
+    }
+}
+
+static int BigBitLength(const BigInt* a)
+{
+    int i, bit;
+    for(i = LIMB_COUNT - 1; i >= 0; i--)
+    {
+        for(bit = LIMB_BITS - 1; a->limbs[i] && bit >= 0; bit--)
+        {
+            if(a->limbs[i] >> bit & 1)
+            {
+                return i * LIMB_BITS + bit + 1;
+            }
+        }
+    }
+    return 0;
+}
+
+static int BigBit(const BigInt* a, int bit)
+{
+    return (int) (a->limbs[bit / LIMB_BITS] >> bit % LIMB_BITS & 1);
+}
+
+static void BigShiftLeft(BigInt* a, int count)
+{
+    BigInt result;
+    int i;
+    memset(&result, 0, sizeof(result));
+    for(i = LIMB_COUNT * LIMB_BITS - 1; i >= count; i--)
+    {
+        result.limbs[i / LIMB_BITS] |= (unsigned long) BigBit(a, i - count) << i % LIMB_BITS;
+    }
+    *a = result;
+}
+
+static void BigShiftRight(BigInt* a, int count)
+{
+    BigInt result;
+    int i;
+    memset(&result, 0, sizeof(result));
+    for(i = 0; i + count < LIMB_COUNT * LIMB_BITS; i++)
+    {
+        result.limbs[i / LIMB_BITS] |= (unsigned long) BigBit(a, i + count) << i % LIMB_BITS;
+    }
+    *a = result;
+}
+
+static int BigCompare(const BigInt* a, const BigInt* b)
+{
+    int i;
+    for(i = LIMB_COUNT - 1; i >= 0; i--)
+    {
+        if(a->limbs[i] != b->limbs[i])
+        {
+            return a->limbs[i] < b->limbs[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+static void BigSubtract(BigInt* a, const BigInt* b)
+{
+    unsigned long borrow = 0;
+    int i;
+    for(i = 0; i < LIMB_COUNT; i++)
+    {
+        unsigned long subtrahend = b->limbs[i] + borrow;
+        borrow = a->limbs[i] < subtrahend;
+        a->limbs[i] = (a->limbs[i] + (borrow << LIMB_BITS) - subtrahend) & 0xFFFF;
+    }
+}
+
+static void BigIncrement(BigInt* a)
+{
+    int i;
+    for(i = 0; i < LIMB_COUNT && ++a->limbs[i] > 0xFFFF; i++)
+    {
+        a->limbs[i] = 0;
+    }
+}
+
+/* quotient = floor(2^power / divisor), by shift-and-subtract. */
+static void BigDividePowerOfTwo(BigInt* quotient, int power, const BigInt* divisor)
+{
+    BigInt remainder;
+    int bit;
+    BigSet(quotient, 0);
+    BigSet(&remainder, 0);
+    for(bit = power; bit >= 0; bit--)
+    {
+        BigShiftLeft(&remainder, 1);
+        remainder.limbs[0] |= bit == power;
+        if(BigCompare(&remainder, divisor) >= 0)
+        {
+            BigSubtract(&remainder, divisor);
+            quotient->limbs[bit / LIMB_BITS] |= 1UL << bit % LIMB_BITS;
+        }
+    }
+}
+
+static void PowerOfFive(BigInt* result, int q)
+{
+    BigInt power;
+    int length, i;
+    
+    BigSet(&power, 1);
+    for(i = 0; i < (q < 0 ? -q : q); i++)
+    {
+        BigMultiplySmall(&power, 5);
+    }
+    length = BigBitLength(&power);
+    if(q >= 0)
+    {
+        *result = power;
+        if(length > 128)
+        {
+            BigShiftRight(result, length - 128);
+        }
+        else
+        {
+            BigShiftLeft(result, 128 - length);
+        }
+    }
+    else
+    {
+        /* 5^-q isn't a power of two, so 2^length is the smallest one above it. */
+        BigDividePowerOfTwo(result, q >= -27 ? length + 127 : 2 * length + 128, &power);
+        BigIncrement(result);
+        while(BigBitLength(result) > 128)
+        {
+            BigShiftRight(result, 1);
+        }
+    }
+}
+
+static unsigned long Word(const BigInt* a, int index)
+{
+    return a->limbs[index * 2] | a->limbs[index * 2 + 1] << LIMB_BITS;
+}
+
+int main(void)
+{
+    BigInt power;
+    int q;
+    
+    printf("/* Generated by src/tools/jot_numgen.c -- do not edit. */\n");
+    printf("#ifndef JOT_NUMTAB_H\n");
+    printf("#define JOT_NUMTAB_H\n\n");
+    
+    printf("enum\n{\n");
+    printf("    JOT_NUM_POW5_MIN = %d,\n", POW5_MIN);
+    printf("    JOT_NUM_POW5_MAX = %d\n", POW5_MAX);
+    printf("};\n\n");
+    
+    printf("#define JOT_NUM_U64(high, low) ((uint64_t) (high) << 32 | (low))\n\n");
+    
+    printf("/* High then low 64 bits of 5^q, for q = JOT_NUM_POW5_MIN .. JOT_NUM_POW5_MAX. */\n");
+    printf("static const uint64_t jot_num_pow5[%d][2] = {\n", POW5_MAX - POW5_MIN + 1);
+    for(q = POW5_MIN; q <= POW5_MAX; q++)
+    {
+        PowerOfFive(&power, q);
+        printf("    {JOT_NUM_U64(0x%08lXUL, 0x%08lXUL), JOT_NUM_U64(0x%08lXUL, 0x%08lXUL)}%s /* %d */\n",
+            Word(&power, 3), Word(&power, 2), Word(&power, 1), Word(&power, 0), q < POW5_MAX ? "," : "", q);
+    }
+    printf("};\n\n");
+    
+    printf("#undef JOT_NUM_U64\n\n");
+    printf("#endif\n");
+    return 0;
+}
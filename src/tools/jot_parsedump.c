@@ -0,0 +1,325 @@
+/*
+    jot - Parse Dump
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+
+/*
+    Prints the tree a file parses into, one node per line and indented by
+    depth, or the first syntax error in it. With -lazy, function bodies are
+    skipped at first and only parsed as they're printed. With -fold,
+    constants are folded first:
+
+        cc -I../jot jot_parsedump.c ../jot/jot_*.c -o jot_parsedump -lpthread -lm
+        ./jot_parsedump [-lazy] [-fold] ../jot/hello.txt
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "jot_fold.h"
+#include "jot_parse.h"
+
+static const char* node_name[JOT_NODE_KIND_COUNT] =
+{
+    "none", "nil", "true", "false", "...", "int", "num", "str", "name",
+    "func", "table", "array", "index", "call", "method-call", "unary",
+    "binary", "and", "or", "block", "var", "assign", "if", "while",
+    "repeat", "for", "break", "continue", "return"
+};
+
+static void PrintAtom(const jot_Ast* ast, uint32_t id)
+{
+    const jot_Atom* atom = jot_AtomTableGet(ast->atoms, id);
+    fwrite(atom->text, 1, atom->length, stdout);
+}
+
+/* printf has no portable way to print a 64-bit integer in C89. */
+static void PrintInt(int64_t value)
+{
+    char digits[24];
+    size_t i = sizeof(digits);
+    uint64_t magnitude = value < 0 ? 0 - (uint64_t) value : (uint64_t) value;
+    
+    digits[--i] = '\0';
+    do
+    {
+        digits[--i] = (char) ('0' + magnitude % 10);
+        magnitude /= 10;
+    } while(magnitude != 0);
+    if(value < 0)
+    {
+        digits[--i] = '-';
+    }
+    printf("%s", digits + i);
+}
+
+/* Where the body of a function was found to have a syntax error, if one was. */
+static jot_ParseError body_error;
+static int fold;
+
+static void PrintNode(jot_Ast* ast, jot_NodeRef node, int depth);
+
+/* Prints count child nodes, starting at word first of node. */
+static void PrintChildren(jot_Ast* ast, jot_NodeRef node, size_t first, size_t count, int depth)
+{
+    size_t i;
+    for(i = 0; i < count; i++)
+    {
+        PrintNode(ast, jot_AstWord(ast, node, first + i), depth);
+    }
+}
+
+/* Prints count atoms, starting at word first of node. */
+static void PrintAtoms(const jot_Ast* ast, jot_NodeRef node, size_t first, size_t count)
+{
+    size_t i;
+    for(i = 0; i < count; i++)
+    {
+        printf(" ");
+        PrintAtom(ast, jot_AstWord(ast, node, first + i));
+    }
+}
+
+static void PrintNode(jot_Ast* ast, jot_NodeRef node, int depth)
+{
+    jot_NodeKind kind;
+    jot_NodeRef body;
+    size_t count;
+    
+    printf("%*s", depth * 2, "");
+    if(!node)
+    {
+        printf("-\n");
+        return;
+    }
+    kind = jot_AstKind(ast, node);
+    printf("%s", node_name[kind]);
+    switch(kind)
+    {
+        case JOT_NODE_INT:
+            printf(" ");
+            PrintInt(jot_AstInt(ast, node));
+            printf("\n");
+            break;
+        case JOT_NODE_NUM:
+            printf(" %.17g\n", jot_AstNum(ast, node));
+            break;
+        case JOT_NODE_STR:
+        case JOT_NODE_NAME:
+            printf(" '");
+            PrintAtom(ast, jot_AstWord(ast, node, 0));
+            printf("'\n");
+            break;
+        case JOT_NODE_FUNC:
+            if(jot_AstWord(ast, node, 3) != JOT_AST_NO_ATOM)
+            {
+                printf(" ");
+                PrintAtom(ast, jot_AstWord(ast, node, 3));
+            }
+            printf(" (");
+            PrintAtoms(ast, node, 5, jot_AstWord(ast, node, 4));
+            printf("%s )%s\n", jot_AstFlags(ast, node) & JOT_FUNC_VARARG ? " ..." : "",
+                jot_AstFlags(ast, node) & JOT_FUNC_METHOD ? " method" : "");
+            if(body_error.message == NULL)
+            {
+                /* A body parsed just now hasn't been folded along with the rest. */
+                int parsed = jot_AstWord(ast, node, 2) != 0;
+                body = jot_AstFunctionBody(ast, node, &body_error);
+                if(body && fold && !parsed && !jot_Fold(ast, body))
+                {
+                    fprintf(stderr, "jot_parsedump: out of memory\n");
+                    exit(1);
+                }
+                if(body)
+                {
+                    PrintNode(ast, body, depth + 1);
+                }
+            }
+            break;
+        case JOT_NODE_TABLE:
+            printf("\n");
+            PrintChildren(ast, node, 1, jot_AstWord(ast, node, 0) * 2, depth + 1);
+            break;
+        case JOT_NODE_ARRAY:
+        case JOT_NODE_BLOCK:
+        case JOT_NODE_RETURN:
+            printf("\n");
+            PrintChildren(ast, node, 1, jot_AstWord(ast, node, 0), depth + 1);
+            break;
+        case JOT_NODE_CALL:
+            printf("\n");
+            PrintNode(ast, jot_AstWord(ast, node, 0), depth + 1);
+            PrintChildren(ast, node, 2, jot_AstWord(ast, node, 1), depth + 1);
+            break;
+        case JOT_NODE_METHOD_CALL:
+            printf(" ");
+            PrintAtom(ast, jot_AstWord(ast, node, 1));
+            printf("\n");
+            PrintNode(ast, jot_AstWord(ast, node, 0), depth + 1);
+            PrintChildren(ast, node, 3, jot_AstWord(ast, node, 2), depth + 1);
+            break;
+        case JOT_NODE_UNARY:
+        case JOT_NODE_BINARY:
+            printf(" %s\n", token_name[jot_AstOp(ast, node)]);
+            PrintChildren(ast, node, 0, kind == JOT_NODE_UNARY ? 1 : 2, depth + 1);
+            break;
+        case JOT_NODE_INDEX:
+        case JOT_NODE_AND:
+        case JOT_NODE_OR:
+        case JOT_NODE_WHILE:
+        case JOT_NODE_REPEAT:
+            printf("\n");
+            PrintChildren(ast, node, 0, 2, depth + 1);
+            break;
+        case JOT_NODE_VAR:
+            count = jot_AstWord(ast, node, 0);
+            PrintAtoms(ast, node, 2, count);
+            printf("\n");
+            PrintChildren(ast, node, 2 + count, jot_AstWord(ast, node, 1), depth + 1);
+            break;
+        case JOT_NODE_ASSIGN:
+            printf("\n");
+            PrintChildren(ast, node, 2, jot_AstWord(ast, node, 0) + jot_AstWord(ast, node, 1), depth + 1);
+            break;
+        case JOT_NODE_IF:
+            printf("\n");
+            PrintChildren(ast, node, 1, jot_AstWord(ast, node, 0) * 2 + 1, depth + 1);
+            break;
+        case JOT_NODE_FOR:
+            PrintAtoms(ast, node, 3, jot_AstWord(ast, node, 2));
+            printf("\n");
+            PrintChildren(ast, node, 0, 2, depth + 1);
+            break;
+        default:
+            printf("\n");
+            break;
+    }
+}
+
+/* Reports an error at offset into text as a line and column. */
+static void PrintError(const char* filename, const char* text, const jot_ParseError* error)
+{
+    unsigned long line = 1;
+    unsigned long column = 1;
+    size_t i;
+    
+    for(i = 0; i < error->offset; i++)
+    {
+        if(text[i] == '\n' || (text[i] == '\r' && text[i + 1] != '\n'))
+        {
+            line++;
+            column = 1;
+        }
+        else if(text[i] != '\r')
+        {
+            column++;
+        }
+    }
+    fprintf(stderr, "%s:%lu:%lu: %s\n", filename, line, column, error->message);
+}
+
+int main(int argc, char** argv)
+{
+    const char* filename = "hello.txt";
+    int lazy = 0;
+    FILE* file;
+    char* text = NULL;
+    size_t size = 0;
+    size_t capacity = 0;
+    jot_AtomTable* atoms;
+    jot_ParseError error;
+    jot_Ast* ast;
+    int status = 0;
+    int i;
+    
+    for(i = 1; i < argc; i++)
+    {
+        if(strcmp(argv[i], "-lazy") == 0)
+        {
+            lazy = 1;
+        }
+        else if(strcmp(argv[i], "-fold") == 0)
+        {
+            fold = 1;
+        }
+        else
+        {
+            filename = argv[i];
+        }
+    }
+    file = fopen(filename, "rb");
+    if(file == NULL)
+    {
+        fprintf(stderr, "jot_parsedump: can't open %s\n", filename);
+        return 1;
+    }
+    do
+    {
+        if(size == capacity)
+        {
+            capacity = capacity ? capacity * 2 : 65536;
+            text = realloc(text, capacity);
+            if(text == NULL)
+            {
+                fprintf(stderr, "jot_parsedump: out of memory\n");
+                return 1;
+            }
+        }
+        size += fread(text + size, 1, capacity - size, file);
+    } while(size == capacity);
+    fclose(file);
+    
+    atoms = jot_AtomTableNew(NULL);
+    if(atoms == NULL)
+    {
+        fprintf(stderr, "jot_parsedump: out of memory\n");
+        return 1;
+    }
+    ast = jot_ParseText(NULL, text, size, atoms, lazy ? JOT_PARSE_LAZY : 0, &error);
+    if(ast == NULL)
+    {
+        PrintError(filename, text, &error);
+        status = 1;
+    }
+    else
+    {
+        if(fold && !jot_Fold(ast, ast->root))
+        {
+            fprintf(stderr, "jot_parsedump: out of memory\n");
+            return 1;
+        }
+        PrintNode(ast, ast->root, 0);
+        if(body_error.message != NULL)
+        {
+            PrintError(filename, text, &body_error);
+            status = 1;
+        }
+        jot_AstFree(ast);
+    }
+    jot_AtomTableFree(atoms);
+    free(text);
+    
+    return status;
+}
@@ -0,0 +1,138 @@
+/*
+    jot - Script Runner
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+
+/*
+    Runs a script, passing it the arguments after its filename as '...'.
+    Prints the first error it raises, where it was raised:
+
+        cc -O2 -I../jot jot_run.c ../jot/jot_*.c -o jot_run -lpthread -lm
+        ./jot_run script.txt [arguments...]
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "jot_lib.h"
+#include "jot_vm.h"
+
+/* Reports the VM's error, as a line and column when it's at an offset into text. */
+static void PrintError(const jot_Vm* vm, const char* text)
+{
+    unsigned long line = 1;
+    unsigned long column = 1;
+    size_t i;
+    
+    if(vm->error_source == NULL)
+    {
+        fprintf(stderr, "jot_run: %s\n", vm->error);
+        return;
+    }
+    for(i = 0; i < vm->error_offset; i++)
+    {
+        if(text[i] == '\n' || (text[i] == '\r' && text[i + 1] != '\n'))
+        {
+            line++;
+            column = 1;
+        }
+        else if(text[i] != '\r')
+        {
+            column++;
+        }
+    }
+    fprintf(stderr, "%s:%lu:%lu: %s\n", vm->error_source->text, line, column, vm->error);
+}
+
+int main(int argc, char** argv)
+{
+    FILE* file;
+    char* text = NULL;
+    size_t size = 0;
+    size_t capacity = 0;
+    jot_Vm* vm;
+    jot_Value function;
+    jot_Value* args;
+    jot_String* arg;
+    int status = 0;
+    int i;
+    
+    if(argc < 2)
+    {
+        fprintf(stderr, "usage: jot_run script.txt [arguments...]\n");
+        return 1;
+    }
+    file = fopen(argv[1], "rb");
+    if(file == NULL)
+    {
+        fprintf(stderr, "jot_run: can't open %s\n", argv[1]);
+        return 1;
+    }
+    do
+    {
+        /* One byte more than is read, so errors can look past the last one. */
+        if(size + 1 >= capacity)
+        {
+            capacity = capacity ? capacity * 2 : 65536;
+            text = realloc(text, capacity);
+            if(text == NULL)
+            {
+                fprintf(stderr, "jot_run: out of memory\n");
+                return 1;
+            }
+        }
+        size += fread(text + size, 1, capacity - size - 1, file);
+    } while(size + 1 == capacity);
+    fclose(file);
+    text[size] = '\0';
+    
+    vm = jot_VmNew(NULL);
+    args = malloc(sizeof(jot_Value) * (size_t) argc);
+    if(vm == NULL || args == NULL || !jot_LibOpen(vm))
+    {
+        fprintf(stderr, "jot_run: out of memory\n");
+        return 1;
+    }
+    for(i = 2; i < argc; i++)
+    {
+        arg = jot_StringNew(&vm->heap, argv[i], strlen(argv[i]));
+        if(arg == NULL)
+        {
+            fprintf(stderr, "jot_run: out of memory\n");
+            return 1;
+        }
+        JOT_SET_OBJECT(&args[i - 2], arg);
+    }
+    if(!jot_VmLoad(vm, argv[1], text, size, &function) || !jot_VmCall(vm, function, args, argc - 2, NULL, 0))
+    {
+        PrintError(vm, text);
+        status = 1;
+    }
+    
+    free(args);
+    jot_VmFree(vm);
+    free(text);
+    return status;
+}
@@ -0,0 +1,89 @@
+/*
+    jot - Token Dumper
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+
+/*
+    Prints every token in a file along with its line, column and text, one per line,
+    which is handy for checking what the scanner makes of something:
+
+        cc -I../jot jot_scandump.c ../jot/jot_*.c -o jot_scandump -lpthread -lm
+        ./jot_scandump ../jot/hello.txt
+*/
+#include <stdio.h>
+
+#include "jot_source.h"
+#include "jot_scanner.h"
+
+int main(int argc, char** argv)
+{
+    const char* filename = argc > 1 ? argv[1] : "hello.txt";
+    jot_Token token;
+    jot_Source* source;
+    jot_Scanner* scanner;
+    jot_LineIndex* lines;
+    size_t line, column;
+    
+    source = jot_MmapSourceNew(NULL, filename);
+    if(source == NULL)
+    {
+        fprintf(stderr, "jot_scandump: can't open %s\n", filename);
+        return 1;
+    }
+    lines = jot_LineIndexNew(NULL);
+    scanner = jot_ScannerNew(NULL, source);
+    if(lines == NULL || scanner == NULL)
+    {
+        fprintf(stderr, "jot_scandump: out of memory\n");
+        return 1;
+    }
+    scanner->lines = lines;
+    while(token = jot_ScannerNext(scanner), token != JOT_TOKEN_EOF)
+    {
+        jot_ScannerLocate(scanner, scanner->last_offset, &line, &column);
+        printf("%lu:%lu Token: %d %s", (unsigned long) line, (unsigned long) column, token, token_name[token]);
+        switch(token)
+        {
+            case JOT_TOKEN_INT:
+            case JOT_TOKEN_HEX:
+            case JOT_TOKEN_BIN:
+            case JOT_TOKEN_NUM:
+            case JOT_TOKEN_STR:
+            case JOT_TOKEN_IDENTIFIER:
+            case JOT_TOKEN_KEYWORD:
+                printf(" -- '");
+                fwrite(scanner->last_text, 1, scanner->last_text_length, stdout);
+                printf("'");
+                /* fall through */
+            default:
+                printf("\n");
+        }
+    }
+    jot_ScannerFree(scanner);
+    jot_LineIndexFree(lines);
+    jot_MmapSourceFree(source);
+    
+    return 0;
+}
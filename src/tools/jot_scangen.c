@@ -0,0 +1,525 @@
+/*
+    jot - Scanner Table Generator
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+
+/*
+    Builds the character class and transition tables that drive
+    jot_ScannerNext, plus the keyword hash, and writes them out as C source:
+
+        cc -I../jot jot_scangen.c -o jot_scangen
+        ./jot_scangen > ../jot/jot_scantab.h
+
+    Every byte is first mapped to one of a few dozen classes, so that the
+    scanner's inner loop is a class lookup plus a state x class lookup.
+    Classes only need to distinguish what some state actually cares about.
+*/
+#include <stdio.h>
+#include <string.h>
+
+#include "jot_scanner.h"
+
+enum
+{
+    CLASS_OTHER,        /* Anything not legal outside of strings and comments. */
+    CLASS_SPACE,        /* ' ' '\t' */
+    CLASS_LINE_END,     /* '\r' '\n' */
+    CLASS_ZERO,         /* '0' */
+    CLASS_ONE,          /* '1' */
+    CLASS_DIGIT,        /* '2' .. '9' */
+    CLASS_HEX_LETTER,   /* 'c' 'd' 'A' 'B' 'C' 'D' 'F' */
+    CLASS_HEX_ESCAPE,   /* 'a' 'f' -- hex digits that are also escapes */
+    CLASS_B,            /* 'b' -- hex digit, escape and binary prefix */
+    CLASS_E,            /* 'e' 'E' -- hex digit and exponent */
+    CLASS_ESCAPE,       /* 'n' 'r' 't' 'v' */
+    CLASS_X,            /* 'x' -- hex prefix and hex escape */
+    CLASS_LETTER,       /* The rest of 'a' .. 'z' | 'A' .. 'Z' */
+    CLASS_UNDERSCORE,   /* '_' */
+    CLASS_QUOTE,        /* '\'' '\"' */
+    CLASS_BACKSLASH,    /* '\\' */
+    CLASS_HASH,         /* '#' */
+    CLASS_DOT,          /* '.' */
+    CLASS_LT,           /* '<' */
+    CLASS_GT,           /* '>' */
+    CLASS_EQ,           /* '=' */
+    CLASS_ASTERISK,     /* '*' */
+    CLASS_DASH,         /* '-' */
+    CLASS_EXCLAIM,      /* '!' */
+    CLASS_PLUS,         /* '+' */
+    CLASS_PUNCT,        /* Other single character tokens. */
+    CLASS_UTF8,         /* 0x80 .. 0xFF -- part of a multibyte UTF-8 sequence */
+    CLASS_EOS,          /* End of stream, never produced by an actual byte. */
+    CLASS_COUNT
+};
+
+enum
+{
+    STATE_COUNT = JOT_STATE_EXCLAIM + 1
+};
+
+static const char* class_names[CLASS_COUNT] = {
+    "other", "space", "line end", "zero", "one", "digit", "hex letter",
+    "hex escape", "b", "e", "escape", "x", "letter", "underscore", "quote",
+    "backslash", "hash", "dot", "lt", "gt", "eq", "asterisk", "dash",
+    "exclaim", "plus", "punct", "utf8", "eos"
+};
+
+static const char* state_names[STATE_COUNT] = {
+    "START", "ZERO", "INT", "HEX", "BIN", "NUM", "E_SIGN", "E_VALUE",
+    "STR", "STR_BACKSLASH", "STR_HEX_HIGH", "STR_HEX_LOW", "IDENTIFIER",
+    "HASH", "HASH_COMMENT", "HASH_HASH_COMMENT", "HASH_HASH_COMMENT_HASH",
+    "DOT", "DOT_DOT", "LT", "GT", "EQ", "ASTERISK", "DASH", "EXCLAIM"
+};
+
+/* Indexed by jot_Keyword. */
+static const char* keyword_names[] = {
+    NULL, "and", "break", "continue", "do", "else", "elseif", "end", "false",
+    "for", "func", "if", "in", "nil", "not", "or", "repeat", "then", "true",
+    "until", "while", "var"
+};
+
+enum
+{
+    KEYWORD_COUNT = JOT_KEYWORD_VAR + 1,
+    KEYWORD_MAX_SLOTS = 256
+};
+
+static unsigned char classes[256];
+static unsigned short transitions[STATE_COUNT][CLASS_COUNT];
+static unsigned char escapes[256];
+static unsigned char punct[256];
+
+/* Groups of classes that several states treat alike, terminated by -1. */
+static const int decimal_digits[] = { CLASS_ZERO, CLASS_ONE, CLASS_DIGIT, -1 };
+static const int hex_digits[] = {
+    CLASS_ZERO, CLASS_ONE, CLASS_DIGIT,
+    CLASS_HEX_LETTER, CLASS_HEX_ESCAPE, CLASS_B, CLASS_E, -1
+};
+static const int binary_digits[] = { CLASS_ZERO, CLASS_ONE, -1 };
+static const int letters[] = {
+    CLASS_HEX_LETTER, CLASS_HEX_ESCAPE, CLASS_B, CLASS_E,
+    CLASS_ESCAPE, CLASS_X, CLASS_LETTER, CLASS_UNDERSCORE, -1
+};
+static const int ident_chars[] = {
+    CLASS_ZERO, CLASS_ONE, CLASS_DIGIT,
+    CLASS_HEX_LETTER, CLASS_HEX_ESCAPE, CLASS_B, CLASS_E,
+    CLASS_ESCAPE, CLASS_X, CLASS_LETTER, CLASS_UNDERSCORE, -1
+};
+static const int simple_escapes[] = {
+    CLASS_BACKSLASH, CLASS_QUOTE, CLASS_HEX_ESCAPE, CLASS_B, CLASS_ESCAPE, -1
+};
+static const int line_ends[] = { CLASS_LINE_END, CLASS_EOS, -1 };
+
+static void SetClass(const char* chars, int c)
+{
+    while(*chars)
+    {
+        classes[(unsigned char) *chars++] = (unsigned char) c;
+    }
+}
+
+static void SetRange(int low, int high, int c)
+{
+    int i;
+    for(i = low; i <= high; i++)
+    {
+        classes[i] = (unsigned char) c;
+    }
+}
+
+static unsigned short Entry(jot_ScanState next, jot_ScanAction action, jot_Token token)
+{
+    return (unsigned short) (next
+        | action << JOT_SCAN_ACTION_SHIFT
+        | token << JOT_SCAN_TOKEN_SHIFT);
+}
+
+/* Transition used for every class not mentioned afterwards. */
+static void Default(jot_ScanState state, jot_ScanState next, jot_ScanAction action, jot_Token token)
+{
+    int i;
+    for(i = 0; i < CLASS_COUNT; i++)
+    {
+        transitions[state][i] = Entry(next, action, token);
+    }
+}
+
+static void On(jot_ScanState state, int c, jot_ScanState next, jot_ScanAction action, jot_Token token)
+{
+    transitions[state][c] = Entry(next, action, token);
+}
+
+static void OnEach(jot_ScanState state, const int* group, jot_ScanState next, jot_ScanAction action, jot_Token token)
+{
+    while(*group != -1)
+    {
+        On(state, *group++, next, action, token);
+    }
+}
+
+static void BuildClasses(void)
+{
+    memset(classes, CLASS_OTHER, sizeof(classes));
+    SetClass(" \t", CLASS_SPACE);
+    SetClass("\r\n", CLASS_LINE_END);
+    SetClass("0", CLASS_ZERO);
+    SetClass("1", CLASS_ONE);
+    SetRange('2', '9', CLASS_DIGIT);
+    SetRange('a', 'z', CLASS_LETTER);
+    SetRange('A', 'Z', CLASS_LETTER);
+    SetClass("cdABCDF", CLASS_HEX_LETTER);
+    SetClass("af", CLASS_HEX_ESCAPE);
+    SetClass("b", CLASS_B);
+    SetClass("eE", CLASS_E);
+    SetClass("nrtv", CLASS_ESCAPE);
+    SetClass("x", CLASS_X);
+    SetClass("_", CLASS_UNDERSCORE);
+    SetClass("\'\"", CLASS_QUOTE);
+    SetClass("\\", CLASS_BACKSLASH);
+    SetClass("#", CLASS_HASH);
+    SetClass(".", CLASS_DOT);
+    SetClass("<", CLASS_LT);
+    SetClass(">", CLASS_GT);
+    SetClass("=", CLASS_EQ);
+    SetClass("*", CLASS_ASTERISK);
+    SetClass("-", CLASS_DASH);
+    SetClass("!", CLASS_EXCLAIM);
+    SetClass("+", CLASS_PLUS);
+    SetClass(":;,()[]{}/%&|^~", CLASS_PUNCT);
+    SetRange(0x80, 0xFF, CLASS_UTF8);
+    
+    /* Single character tokens. Anything else that reaches JOT_SCAN_EMIT_PUNCT is illegal. */
+    memset(punct, JOT_TOKEN_ERROR, sizeof(punct));
+    punct['+'] = JOT_TOKEN_ADD;
+    punct[':'] = JOT_TOKEN_COLON;
+    punct[';'] = JOT_TOKEN_SEMICOLON;
+    punct[','] = JOT_TOKEN_COMMA;
+    punct['('] = JOT_TOKEN_LPAREN;
+    punct[')'] = JOT_TOKEN_RPAREN;
+    punct['['] = JOT_TOKEN_LBRACKET;
+    punct[']'] = JOT_TOKEN_RBRACKET;
+    punct['{'] = JOT_TOKEN_LBRACE;
+    punct['}'] = JOT_TOKEN_RBRACE;
+    punct['/'] = JOT_TOKEN_DIV;
+    punct['%'] = JOT_TOKEN_MOD;
+    punct['&'] = JOT_TOKEN_AND;
+    punct['|'] = JOT_TOKEN_OR;
+    punct['^'] = JOT_TOKEN_XOR;
+    punct['~'] = JOT_TOKEN_TILDE;
+    
+    escapes['\\'] = '\\';
+    escapes['\''] = '\'';
+    escapes['\"'] = '\"';
+    escapes['a'] = '\a';
+    escapes['b'] = '\b';
+    escapes['f'] = '\f';
+    escapes['n'] = '\n';
+    escapes['r'] = '\r';
+    escapes['t'] = '\t';
+    escapes['v'] = '\v';
+}
+
+static void BuildTransitions(void)
+{
+    /*
+        Start of a token. Every transition that starts one goes through an
+        action (never plain JOT_SCAN_NEXT), so the scanner can note where it began.
+    */
+    Default(JOT_STATE_START, JOT_STATE_START, JOT_SCAN_EMIT_PUNCT, JOT_TOKEN_NONE);
+    /* Lines aren't counted while scanning (see jot_LineIndex), so line ends are just more space. */
+    On(JOT_STATE_START, CLASS_SPACE, JOT_STATE_START, JOT_SCAN_RUN_SPACE, JOT_TOKEN_NONE);
+    On(JOT_STATE_START, CLASS_LINE_END, JOT_STATE_START, JOT_SCAN_RUN_SPACE, JOT_TOKEN_NONE);
+    On(JOT_STATE_START, CLASS_EOS, JOT_STATE_START, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    On(JOT_STATE_START, CLASS_ZERO, JOT_STATE_ZERO, JOT_SCAN_BEGIN, JOT_TOKEN_NONE);
+    On(JOT_STATE_START, CLASS_ONE, JOT_STATE_INT, JOT_SCAN_BEGIN, JOT_TOKEN_NONE);
+    On(JOT_STATE_START, CLASS_DIGIT, JOT_STATE_INT, JOT_SCAN_BEGIN, JOT_TOKEN_NONE);
+    On(JOT_STATE_START, CLASS_QUOTE, JOT_STATE_STR, JOT_SCAN_BEGIN_STR, JOT_TOKEN_NONE);
+    OnEach(JOT_STATE_START, letters, JOT_STATE_IDENTIFIER, JOT_SCAN_BEGIN_IDENTIFIER, JOT_TOKEN_NONE);
+    /* Outside of strings and comments, non-ASCII text can only be part of an identifier. */
+    On(JOT_STATE_START, CLASS_UTF8, JOT_STATE_IDENTIFIER, JOT_SCAN_BEGIN_UTF8_IDENTIFIER, JOT_TOKEN_NONE);
+    On(JOT_STATE_START, CLASS_HASH, JOT_STATE_HASH, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    /* Might turn out to be the start of a number. */
+    On(JOT_STATE_START, CLASS_DOT, JOT_STATE_DOT, JOT_SCAN_BEGIN, JOT_TOKEN_NONE);
+    On(JOT_STATE_START, CLASS_LT, JOT_STATE_LT, JOT_SCAN_BEGIN, JOT_TOKEN_NONE);
+    On(JOT_STATE_START, CLASS_GT, JOT_STATE_GT, JOT_SCAN_BEGIN, JOT_TOKEN_NONE);
+    On(JOT_STATE_START, CLASS_EQ, JOT_STATE_EQ, JOT_SCAN_BEGIN, JOT_TOKEN_NONE);
+    On(JOT_STATE_START, CLASS_ASTERISK, JOT_STATE_ASTERISK, JOT_SCAN_BEGIN, JOT_TOKEN_NONE);
+    On(JOT_STATE_START, CLASS_DASH, JOT_STATE_DASH, JOT_SCAN_BEGIN, JOT_TOKEN_NONE);
+    On(JOT_STATE_START, CLASS_EXCLAIM, JOT_STATE_EXCLAIM, JOT_SCAN_BEGIN, JOT_TOKEN_NONE);
+    On(JOT_STATE_START, CLASS_PUNCT, JOT_STATE_START, JOT_SCAN_EMIT_PUNCT, JOT_TOKEN_NONE);
+    
+    /* Numbers. '_' is a place separator that's left out of the text. */
+    Default(JOT_STATE_ZERO, JOT_STATE_START, JOT_SCAN_EMIT_TEXT, JOT_TOKEN_INT);
+    OnEach(JOT_STATE_ZERO, decimal_digits, JOT_STATE_INT, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    On(JOT_STATE_ZERO, CLASS_UNDERSCORE, JOT_STATE_INT, JOT_SCAN_SKIP, JOT_TOKEN_NONE);
+    On(JOT_STATE_ZERO, CLASS_DOT, JOT_STATE_NUM, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    On(JOT_STATE_ZERO, CLASS_E, JOT_STATE_E_SIGN, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    On(JOT_STATE_ZERO, CLASS_X, JOT_STATE_HEX, JOT_SCAN_PREFIX, JOT_TOKEN_NONE);
+    On(JOT_STATE_ZERO, CLASS_B, JOT_STATE_BIN, JOT_SCAN_PREFIX, JOT_TOKEN_NONE);
+    
+    Default(JOT_STATE_INT, JOT_STATE_START, JOT_SCAN_EMIT_TEXT, JOT_TOKEN_INT);
+    OnEach(JOT_STATE_INT, decimal_digits, JOT_STATE_INT, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    On(JOT_STATE_INT, CLASS_UNDERSCORE, JOT_STATE_INT, JOT_SCAN_SKIP, JOT_TOKEN_NONE);
+    On(JOT_STATE_INT, CLASS_DOT, JOT_STATE_NUM, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    On(JOT_STATE_INT, CLASS_E, JOT_STATE_E_SIGN, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    
+    Default(JOT_STATE_NUM, JOT_STATE_START, JOT_SCAN_EMIT_TEXT, JOT_TOKEN_NUM);
+    OnEach(JOT_STATE_NUM, decimal_digits, JOT_STATE_NUM, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    On(JOT_STATE_NUM, CLASS_UNDERSCORE, JOT_STATE_NUM, JOT_SCAN_SKIP, JOT_TOKEN_NONE);
+    On(JOT_STATE_NUM, CLASS_E, JOT_STATE_E_SIGN, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    
+    Default(JOT_STATE_E_SIGN, JOT_STATE_START, JOT_SCAN_EMIT_TEXT, JOT_TOKEN_NUM);
+    OnEach(JOT_STATE_E_SIGN, decimal_digits, JOT_STATE_E_VALUE, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    On(JOT_STATE_E_SIGN, CLASS_PLUS, JOT_STATE_E_VALUE, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    On(JOT_STATE_E_SIGN, CLASS_DASH, JOT_STATE_E_VALUE, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    On(JOT_STATE_E_SIGN, CLASS_UNDERSCORE, JOT_STATE_E_VALUE, JOT_SCAN_SKIP, JOT_TOKEN_NONE);
+    
+    Default(JOT_STATE_E_VALUE, JOT_STATE_START, JOT_SCAN_EMIT_TEXT, JOT_TOKEN_NUM);
+    OnEach(JOT_STATE_E_VALUE, decimal_digits, JOT_STATE_E_VALUE, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    On(JOT_STATE_E_VALUE, CLASS_UNDERSCORE, JOT_STATE_E_VALUE, JOT_SCAN_SKIP, JOT_TOKEN_NONE);
+    
+    Default(JOT_STATE_HEX, JOT_STATE_START, JOT_SCAN_EMIT_TEXT, JOT_TOKEN_HEX);
+    OnEach(JOT_STATE_HEX, hex_digits, JOT_STATE_HEX, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    On(JOT_STATE_HEX, CLASS_UNDERSCORE, JOT_STATE_HEX, JOT_SCAN_SKIP, JOT_TOKEN_NONE);
+    
+    Default(JOT_STATE_BIN, JOT_STATE_START, JOT_SCAN_EMIT_TEXT, JOT_TOKEN_BIN);
+    OnEach(JOT_STATE_BIN, binary_digits, JOT_STATE_BIN, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    On(JOT_STATE_BIN, CLASS_UNDERSCORE, JOT_STATE_BIN, JOT_SCAN_SKIP, JOT_TOKEN_NONE);
+    
+    /* Strings. A line end or end-of-stream closes an unterminated string. */
+    Default(JOT_STATE_STR, JOT_STATE_STR, JOT_SCAN_RUN_STR, JOT_TOKEN_NONE);
+    On(JOT_STATE_STR, CLASS_QUOTE, JOT_STATE_STR, JOT_SCAN_QUOTE, JOT_TOKEN_NONE);
+    On(JOT_STATE_STR, CLASS_BACKSLASH, JOT_STATE_STR_BACKSLASH, JOT_SCAN_SKIP, JOT_TOKEN_NONE);
+    OnEach(JOT_STATE_STR, line_ends, JOT_STATE_START, JOT_SCAN_EMIT_TEXT, JOT_TOKEN_STR);
+    
+    /*
+        Invalid escapes are dropped, except that a non-ASCII character after
+        one is kept whole rather than losing its first byte.
+    */
+    Default(JOT_STATE_STR_BACKSLASH, JOT_STATE_STR, JOT_SCAN_DROP_ESCAPE, JOT_TOKEN_NONE);
+    On(JOT_STATE_STR_BACKSLASH, CLASS_UTF8, JOT_STATE_STR, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    OnEach(JOT_STATE_STR_BACKSLASH, simple_escapes, JOT_STATE_STR, JOT_SCAN_ESCAPE, JOT_TOKEN_NONE);
+    On(JOT_STATE_STR_BACKSLASH, CLASS_X, JOT_STATE_STR_HEX_HIGH, JOT_SCAN_DROP_ESCAPE, JOT_TOKEN_NONE);
+    OnEach(JOT_STATE_STR_BACKSLASH, line_ends, JOT_STATE_START, JOT_SCAN_EMIT_TEXT, JOT_TOKEN_STR);
+    
+    Default(JOT_STATE_STR_HEX_HIGH, JOT_STATE_STR, JOT_SCAN_DROP_ESCAPE, JOT_TOKEN_NONE);
+    OnEach(JOT_STATE_STR_HEX_HIGH, hex_digits, JOT_STATE_STR_HEX_LOW, JOT_SCAN_HEX_HIGH, JOT_TOKEN_NONE);
+    On(JOT_STATE_STR_HEX_HIGH, CLASS_UTF8, JOT_STATE_STR, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    OnEach(JOT_STATE_STR_HEX_HIGH, line_ends, JOT_STATE_START, JOT_SCAN_EMIT_TEXT, JOT_TOKEN_STR);
+    
+    Default(JOT_STATE_STR_HEX_LOW, JOT_STATE_STR, JOT_SCAN_DROP_ESCAPE, JOT_TOKEN_NONE);
+    OnEach(JOT_STATE_STR_HEX_LOW, hex_digits, JOT_STATE_STR, JOT_SCAN_HEX_LOW, JOT_TOKEN_NONE);
+    On(JOT_STATE_STR_HEX_LOW, CLASS_UTF8, JOT_STATE_STR, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    OnEach(JOT_STATE_STR_HEX_LOW, line_ends, JOT_STATE_START, JOT_SCAN_EMIT_TEXT, JOT_TOKEN_STR);
+    
+    Default(JOT_STATE_IDENTIFIER, JOT_STATE_START, JOT_SCAN_EMIT_IDENTIFIER, JOT_TOKEN_NONE);
+    OnEach(JOT_STATE_IDENTIFIER, ident_chars, JOT_STATE_IDENTIFIER, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    On(JOT_STATE_IDENTIFIER, CLASS_UTF8, JOT_STATE_IDENTIFIER, JOT_SCAN_UTF8_IDENTIFIER, JOT_TOKEN_NONE);
+    
+    /* # line comment, ## block comment ## */
+    Default(JOT_STATE_HASH, JOT_STATE_HASH_COMMENT, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    On(JOT_STATE_HASH, CLASS_HASH, JOT_STATE_HASH_HASH_COMMENT, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    On(JOT_STATE_HASH, CLASS_LINE_END, JOT_STATE_START, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    
+    Default(JOT_STATE_HASH_COMMENT, JOT_STATE_HASH_COMMENT, JOT_SCAN_RUN_LINE_COMMENT, JOT_TOKEN_NONE);
+    On(JOT_STATE_HASH_COMMENT, CLASS_EOS, JOT_STATE_HASH_COMMENT, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    On(JOT_STATE_HASH_COMMENT, CLASS_LINE_END, JOT_STATE_START, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    
+    /* An unclosed block comment just ends at end-of-stream. */
+    Default(JOT_STATE_HASH_HASH_COMMENT, JOT_STATE_HASH_HASH_COMMENT, JOT_SCAN_RUN_BLOCK_COMMENT, JOT_TOKEN_NONE);
+    On(JOT_STATE_HASH_HASH_COMMENT, CLASS_HASH, JOT_STATE_HASH_HASH_COMMENT_HASH, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    On(JOT_STATE_HASH_HASH_COMMENT, CLASS_EOS, JOT_STATE_START, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    
+    Default(JOT_STATE_HASH_HASH_COMMENT_HASH, JOT_STATE_HASH_HASH_COMMENT, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    On(JOT_STATE_HASH_HASH_COMMENT_HASH, CLASS_HASH, JOT_STATE_START, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    On(JOT_STATE_HASH_HASH_COMMENT_HASH, CLASS_EOS, JOT_STATE_START, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    
+    /* '.' '..' '...' or a number starting with a decimal point. */
+    Default(JOT_STATE_DOT, JOT_STATE_START, JOT_SCAN_EMIT, JOT_TOKEN_DOT);
+    OnEach(JOT_STATE_DOT, decimal_digits, JOT_STATE_NUM, JOT_SCAN_NEXT, JOT_TOKEN_NONE);
+    On(JOT_STATE_DOT, CLASS_DOT, JOT_STATE_DOT_DOT, JOT_SCAN_DROP_TEXT, JOT_TOKEN_NONE);
+    
+    Default(JOT_STATE_DOT_DOT, JOT_STATE_START, JOT_SCAN_EMIT, JOT_TOKEN_DOT_DOT);
+    On(JOT_STATE_DOT_DOT, CLASS_DOT, JOT_STATE_START, JOT_SCAN_EMIT_NEXT, JOT_TOKEN_DOT_DOT_DOT);
+    
+    /* Operators that might be followed by a second character. */
+    Default(JOT_STATE_LT, JOT_STATE_START, JOT_SCAN_EMIT, JOT_TOKEN_CMP_LT);
+    On(JOT_STATE_LT, CLASS_EQ, JOT_STATE_START, JOT_SCAN_EMIT_NEXT, JOT_TOKEN_CMP_LE);
+    On(JOT_STATE_LT, CLASS_LT, JOT_STATE_START, JOT_SCAN_EMIT_NEXT, JOT_TOKEN_SHL);
+    
+    Default(JOT_STATE_GT, JOT_STATE_START, JOT_SCAN_EMIT, JOT_TOKEN_CMP_GT);
+    On(JOT_STATE_GT, CLASS_EQ, JOT_STATE_START, JOT_SCAN_EMIT_NEXT, JOT_TOKEN_CMP_GE);
+    On(JOT_STATE_GT, CLASS_GT, JOT_STATE_START, JOT_SCAN_EMIT_NEXT, JOT_TOKEN_SHR);
+    
+    Default(JOT_STATE_EQ, JOT_STATE_START, JOT_SCAN_EMIT, JOT_TOKEN_ASSIGN);
+    On(JOT_STATE_EQ, CLASS_EQ, JOT_STATE_START, JOT_SCAN_EMIT_NEXT, JOT_TOKEN_CMP_EQ);
+    
+    Default(JOT_STATE_ASTERISK, JOT_STATE_START, JOT_SCAN_EMIT, JOT_TOKEN_MUL);
+    On(JOT_STATE_ASTERISK, CLASS_ASTERISK, JOT_STATE_START, JOT_SCAN_EMIT_NEXT, JOT_TOKEN_EXP);
+    
+    Default(JOT_STATE_DASH, JOT_STATE_START, JOT_SCAN_EMIT, JOT_TOKEN_SUB);
+    On(JOT_STATE_DASH, CLASS_GT, JOT_STATE_START, JOT_SCAN_EMIT_NEXT, JOT_TOKEN_ARROW);
+    
+    Default(JOT_STATE_EXCLAIM, JOT_STATE_START, JOT_SCAN_EMIT, JOT_TOKEN_EXCLAIM);
+    On(JOT_STATE_EXCLAIM, CLASS_EQ, JOT_STATE_START, JOT_SCAN_EMIT_NEXT, JOT_TOKEN_CMP_NE);
+}
+
+/*
+    Finds multipliers that make (first * a + last * b + length) % slots
+    collision-free over all keywords, preferring the smallest table. With
+    the keywords spread out like that, recognizing one takes a hash, a
+    length compare and a single memcmp.
+*/
+static int BuildKeywords(unsigned char* slots, unsigned int* slot_count, unsigned int* a, unsigned int* b)
+{
+    unsigned int count, i, j, k;
+    for(count = 32; count <= KEYWORD_MAX_SLOTS; count <<= 1)
+    {
+        for(i = 1; i < 64; i++)
+        {
+            for(j = 1; j < 64; j++)
+            {
+                memset(slots, 0, KEYWORD_MAX_SLOTS);
+                for(k = 1; k < KEYWORD_COUNT; k++)
+                {
+                    const char* name = keyword_names[k];
+                    size_t length = strlen(name);
+                    unsigned int hash = ((unsigned char) name[0] * i
+                        + (unsigned char) name[length - 1] * j
+                        + (unsigned int) length) & (count - 1);
+                    if(slots[hash])
+                    {
+                        break;
+                    }
+                    slots[hash] = (unsigned char) k;
+                }
+                if(k == KEYWORD_COUNT)
+                {
+                    *slot_count = count;
+                    *a = i;
+                    *b = j;
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+static void WriteBytes(const char* declaration, const unsigned char* table)
+{
+    int i;
+    printf("%s[256] = {", declaration);
+    for(i = 0; i < 256; i++)
+    {
+        printf("%s%3d%s", i % 16 ? " " : "\n    ", table[i], i < 255 ? "," : "\n");
+    }
+    printf("};\n\n");
+}
+
+int main(void)
+{
+    unsigned char eos_classes[256];
+    unsigned char keyword_slots[KEYWORD_MAX_SLOTS];
+    unsigned int keyword_slot_count, keyword_a, keyword_b;
+    size_t keyword_min_length, keyword_max_length;
+    int i, j;
+    
+    BuildClasses();
+    BuildTransitions();
+    memset(eos_classes, CLASS_EOS, sizeof(eos_classes));
+    if(!BuildKeywords(keyword_slots, &keyword_slot_count, &keyword_a, &keyword_b))
+    {
+        fprintf(stderr, "jot_scangen: no perfect hash found for the keywords\n");
+        return 1;
+    }
+    keyword_min_length = keyword_max_length = strlen(keyword_names[1]);
+    for(i = 1; i < KEYWORD_COUNT; i++)
+    {
+        size_t length = strlen(keyword_names[i]);
+        keyword_min_length = length < keyword_min_length ? length : keyword_min_length;
+        keyword_max_length = length > keyword_max_length ? length : keyword_max_length;
+    }
+    
+    printf("/* Generated by src/tools/jot_scangen.c -- do not edit. */\n");
+    printf("#ifndef JOT_SCANTAB_H\n");
+    printf("#define JOT_SCANTAB_H\n\n");
+    
+    printf("enum\n{\n");
+    printf("    JOT_SCAN_CLASS_EOS = %d,\n", CLASS_EOS);
+    printf("    JOT_SCAN_CLASS_COUNT = %d,\n", CLASS_COUNT);
+    printf("    JOT_SCAN_STATE_COUNT = %d,\n", STATE_COUNT);
+    printf("    JOT_SCAN_KEYWORD_SLOTS = %u,\n", keyword_slot_count);
+    printf("    JOT_SCAN_KEYWORD_A = %u,\n", keyword_a);
+    printf("    JOT_SCAN_KEYWORD_B = %u,\n", keyword_b);
+    printf("    JOT_SCAN_KEYWORD_MIN_LENGTH = %u,\n", (unsigned int) keyword_min_length);
+    printf("    JOT_SCAN_KEYWORD_MAX_LENGTH = %u\n", (unsigned int) keyword_max_length);
+    printf("};\n\n");
+    
+    WriteBytes("static const unsigned char jot_scan_classes", classes);
+    printf("/* Stands in for jot_scan_classes once the source is exhausted. */\n");
+    WriteBytes("static const unsigned char jot_scan_eos_classes", eos_classes);
+    WriteBytes("static const unsigned char jot_scan_escapes", escapes);
+    WriteBytes("static const unsigned char jot_scan_punct", punct);
+    
+    printf("/* next state | action << %d | token << %d, by state then class:\n", JOT_SCAN_ACTION_SHIFT, JOT_SCAN_TOKEN_SHIFT);
+    for(i = 0; i < CLASS_COUNT; i++)
+    {
+        printf("%s%2d %s", i % 6 ? ", " : "\n    ", i, class_names[i]);
+    }
+    printf("\n*/\n");
+    printf("static const unsigned short jot_scan_transitions[%d][%d] = {\n", STATE_COUNT, CLASS_COUNT);
+    for(i = 0; i < STATE_COUNT; i++)
+    {
+        printf("    /* %s */\n    {", state_names[i]);
+        for(j = 0; j < CLASS_COUNT; j++)
+        {
+            printf("%s0x%04X", j == 0 ? "" : j % 8 == 0 ? ",\n     " : ", ", transitions[i][j]);
+        }
+        printf("}%s\n", i < STATE_COUNT - 1 ? "," : "");
+    }
+    printf("};\n\n");
+    
+    printf("/* Slot (first * A + last * B + length) %% SLOTS holds the only keyword that can match. */\n");
+    printf("static const struct\n{\n    const char* text;\n    unsigned char length;\n    unsigned char keyword;\n}");
+    printf(" jot_scan_keywords[%u] = {\n", keyword_slot_count);
+    for(i = 0; i < (int) keyword_slot_count; i++)
+    {
+        const char* separator = i < (int) keyword_slot_count - 1 ? "," : "";
+        if(keyword_slots[i])
+        {
+            const char* name = keyword_names[keyword_slots[i]];
+            printf("    {\"%s\", %u, %d}%s\n", name, (unsigned int) strlen(name), keyword_slots[i], separator);
+        }
+        else
+        {
+            printf("    {\"\", 0, 0}%s\n", separator);
+        }
+    }
+    printf("};\n\n");
+    
+    printf("#endif\n");
+    return 0;
+}
@@ -0,0 +1,218 @@
+/*
+    jot - UTF-8 Table Generator
+    
+    -
+
+    Copyright (C) 2011 by Andrew G. Crowell
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+*/
+
+/*
+    Builds the XID_Start and XID_Continue lookup tables that jot_utf8.c uses
+    to check identifiers, from the Unicode Character Database's
+    DerivedCoreProperties.txt, and writes them out as C source:
+
+        cc jot_utf8gen.c -o jot_utf8gen
+        ./jot_utf8gen DerivedCoreProperties.txt > ../jot/jot_utf8tab.h
+
+    The code space is cut into pages of 256 code points. Each property gets a
+    page index per page, and the pages themselves are 256-bit bitmaps, shared
+    between both properties when identical, so the mostly-empty and
+    mostly-full parts of the code space cost one page each.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum
+{
+    CODE_POINT_COUNT = 0x110000,
+    PAGE_BITS = 8,
+    PAGE_SIZE = 1 << PAGE_BITS,
+    PAGE_BYTES = PAGE_SIZE / 8,
+    PAGE_COUNT = CODE_POINT_COUNT / PAGE_SIZE,
+    
+    PROPERTY_START = 0,
+    PROPERTY_CONTINUE = 1,
+    PROPERTY_COUNT = 2
+};
+
+static const char* const property_names[PROPERTY_COUNT] = { "XID_Start", "XID_Continue" };
+static const char* const table_names[PROPERTY_COUNT] = { "jot_utf8_xid_start", "jot_utf8_xid_continue" };
+
+static unsigned char bits[PROPERTY_COUNT][CODE_POINT_COUNT / 8];
+static unsigned char pages[PROPERTY_COUNT * PAGE_COUNT][PAGE_BYTES];
+static unsigned int page_index[PROPERTY_COUNT][PAGE_COUNT];
+static int page_count;
+
+/* Parses a line like "0041..005A    ; XID_Start # L&  [26] ...". */
+static void ParseLine(const char* line)
+{
+    char* end;
+    unsigned long first, last, c;
+    int property;
+    
+    first = strtoul(line, &end, 16);
+    if(end == line)
+    {
+        return;
+    }
+    last = first;
+    if(end[0] == '.' && end[1] == '.')
+    {
+        last = strtoul(end + 2, &end, 16);
+    }
+    while(*end == ' ' || *end == '\t')
+    {
+        end++;
+    }
+    if(*end++ != ';')
+    {
+        return;
+    }
+    while(*end == ' ' || *end == '\t')
+    {
+        end++;
+    }
+    for(property = 0; property < PROPERTY_COUNT; property++)
+    {
+        size_t length = strlen(property_names[property]);
+        if(!strncmp(end, property_names[property], length)
+            && (end[length] == ' ' || end[length] == '\t' || end[length] == '#' || end[length] == '\n' || end[length] == '\r' || end[length] == '\0'))
+        {
+            for(c = first; c <= last && c < CODE_POINT_COUNT; c++)
+            {
+                bits[property][c / 8] |= 1 << c % 8;
+            }
+        }
+    }
+}
+
+static unsigned int FindPage(const unsigned char* page)
+{
+    int i;
+    for(i = 0; i < page_count; i++)
+    {
+        if(!memcmp(pages[i], page, PAGE_BYTES))
+        {
+            return i;
+        }
+    }
+    memcpy(pages[page_count], page, PAGE_BYTES);
+    return page_count++;
+}
+
+int main(int argc, char** argv)
+{
+    FILE* f;
+    char line[1024];
+    char version[256];
+    int property, page, used, i;
+    
+    if(argc != 2)
+    {
+        fprintf(stderr, "usage: %s DerivedCoreProperties.txt\n", argv[0]);
+        return 1;
+    }
+    f = fopen(argv[1], "r");
+    if(!f)
+    {
+        fprintf(stderr, "%s: can't open %s\n", argv[0], argv[1]);
+        return 1;
+    }
+    
+    /* The first line names the file, e.g. "# DerivedCoreProperties-14.0.0.txt". */
+    strcpy(version, "unknown");
+    if(fgets(line, sizeof(line), f) && sscanf(line, "# DerivedCoreProperties-%255[0-9.]", version) == 1)
+    {
+        size_t length = strlen(version);
+        if(length && version[length - 1] == '.')
+        {
+            version[length - 1] = '\0';
+        }
+    }
+    while(fgets(line, sizeof(line), f))
+    {
+        ParseLine(line);
+    }
+    fclose(f);
+    
+    /* Page 0 is the empty page, which also covers everything past the end of the index. */
+    {
+        unsigned char empty[PAGE_BYTES];
+        memset(empty, 0, sizeof(empty));
+        FindPage(empty);
+    }
+    used = 0;
+    for(property = 0; property < PROPERTY_COUNT; property++)
+    {
+        for(page = 0; page < PAGE_COUNT; page++)
+        {
+            page_index[property][page] = FindPage(&bits[property][page * PAGE_BYTES]);
+            if(page_index[property][page] && page + 1 > used)
+            {
+                used = page + 1;
+            }
+        }
+    }
+    
+    if(page_count > 256)
+    {
+        fprintf(stderr, "%s: %d distinct pages don't fit an unsigned char index\n", argv[0], page_count);
+        return 1;
+    }
+    
+    printf("/* Generated by src/tools/jot_utf8gen.c from DerivedCoreProperties.txt (Unicode %s) -- do not edit. */\n", version);
+    printf("#ifndef JOT_UTF8TAB_H\n");
+    printf("#define JOT_UTF8TAB_H\n\n");
+    
+    printf("enum\n{\n");
+    printf("    JOT_UTF8_PAGE_BITS = %d,\n", PAGE_BITS);
+    printf("    JOT_UTF8_PAGE_COUNT = %d\n", used);
+    printf("};\n\n");
+    
+    for(property = 0; property < PROPERTY_COUNT; property++)
+    {
+        printf("/* Page of jot_utf8_pages holding the %s bits for code points (page << JOT_UTF8_PAGE_BITS) and up. */\n", property_names[property]);
+        printf("static const unsigned char %s[%d] = {", table_names[property], used);
+        for(page = 0; page < used; page++)
+        {
+            printf("%s%u%s", page % 16 ? " " : "\n    ", page_index[property][page], page + 1 < used ? "," : "\n");
+        }
+        printf("};\n\n");
+    }
+    
+    printf("/* 256-bit pages, bit (c & 7) of byte ((c & 255) >> 3) for code point c. */\n");
+    printf("static const unsigned char jot_utf8_pages[%d][%d] = {\n", page_count, PAGE_BYTES);
+    for(page = 0; page < page_count; page++)
+    {
+        printf("    {");
+        for(i = 0; i < PAGE_BYTES; i++)
+        {
+            printf("0x%02X%s", pages[page][i], i + 1 < PAGE_BYTES ? "," : "");
+        }
+        printf("}%s\n", page + 1 < page_count ? "," : "");
+    }
+    printf("};\n\n");
+    
+    printf("#endif\n");
+    return 0;
+}